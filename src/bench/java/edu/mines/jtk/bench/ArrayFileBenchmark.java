@@ -0,0 +1,84 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.bench;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.ByteOrder;
+import java.util.Random;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.*;
+
+import edu.mines.jtk.io.ArrayFile;
+import static edu.mines.jtk.util.ArrayMath.*;
+
+/**
+ * JMH benchmarks for writing and reading 3-D arrays of n x n x n floats
+ * with an array file, in big- or little-endian byte order. The file is
+ * a temporary file that is deleted after each trial.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@Warmup(iterations=3)
+@Measurement(iterations=5)
+@Fork(1)
+public class ArrayFileBenchmark {
+
+  @Param({"64","256"})
+  public int n;
+
+  @Param({"BIG_ENDIAN","LITTLE_ENDIAN"})
+  public String order;
+
+  @Setup
+  public void setUp() throws IOException {
+    _bo = order.equals("BIG_ENDIAN") ?
+      ByteOrder.BIG_ENDIAN :
+      ByteOrder.LITTLE_ENDIAN;
+    _f = randfloat(new Random(314159),n,n,n);
+    _file = File.createTempFile("ArrayFileBenchmark",".dat");
+    _af = new ArrayFile(_file,"rw",_bo,_bo);
+    _af.writeFloats(_f);
+  }
+
+  @TearDown
+  public void tearDown() throws IOException {
+    _af.close();
+    _file.delete();
+  }
+
+  @Benchmark
+  public float[][][] writeFloats() throws IOException {
+    _af.seek(0);
+    _af.writeFloats(_f);
+    return _f;
+  }
+
+  @Benchmark
+  public float[][][] readFloats() throws IOException {
+    _af.seek(0);
+    _af.readFloats(_f);
+    return _f;
+  }
+
+  private ByteOrder _bo;
+  private float[][][] _f;
+  private File _file;
+  private ArrayFile _af;
+}
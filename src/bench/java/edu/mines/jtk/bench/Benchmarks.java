@@ -0,0 +1,63 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.bench;
+
+import java.util.concurrent.ForkJoinPool;
+
+import edu.mines.jtk.util.Parallel;
+
+/**
+ * Utilities shared by the JMH benchmarks in this package.
+ * <p>
+ * These benchmarks are compiled and run with the Gradle task bench,
+ * which writes results in JSON format to build/bench/results.json.
+ * Options for JMH may be specified with the Gradle property jmh; e.g.,
+ * <pre><code>
+ * gradlew bench -Pjmh="Fft -p nthread=1,4"
+ * </code></pre>
+ * Unlike the other programs in this package, which use a
+ * {@link edu.mines.jtk.util.Stopwatch}, these benchmarks are warmed up,
+ * run in forked virtual machines, and summarized with statistics.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+class Benchmarks {
+
+  /**
+   * Makes methods of {@link Parallel} use a specified number of threads.
+   * @param nthread the number of threads; zero, for one thread per
+   *  available processor.
+   * @return the pool used by Parallel before this method was called.
+   */
+  static ForkJoinPool setThreads(int nthread) {
+    ForkJoinPool pool = Parallel.getPool();
+    if (nthread<=0)
+      nthread = Runtime.getRuntime().availableProcessors();
+    Parallel.setPool(new ForkJoinPool(nthread));
+    return pool;
+  }
+
+  /**
+   * Restores the pool used by methods of {@link Parallel}.
+   * The pool set by {@link #setThreads(int)} is shut down.
+   * @param pool the pool returned by setThreads.
+   */
+  static void restoreThreads(ForkJoinPool pool) {
+    ForkJoinPool current = Parallel.getPool();
+    Parallel.setPool(pool);
+    if (current!=pool)
+      current.shutdown();
+  }
+}
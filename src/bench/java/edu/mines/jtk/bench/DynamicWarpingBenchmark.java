@@ -0,0 +1,71 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.bench;
+
+import java.util.Random;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.*;
+
+import edu.mines.jtk.dsp.DynamicWarping;
+import static edu.mines.jtk.util.ArrayMath.*;
+
+/**
+ * JMH benchmarks for dynamic warping of 2-D images with n2 traces of
+ * N1 samples each, for shifts in [-SHIFT_MAX,SHIFT_MAX].
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@Warmup(iterations=3)
+@Measurement(iterations=5)
+@Fork(1)
+public class DynamicWarpingBenchmark {
+
+  @Param({"100","1000"})
+  public int n2;
+
+  @Param({"1","0"})
+  public int nthread;
+
+  @Setup
+  public void setUp() {
+    _pool = Benchmarks.setThreads(nthread);
+    Random r = new Random(314159);
+    _dw = new DynamicWarping(-SHIFT_MAX,SHIFT_MAX);
+    _f = randfloat(r,N1,n2);
+    _g = randfloat(r,N1,n2);
+  }
+
+  @TearDown
+  public void tearDown() {
+    Benchmarks.restoreThreads(_pool);
+  }
+
+  @Benchmark
+  public float[][] findShifts() {
+    return _dw.findShifts(_f,_g);
+  }
+
+  private static final int N1 = 501;
+  private static final int SHIFT_MAX = 20;
+
+  private ForkJoinPool _pool;
+  private DynamicWarping _dw;
+  private float[][] _f,_g;
+}
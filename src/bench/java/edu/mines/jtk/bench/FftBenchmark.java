@@ -0,0 +1,90 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.bench;
+
+import java.util.Random;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.*;
+
+import edu.mines.jtk.dsp.Fft;
+import edu.mines.jtk.dsp.FftReal;
+import static edu.mines.jtk.util.ArrayMath.*;
+
+/**
+ * JMH benchmarks for FFTs of 1-D, 2-D and 3-D arrays.
+ * The 2-D arrays have n x n samples; the 3-D arrays have
+ * n/4 x n/4 x n/4 samples.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@Warmup(iterations=3)
+@Measurement(iterations=5)
+@Fork(1)
+public class FftBenchmark {
+
+  @Param({"256","1024"})
+  public int n;
+
+  @Param({"1","0"})
+  public int nthread;
+
+  @Setup
+  public void setUp() {
+    _pool = Benchmarks.setThreads(nthread);
+    Random r = new Random(314159);
+    int nfft = FftReal.nfftFast(n*n);
+    _fft = new FftReal(nfft);
+    _rx = randfloat(r,nfft);
+    _cy = new float[nfft+2];
+    _f2 = randfloat(r,n,n);
+    _fft2 = new Fft(_f2);
+    int m = n/4;
+    _f3 = randfloat(r,m,m,m);
+    _fft3 = new Fft(_f3);
+  }
+
+  @TearDown
+  public void tearDown() {
+    Benchmarks.restoreThreads(_pool);
+  }
+
+  @Benchmark
+  public float[] realToComplex1() {
+    _fft.realToComplex(-1,_rx,_cy);
+    return _cy;
+  }
+
+  @Benchmark
+  public float[][] forward2() {
+    return _fft2.applyForward(_f2);
+  }
+
+  @Benchmark
+  public float[][][] forward3() {
+    return _fft3.applyForward(_f3);
+  }
+
+  private ForkJoinPool _pool;
+  private FftReal _fft;
+  private float[] _rx,_cy;
+  private float[][] _f2;
+  private float[][][] _f3;
+  private Fft _fft2,_fft3;
+}
@@ -0,0 +1,89 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.bench;
+
+import java.util.Random;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.*;
+
+import edu.mines.jtk.dsp.LocalSmoothingFilter;
+import static edu.mines.jtk.util.ArrayMath.*;
+
+/**
+ * JMH benchmarks for local smoothing filters of 2-D and 3-D arrays.
+ * The 2-D arrays have n x n samples; the 3-D arrays have
+ * n/4 x n/4 x n/4 samples. The number of conjugate-gradient iterations
+ * is fixed, so that times are comparable.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@Warmup(iterations=3)
+@Measurement(iterations=5)
+@Fork(1)
+public class LocalSmoothingBenchmark {
+
+  @Param({"256","512"})
+  public int n;
+
+  @Param({"1","0"})
+  public int nthread;
+
+  @Param({"none","simple","multigrid"})
+  public String preconditioner;
+
+  @Setup
+  public void setUp() {
+    _pool = Benchmarks.setThreads(nthread);
+    Random r = new Random(314159);
+    _lsf = new LocalSmoothingFilter(0.0,NITER);
+    _lsf.setPreconditioner(preconditioner.equals("simple"));
+    _lsf.setMultigrid(preconditioner.equals("multigrid"));
+    _x2 = randfloat(r,n,n);
+    _y2 = zerofloat(n,n);
+    int m = n/4;
+    _x3 = randfloat(r,m,m,m);
+    _y3 = zerofloat(m,m,m);
+  }
+
+  @TearDown
+  public void tearDown() {
+    Benchmarks.restoreThreads(_pool);
+  }
+
+  @Benchmark
+  public float[][] apply2() {
+    _lsf.apply(C,_x2,_y2);
+    return _y2;
+  }
+
+  @Benchmark
+  public float[][][] apply3() {
+    _lsf.apply(C,_x3,_y3);
+    return _y3;
+  }
+
+  private static final int NITER = 20;
+  private static final float C = 10.0f;
+
+  private ForkJoinPool _pool;
+  private LocalSmoothingFilter _lsf;
+  private float[][] _x2,_y2;
+  private float[][][] _x3,_y3;
+}
@@ -0,0 +1,88 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.bench;
+
+import java.util.Random;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.*;
+
+import edu.mines.jtk.dsp.Sampling;
+import edu.mines.jtk.interp.SibsonInterpolator2;
+import edu.mines.jtk.interp.SibsonInterpolator3;
+import static edu.mines.jtk.util.ArrayMath.*;
+
+/**
+ * JMH benchmarks for Sibson interpolation of m scattered samples onto
+ * uniform grids in 2-D and 3-D. Scattered samples lie within a unit
+ * square or cube. Interpolators are constructed once, so that times
+ * include interpolation only.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@Warmup(iterations=3)
+@Measurement(iterations=5)
+@Fork(1)
+public class SibsonBenchmark {
+
+  @Param({"1000","10000"})
+  public int m;
+
+  @Param({"1","0"})
+  public int nthread;
+
+  @Setup
+  public void setUp() {
+    _pool = Benchmarks.setThreads(nthread);
+    Random r = new Random(314159);
+    float[] f = randfloat(r,m);
+    float[] x1 = randfloat(r,m);
+    float[] x2 = randfloat(r,m);
+    float[] x3 = randfloat(r,m);
+    _si2 = new SibsonInterpolator2(f,x1,x2);
+    _si3 = new SibsonInterpolator3(f,x1,x2,x3);
+    _s2 = new Sampling(N2,1.0/(N2-1),0.0);
+    _s3 = new Sampling(N3,1.0/(N3-1),0.0);
+    _si2.setBounds(_s2,_s2);
+    _si3.setBounds(_s3,_s3,_s3);
+  }
+
+  @TearDown
+  public void tearDown() {
+    Benchmarks.restoreThreads(_pool);
+  }
+
+  @Benchmark
+  public float[][] interpolate2() {
+    return _si2.interpolate(_s2,_s2);
+  }
+
+  @Benchmark
+  public float[][][] interpolate3() {
+    return _si3.interpolate(_s3,_s3,_s3);
+  }
+
+  private static final int N2 = 501; // number of samples in 2-D grids
+  private static final int N3 = 51; // number of samples in 3-D grids
+
+  private ForkJoinPool _pool;
+  private SibsonInterpolator2 _si2;
+  private SibsonInterpolator3 _si3;
+  private Sampling _s2,_s3;
+}
@@ -0,0 +1,67 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.bench;
+
+import java.util.Random;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.*;
+
+import edu.mines.jtk.mesh.TetMesh;
+import static edu.mines.jtk.util.ArrayMath.*;
+
+/**
+ * JMH benchmarks for building tetrahedral meshes of n random nodes.
+ * Nodes are added either one at a time, in random order, or in bulk,
+ * in the order chosen by {@link TetMesh#addNodes(float[],float[],float[])}.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@Warmup(iterations=3)
+@Measurement(iterations=5)
+@Fork(1)
+public class TetMeshBenchmark {
+
+  @Param({"10000","100000"})
+  public int n;
+
+  @Setup
+  public void setUp() {
+    Random r = new Random(314159);
+    _x = randfloat(r,n);
+    _y = randfloat(r,n);
+    _z = randfloat(r,n);
+  }
+
+  @Benchmark
+  public TetMesh addNode() {
+    TetMesh mesh = new TetMesh();
+    for (int i=0; i<n; ++i)
+      mesh.addNode(new TetMesh.Node(_x[i],_y[i],_z[i]));
+    return mesh;
+  }
+
+  @Benchmark
+  public TetMesh addNodes() {
+    TetMesh mesh = new TetMesh();
+    mesh.addNodes(_x,_y,_z);
+    return mesh;
+  }
+
+  private float[] _x,_y,_z;
+}
@@ -30,6 +30,7 @@ public class ArrayFileBench {
   public static void main(String[] args) {
     benchEndian();
     benchStream();
+    benchVolume();
   }
 
   ///////////////////////////////////////////////////////////////////////////
@@ -90,6 +91,69 @@ public class ArrayFileBench {
     System.out.println(" ArrayInputStream: sum="+s+" nr="+nr+" rate="+rate);
   }
 
+  private static void benchVolume() {
+    try {
+      File file = File.createTempFile("junk","dat");
+      file.deleteOnExit();
+      int n1 = 251, n2 = 252, n3 = 253; // short rows, like traces
+      float[][][] a = randfloat(n1,n2,n3);
+      float[][][] b = zerofloat(n1,n2,n3);
+      boolean[] d = {false,true};
+      for (boolean direct:d)
+        benchVolume(file,direct,a,b);
+      benchVolume(file,a,b);
+    } catch (IOException ioe) {
+      throw new RuntimeException(ioe);
+    }
+  }
+  private static void benchVolume(
+    File file, boolean direct, float[][][] a, float[][][] b) 
+    throws IOException 
+  {
+    ByteOrder order = ByteOrder.LITTLE_ENDIAN;
+    Stopwatch sw = new Stopwatch();
+    double mbytes = 4.0e-6*a.length*a[0].length*a[0][0].length;
+    int nio;
+    sw.start();
+    for (nio=0; sw.time()<5.0; ++nio) {
+      ArrayOutputStream aos = 
+        new ArrayOutputStream(new FileOutputStream(file),order,direct);
+      aos.writeFloats(a);
+      aos.close();
+      ArrayInputStream ais = 
+        new ArrayInputStream(new FileInputStream(file),order,direct);
+      ais.readFloats(b);
+      ais.close();
+    }
+    sw.stop();
+    if (!equal(a,b))
+      throw new RuntimeException("volume: i/o failure");
+    double rate = 2.0*mbytes*nio/sw.time();
+    System.out.println("volume: direct="+direct+" rate="+rate+" MB/s");
+  }
+  private static void benchVolume(File file, float[][][] a, float[][][] b) 
+    throws IOException 
+  {
+    ByteOrder order = ByteOrder.LITTLE_ENDIAN;
+    Stopwatch sw = new Stopwatch();
+    double mbytes = 4.0e-6*a.length*a[0].length*a[0][0].length;
+    int nio;
+    ArrayFile af = new ArrayFile(file,"rw",order,order);
+    sw.start();
+    for (nio=0; sw.time()<5.0; ++nio) {
+      af.seek(0);
+      af.writeFloats(a);
+      af.seek(0);
+      af.readFloats(b);
+    }
+    sw.stop();
+    af.close();
+    if (!equal(a,b))
+      throw new RuntimeException("volume: i/o failure");
+    double rate = 2.0*mbytes*nio/sw.time();
+    System.out.println("volume: ArrayFile rate="+rate+" MB/s");
+  }
+
   private static void benchEndian() {
     benchBigEndian();
     benchLittleEndian();
@@ -14,17 +14,25 @@ limitations under the License.
 ****************************************************************************/
 package edu.mines.jtk.bench;
 
+import edu.mines.jtk.dsp.Fft;
 import edu.mines.jtk.dsp.FftComplex;
 import static edu.mines.jtk.util.ArrayMath.crandfloat;
+import static edu.mines.jtk.util.ArrayMath.randfloat;
+import edu.mines.jtk.util.Parallel;
 import edu.mines.jtk.util.Stopwatch;
 
 /**
- * Benchmark FFTs.
+ * Benchmark FFTs. With the argument "parallel", this benchmark instead
+ * compares serial and parallel times for 2-D and 3-D transforms.
  * @author Dave Hale, Colorado School of Mines
  * @version 2005.03.24
  */
 public class FftBench {
   public static void main(String[] args) {
+    if (args.length>0 && args[0].equals("parallel")) {
+      benchParallel();
+      return;
+    }
     for (int niter=0; niter<5; ++niter) {
       for (int nfft=1; nfft<=720720;) {
         int nfftSmall = FftComplex.nfftSmall(nfft);
@@ -44,6 +52,48 @@ public class FftBench {
     }
   }
 
+  private static void benchParallel() {
+    int nthread = Runtime.getRuntime().availableProcessors();
+    System.out.println("nthread="+nthread);
+    for (int niter=0; niter<3; ++niter) {
+      float[][] f2 = randfloat(1000,1000);
+      float[][][] f3 = randfloat(200,200,200);
+      double ts2 = time(false,f2), tp2 = time(true,f2);
+      double ts3 = time(false,f3), tp3 = time(true,f3);
+      System.out.printf("2D: serial=%.4f parallel=%.4f speedup=%.2f\n",
+        ts2,tp2,ts2/tp2);
+      System.out.printf("3D: serial=%.4f parallel=%.4f speedup=%.2f\n",
+        ts3,tp3,ts3/tp3);
+    }
+    Parallel.setParallel(true);
+  }
+
+  private static double time(boolean parallel, float[][] f) {
+    Parallel.setParallel(parallel);
+    Fft fft = new Fft(f);
+    double maxtime = 2.0;
+    int count;
+    Stopwatch sw = new Stopwatch();
+    sw.start();
+    for (count=0; sw.time()<maxtime; ++count)
+      fft.applyInverse(fft.applyForward(f));
+    sw.stop();
+    return sw.time()/(float)count;
+  }
+
+  private static double time(boolean parallel, float[][][] f) {
+    Parallel.setParallel(parallel);
+    Fft fft = new Fft(f);
+    double maxtime = 2.0;
+    int count;
+    Stopwatch sw = new Stopwatch();
+    sw.start();
+    for (count=0; sw.time()<maxtime; ++count)
+      fft.applyInverse(fft.applyForward(f));
+    sw.stop();
+    return sw.time()/(float)count;
+  }
+
   private static double time(int nfft) {
     double maxtime = 2.0;
     FftComplex fft = new FftComplex(nfft);
@@ -18,6 +18,7 @@ import static java.lang.Math.min;
 import java.util.concurrent.*;
 import java.util.concurrent.atomic.AtomicInteger;
 
+import edu.mines.jtk.la.Dgemm;
 import edu.mines.jtk.util.*;
 import static edu.mines.jtk.util.ArrayMath.*;
 
@@ -93,6 +94,83 @@ public class MtMatMulBench {
       assertEquals(c1,c4);
       assertEquals(c1,c5);
     }
+    benchDouble(m,n,maxtime);
+  }
+
+  /**
+   * Compares double-precision multiplication by simple dot products,
+   * by blocked and multi-threaded edu.mines.jtk.la.Dgemm, and by the
+   * BLAS dgemm of netlib-java, which may be native or F2J.
+   */
+  private static void benchDouble(int m, int n, double maxtime) {
+    double[][] a = randdouble(n,m);
+    double[][] b = randdouble(m,n);
+    double[][] c1 = zerodouble(m,m);
+    double[][] c2 = zerodouble(m,m);
+    double[] ap = packColumns(a);
+    double[] bp = packColumns(b);
+    double[] cp = new double[m*m];
+    org.netlib.blas.BLAS blas = org.netlib.blas.BLAS.getInstance();
+    Stopwatch s = new Stopwatch();
+    double mflops = 2.0e-6*m*m*n;
+
+    System.out.println();
+    System.out.println("Double-precision matrix multiply benchmark");
+    System.out.println("dot  = single-threaded dot products");
+    System.out.println("la   = edu.mines.jtk.la.Dgemm");
+    System.out.println("blas = "+blas.getClass().getName());
+    for (int ntrial=0; ntrial<3; ++ntrial) {
+      System.out.println();
+      int nmul;
+
+      s.restart();
+      for (nmul=0; s.time()<maxtime; ++nmul)
+        mulDot(a,b,c1);
+      s.stop();
+      System.out.println("dot:  rate="+(int)(nmul*mflops/s.time())+" mflops");
+
+      s.restart();
+      for (nmul=0; s.time()<maxtime; ++nmul)
+        Dgemm.mul(false,false,1.0,a,b,0.0,c2);
+      s.stop();
+      System.out.println("la:   rate="+(int)(nmul*mflops/s.time())+" mflops");
+
+      s.restart();
+      for (nmul=0; s.time()<maxtime; ++nmul)
+        blas.dgemm("N","N",m,m,n,1.0,ap,m,bp,n,0.0,cp,m);
+      s.stop();
+      System.out.println("blas: rate="+(int)(nmul*mflops/s.time())+" mflops");
+
+      System.out.println("max |la-dot| = "+max(abs(sub(c2,c1))));
+    }
+  }
+
+  private static void mulDot(double[][] a, double[][] b, double[][] c) {
+    int ni = c.length;
+    int nj = c[0].length;
+    int nk = b.length;
+    double[] bj = new double[nk];
+    for (int j=0; j<nj; ++j) {
+      for (int k=0; k<nk; ++k)
+        bj[k] = b[k][j];
+      for (int i=0; i<ni; ++i) {
+        double[] ai = a[i];
+        double s = 0.0;
+        for (int k=0; k<nk; ++k)
+          s += ai[k]*bj[k];
+        c[i][j] = s;
+      }
+    }
+  }
+
+  private static double[] packColumns(double[][] x) {
+    int m = x.length;
+    int n = x[0].length;
+    double[] y = new double[m*n];
+    for (int j=0; j<n; ++j)
+      for (int i=0; i<m; ++i)
+        y[i+j*m] = x[i][j];
+    return y;
   }
 
   /**
@@ -15,20 +15,26 @@ limitations under the License.
 package edu.mines.jtk.bench;
 
 import static edu.mines.jtk.util.ArrayMath.sum;
+import edu.mines.jtk.util.Parallel;
 import edu.mines.jtk.util.Stopwatch;
 
 /**
- * Benchmark QR decompositions in packages la and lapack.
+ * Benchmark QR decompositions in packages la and lapack. The blocked QR
+ * decomposition in package la is timed with and without multi-threaded
+ * matrix multiplication.
  * @author Dave Hale, Colorado School of Mines
  * @version 2005.12.14
  */
 public class QrdBench {
 
   public static void main(String[] args) {
+    bench(100,5,5);
+    bench(1000,500,5);
+  }
+
+  private static void bench(int m, int n, int nrhs) {
     double maxtime = 5;
-    int m = 100;
-    int n = 5;
-    int nrhs = 5;
+    System.out.println("m="+m+" n="+n+" nrhs="+nrhs);
 
     // Pure Java.
     edu.mines.jtk.la.DMatrix aj = 
@@ -45,20 +51,24 @@ public class QrdBench {
     double rate,sum;
     int nqrd;
     Stopwatch sw = new Stopwatch();
-    for (int niter=0; niter<5; ++niter) {
+    for (int niter=0; niter<3; ++niter) {
 
-      // edu.mines.jtk.la
-      edu.mines.jtk.la.DMatrixQrd qrd1;
-      edu.mines.jtk.la.DMatrix x1 = new edu.mines.jtk.la.DMatrix(1,1);
-      sw.restart();
-      for (nqrd=0;  sw.time()<maxtime; ++nqrd) {
-        qrd1 = new edu.mines.jtk.la.DMatrixQrd(aj);
-        x1 = qrd1.solve(bj);
+      // edu.mines.jtk.la, single-threaded and multi-threaded
+      for (int ipar=0; ipar<2; ++ipar) {
+        Parallel.setParallel(ipar==1);
+        edu.mines.jtk.la.DMatrixQrd qrd1;
+        edu.mines.jtk.la.DMatrix x1 = new edu.mines.jtk.la.DMatrix(1,1);
+        sw.restart();
+        for (nqrd=0;  sw.time()<maxtime; ++nqrd) {
+          qrd1 = new edu.mines.jtk.la.DMatrixQrd(aj);
+          x1 = qrd1.solve(bj);
+        }
+        sw.stop();
+        sum = sum(x1.getArray());
+        rate = nqrd/sw.time();
+        System.out.println("edu.mines.jtk.la"+((ipar==1)?" (mt):":":     ")+
+                           " rate="+rate+" sum="+sum);
       }
-      sw.stop();
-      sum = sum(x1.getArray());
-      rate = nqrd/sw.time();
-      System.out.println("edu.mines.jtk.la:     rate="+rate+" sum="+sum);
 
       // edu.mines.jtk.lapack
       edu.mines.jtk.lapack.DMatrixQrd qrd2;
@@ -71,7 +81,7 @@ public class QrdBench {
       sw.stop();
       sum = sum(x2.getArray());
       rate = nqrd/sw.time();
-      System.out.println("edu.mines.jtk.lapack: rate="+rate+" sum="+sum);
+      System.out.println("edu.mines.jtk.lapack:  rate="+rate+" sum="+sum);
     }
   }
 }
@@ -14,6 +14,7 @@ limitations under the License.
 ****************************************************************************/
 package edu.mines.jtk.dsp;
 
+import edu.mines.jtk.util.Parallel;
 import static edu.mines.jtk.util.ArrayMath.*;
 
 /**
@@ -70,6 +71,17 @@ import static edu.mines.jtk.util.ArrayMath.*;
  * Unlike convolution, cross-correlation is not commutative. In other words,
  * the cross-correlation of x and y does not equal the cross-correlation of 
  * y and x.
+ * <p>
+ * Depending on the lengths of sequences, sums are computed directly or
+ * with fast Fourier transforms. Direct sums are faster for short
+ * sequences. When both sequences are long, FFTs are faster; for 1-D
+ * sequences, the longer sequence is then transformed in overlapping
+ * blocks (overlap-save), so that the cost of each block is proportional
+ * to the length of the shorter sequence. For 2-D and 3-D sequences,
+ * arrays are transformed in only the 1st dimension and, as for direct
+ * sums, output samples for different indices in the outer dimension are
+ * computed in parallel. Results computed with FFTs differ from direct
+ * sums only by rounding errors.
  * @author Dave Hale, Colorado School of Mines
  * @version 2005.08.15
  */
@@ -92,7 +104,12 @@ public class Conv {
     int ly, int ky, float[] y,
     int lz, int kz, float[] z)
   {
-    convFast(lx,kx,x,ly,ky,y,lz,kz,z);
+    int nfft = nfftConv(lx,kx,ly,ky,lz,kz);
+    if (nfft>0) {
+      convFft(nfft,lx,kx,x,ly,ky,y,lz,kz,z);
+    } else {
+      convFast(lx,kx,x,ly,ky,y,lz,kz,z);
+    }
   }
 
   /**
@@ -118,15 +135,15 @@ public class Conv {
     int ly1, int ly2, int ky1, int ky2, float[][] y,
     int lz1, int lz2, int kz1, int kz2, float[][] z)
   {
-    zero(lz1,lz2,z);
-    int ilo2 = kz2-kx2-ky2;
-    int ihi2 = ilo2+lz2-1;
-    for (int i2=ilo2; i2<=ihi2; ++i2) {
-      int jlo2 = max(0,i2-ly2+1);
-      int jhi2 = min(lx2-1,i2);
-      for (int j2=jlo2; j2<=jhi2; ++j2) {
-        convSum(lx1,kx1,x[j2],ly1,ky1,y[i2-j2],lz1,kz1,z[i2-ilo2]);
-      }
+    if (lz2<=0)
+      return;
+    long npair = countPairs(lx2,ly2,kz2-kx2-ky2,lz2);
+    int nfft = nfftRows(lx1,kx1,ly1,ky1,lz1,kz1,npair,lx2+ly2+lz2);
+    if (nfft>0) {
+      convFft(nfft,lx1,lx2,kx1,kx2,x,ly1,ly2,ky1,ky2,y,lz1,lz2,kz1,kz2,z);
+    } else {
+      convSum(lx1,lx2,kx1,kx2,x,ly1,ly2,ky1,ky2,y,lz1,lz2,kz1,kz2,z,
+              isParallel(npair*min(lx1,ly1)*lz1));
     }
   }
 
@@ -159,25 +176,21 @@ public class Conv {
     int ly1, int ly2, int ly3, int ky1, int ky2, int ky3, float[][][] y,
     int lz1, int lz2, int lz3, int kz1, int kz2, int kz3, float[][][] z)
   {
-    zero(lz1,lz2,lz3,z);
-    int ilo2 = kz2-kx2-ky2;
-    int ilo3 = kz3-kx3-ky3;
-    int ihi2 = ilo2+lz2-1;
-    int ihi3 = ilo3+lz3-1;
-    for (int i3=ilo3; i3<=ihi3; ++i3) {
-      int jlo3 = max(0,i3-ly3+1);
-      int jhi3 = min(lx3-1,i3);
-      for (int j3=jlo3; j3<=jhi3; ++j3) {
-        for (int i2=ilo2; i2<=ihi2; ++i2) {
-          int jlo2 = max(0,i2-ly2+1);
-          int jhi2 = min(lx2-1,i2);
-          for (int j2=jlo2; j2<=jhi2; ++j2) {
-            convSum(lx1,kx1,x[j3][j2],
-                    ly1,ky1,y[i3-j3][i2-j2],
-                    lz1,kz1,z[i3-ilo3][i2-ilo2]);
-          }
-        }
-      }
+    if (lz2<=0 || lz3<=0)
+      return;
+    long npair = countPairs(lx2,ly2,kz2-kx2-ky2,lz2)
+                *countPairs(lx3,ly3,kz3-kx3-ky3,lz3);
+    long nrow = (long)lx2*lx3+(long)ly2*ly3+(long)lz2*lz3;
+    int nfft = nfftRows(lx1,kx1,ly1,ky1,lz1,kz1,npair,nrow);
+    if (nfft>0) {
+      convFft(nfft,lx1,lx2,lx3,kx1,kx2,kx3,x,
+                   ly1,ly2,ly3,ky1,ky2,ky3,y,
+                   lz1,lz2,lz3,kz1,kz2,kz3,z);
+    } else {
+      convSum(lx1,lx2,lx3,kx1,kx2,kx3,x,
+              ly1,ly2,ly3,ky1,ky2,ky3,y,
+              lz1,lz2,lz3,kz1,kz2,kz3,z,
+              isParallel(npair*min(lx1,ly1)*lz1));
     }
   }
 
@@ -282,6 +295,343 @@ public class Conv {
   ///////////////////////////////////////////////////////////////////////////
   // private
 
+  // Sequences shorter than this are always convolved with direct sums.
+  private static final int FFT_MIN = 32;
+
+  // Approximate cost of FFTs, in multiply-adds per sample per log2(nfft),
+  // relative to the cost of one multiply-add in a direct sum.
+  private static final double FFT_COST = 3.0;
+
+  // Maximum FFT length supported by FftReal.
+  private static final int NFFT_MAX = 1441440;
+
+  // Minimum number of multiply-adds for which outer loops are parallel.
+  private static final long PARALLEL_MIN = 1L<<16;
+
+  /**
+   * Returns the number of samples in the range [imin,imin+lz) for which
+   * the convolution of sequences with lengths lx and ly may be non-zero.
+   */
+  private static int countOutputs(int lx, int ly, int imin, int lz) {
+    int ilo = max(0,imin);
+    int ihi = min(lx+ly-2,imin+lz-1);
+    return max(0,1+ihi-ilo);
+  }
+
+  /**
+   * Returns the number of pairs of indices (i,j) for which the index
+   * i of an output sample lies in [imin,imin+lz) and both j and i-j are
+   * valid indices for sequences with lengths lx and ly, respectively.
+   */
+  private static long countPairs(int lx, int ly, int imin, int lz) {
+    long npair = 0;
+    for (int i=imin; i<imin+lz; ++i) {
+      int jlo = max(0,i-ly+1);
+      int jhi = min(lx-1,i);
+      if (jlo<=jhi)
+        npair += 1+jhi-jlo;
+    }
+    return npair;
+  }
+
+  /**
+   * Returns the FFT length for overlap-save convolution of 1-D sequences,
+   * or zero, if direct convolution is expected to be faster.
+   */
+  private static int nfftConv(
+    int lx, int kx, int ly, int ky, int lz, int kz)
+  {
+    int nz = countOutputs(lx,ly,kz-kx-ky,lz);
+    int lmin = min(lx,ly);
+    if (lmin<FFT_MIN || nz<FFT_MIN)
+      return 0;
+
+    // Each block of length nfft yields nfft-lmin+1 output samples. Blocks
+    // about four times longer than the shorter sequence are efficient,
+    // but blocks need not be longer than required for all output samples.
+    int n = (int)min((long)lmin-1+nz,4L*lmin);
+    if (n>NFFT_MAX) {
+      if (2*lmin>NFFT_MAX)
+        return 0;
+      n = NFFT_MAX;
+    }
+    int nfft = FftReal.nfftFast(n);
+    int nb = nfft-lmin+1;
+    int nblock = (nz+nb-1)/nb;
+    double costFft = FFT_COST*nblock*nfft*log2(nfft);
+    double costSum = (double)lmin*nz;
+    return (costFft<costSum)?nfft:0;
+  }
+
+  /**
+   * Returns the FFT length for convolution of 2-D or 3-D sequences with
+   * FFTs of their 1st dimension, or zero, if direct convolution is
+   * expected to be faster. The number of pairs of 1-D sequences to be
+   * convolved is npair, and the number of 1-D FFTs required is nrow.
+   */
+  private static int nfftRows(
+    int lx1, int kx1, int ly1, int ky1, int lz1, int kz1,
+    long npair, long nrow)
+  {
+    int nz1 = countOutputs(lx1,ly1,kz1-kx1-ky1,lz1);
+    int lmin = min(lx1,ly1);
+    int n = lx1+ly1-1;
+    if (lmin<FFT_MIN || nz1<FFT_MIN || n>NFFT_MAX)
+      return 0;
+    int nfft = FftReal.nfftFast(n);
+    double costFft = FFT_COST*nrow*nfft*log2(nfft)+2.0*npair*nfft;
+    double costSum = (double)npair*lmin*nz1;
+    return (costFft<costSum)?nfft:0;
+  }
+
+  private static double log2(int n) {
+    return Math.log(n)/Math.log(2.0);
+  }
+
+  private static boolean isParallel(long nmul) {
+    return nmul>=PARALLEL_MIN;
+  }
+
+  // Performs a loop over indices i = 0, 1, ..., n-1, in parallel if
+  // specified and if more than one index.
+  private static void loop(int n, boolean parallel, Parallel.LoopInt body) {
+    if (parallel && n>1) {
+      Parallel.loop(n,body);
+    } else {
+      for (int i=0; i<n; ++i)
+        body.compute(i);
+    }
+  }
+
+  // Direct convolution of 2-D sequences; output rows are independent.
+  private static void convSum(
+    final int lx1, final int lx2, final int kx1, final int kx2,
+    final float[][] x,
+    final int ly1, final int ly2, final int ky1, final int ky2,
+    final float[][] y,
+    final int lz1, final int lz2, final int kz1, final int kz2,
+    final float[][] z, boolean parallel)
+  {
+    final int ilo2 = kz2-kx2-ky2;
+    loop(lz2,parallel,new Parallel.LoopInt() {
+    public void compute(int iz2) {
+      int i2 = ilo2+iz2;
+      zero(lz1,z[iz2]);
+      int jlo2 = max(0,i2-ly2+1);
+      int jhi2 = min(lx2-1,i2);
+      for (int j2=jlo2; j2<=jhi2; ++j2) {
+        convSum(lx1,kx1,x[j2],ly1,ky1,y[i2-j2],lz1,kz1,z[iz2]);
+      }
+    }});
+  }
+
+  // Direct convolution of 3-D sequences; output slices are independent.
+  private static void convSum(
+    final int lx1, final int lx2, final int lx3,
+    final int kx1, final int kx2, final int kx3, final float[][][] x,
+    final int ly1, final int ly2, final int ly3,
+    final int ky1, final int ky2, final int ky3, final float[][][] y,
+    final int lz1, final int lz2, final int lz3,
+    final int kz1, final int kz2, final int kz3, final float[][][] z,
+    boolean parallel)
+  {
+    final int ilo2 = kz2-kx2-ky2;
+    final int ilo3 = kz3-kx3-ky3;
+    loop(lz3,parallel,new Parallel.LoopInt() {
+    public void compute(int iz3) {
+      int i3 = ilo3+iz3;
+      zero(lz1,lz2,z[iz3]);
+      int jlo3 = max(0,i3-ly3+1);
+      int jhi3 = min(lx3-1,i3);
+      for (int j3=jlo3; j3<=jhi3; ++j3) {
+        for (int iz2=0,i2=ilo2; iz2<lz2; ++iz2,++i2) {
+          int jlo2 = max(0,i2-ly2+1);
+          int jhi2 = min(lx2-1,i2);
+          for (int j2=jlo2; j2<=jhi2; ++j2) {
+            convSum(lx1,kx1,x[j3][j2],
+                    ly1,ky1,y[i3-j3][i2-j2],
+                    lz1,kz1,z[iz3][iz2]);
+          }
+        }
+      }
+    }});
+  }
+
+  // Overlap-save convolution. After swapping so that x is the shorter
+  // sequence, the transform of x is computed once. Then, for each block
+  // of nb = nfft-lx+1 output samples beginning with index i0, a block
+  // of nfft samples of y beginning with index i0-lx+1 is transformed,
+  // multiplied by the transform of x, and inverse transformed. The last
+  // nb samples of the resulting circular convolution equal samples of
+  // the (linear) convolution z with indices i0, i0+1, ..., i0+nb-1.
+  private static void convFft(
+    int nfft,
+    int lx, int kx, float[] x,
+    int ly, int ky, float[] y,
+    int lz, int kz, float[] z)
+  {
+    if (lx>ly) {
+      int lt = lx;  lx = ly;  ly = lt;
+      int kt = kx;  kx = ky;  ky = kt;
+      float[] t = x;  x = y;  y = t;
+    }
+    int imin = kz-kx-ky;
+    int ilo = max(0,imin);
+    int ihi = min(lx+ly-2,imin+lz-1);
+    zero(lz,z);
+    FftReal fft = new FftReal(nfft);
+    float[] cx = fftRow(fft,lx,x,1.0f/nfft);
+    float[] cy = new float[nfft+2];
+    int nb = nfft-lx+1;
+    for (int i0=ilo; i0<=ihi; i0+=nb) {
+      int jy = i0-lx+1;
+      for (int i=0,j=jy; i<nfft; ++i,++j)
+        cy[i] = (0<=j && j<ly)?y[j]:0.0f;
+      fft.realToComplex(-1,cy,cy);
+      mulComplex(nfft,cx,cy);
+      fft.complexToReal(1,cy,cy);
+      int i1 = min(ihi,i0+nb-1);
+      for (int i=i0; i<=i1; ++i)
+        z[i-imin] = cy[i-jy];
+    }
+  }
+
+  // Convolution of 2-D sequences via FFTs of their 1st dimension. Rows
+  // of x and y are transformed once. Then, for each output row, products
+  // of transformed rows are accumulated and inverse transformed.
+  private static void convFft(
+    final int nfft,
+    int lx1, final int lx2, int kx1, int kx2, float[][] x,
+    int ly1, final int ly2, int ky1, int ky2, float[][] y,
+    final int lz1, int lz2, int kz1, int kz2, final float[][] z)
+  {
+    final int n1 = lx1+ly1-1;
+    final int imin1 = kz1-kx1-ky1;
+    final int ilo2 = kz2-kx2-ky2;
+    final FftReal fft = new FftReal(nfft);
+    final float[][] cx = fftRows(fft,lx1,lx2,x,1.0f/nfft);
+    final float[][] cy = fftRows(fft,ly1,ly2,y,1.0f);
+    final Parallel.Unsafe<float[]> cu = new Parallel.Unsafe<float[]>();
+    loop(lz2,true,new Parallel.LoopInt() {
+    public void compute(int iz2) {
+      float[] cz = cu.get();
+      if (cz==null) cu.set(cz=new float[nfft+2]);
+      zero(nfft+2,cz);
+      int i2 = ilo2+iz2;
+      int jlo2 = max(0,i2-ly2+1);
+      int jhi2 = min(lx2-1,i2);
+      for (int j2=jlo2; j2<=jhi2; ++j2)
+        mulAddComplex(nfft,cx[j2],cy[i2-j2],cz);
+      if (jlo2<=jhi2)
+        fft.complexToReal(1,cz,cz);
+      copyRow(n1,imin1,lz1,cz,z[iz2]);
+    }});
+  }
+
+  // Convolution of 3-D sequences via FFTs of their 1st dimension.
+  private static void convFft(
+    final int nfft,
+    int lx1, final int lx2, final int lx3,
+    int kx1, int kx2, int kx3, float[][][] x,
+    int ly1, final int ly2, final int ly3,
+    int ky1, int ky2, int ky3, float[][][] y,
+    final int lz1, final int lz2, int lz3,
+    int kz1, int kz2, int kz3, final float[][][] z)
+  {
+    final int n1 = lx1+ly1-1;
+    final int imin1 = kz1-kx1-ky1;
+    final int ilo2 = kz2-kx2-ky2;
+    final int ilo3 = kz3-kx3-ky3;
+    final FftReal fft = new FftReal(nfft);
+    final float[][][] cx = fftRows(fft,lx1,lx2,lx3,x,1.0f/nfft);
+    final float[][][] cy = fftRows(fft,ly1,ly2,ly3,y,1.0f);
+    final Parallel.Unsafe<float[]> cu = new Parallel.Unsafe<float[]>();
+    loop(lz3,true,new Parallel.LoopInt() {
+    public void compute(int iz3) {
+      float[] cz = cu.get();
+      if (cz==null) cu.set(cz=new float[nfft+2]);
+      int i3 = ilo3+iz3;
+      int jlo3 = max(0,i3-ly3+1);
+      int jhi3 = min(lx3-1,i3);
+      for (int iz2=0,i2=ilo2; iz2<lz2; ++iz2,++i2) {
+        int jlo2 = max(0,i2-ly2+1);
+        int jhi2 = min(lx2-1,i2);
+        zero(nfft+2,cz);
+        for (int j3=jlo3; j3<=jhi3; ++j3) {
+          for (int j2=jlo2; j2<=jhi2; ++j2)
+            mulAddComplex(nfft,cx[j3][j2],cy[i3-j3][i2-j2],cz);
+        }
+        if (jlo3<=jhi3 && jlo2<=jhi2)
+          fft.complexToReal(1,cz,cz);
+        copyRow(n1,imin1,lz1,cz,z[iz3][iz2]);
+      }
+    }});
+  }
+
+  // Returns the FFT of the specified sequence, scaled and zero-padded.
+  private static float[] fftRow(FftReal fft, int lx, float[] x, float s) {
+    int nfft = fft.getNfft();
+    float[] cx = new float[nfft+2];
+    for (int i=0; i<lx; ++i)
+      cx[i] = s*x[i];
+    fft.realToComplex(-1,cx,cx);
+    return cx;
+  }
+
+  private static float[][] fftRows(
+    final FftReal fft, final int lx1, int lx2, final float[][] x,
+    final float s)
+  {
+    final float[][] cx = new float[lx2][];
+    loop(lx2,true,new Parallel.LoopInt() {
+    public void compute(int i2) {
+      cx[i2] = fftRow(fft,lx1,x[i2],s);
+    }});
+    return cx;
+  }
+
+  private static float[][][] fftRows(
+    final FftReal fft, final int lx1, final int lx2, int lx3,
+    final float[][][] x, final float s)
+  {
+    final float[][][] cx = new float[lx3][lx2][];
+    loop(lx3,true,new Parallel.LoopInt() {
+    public void compute(int i3) {
+      for (int i2=0; i2<lx2; ++i2)
+        cx[i3][i2] = fftRow(fft,lx1,x[i3][i2],s);
+    }});
+    return cx;
+  }
+
+  // Complex multiply b = a*b, for nfft/2+1 complex numbers.
+  private static void mulComplex(int nfft, float[] a, float[] b) {
+    for (int ir=0,ii=1; ir<=nfft; ir+=2,ii+=2) {
+      float ar = a[ir], ai = a[ii];
+      float br = b[ir], bi = b[ii];
+      b[ir] = ar*br-ai*bi;
+      b[ii] = ar*bi+ai*br;
+    }
+  }
+
+  // Complex multiply-add c += a*b, for nfft/2+1 complex numbers.
+  private static void mulAddComplex(
+    int nfft, float[] a, float[] b, float[] c)
+  {
+    for (int ir=0,ii=1; ir<=nfft; ir+=2,ii+=2) {
+      float ar = a[ir], ai = a[ii];
+      float br = b[ir], bi = b[ii];
+      c[ir] += ar*br-ai*bi;
+      c[ii] += ar*bi+ai*br;
+    }
+  }
+
+  // Copies samples c[i] of a convolution with n non-zero samples to
+  // z[i-imin], for i = imin, imin+1, ..., imin+lz-1.
+  private static void copyRow(int n, int imin, int lz, float[] c, float[] z) {
+    for (int iz=0,i=imin; iz<lz; ++iz,++i)
+      z[iz] = (0<=i && i<n)?c[i]:0.0f;
+  }
+
   ///////////////////////////////////////////////////////////////////////////
   // Convolution with only (slightly more than) one load per multiply-add. 
   // Simpler and slower alternatives to this method require at least two 
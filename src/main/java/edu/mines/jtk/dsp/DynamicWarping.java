@@ -50,6 +50,9 @@ import static edu.mines.jtk.util.ArrayMath.*;
  * is likely to be too large for the temporary array to fit in random-
  * access memory (RAM). In this case, shifts u are obtained by blending 
  * together shifts computed from overlapping subsets of the 3D image.
+ * Alternatively, shifts may be found by streaming, one trace at a time,
+ * so that the temporary arrays required are proportional to the number 
+ * of threads, not to the number of image samples.
  * <p>
  * Estimated shifts u can be smoothed, and the extent of smoothing 
  * along each dimension is inversely proportional to the strain limit 
@@ -193,6 +196,24 @@ public class DynamicWarping {
     _esmooth = esmooth;
   }
 
+  /**
+   * Sets whether shifts for 2D and 3D images are found by streaming.
+   * When streaming, alignment errors are computed, smoothed, accumulated
+   * and backtracked for one trace f[i2] or f[i3][i2] at a time, using 
+   * temporary arrays[n1][nl] that are allocated only once per thread.
+   * Memory required then grows with the number of threads instead of
+   * the number of image samples, and 3D images are not split into 
+   * overlapping windows.
+   * <p>
+   * Because traces are processed independently, alignment errors are 
+   * normalized and smoothed in only the 1st dimension. Shifts are still
+   * smoothed in all dimensions. The default is not streaming.
+   * @param streaming true, for streaming; false, otherwise.
+   */
+  public void setStreaming(boolean streaming) {
+    _streaming = streaming;
+  }
+
   /**
    * Sets extent of smoothing filters used to smooth shifts.
    * Half-widths of smoothing filters are inversely proportional to
@@ -350,22 +371,55 @@ public class DynamicWarping {
    * @param u output array of shifts u.
    */
   public void findShifts(float[][] f, float[][] g, float[][] u) {
-    final float[][][] e = computeErrors(f,g);
+    if (_streaming) {
+      findShiftsByTrace(
+        new float[][][]{f},new float[][][]{g},new float[][][]{u});
+      Profiler.start(PROFILE_SMOOTH_SHIFTS);
+      try {
+        smoothShifts(u,u);
+      } finally {
+        Profiler.stop(PROFILE_SMOOTH_SHIFTS);
+      }
+      return;
+    }
+    final float[][][] e;
+    Profiler.start(PROFILE_ERRORS);
+    try {
+      e = computeErrors(f,g);
+    } finally {
+      Profiler.stop(PROFILE_ERRORS);
+    }
     final int nl = e[0][0].length;
     final int n1 = e[0].length;
     final int n2 = e.length;
+    Profiler.count(PROFILE_BYTES,4L*nl*n1*n2);
     final float[][] uf = u;
-    for (int is=0; is<_esmooth; ++is)
-      smoothErrors(e,e);
+    Profiler.start(PROFILE_SMOOTH_ERRORS);
+    try {
+      for (int is=0; is<_esmooth; ++is)
+        smoothErrors(e,e);
+    } finally {
+      Profiler.stop(PROFILE_SMOOTH_ERRORS);
+    }
     final Parallel.Unsafe<float[][]> du = new Parallel.Unsafe<float[][]>();
     Parallel.loop(n2,new Parallel.LoopInt() {
     public void compute(int i2) {
-      float[][] d = du.get();
-      if (d==null) du.set(d=new float[n1][nl]);
-      accumulateForward(e[i2],d);
-      backtrackReverse(d,e[i2],uf[i2]);
+      Profiler.start(PROFILE_ACCUMULATE);
+      try {
+        float[][] d = du.get();
+        if (d==null) du.set(d=new float[n1][nl]);
+        accumulateForward(e[i2],d);
+        backtrackReverse(d,e[i2],uf[i2]);
+      } finally {
+        Profiler.stop(PROFILE_ACCUMULATE);
+      }
     }});
-    smoothShifts(u,u);
+    Profiler.start(PROFILE_SMOOTH_SHIFTS);
+    try {
+      smoothShifts(u,u);
+    } finally {
+      Profiler.stop(PROFILE_SMOOTH_SHIFTS);
+    }
   }
 
   /**
@@ -375,6 +429,16 @@ public class DynamicWarping {
    * @param u output array of shifts u.
    */
   public void findShifts(float[][][] f, float[][][] g, float[][][] u) {
+    if (_streaming) {
+      findShiftsByTrace(f,g,u);
+      Profiler.start(PROFILE_SMOOTH_SHIFTS);
+      try {
+        smoothShifts(u);
+      } finally {
+        Profiler.stop(PROFILE_SMOOTH_SHIFTS);
+      }
+      return;
+    }
     int n1 = f[0][0].length;
     int n2 = f[0].length;
     int n3 = f.length;
@@ -388,6 +452,7 @@ public class DynamicWarping {
     float[][][] gw = new float[l3][l2][];
     float[][][] uw = new float[l3][l2][n1];
     float[][][][] ew = new float[l3][l2][n1][_nl];
+    Profiler.count(PROFILE_BYTES,4L*l3*l2*n1*(1+_nl));
     for (int k3=0; k3<m3; ++k3) {
       int i3 = ow.getI2(k3);
       for (int k2=0; k2<m2; ++k2) {
@@ -398,11 +463,26 @@ public class DynamicWarping {
             gw[j3][j2] = g[i3+j3][i2+j2];
           }
         }
-        computeErrors(fw,gw,ew);
-        normalizeErrors(ew);
-        for (int is=0; is<_esmooth; ++is)
-          smoothErrors(ew);
-        computeShifts(ew,uw);
+        Profiler.start(PROFILE_ERRORS);
+        try {
+          computeErrors(fw,gw,ew);
+          normalizeErrors(ew);
+        } finally {
+          Profiler.stop(PROFILE_ERRORS);
+        }
+        Profiler.start(PROFILE_SMOOTH_ERRORS);
+        try {
+          for (int is=0; is<_esmooth; ++is)
+            smoothErrors(ew);
+        } finally {
+          Profiler.stop(PROFILE_SMOOTH_ERRORS);
+        }
+        Profiler.start(PROFILE_ACCUMULATE);
+        try {
+          computeShifts(ew,uw);
+        } finally {
+          Profiler.stop(PROFILE_ACCUMULATE);
+        }
         for (int j3=0; j3<l3; ++j3) {
           for (int j2=0; j2<l2; ++j2) {
             float wij = ow.getWeight(i2,i3,j2,j3);
@@ -413,7 +493,12 @@ public class DynamicWarping {
         }
       }
     }
-    smoothShifts(u);
+    Profiler.start(PROFILE_SMOOTH_SHIFTS);
+    try {
+      smoothShifts(u);
+    } finally {
+      Profiler.stop(PROFILE_SMOOTH_SHIFTS);
+    }
   }
 
   /**
@@ -494,9 +579,10 @@ public class DynamicWarping {
    */
   public void applyShifts(float[] u, float[] g, float[] h) {
     int n1 = u.length;
-    for (int i1=0; i1<n1; ++i1) {
-      h[i1] = _si.interpolate(n1,1.0,0.0,g,i1+u[i1]);
-    }
+    float[] x = new float[n1];
+    for (int i1=0; i1<n1; ++i1)
+      x[i1] = i1+u[i1];
+    _si.interpolate(n1,1.0,0.0,g,n1,x,h);
   }
 
   /**
@@ -513,9 +599,10 @@ public class DynamicWarping {
     final float[][] hf = h;
     Parallel.loop(n2,new Parallel.LoopInt() {
     public void compute(int i2) {
-      for (int i1=0; i1<n1; ++i1) {
-        hf[i2][i1] = _si.interpolate(n1,1.0,0.0,gf[i2],i1+uf[i2][i1]);
-      }
+      float[] x = new float[n1];
+      for (int i1=0; i1<n1; ++i1)
+        x[i1] = i1+uf[i2][i1];
+      _si.interpolate(n1,1.0,0.0,gf[i2],n1,x,hf[i2]);
     }});
   }
 
@@ -1095,6 +1182,18 @@ public class DynamicWarping {
   ///////////////////////////////////////////////////////////////////////////
   // private
 
+  // Names of phases and counters for the profiler.
+  private static final String PROFILE_ERRORS =
+    "DynamicWarping.computeErrors";
+  private static final String PROFILE_SMOOTH_ERRORS =
+    "DynamicWarping.smoothErrors";
+  private static final String PROFILE_ACCUMULATE =
+    "DynamicWarping.accumulate";
+  private static final String PROFILE_SMOOTH_SHIFTS =
+    "DynamicWarping.smoothShifts";
+  private static final String PROFILE_BYTES =
+    "DynamicWarping.bytesAllocated";
+
   private int _nl; // number of lags
   private int _lmin,_lmax; // min,max lags
   private ErrorExtrapolation _extrap; // method for error extrapolation
@@ -1114,6 +1213,7 @@ public class DynamicWarping {
   private int _owl3 = 50; // window size in 3rd dimension for 3D images
   private double _owf2 = 0.5; // fraction of window overlap in 2nd dimension
   private double _owf3 = 0.5; // fraction of window overlap in 3rd dimension
+  private boolean _streaming; // true, if finding shifts one trace at a time
 
   private float error(float f, float g) {
     return pow(abs(f-g),_epow);
@@ -1360,8 +1460,23 @@ public class DynamicWarping {
   private static void smoothErrors1(int b, float[][] e, float[][] es) {
     int nl = e[0].length;
     int n1 = e.length;
-    float[][] ef = new float[n1][nl];
-    float[][] er = new float[n1][nl];
+    smoothErrors1(b,e,es,new float[n1][nl],new float[n1][nl]);
+  }
+
+  /**
+   * Smooths alignment errors in 1st dimension, using specified work arrays.
+   * Does not normalize errors after smoothing.
+   * @param b strain parameter in 1st dimension.
+   * @param e input array of alignment errors to be smooothed.
+   * @param es output array of smoothed alignment errors.
+   * @param ef work array of errors accumulated in forward direction.
+   * @param er work array of errors accumulated in reverse direction.
+   */
+  private static void smoothErrors1(
+    int b, float[][] e, float[][] es, float[][] ef, float[][] er) 
+  {
+    int nl = e[0].length;
+    int n1 = e.length;
     accumulate( 1,b,e,ef);
     accumulate(-1,b,e,er);
     for (int i1=0; i1<n1; ++i1)
@@ -1546,6 +1661,47 @@ public class DynamicWarping {
       }
     }});
   }
+  private void findShiftsByTrace(
+    final float[][][] f, final float[][][] g, final float[][][] u)
+  {
+    final int nl = _nl;
+    final int n1 = f[0][0].length;
+    final int n2 = f[0].length;
+    final int n3 = f.length;
+    final int nw = (_esmooth>0)?3:2;
+    final Parallel.Unsafe<float[][][]> edu = 
+      new Parallel.Unsafe<float[][][]>();
+    Parallel.loop2(n2,n3,new Parallel.LoopInt2() {
+    public void compute(int i2, int i3) {
+      float[][][] ed = edu.get();
+      if (ed==null) edu.set(ed=new float[nw][n1][nl]);
+      float[][] e = ed[0];
+      float[][] d = ed[1];
+      Profiler.start(PROFILE_ERRORS);
+      try {
+        computeErrors(f[i3][i2],g[i3][i2],e);
+        normalizeErrors(e);
+      } finally {
+        Profiler.stop(PROFILE_ERRORS);
+      }
+      Profiler.start(PROFILE_SMOOTH_ERRORS);
+      try {
+        for (int is=0; is<_esmooth; ++is) {
+          smoothErrors1(_bstrain1,e,e,d,ed[2]);
+          normalizeErrors(e);
+        }
+      } finally {
+        Profiler.stop(PROFILE_SMOOTH_ERRORS);
+      }
+      Profiler.start(PROFILE_ACCUMULATE);
+      try {
+        accumulate( 1,_bstrain1,e,d);
+        backtrack(-1,_bstrain1,_lmin,d,e,u[i3][i2]);
+      } finally {
+        Profiler.stop(PROFILE_ACCUMULATE);
+      }
+    }});
+  }
   private void smoothShifts(float[][][] u) {
     if (_ref1!=null) _ref1.apply1(u,u);
     if (_ref2!=null) _ref2.apply2(u,u);
@@ -19,6 +19,7 @@ import java.io.*;
 import edu.mines.jtk.io.ArrayInputStream;
 import edu.mines.jtk.io.ArrayOutputStream;
 import static edu.mines.jtk.util.ArrayMath.*;
+import edu.mines.jtk.util.Parallel;
 import edu.mines.jtk.util.UnitSphereSampling;
 
 
@@ -107,30 +108,21 @@ public class EigenTensors3 implements Tensors3,Serializable {
    * @param compressed true, for compressed tensors; false, otherwise.
    */
   public EigenTensors3(
-    float[][][] u1, float[][][] u2,
-    float[][][] w1, float[][][] w2,
-    float[][][] au, float[][][] av, float[][][] aw,
+    final float[][][] u1, final float[][][] u2,
+    final float[][][] w1, final float[][][] w2,
+    final float[][][] au, final float[][][] av, final float[][][] aw,
     boolean compressed)
   {
     this(u1[0][0].length,u1[0].length,u1.length,compressed);
-    for (int i3=0; i3<_n3; ++i3) {
+    Parallel.loop(_n3,new Parallel.LoopInt() {
+    public void compute(int i3) {
       for (int i2=0; i2<_n2; ++i2) {
-        for (int i1=0; i1<_n1; ++i1) {
-          float aui = au[i3][i2][i1];
-          float avi = av[i3][i2][i1];
-          float awi = aw[i3][i2][i1];
-          float u1i = u1[i3][i2][i1];
-          float u2i = u2[i3][i2][i1];
-          float u3i = c3(u1i,u2i);
-          float w1i = w1[i3][i2][i1];
-          float w2i = w2[i3][i2][i1];
-          float w3i = c3(w1i,w2i);
-          setEigenvalues(i1,i2,i3,aui,avi,awi);
-          setEigenvectorU(i1,i2,i3,u1i,u2i,u3i);
-          setEigenvectorW(i1,i2,i3,w1i,w2i,w3i);
-        }
+        setRow(i2,i3,
+          u1[i3][i2],u2[i3][i2],null,
+          w1[i3][i2],w2[i3][i2],null,
+          au[i3][i2],av[i3][i2],aw[i3][i2]);
       }
-    }
+    }});
   }
 
   /**
@@ -233,6 +225,57 @@ public class EigenTensors3 implements Tensors3,Serializable {
   }
 
 
+  /**
+   * Gets tensor elements for one row of tensors with specified indices.
+   * This method decodes all n1 tensors in the row, and is equivalent
+   * to, but faster than, calling {@link #getTensor(int,int,int,float[])}
+   * for each index i1.
+   * @param i2 index for 2nd dimension.
+   * @param i3 index for 3rd dimension.
+   * @param a11 array[n1] of tensor elements a11.
+   * @param a12 array[n1] of tensor elements a12.
+   * @param a13 array[n1] of tensor elements a13.
+   * @param a22 array[n1] of tensor elements a22.
+   * @param a23 array[n1] of tensor elements a23.
+   * @param a33 array[n1] of tensor elements a33.
+   */
+  public void getTensors(
+    int i2, int i3,
+    float[] a11, float[] a12, float[] a13,
+    float[] a22, float[] a23, float[] a33)
+  {
+    float[] as = _as[i3][i2];
+    if (_compressed) {
+      short[] bu = _bu[i3][i2], bw = _bw[i3][i2];
+      short[] iu = _iu[i3][i2], iw = _iw[i3][i2];
+      for (int i1=0; i1<_n1; ++i1) {
+        float asum = as[i1];
+        float ascale = asum*AS_GET;
+        float au = ascale*bu[i1];
+        float aw = ascale*bw[i1];
+        float av = asum-au-aw;
+        float[] u = _uss.getPoint(iu[i1]);
+        float[] w = _uss.getPoint(iw[i1]);
+        setElements(i1,au-av,av,aw-av,u[0],u[1],u[2],w[0],w[1],w[2],
+                    a11,a12,a13,a22,a23,a33);
+      }
+    } else {
+      float[] aur = _au[i3][i2], awr = _aw[i3][i2];
+      float[] u1 = _u1[i3][i2], u2 = _u2[i3][i2];
+      float[] w1 = _w1[i3][i2], w2 = _w2[i3][i2];
+      for (int i1=0; i1<_n1; ++i1) {
+        float asum = as[i1];
+        float au = aur[i1];
+        float aw = awr[i1];
+        float av = asum-au-aw;
+        float u1i = u1[i1], u2i = u2[i1], u3i = c3(u1i,u2i);
+        float w1i = w1[i1], w2i = w2[i1], w3i = c3(w1i,w2i);
+        setElements(i1,au-av,av,aw-av,u1i,u2i,u3i,w1i,w2i,w3i,
+                    a11,a12,a13,a22,a23,a33);
+      }
+    }
+  }
+
   /**
    * Gets eigenvalues for the tensor with specified indices.
    * @param i1 index for 1st dimension.
@@ -441,6 +484,78 @@ public class EigenTensors3 implements Tensors3,Serializable {
     setEigenvalues(i1,i2,i3,au,av,aw);
   }
 
+  /**
+   * Sets tensor elements for one row of tensors with specified indices.
+   * This method computes eigen-decompositions of all n1 tensors in the
+   * row, and then stores the computed eigenvectors and eigenvalues. It
+   * is equivalent to, but faster than, calling the method
+   * {@link #setTensor(int,int,int,float[])} for each index i1.
+   * @param i2 index for 2nd dimension.
+   * @param i3 index for 3rd dimension.
+   * @param a11 array[n1] of tensor elements a11.
+   * @param a12 array[n1] of tensor elements a12.
+   * @param a13 array[n1] of tensor elements a13.
+   * @param a22 array[n1] of tensor elements a22.
+   * @param a23 array[n1] of tensor elements a23.
+   * @param a33 array[n1] of tensor elements a33.
+   */
+  public void setTensors(
+    int i2, int i3,
+    float[] a11, float[] a12, float[] a13,
+    float[] a22, float[] a23, float[] a33)
+  {
+    int n1 = _n1;
+    float[] u1 = new float[n1], u2 = new float[n1], u3 = new float[n1];
+    float[] w1 = new float[n1], w2 = new float[n1], w3 = new float[n1];
+    float[] au = new float[n1], av = new float[n1], aw = new float[n1];
+    double[][] aa = new double[3][3];
+    double[][] vv = new double[3][3];
+    double[] ev = new double[3];
+    for (int i1=0; i1<n1; ++i1) {
+      aa[0][0] = a11[i1];
+      aa[0][1] = aa[1][0] = a12[i1];
+      aa[0][2] = aa[2][0] = a13[i1];
+      aa[1][1] = a22[i1];
+      aa[1][2] = aa[2][1] = a23[i1];
+      aa[2][2] = a33[i1];
+      Eigen.solveSymmetric33(aa,vv,ev);
+      double[] u = vv[0];
+      double[] w = vv[2];
+      u1[i1] = (float)u[0]; u2[i1] = (float)u[1]; u3[i1] = (float)u[2];
+      w1[i1] = (float)w[0]; w2[i1] = (float)w[1]; w3[i1] = (float)w[2];
+      au[i1] = max(0.0f,(float)ev[0]);
+      av[i1] = max(0.0f,(float)ev[1]);
+      aw[i1] = max(0.0f,(float)ev[2]);
+    }
+    setRow(i2,i3,u1,u2,u3,w1,w2,w3,au,av,aw);
+  }
+
+  /**
+   * Sets tensor elements for all tensors.
+   * This method computes eigen-decompositions of all tensors, in
+   * parallel for rows of tensors, and then stores the computed
+   * eigenvectors and eigenvalues.
+   * @param a11 array of tensor elements a11.
+   * @param a12 array of tensor elements a12.
+   * @param a13 array of tensor elements a13.
+   * @param a22 array of tensor elements a22.
+   * @param a23 array of tensor elements a23.
+   * @param a33 array of tensor elements a33.
+   */
+  public void setTensors(
+    final float[][][] a11, final float[][][] a12, final float[][][] a13,
+    final float[][][] a22, final float[][][] a23, final float[][][] a33)
+  {
+    Parallel.loop(_n3,new Parallel.LoopInt() {
+    public void compute(int i3) {
+      for (int i2=0; i2<_n2; ++i2) {
+        setTensors(i2,i3,
+          a11[i3][i2],a12[i3][i2],a13[i3][i2],
+          a22[i3][i2],a23[i3][i2],a33[i3][i2]);
+      }
+    }});
+  }
+
   /**
    * Sets eigenvalues for all tensors.
    * @param au eigenvalue au.
@@ -740,6 +855,70 @@ public class EigenTensors3 implements Tensors3,Serializable {
     return (c3s>0.0f)?(float)Math.sqrt(c3s):0.0f;
   }
 
+  // Computes elements of one tensor in a row, from eigenvalue differences
+  // du = au-av and dw = aw-av, eigenvalue av, and eigenvectors u and w.
+  private static void setElements(
+    int i1, float du, float av, float dw,
+    float u1, float u2, float u3, float w1, float w2, float w3,
+    float[] a11, float[] a12, float[] a13,
+    float[] a22, float[] a23, float[] a33)
+  {
+    a11[i1] = du*u1*u1+dw*w1*w1+av;
+    a12[i1] = du*u1*u2+dw*w1*w2   ;
+    a13[i1] = du*u1*u3+dw*w1*w3   ;
+    a22[i1] = du*u2*u2+dw*w2*w2+av;
+    a23[i1] = du*u2*u3+dw*w2*w3   ;
+    a33[i1] = du*u3*u3+dw*w3*w3+av;
+  }
+
+  // Stores eigenvalues and eigenvectors for one row of tensors. If the
+  // arrays u3 and w3 are null, 3rd components are computed from the 1st
+  // and 2nd components and are assumed to be non-negative. Otherwise,
+  // vectors with negative 3rd components are negated before storing.
+  private void setRow(
+    int i2, int i3,
+    float[] u1, float[] u2, float[] u3,
+    float[] w1, float[] w2, float[] w3,
+    float[] au, float[] av, float[] aw)
+  {
+    float[] as = _as[i3][i2];
+    for (int i1=0; i1<_n1; ++i1)
+      as[i1] = au[i1]+av[i1]+aw[i1];
+    if (_compressed) {
+      short[] bu = _bu[i3][i2], bw = _bw[i3][i2];
+      short[] iu = _iu[i3][i2], iw = _iw[i3][i2];
+      for (int i1=0; i1<_n1; ++i1) {
+        float ascale = (as[i1]>0.0f)?AS_SET/as[i1]:0.0f;
+        bu[i1] = (short)(au[i1]*ascale+0.5f);
+        bw[i1] = (short)(aw[i1]*ascale+0.5f);
+        float u1i = u1[i1], u2i = u2[i1];
+        float u3i = (u3!=null)?u3[i1]:c3(u1i,u2i);
+        float w1i = w1[i1], w2i = w2[i1];
+        float w3i = (w3!=null)?w3[i1]:c3(w1i,w2i);
+        iu[i1] = (short)((u3i<0.0f) ?
+          _uss.getIndex(-u1i,-u2i,-u3i) :
+          _uss.getIndex( u1i, u2i, u3i));
+        iw[i1] = (short)((w3i<0.0f) ?
+          _uss.getIndex(-w1i,-w2i,-w3i) :
+          _uss.getIndex( w1i, w2i, w3i));
+      }
+    } else {
+      float[] aur = _au[i3][i2], awr = _aw[i3][i2];
+      float[] u1r = _u1[i3][i2], u2r = _u2[i3][i2];
+      float[] w1r = _w1[i3][i2], w2r = _w2[i3][i2];
+      for (int i1=0; i1<_n1; ++i1) {
+        aur[i1] = au[i1];
+        awr[i1] = aw[i1];
+        boolean un = u3!=null && u3[i1]<0.0f;
+        boolean wn = w3!=null && w3[i1]<0.0f;
+        u1r[i1] = (un)?-u1[i1]:u1[i1];
+        u2r[i1] = (un)?-u2[i1]:u2[i1];
+        w1r[i1] = (wn)?-w1[i1]:w1[i1];
+        w2r[i1] = (wn)?-w2[i1]:w2[i1];
+      }
+    }
+  }
+
   private void readObject(ObjectInputStream ois)
     throws IOException, ClassNotFoundException 
   {
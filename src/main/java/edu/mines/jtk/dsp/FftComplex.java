@@ -16,6 +16,7 @@ package edu.mines.jtk.dsp;
 
 import static edu.mines.jtk.util.ArrayMath.*;
 import edu.mines.jtk.util.Check;
+import edu.mines.jtk.util.Parallel;
 
 /**
  * Fast Fourier transform of complex-valued arrays. The FFT length 
@@ -39,6 +40,10 @@ import edu.mines.jtk.util.Check;
  * numbers to an output array cy[nfft][2*n1] of nfft*n1 complex numbers. 
  * In either case, the input array cx and the output array cy may be the 
  * same array, such that the transform may be performed in-place. 
+ * <p>
+ * Transforms of multi-dimensional arrays are computed in parallel, for 
+ * different indices in the dimensions not transformed. Because those
+ * transforms are independent, results are the same as for a serial loop.
  * @author Dave Hale, Colorado School of Mines
  * @version 2005.03.21
  */
@@ -117,12 +122,17 @@ public class FftComplex {
    * @param cx the input array.
    * @param cy the output array.
    */
-  public void complexToComplex1(int sign, int n2, float[][] cx, float[][] cy) {
+  public void complexToComplex1(
+    final int sign, int n2, final float[][] cx, final float[][] cy) 
+  {
     checkSign(sign);
     checkArray(2*_nfft,n2,cx,"cx");
     checkArray(2*_nfft,n2,cy,"cy");
-    for (int i2=0; i2<n2; ++i2)
-      complexToComplex(sign,cx[i2],cy[i2]);
+    Parallel.loop(n2,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        complexToComplex(sign,cx[i2],cy[i2]);
+      }
+    });
   }
 
   /**
@@ -134,13 +144,67 @@ public class FftComplex {
    * @param cx the input array.
    * @param cy the output array.
    */
-  public void complexToComplex2(int sign, int n1, float[][] cx, float[][] cy) {
+  public void complexToComplex2(
+    final int sign, final int n1, float[][] cx, final float[][] cy) 
+  {
     checkSign(sign);
     checkArray(2*n1,_nfft,cx,"cx");
     checkArray(2*n1,_nfft,cy,"cy");
     if (cx!=cy) 
       ccopy(n1,_nfft,cx,cy);
-    Pfacc.transform2a(sign,n1,_nfft,cy);
+    Parallel.loop(countChunks(n1),new Parallel.LoopInt() {
+      public void compute(int ic) {
+        int k1 = ic*NCHUNK;
+        int l1 = min(n1,k1+NCHUNK);
+        Pfacc.transform2a(sign,k1,l1,_nfft,cy);
+      }
+    });
+  }
+
+  /**
+   * Computes a complex-to-complex dimension-2 fast Fourier transform
+   * for complex numbers with real and imaginary parts in separate arrays.
+   * Transforms 2-D input arrays rx[nfft][n1] and ix[nfft][n1] of real
+   * and imaginary parts to 2-D output arrays ry[nfft][n1] and iy[nfft][n1].
+   * <p>
+   * This method efficiently computes a batch of n1 transforms, each of
+   * nfft complex numbers, as for many short sequences with the same
+   * length. Inner loops run with unit stride over the n1 transforms,
+   * and need not de-interleave real and imaginary parts, so that the
+   * compiler may vectorize them.
+   * @param sign the sign (1 or -1) of the exponent used in the FFT.
+   * @param n1 the 1st dimension of arrays; the number of transforms.
+   * @param rx the input array of real parts.
+   * @param ix the input array of imaginary parts.
+   * @param ry the output array of real parts.
+   * @param iy the output array of imaginary parts.
+   */
+  public void complexToComplex2(
+    final int sign, final int n1,
+    float[][] rx, float[][] ix, float[][] ry, float[][] iy)
+  {
+    checkSign(sign);
+    checkArray(n1,_nfft,rx,"rx");
+    checkArray(n1,_nfft,ix,"ix");
+    checkArray(n1,_nfft,ry,"ry");
+    checkArray(n1,_nfft,iy,"iy");
+    Check.argument(ry!=iy,"ry and iy are distinct");
+    if (rx!=ry)
+      copy(n1,_nfft,rx,ry);
+    if (ix!=iy)
+      copy(n1,_nfft,ix,iy);
+    final float[][] cy = new float[2*_nfft][];
+    for (int i2=0; i2<_nfft; ++i2) {
+      cy[2*i2  ] = ry[i2];
+      cy[2*i2+1] = iy[i2];
+    }
+    Parallel.loop(countChunks(n1),new Parallel.LoopInt() {
+      public void compute(int ic) {
+        int k1 = ic*NCHUNK;
+        int l1 = min(n1,k1+NCHUNK);
+        Pfacc.transform2b(sign,k1,l1,_nfft,cy);
+      }
+    });
   }
 
   /**
@@ -155,13 +219,17 @@ public class FftComplex {
    * @param cy the output array.
    */
   public void complexToComplex1(
-    int sign, int n2, int n3, float[][][] cx, float[][][] cy)
+    final int sign, final int n2, int n3, 
+    final float[][][] cx, final float[][][] cy)
   {
     checkSign(sign);
     checkArray(2*_nfft,n2,n3,cx,"cx");
     checkArray(2*_nfft,n2,n3,cy,"cy");
-    for (int i3=0; i3<n3; ++i3)
+    Parallel.loop(n3,new Parallel.LoopInt() {
+      public void compute(int i3) {
         complexToComplex1(sign,n2,cx[i3],cy[i3]);
+      }
+    });
   }
 
   /**
@@ -176,13 +244,17 @@ public class FftComplex {
    * @param cy the output array.
    */
   public void complexToComplex2(
-    int sign, int n1, int n3, float[][][] cx, float[][][] cy)
+    final int sign, final int n1, int n3, 
+    final float[][][] cx, final float[][][] cy)
   {
     checkSign(sign);
     checkArray(2*n1,_nfft,n3,cx,"cx");
     checkArray(2*n1,_nfft,n3,cy,"cy");
-    for (int i3=0; i3<n3; ++i3)
+    Parallel.loop(n3,new Parallel.LoopInt() {
+      public void compute(int i3) {
         complexToComplex2(sign,n1,cx[i3],cy[i3]);
+      }
+    });
   }
 
   /**
@@ -197,20 +269,23 @@ public class FftComplex {
    * @param cy the output array.
    */
   public void complexToComplex3(
-    int sign, int n1, int n2, float[][][] cx, float[][][] cy)
+    final int sign, final int n1, int n2, 
+    final float[][][] cx, final float[][][] cy)
   {
     checkSign(sign);
     checkArray(2*n1,n2,_nfft,cx,"cx");
     checkArray(2*n1,n2,_nfft,cy,"cy");
-    float[][] cxi2 = new float[_nfft][];
-    float[][] cyi2 = new float[_nfft][];
-    for (int i2=0; i2<n2; ++i2) {
-      for (int i3=0; i3<_nfft; ++i3) {
-        cxi2[i3] = cx[i3][i2];
-        cyi2[i3] = cy[i3][i2];
+    Parallel.loop(n2,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        float[][] cxi2 = new float[_nfft][];
+        float[][] cyi2 = new float[_nfft][];
+        for (int i3=0; i3<_nfft; ++i3) {
+          cxi2[i3] = cx[i3][i2];
+          cyi2[i3] = cy[i3][i2];
+        }
+        complexToComplex2(sign,n1,cxi2,cyi2);
       }
-      complexToComplex2(sign,n1,cxi2,cyi2);
-    }
+    });
   }
 
   /**
@@ -259,6 +334,14 @@ public class FftComplex {
 
   private int _nfft; // FFT length (number of complex numbers to transform)
 
+  // Dimension-2 transforms are computed in parallel, for chunks of this 
+  // many transforms. Each chunk has only a few cache lines per row.
+  private static final int NCHUNK = 64;
+
+  private static int countChunks(int n1) {
+    return 1+(n1-1)/NCHUNK;
+  }
+
   private static void checkSign(int sign) {
     Check.argument(sign==1 || sign==-1,"sign equals 1 or -1");
   }
@@ -15,9 +15,11 @@ limitations under the License.
 package edu.mines.jtk.dsp;
 
 import static java.lang.Math.PI;
+import static java.lang.Math.min;
 import static java.lang.Math.sin;
 
 import edu.mines.jtk.util.Check;
+import edu.mines.jtk.util.Parallel;
 
 /**
  * Fast Fourier transform of real-valued arrays. The FFT length nfft 
@@ -54,6 +56,10 @@ import edu.mines.jtk.util.Check;
  * of complex numbers in multi-dimensional arrays of floats. (See above.)
  * Therefore, dimension-1 transforms are best when performing real-to-complex 
  * or complex-to-real transforms of multi-dimensional arrays.
+ * <p>
+ * Dimension-1 transforms of multi-dimensional arrays are computed in
+ * parallel, for different indices in the other dimensions. Because those
+ * transforms are independent, results are the same as for a serial loop.
  * @author Dave Hale, Colorado School of Mines
  * @version 2005.03.21
  */
@@ -203,12 +209,17 @@ public class FftReal {
    * @param rx the input array.
    * @param cy the output array.
    */
-  public void realToComplex1(int sign, int n2, float[][] rx, float[][] cy) {
+  public void realToComplex1(
+    final int sign, int n2, final float[][] rx, final float[][] cy) 
+  {
     checkSign(sign);
     checkArray(_nfft,n2,rx,"rx");
     checkArray(_nfft+2,n2,cy,"cy");
-    for (int i2=0; i2<n2; ++i2)
-      realToComplex(sign,rx[i2],cy[i2]);
+    Parallel.loop(n2,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        realToComplex(sign,rx[i2],cy[i2]);
+      }
+    });
   }
 
   /**
@@ -220,12 +231,17 @@ public class FftReal {
    * @param cx the input array.
    * @param ry the output array.
    */
-  public void complexToReal1(int sign, int n2, float[][] cx, float[][] ry) {
+  public void complexToReal1(
+    final int sign, int n2, final float[][] cx, final float[][] ry) 
+  {
     checkSign(sign);
     checkArray(_nfft+2,n2,cx,"cx");
     checkArray(_nfft,n2,ry,"ry");
-    for (int i2=0; i2<n2; ++i2)
-      complexToReal(sign,cx[i2],ry[i2]);
+    Parallel.loop(n2,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        complexToReal(sign,cx[i2],ry[i2]);
+      }
+    });
   }
 
   /**
@@ -237,7 +253,9 @@ public class FftReal {
    * @param rx the input array.
    * @param cy the output array.
    */
-  public void realToComplex2(int sign, int n1, float[][] rx, float[][] cy) {
+  public void realToComplex2(
+    final int sign, final int n1, float[][] rx, final float[][] cy) 
+  {
     checkSign(sign);
     checkArray(n1,_nfft,rx,"rx");
     checkArray(2*n1,_nfft/2+1,cy,"cy");
@@ -251,43 +269,14 @@ public class FftReal {
       }
     }
 
-    // Dimension-2 complex-to-complex transform.
-    Pfacc.transform2a(sign,n1,_nfft/2,cy);
-
-    // Finish transform.
-    float[] cy0 = cy[0];
-    float[] cyn = cy[_nfft/2];
-    for (int i1=2*n1-2; i1>=0; i1-=2) {
-      cyn[i1  ] = 2.0f*(cy0[i1]-cy0[i1+1]);
-      cy0[i1  ] = 2.0f*(cy0[i1]+cy0[i1+1]);
-      cyn[i1+1] = 0.0f;
-      cy0[i1+1] = 0.0f;
-    }
-    double theta = sign*2.0*PI/_nfft;
-    double wt = sin(0.5*theta);
-    double wpr = -2.0*wt*wt; // = cos(theta)-1, with less rounding error
-    double wpi = sin(theta); // = sin(theta)
-    double wr = 1.0+wpr;
-    double wi = wpi;
-    for (int j2=1,k2=_nfft/2-1; j2<=k2; ++j2,--k2) {
-      float[] cyj2 = cy[j2];
-      float[] cyk2 = cy[k2];
-      for (int i1=0,j1=0; i1<n1; ++i1,j1+=2) {
-        float sumr = cyj2[j1  ]+cyk2[j1  ];
-        float sumi = cyj2[j1+1]+cyk2[j1+1];
-        float difr = cyj2[j1  ]-cyk2[j1  ];
-        float difi = cyj2[j1+1]-cyk2[j1+1];
-        float tmpr = (float)(wi*difr+wr*sumi);
-        float tmpi = (float)(wi*sumi-wr*difr);
-        cyj2[j1  ] = sumr+tmpr;
-        cyj2[j1+1] = tmpi+difi;
-        cyk2[j1  ] = sumr-tmpr;
-        cyk2[j1+1] = tmpi-difi;
+    // Transform, in parallel for chunks of transforms in 1st dimension.
+    Parallel.loop(countChunks(n1),new Parallel.LoopInt() {
+      public void compute(int ic) {
+        int k1 = ic*NCHUNK;
+        int l1 = min(n1,k1+NCHUNK);
+        realToComplex2(sign,k1,l1,cy);
       }
-      wt = wr;
-      wr += wr*wpr-wi*wpi;
-      wi += wi*wpr+wt*wpi;
-    }
+    });
   }
 
   /**
@@ -299,7 +288,9 @@ public class FftReal {
    * @param cx the input array.
    * @param ry the output array.
    */
-  public void complexToReal2(int sign, int n1, float[][] cx, float[][] ry) {
+  public void complexToReal2(
+    final int sign, final int n1, float[][] cx, final float[][] ry) 
+  {
     checkSign(sign);
     checkArray(2*n1,_nfft/2+1,cx,"cx");
     checkArray(n1,_nfft,ry,"ry");
@@ -317,37 +308,14 @@ public class FftReal {
       ry[0][j1] = cx0+cxn;
     }
 
-    // Begin transform.
-    double theta = -sign*2.0*PI/_nfft;
-    double wt = sin(0.5*theta);
-    double wpr = -2.0*wt*wt; // = cos(theta)-1, with less rounding error
-    double wpi = sin(theta); // = sin(theta)
-    double wr = 1.0+wpr;
-    double wi = wpi;
-    for (int j2=2,k2=_nfft-2; j2<=k2; j2+=2,k2-=2) {
-      float[] ryj2r = ry[j2  ];
-      float[] ryj2i = ry[j2+1];
-      float[] ryk2r = ry[k2  ];
-      float[] ryk2i = ry[k2+1];
-      for (int i1=0; i1<n1; ++i1) {
-        float sumr = ryj2r[i1]+ryk2r[i1];
-        float sumi = ryj2i[i1]+ryk2i[i1];
-        float difr = ryj2r[i1]-ryk2r[i1];
-        float difi = ryj2i[i1]-ryk2i[i1];
-        float tmpr = (float)(wi*difr-wr*sumi);
-        float tmpi = (float)(wi*sumi+wr*difr);
-        ryj2r[i1] = sumr+tmpr;
-        ryj2i[i1] = tmpi+difi;
-        ryk2r[i1] = sumr-tmpr;
-        ryk2i[i1] = tmpi-difi;
+    // Transform, in parallel for chunks of transforms in 1st dimension.
+    Parallel.loop(countChunks(n1),new Parallel.LoopInt() {
+      public void compute(int ic) {
+        int k1 = ic*NCHUNK;
+        int l1 = min(n1,k1+NCHUNK);
+        complexToReal2(sign,k1,l1,ry);
       }
-      wt = wr;
-      wr += wr*wpr-wi*wpi;
-      wi += wi*wpr+wt*wpi;
-    }
-
-    // Dimension-2 complex-to-complex transform.
-    Pfacc.transform2b(sign,n1,_nfft/2,ry);
+    });
   }
 
   /**
@@ -362,13 +330,17 @@ public class FftReal {
    * @param cy the output array.
    */
   public void realToComplex1(
-    int sign, int n2, int n3, float[][][] rx, float[][][] cy) 
+    final int sign, final int n2, int n3, 
+    final float[][][] rx, final float[][][] cy) 
   {
     checkSign(sign);
     checkArray(_nfft,n2,n3,rx,"rx");
     checkArray(_nfft+2,n2,n3,cy,"cy");
-    for (int i3=0; i3<n3; ++i3)
-      realToComplex1(sign,n2,rx[i3],cy[i3]);
+    Parallel.loop(n3,new Parallel.LoopInt() {
+      public void compute(int i3) {
+        realToComplex1(sign,n2,rx[i3],cy[i3]);
+      }
+    });
   }
 
   /**
@@ -383,13 +355,17 @@ public class FftReal {
    * @param ry the output array.
    */
   public void complexToReal1(
-    int sign, int n2, int n3, float[][][] cx, float[][][] ry) 
+    final int sign, final int n2, int n3, 
+    final float[][][] cx, final float[][][] ry) 
   {
     checkSign(sign);
     checkArray(_nfft+2,n2,n3,cx,"cx");
     checkArray(_nfft,n2,n3,ry,"ry");
-    for (int i3=0; i3<n3; ++i3)
-      complexToReal1(sign,n2,cx[i3],ry[i3]);
+    Parallel.loop(n3,new Parallel.LoopInt() {
+      public void compute(int i3) {
+        complexToReal1(sign,n2,cx[i3],ry[i3]);
+      }
+    });
   }
 
   /**
@@ -437,6 +413,92 @@ public class FftReal {
 
   private int _nfft; // FFT length (number of real numbers to transform)
 
+  // Dimension-2 transforms are computed in parallel, for chunks of this 
+  // many transforms. Each chunk has only a few cache lines per row.
+  private static final int NCHUNK = 64;
+
+  private static int countChunks(int n1) {
+    return 1+(n1-1)/NCHUNK;
+  }
+
+  // Completes a real-to-complex dimension-2 transform of packed input, 
+  // for transforms with indices k1 <= i1 < l1 in the 1st dimension.
+  private void realToComplex2(int sign, int k1, int l1, float[][] cy) {
+    // Dimension-2 complex-to-complex transform.
+    Pfacc.transform2a(sign,k1,l1,_nfft/2,cy);
+
+    // Finish transform.
+    float[] cy0 = cy[0];
+    float[] cyn = cy[_nfft/2];
+    for (int i1=2*l1-2; i1>=2*k1; i1-=2) {
+      cyn[i1  ] = 2.0f*(cy0[i1]-cy0[i1+1]);
+      cy0[i1  ] = 2.0f*(cy0[i1]+cy0[i1+1]);
+      cyn[i1+1] = 0.0f;
+      cy0[i1+1] = 0.0f;
+    }
+    double theta = sign*2.0*PI/_nfft;
+    double wt = sin(0.5*theta);
+    double wpr = -2.0*wt*wt; // = cos(theta)-1, with less rounding error
+    double wpi = sin(theta); // = sin(theta)
+    double wr = 1.0+wpr;
+    double wi = wpi;
+    for (int j2=1,k2=_nfft/2-1; j2<=k2; ++j2,--k2) {
+      float[] cyj2 = cy[j2];
+      float[] cyk2 = cy[k2];
+      for (int i1=k1,j1=2*k1; i1<l1; ++i1,j1+=2) {
+        float sumr = cyj2[j1  ]+cyk2[j1  ];
+        float sumi = cyj2[j1+1]+cyk2[j1+1];
+        float difr = cyj2[j1  ]-cyk2[j1  ];
+        float difi = cyj2[j1+1]-cyk2[j1+1];
+        float tmpr = (float)(wi*difr+wr*sumi);
+        float tmpi = (float)(wi*sumi-wr*difr);
+        cyj2[j1  ] = sumr+tmpr;
+        cyj2[j1+1] = tmpi+difi;
+        cyk2[j1  ] = sumr-tmpr;
+        cyk2[j1+1] = tmpi-difi;
+      }
+      wt = wr;
+      wr += wr*wpr-wi*wpi;
+      wi += wi*wpr+wt*wpi;
+    }
+  }
+
+  // Completes a complex-to-real dimension-2 transform of unpacked input,
+  // for transforms with indices k1 <= i1 < l1 in the 1st dimension.
+  private void complexToReal2(int sign, int k1, int l1, float[][] ry) {
+    // Begin transform.
+    double theta = -sign*2.0*PI/_nfft;
+    double wt = sin(0.5*theta);
+    double wpr = -2.0*wt*wt; // = cos(theta)-1, with less rounding error
+    double wpi = sin(theta); // = sin(theta)
+    double wr = 1.0+wpr;
+    double wi = wpi;
+    for (int j2=2,k2=_nfft-2; j2<=k2; j2+=2,k2-=2) {
+      float[] ryj2r = ry[j2  ];
+      float[] ryj2i = ry[j2+1];
+      float[] ryk2r = ry[k2  ];
+      float[] ryk2i = ry[k2+1];
+      for (int i1=k1; i1<l1; ++i1) {
+        float sumr = ryj2r[i1]+ryk2r[i1];
+        float sumi = ryj2i[i1]+ryk2i[i1];
+        float difr = ryj2r[i1]-ryk2r[i1];
+        float difi = ryj2i[i1]-ryk2i[i1];
+        float tmpr = (float)(wi*difr-wr*sumi);
+        float tmpi = (float)(wi*sumi+wr*difr);
+        ryj2r[i1] = sumr+tmpr;
+        ryj2i[i1] = tmpi+difi;
+        ryk2r[i1] = sumr-tmpr;
+        ryk2i[i1] = tmpi-difi;
+      }
+      wt = wr;
+      wr += wr*wpr-wi*wpi;
+      wi += wi*wpr+wt*wpi;
+    }
+
+    // Dimension-2 complex-to-complex transform.
+    Pfacc.transform2b(sign,k1,l1,_nfft/2,ry);
+  }
+
   private static void checkSign(int sign) {
     Check.argument(sign==1 || sign==-1,"sign equals 1 or -1");
   }
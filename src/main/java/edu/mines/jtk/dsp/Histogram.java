@@ -16,6 +16,7 @@ package edu.mines.jtk.dsp;
 
 import static edu.mines.jtk.util.ArrayMath.*;
 import edu.mines.jtk.util.Check;
+import edu.mines.jtk.util.Parallel;
 
 /**
  * A histogram summarizes the distribution of values v in an array.
@@ -40,6 +41,9 @@ import edu.mines.jtk.util.Check;
  * computed automatically. If specified, then only values in the range 
  * [vmin,vmax] are binned, and values outside this range are ignored.
  * <p>
+ * Minimum and maximum values and counts are computed in parallel, for
+ * chunks of the array of values.
+ * <p>
  * Reference: Izenman, A. J., 1991, Recent developments in nonparametric 
  * density estimation: Journal of the American Statistical Association, 
  * v. 86, p. 205-224.
@@ -205,17 +209,37 @@ public class Histogram {
   private long _nlo; // number of samples < vmin
   private long _nhi; // number of samples > vmax
 
-  private void initMinMax(float[] v) {
-    int n = v.length;
-    _vmin = _vmax = v[0];
-    for (int i=1; i<n; ++i) {
-      float vi = v[i];
-      if (vi<_vmin)
-        _vmin = vi;
-      if (vi>_vmax)
-        _vmax = vi;
-    }
+  private static final int CHUNK = 65536; // values per parallel task
+
+  private void initMinMax(final float[] v) {
+    final int n = v.length;
     _computedMinMax = true;
+    if (n==0) {
+      _vmin = _vmax = 0.0f;
+      return;
+    }
+    int nchunk = (n+CHUNK-1)/CHUNK;
+    float[] vminmax = Parallel.reduce(nchunk,new Parallel.ReduceInt<float[]>() {
+      public float[] compute(int ichunk) {
+        int ifirst = ichunk*CHUNK;
+        int ilast = min(n,ifirst+CHUNK);
+        float vmin = v[ifirst];
+        float vmax = v[ifirst];
+        for (int i=ifirst+1; i<ilast; ++i) {
+          float vi = v[i];
+          if (vi<vmin)
+            vmin = vi;
+          if (vi>vmax)
+            vmax = vi;
+        }
+        return new float[]{vmin,vmax};
+      }
+      public float[] combine(float[] va, float[] vb) {
+        return new float[]{min(va[0],vb[0]),max(va[1],vb[1])};
+      }
+    });
+    _vmin = vminmax[0];
+    _vmax = vminmax[1];
   }
 
   private void initMinMax(float vmin, float vmax) {
@@ -294,29 +318,49 @@ public class Histogram {
     double fbin = _vmin+0.5*dbin;
     _sbin = new Sampling(nbin,dbin,fbin);
 
-    // Count binned values.
-    double vscl = 1.0/dbin;
-    int n = v.length;
-    _nlo = 0;
-    _nhi = 0;
-    _h = new long[nbin];
-    _nin = 0;
-    for (int i=0; i<n; ++i) {
-      float vi = v[i];
-      if (vi<_vmin) {
-        ++_nlo;
-      } else if (vi>_vmax) {
-        ++_nhi;
-      } else {
-        int ibin = (int)rint((vi-fbin)*vscl);
-        if (ibin<0) {
-          ibin = 0;
-        } else if (ibin>=nbin) {
-          ibin = nbin-1;
+    // Count binned values, in parallel for chunks of values. For each 
+    // chunk, counts of low and high values follow counts for all bins.
+    final float[] vf = v;
+    final int nb = nbin;
+    final int n = v.length;
+    final float vmin = _vmin;
+    final float vmax = _vmax;
+    final double fb = fbin;
+    final double vscl = 1.0/dbin;
+    int nchunk = max(1,(n+CHUNK-1)/CHUNK);
+    long[] h = Parallel.reduce(nchunk,new Parallel.ReduceInt<long[]>() {
+      public long[] compute(int ichunk) {
+        long[] h = new long[nb+2];
+        int ilast = min(n,(ichunk+1)*CHUNK);
+        for (int i=ichunk*CHUNK; i<ilast; ++i) {
+          float vi = vf[i];
+          if (vi<vmin) {
+            ++h[nb];
+          } else if (vi>vmax) {
+            ++h[nb+1];
+          } else {
+            int ibin = (int)rint((vi-fb)*vscl);
+            if (ibin<0) {
+              ibin = 0;
+            } else if (ibin>=nb) {
+              ibin = nb-1;
+            }
+            ++h[ibin];
+          }
         }
-        ++_h[ibin];
-        ++_nin;
+        return h;
       }
-    }
+      public long[] combine(long[] ha, long[] hb) {
+        for (int i=0; i<ha.length; ++i)
+          ha[i] += hb[i];
+        return ha;
+      }
+    });
+    _h = copy(nbin,h);
+    _nlo = h[nbin];
+    _nhi = h[nbin+1];
+    _nin = 0;
+    for (int ibin=0; ibin<nbin; ++ibin)
+      _nin += _h[ibin];
   }
 }
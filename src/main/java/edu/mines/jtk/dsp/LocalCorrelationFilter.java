@@ -16,6 +16,7 @@ package edu.mines.jtk.dsp;
 
 import static edu.mines.jtk.util.ArrayMath.*;
 import edu.mines.jtk.util.Check;
+import edu.mines.jtk.util.Parallel;
 
 /**
  * Local cross-correlation of two arrays with seamless overlapping windows.
@@ -225,7 +226,7 @@ public class LocalCorrelationFilter {
    */
   public void correlate(int lag, float[] c) {
     checkDimensions(c);
-    correlate(lag,_f[0][0],_g[0][0],c);
+    correlate(lag,_f[0][0],_g[0][0],new float[_n1],c);
   }
 
   /**
@@ -236,7 +237,7 @@ public class LocalCorrelationFilter {
    */
   public void correlate(int lag1, int lag2, float[][] c) {
     checkDimensions(c);
-    correlate(lag1,lag2,_f[0],_g[0],c);
+    correlate(lag1,lag2,_f[0],_g[0],new float[_n2][_n1],c);
   }
 
   /**
@@ -248,7 +249,156 @@ public class LocalCorrelationFilter {
    */
   public void correlate(int lag1, int lag2, int lag3, float[][][] c) {
     checkDimensions(c);
-    correlate(lag1,lag2,lag3,_f,_g,c);
+    correlate(lag1,lag2,lag3,_f,_g,new float[_n3][_n2][_n1],c);
+  }
+
+  /**
+   * Correlates the current inputs for multiple specified lags.
+   * Lags are correlated in parallel, which is faster than calling the
+   * method {@link #correlate(int,float[])} for each lag.
+   * @param lags array[nlag] of correlation lags.
+   * @param c output array[nlag][n1] of correlations, one for each lag.
+   */
+  public void correlate(final int[] lags, final float[][] c) {
+    int nlag = lags.length;
+    Check.argument(c.length==nlag,"c.length equals number of lags");
+    for (int ilag=0; ilag<nlag; ++ilag)
+      checkDimensions(c[ilag]);
+    final float[] f = _f[0][0];
+    final float[] g = _g[0][0];
+    final Parallel.Unsafe<float[]> hu = new Parallel.Unsafe<float[]>();
+    Parallel.loop(nlag,new Parallel.LoopInt() {
+    public void compute(int ilag) {
+      float[] h = hu.get();
+      if (h==null) {
+        hu.set(h=new float[_n1]);
+      } else {
+        zero(h);
+      }
+      correlate(lags[ilag],f,g,h,c[ilag]);
+    }});
+  }
+
+  /**
+   * Correlates the current inputs for multiple specified lags.
+   * Lags are correlated in parallel, which is faster than calling the
+   * method {@link #correlate(int,int,float[][])} for each lag.
+   * @param lag1 array[nlag] of lags in the 1st dimension.
+   * @param lag2 array[nlag] of lags in the 2nd dimension.
+   * @param c output array[nlag][n2][n1] of correlations.
+   */
+  public void correlate(
+    final int[] lag1, final int[] lag2, final float[][][] c)
+  {
+    int nlag = lag1.length;
+    Check.argument(lag2.length==nlag,"lag2.length equals lag1.length");
+    Check.argument(c.length==nlag,"c.length equals number of lags");
+    for (int ilag=0; ilag<nlag; ++ilag)
+      checkDimensions(c[ilag]);
+    final float[][] f = _f[0];
+    final float[][] g = _g[0];
+    final Parallel.Unsafe<float[][]> hu = new Parallel.Unsafe<float[][]>();
+    Parallel.loop(nlag,new Parallel.LoopInt() {
+    public void compute(int ilag) {
+      float[][] h = hu.get();
+      if (h==null) {
+        hu.set(h=new float[_n2][_n1]);
+      } else {
+        zero(h);
+      }
+      correlate(lag1[ilag],lag2[ilag],f,g,h,c[ilag]);
+    }});
+  }
+
+  /**
+   * Correlates the current inputs for multiple specified lags.
+   * Lags are correlated in parallel, which is faster than calling the
+   * method {@link #correlate(int,int,int,float[][][])} for each lag.
+   * @param lag1 array[nlag] of lags in the 1st dimension.
+   * @param lag2 array[nlag] of lags in the 2nd dimension.
+   * @param lag3 array[nlag] of lags in the 3rd dimension.
+   * @param c output array[nlag][n3][n2][n1] of correlations.
+   */
+  public void correlate(
+    final int[] lag1, final int[] lag2, final int[] lag3, 
+    final float[][][][] c)
+  {
+    int nlag = lag1.length;
+    Check.argument(lag2.length==nlag,"lag2.length equals lag1.length");
+    Check.argument(lag3.length==nlag,"lag3.length equals lag1.length");
+    Check.argument(c.length==nlag,"c.length equals number of lags");
+    for (int ilag=0; ilag<nlag; ++ilag)
+      checkDimensions(c[ilag]);
+    final float[][][] f = _f;
+    final float[][][] g = _g;
+    final Parallel.Unsafe<float[][][]> hu = 
+      new Parallel.Unsafe<float[][][]>();
+    Parallel.loop(nlag,new Parallel.LoopInt() {
+    public void compute(int ilag) {
+      float[][][] h = hu.get();
+      if (h==null) {
+        hu.set(h=new float[_n3][_n2][_n1]);
+      } else {
+        zero(h);
+      }
+      correlate(lag1[ilag],lag2[ilag],lag3[ilag],f,g,h,c[ilag]);
+    }});
+  }
+
+  /**
+   * Returns correlations of the current inputs for a range of lags.
+   * Correlations are normalized.
+   * @param lagMin the minimum lag.
+   * @param lagMax the maximum lag.
+   * @return array[1+lagMax-lagMin][n1] of correlations.
+   */
+  public float[][] correlateLags1(int lagMin, int lagMax) {
+    checkDimension(1);
+    int[] lags = rampint(lagMin,1,1+lagMax-lagMin);
+    float[][] c = new float[lags.length][_n1];
+    correlate(lags,c);
+    normalize(lags,c);
+    return c;
+  }
+
+  /**
+   * Returns correlations of the current inputs for a range of lags
+   * in the 1st dimension. Correlations are normalized.
+   * @param lag1Min the minimum lag in the 1st dimension.
+   * @param lag1Max the maximum lag in the 1st dimension.
+   * @param lag2 the lag in the 2nd dimension.
+   * @return array[1+lag1Max-lag1Min][n2][n1] of correlations.
+   */
+  public float[][][] correlateLags1(int lag1Min, int lag1Max, int lag2) {
+    checkDimension(2);
+    int[] lag1 = rampint(lag1Min,1,1+lag1Max-lag1Min);
+    int[] lag2s = fillint(lag2,lag1.length);
+    float[][][] c = new float[lag1.length][_n2][_n1];
+    correlate(lag1,lag2s,c);
+    normalize(lag1,lag2s,c);
+    return c;
+  }
+
+  /**
+   * Returns correlations of the current inputs for a range of lags
+   * in the 1st dimension. Correlations are normalized.
+   * @param lag1Min the minimum lag in the 1st dimension.
+   * @param lag1Max the maximum lag in the 1st dimension.
+   * @param lag2 the lag in the 2nd dimension.
+   * @param lag3 the lag in the 3rd dimension.
+   * @return array[1+lag1Max-lag1Min][n3][n2][n1] of correlations.
+   */
+  public float[][][][] correlateLags1(
+    int lag1Min, int lag1Max, int lag2, int lag3) 
+  {
+    checkDimension(3);
+    int[] lag1 = rampint(lag1Min,1,1+lag1Max-lag1Min);
+    int[] lag2s = fillint(lag2,lag1.length);
+    int[] lag3s = fillint(lag3,lag1.length);
+    float[][][][] c = new float[lag1.length][_n3][_n2][_n1];
+    correlate(lag1,lag2s,lag3s,c);
+    normalize(lag1,lag2s,lag3s,c);
+    return c;
   }
 
   /**
@@ -385,6 +535,56 @@ public class LocalCorrelationFilter {
     }
   }
 
+  /**
+   * Normalizes cross-correlations for multiple specified lags.
+   * @param lags array[nlag] of lags.
+   * @param c array[nlag][n1] of cross-correlations to be modified.
+   */
+  public void normalize(final int[] lags, final float[][] c) {
+    if (_s==null)
+      updateNormalize();
+    Parallel.loop(lags.length,new Parallel.LoopInt() {
+    public void compute(int ilag) {
+      normalize(lags[ilag],c[ilag]);
+    }});
+  }
+
+  /**
+   * Normalizes cross-correlations for multiple specified lags.
+   * @param lag1 array[nlag] of lags in the 1st dimension.
+   * @param lag2 array[nlag] of lags in the 2nd dimension.
+   * @param c array[nlag][n2][n1] of cross-correlations to be modified.
+   */
+  public void normalize(
+    final int[] lag1, final int[] lag2, final float[][][] c) 
+  {
+    if (_s==null)
+      updateNormalize();
+    Parallel.loop(lag1.length,new Parallel.LoopInt() {
+    public void compute(int ilag) {
+      normalize(lag1[ilag],lag2[ilag],c[ilag]);
+    }});
+  }
+
+  /**
+   * Normalizes cross-correlations for multiple specified lags.
+   * @param lag1 array[nlag] of lags in the 1st dimension.
+   * @param lag2 array[nlag] of lags in the 2nd dimension.
+   * @param lag3 array[nlag] of lags in the 3rd dimension.
+   * @param c array[nlag][n3][n2][n1] of cross-correlations to be modified.
+   */
+  public void normalize(
+    final int[] lag1, final int[] lag2, final int[] lag3, 
+    final float[][][][] c) 
+  {
+    if (_s==null)
+      updateNormalize();
+    Parallel.loop(lag1.length,new Parallel.LoopInt() {
+    public void compute(int ilag) {
+      normalize(lag1[ilag],lag2[ilag],lag3[ilag],c[ilag]);
+    }});
+  }
+
   /** 
    * Removes bias by subtracting local means from the specified array.
    * @param f the input array.
@@ -450,7 +650,9 @@ public class LocalCorrelationFilter {
   private static float S4 = -0.0115417f;
   private static float[] S = {S4,S3,S2,S1,S1,S2,S3,S4};
 
-  private void correlate(int lag, float[] f, float[] g, float[] c) {
+  private void correlate(
+    int lag, float[] f, float[] g, float[] h, float[] c)
+  {
     Check.argument(f!=c,"f!=c");
     Check.argument(g!=c,"g!=c");
     int n1 = f.length;
@@ -492,8 +694,7 @@ public class LocalCorrelationFilter {
     }
     float scale = (float)scale1;
 
-    // Correlation product.
-    float[] h = new float[n1];
+    // Correlation product; h is zero except where computed here.
     int i1min = max(0,l1f,-l1g);
     int i1max = min(n1,n1+l1f,n1-l1g);
     for (int i1=i1min; i1<i1max; ++i1) {
@@ -518,7 +719,7 @@ public class LocalCorrelationFilter {
   }
 
   private void correlate(
-    int lag1, int lag2, float[][] f, float[][] g, float[][] c) 
+    int lag1, int lag2, float[][] f, float[][] g, float[][] h, float[][] c) 
   {
     Check.argument(f!=c,"f!=c");
     Check.argument(g!=c,"g!=c");
@@ -568,8 +769,7 @@ public class LocalCorrelationFilter {
     }
     float scale = (float)(scale1*scale2);
 
-    // Correlation product.
-    float[][] h = new float[n2][n1];
+    // Correlation product; h is zero except where computed here.
     int i1min = max(0,l1f,-l1g);
     int i1max = min(n1,n1+l1f,n1-l1g);
     int i2min = max(0,l2f,-l2g);
@@ -610,7 +810,8 @@ public class LocalCorrelationFilter {
   }
 
   private void correlate(
-    int lag1, int lag2, int lag3, float[][][] f, float[][][] g, float[][][] c) 
+    int lag1, int lag2, int lag3, 
+    float[][][] f, float[][][] g, float[][][] h, float[][][] c) 
   {
     Check.argument(f!=c,"f!=c");
     Check.argument(g!=c,"g!=c");
@@ -671,8 +872,7 @@ public class LocalCorrelationFilter {
     }
     float scale = (float)(scale1*scale2*scale3);
 
-    // Correlation product.
-    float[][][] h = new float[n3][n2][n1];
+    // Correlation product; h is zero except where computed here.
     int i1min = max(0,l1f,-l1g);
     int i1max = min(n1,n1+l1f,n1-l1g);
     int i2min = max(0,l2f,-l2g);
@@ -735,14 +935,18 @@ public class LocalCorrelationFilter {
     int n2 = max(1,_n2);
     int n3 = max(1,_n3);
     _s = new float[ns][n3][n2][n1];
+
+    // The workspace h is reused for f and g, because the correlation
+    // product for lag zero is computed for all samples.
     if (_type==Type.SIMPLE) {
       if (_dimension==1) {
         float[] f = _f[0][0];
         float[] g = _g[0][0];
         float[] sf = _s[0][0][0];
         float[] sg = _s[1][0][0];
-        correlate(0,f,f,sf);
-        correlate(0,g,g,sg);
+        float[] h = new float[_n1];
+        correlate(0,f,f,h,sf);
+        correlate(0,g,g,h,sg);
         sqrt(sf,sf);
         sqrt(sg,sg);
         div(1.0f,sf,sf);
@@ -752,8 +956,9 @@ public class LocalCorrelationFilter {
         float[][] g = _g[0];
         float[][] sf = _s[0][0];
         float[][] sg = _s[1][0];
-        correlate(0,0,f,f,sf);
-        correlate(0,0,g,g,sg);
+        float[][] h = new float[_n2][_n1];
+        correlate(0,0,f,f,h,sf);
+        correlate(0,0,g,g,h,sg);
         sqrt(sf,sf);
         sqrt(sg,sg);
         div(1.0f,sf,sf);
@@ -763,8 +968,9 @@ public class LocalCorrelationFilter {
         float[][][] g = _g;
         float[][][] sf = _s[0];
         float[][][] sg = _s[1];
-        correlate(0,0,0,f,f,sf);
-        correlate(0,0,0,g,g,sg);
+        float[][][] h = new float[_n3][_n2][_n1];
+        correlate(0,0,0,f,f,h,sf);
+        correlate(0,0,0,g,g,h,sg);
         sqrt(sf,sf);
         sqrt(sg,sg);
         div(1.0f,sf,sf);
@@ -777,8 +983,9 @@ public class LocalCorrelationFilter {
         float[] s = _s[0][0][0];
         float[] sf = s;
         float[] sg = new float[_n1];
-        correlate(0,f,f,sf);
-        correlate(0,g,g,sg);
+        float[] h = new float[_n1];
+        correlate(0,f,f,h,sf);
+        correlate(0,g,g,h,sg);
         mul(sf,sg,s);
         sqrt(s,s);
         div(1.0f,s,s);
@@ -788,8 +995,9 @@ public class LocalCorrelationFilter {
         float[][] s = _s[0][0];
         float[][] sf = s;
         float[][] sg = new float[_n2][_n1];
-        correlate(0,0,f,f,sf);
-        correlate(0,0,g,g,sg);
+        float[][] h = new float[_n2][_n1];
+        correlate(0,0,f,f,h,sf);
+        correlate(0,0,g,g,h,sg);
         mul(sf,sg,s);
         sqrt(s,s);
         div(1.0f,s,s);
@@ -799,8 +1007,9 @@ public class LocalCorrelationFilter {
         float[][][] s = _s[0];
         float[][][] sf = s;
         float[][][] sg = new float[_n3][_n2][_n1];
-        correlate(0,0,0,f,f,sf);
-        correlate(0,0,0,g,g,sg);
+        float[][][] h = new float[_n3][_n2][_n1];
+        correlate(0,0,0,f,f,h,sf);
+        correlate(0,0,0,g,g,h,sg);
         mul(sf,sg,s);
         sqrt(s,s);
         div(1.0f,s,s);
@@ -332,6 +332,27 @@ public class LocalDiffusionKernel {
     }
   };
 
+  /**
+   * Gets tensor elements for one row of tensors with indices i2 and i3.
+   * Eigen-tensors decode the entire row at once; other tensors are
+   * decoded one at a time.
+   */
+  static void getTensors(Tensors3 d, int i2, int i3, float[][] di) {
+    float[] d11 = di[0], d12 = di[1], d13 = di[2];
+    float[] d22 = di[3], d23 = di[4], d33 = di[5];
+    int n1 = d11.length;
+    if (d instanceof EigenTensors3 && ((EigenTensors3)d).getN1()==n1) {
+      ((EigenTensors3)d).getTensors(i2,i3,d11,d12,d13,d22,d23,d33);
+    } else {
+      float[] dt = new float[6];
+      for (int i1=0; i1<n1; ++i1) {
+        d.getTensor(i1,i2,i3,dt);
+        d11[i1] = dt[0]; d12[i1] = dt[1]; d13[i1] = dt[2];
+        d22[i1] = dt[3]; d23[i1] = dt[4]; d33[i1] = dt[5];
+      }
+    }
+  }
+
   private Stencil _stencil;
   private int _npass = 1;
   private boolean _parallel = true;
@@ -529,8 +550,9 @@ public class LocalDiffusionKernel {
     c *= 0.0625f;
     int n1 = x[0][0].length;
     int n2 = x[0].length;
-    float[] di = new float[6];
+    float[][] di = new float[6][n1];
     for (int i2=1; i2<n2; ++i2) {
+      getTensors(d,i2,i3,di);
       float[] x00 = x[i3  ][i2  ];
       float[] x0m = x[i3  ][i2-1];
       float[] xm0 = x[i3-1][i2  ];
@@ -540,14 +562,13 @@ public class LocalDiffusionKernel {
       float[] ym0 = y[i3-1][i2  ];
       float[] ymm = y[i3-1][i2-1];
       for (int i1=1,m1=0; i1<n1; ++i1,++m1) {
-        d.getTensor(i1,i2,i3,di);
         float csi = (s!=null)?c*s[i3][i2][i1]:c;
-        float d11 = di[0]*csi;
-        float d12 = di[1]*csi;
-        float d13 = di[2]*csi;
-        float d22 = di[3]*csi;
-        float d23 = di[4]*csi;
-        float d33 = di[5]*csi;
+        float d11 = di[0][i1]*csi;
+        float d12 = di[1][i1]*csi;
+        float d13 = di[2][i1]*csi;
+        float d22 = di[3][i1]*csi;
+        float d23 = di[4][i1]*csi;
+        float d33 = di[5][i1]*csi;
         float xa = x00[i1]-xmm[m1];
         float xb = x00[m1]-xmm[i1];
         float xc = x0m[i1]-xm0[m1];
@@ -719,8 +740,9 @@ public class LocalDiffusionKernel {
     float bb = 0.5f*b*b;
     int n1 = x[0][0].length;
     int n2 = x[0].length;
-    float[] di = new float[6];
+    float[][] di = new float[6][n1];
     for (int i2=1; i2<n2-1; ++i2) {
+      getTensors(d,i2,i3,di);
       float[] xmm = x[i3-1][i2-1], xm0 = x[i3-1][i2  ], xmp = x[i3-1][i2+1];
       float[] x0m = x[i3  ][i2-1], x00 = x[i3  ][i2  ], x0p = x[i3  ][i2+1];
       float[] xpm = x[i3+1][i2-1], xp0 = x[i3+1][i2  ], xpp = x[i3+1][i2+1];
@@ -728,14 +750,13 @@ public class LocalDiffusionKernel {
       float[] y0m = y[i3  ][i2-1], y00 = y[i3  ][i2  ], y0p = y[i3  ][i2+1];
       float[] ypm = y[i3+1][i2-1], yp0 = y[i3+1][i2  ], ypp = y[i3+1][i2+1];
       for (int m1=0,i1=1,p1=2; p1<n1; ++m1,++i1,++p1) {
-        d.getTensor(i1,i2,i3,di);
         float csi = (s!=null)?c*s[i3][i2][i1]:c;
-        float d11 = di[0]*csi;
-        float d12 = di[1]*csi;
-        float d13 = di[2]*csi;
-        float d22 = di[3]*csi;
-        float d23 = di[4]*csi;
-        float d33 = di[5]*csi;
+        float d11 = di[0][i1]*csi;
+        float d12 = di[1][i1]*csi;
+        float d13 = di[2][i1]*csi;
+        float d22 = di[3][i1]*csi;
+        float d23 = di[4][i1]*csi;
+        float d33 = di[5][i1]*csi;
         float xmmm = xmm[m1], xmm0 = xmm[i1], xmmp = xmm[p1];
         float xm0m = xm0[m1], xm00 = xm0[i1], xm0p = xm0[p1];
         float xmpm = xmp[m1], xmp0 = xmp[i1], xmpp = xmp[p1];
@@ -895,7 +916,7 @@ public class LocalDiffusionKernel {
     int n1 = x[0][0].length;
     int n2 = x[0].length;
     int n3 = x.length;
-    float[] di = new float[6];
+    float[][] di = new float[6][n1];
     int i3m3 = max(0,i3-3), i3p3 = min(n3-1,i3+3);
     int i3m2 = max(0,i3-2), i3p2 = min(n3-1,i3+2);
     int i3m1 = max(0,i3-1), i3p1 = min(n3-1,i3+1);
@@ -903,6 +924,7 @@ public class LocalDiffusionKernel {
     float[][] g2 = new float[n2][n1];
     gf(C71,x[i3],g1,g2);
     for (int i2=0; i2<n2; ++i2) {
+      getTensors(d,i2,i3,di);
       float[] xm1 = x[i3m1][i2], xm2 = x[i3m2][i2], xm3 = x[i3m3][i2];
       float[] xp1 = x[i3p1][i2], xp2 = x[i3p2][i2], xp3 = x[i3p3][i2];
       float[] ym1 = y[i3m1][i2], ym2 = y[i3m2][i2], ym3 = y[i3m3][i2];
@@ -910,14 +932,13 @@ public class LocalDiffusionKernel {
       float[] g1i = g1[i2];
       float[] g2i = g2[i2];
       for (int i1=0; i1<n1; ++i1) {
-        d.getTensor(i1,i2,i3,di);
         float csi = (s!=null)?c*s[i3][i2][i1]:c;
-        float d11 = di[0]*csi;
-        float d12 = di[1]*csi;
-        float d13 = di[2]*csi;
-        float d22 = di[3]*csi;
-        float d23 = di[4]*csi;
-        float d33 = di[5]*csi;
+        float d11 = di[0][i1]*csi;
+        float d12 = di[1][i1]*csi;
+        float d13 = di[2][i1]*csi;
+        float d22 = di[3][i1]*csi;
+        float d23 = di[4][i1]*csi;
+        float d33 = di[5][i1]*csi;
         float x1 = g1i[i1];
         float x2 = g2i[i1];
         float x3 = c1*(xp1[i1]-xm1[i1]) +
@@ -943,7 +964,7 @@ public class LocalDiffusionKernel {
     int n1 = x[0][0].length;
     int n2 = x[0].length;
     int n3 = x.length;
-    float[] di = new float[6];
+    float[][] di = new float[6][n1];
     int i3m3 = i3-3; if (i3m3<0) i3m3 = 0;
     int i3m2 = i3-2; if (i3m2<0) i3m2 = 0;
     int i3m1 = i3-1; if (i3m1<0) i3m1 = 0;
@@ -953,6 +974,7 @@ public class LocalDiffusionKernel {
     int i3p3 = i3+3; if (i3p3>=n3) i3p3 = n3-1;
     int i2m3,i2m2=0,i2m1=0,i2p0=0,i2p1=0,i2p2=1,i2p3=2;
     for (int i2=0; i2<n2; ++i2) {
+      getTensors(d,i2,i3,di);
       i2m3 = i2m2; i2m2 = i2m1; i2m1 = i2p0;
       i2p0 = i2p1; i2p1 = i2p2; i2p2 = i2p3; ++i2p3;
       if (i2p1>=n2) i2p1 = n2-1;
@@ -978,14 +1000,13 @@ public class LocalDiffusionKernel {
         if (p1>=n1) p1 = n1-1;
         if (p2>=n1) p2 = n1-1;
         if (p3>=n1) p3 = n1-1;
-        d.getTensor(i1,i2,i3,di);
         float csi = (s!=null)?c*s[i3][i2][i1]:c;
-        float d11 = di[0]*csi;
-        float d12 = di[1]*csi;
-        float d13 = di[2]*csi;
-        float d22 = di[3]*csi;
-        float d23 = di[4]*csi;
-        float d33 = di[5]*csi;
+        float d11 = di[0][i1]*csi;
+        float d12 = di[1][i1]*csi;
+        float d13 = di[2][i1]*csi;
+        float d22 = di[3][i1]*csi;
+        float d23 = di[4][i1]*csi;
+        float d33 = di[5][i1]*csi;
         float x1  = c1*(xp0p0[p1]-xp0p0[m1]) +
                     c2*(xp0p0[p2]-xp0p0[m2]) +
                     c3*(xp0p0[p3]-xp0p0[m3]);
@@ -14,6 +14,7 @@ limitations under the License.
 ****************************************************************************/
 package edu.mines.jtk.dsp;
 
+import edu.mines.jtk.util.Check;
 import edu.mines.jtk.util.Parallel;
 import static edu.mines.jtk.util.ArrayMath.*;
 
@@ -88,6 +89,7 @@ public class LocalOrientFilter {
    * @param sigma3 half-width of window in 3rd and higher dimensions.
    */
   public LocalOrientFilter(double sigma1, double sigma2, double sigma3) {
+    _sigma3 = sigma3;
     _rgfSmoother1 = (sigma1>=1.0)?new RecursiveGaussianFilter(sigma1):null;
     if (sigma2==sigma1) {
       _rgfSmoother2 = _rgfSmoother1;
@@ -140,6 +142,7 @@ public class LocalOrientFilter {
   public void setGradientSmoothing(
     double sigma1, double sigma2, double sigma3) 
   {
+    _sigmaGradient3 = sigma3;
     _rgfGradient1 = new RecursiveGaussianFilter(sigma1);
     if (sigma2==sigma1) {
       _rgfGradient2 = _rgfGradient1;
@@ -152,6 +155,26 @@ public class LocalOrientFilter {
       _rgfGradient3 = new RecursiveGaussianFilter(sigma3);
     }
   }
+
+  /**
+   * Sets the number of samples per slab used to compute 3-D tensors.
+   * If positive and less than the number of samples in the 3rd dimension,
+   * then methods that compute structure tensors for 3-D images do so for
+   * one slab of samples in the 3rd dimension at a time. Gradients, their
+   * products and smoothed products are then stored only for one slab
+   * plus a halo of samples on either side, and not for the entire image.
+   * <p>
+   * Each halo extends eight times the sum of the half-widths of the
+   * Gaussian derivative and window in the 3rd dimension. Tensors computed
+   * for slabs differ from those computed for the entire image by only
+   * the tiny tails of those recursive filters outside of halos.
+   * The default number of samples per slab is zero, for no slabs.
+   * @param m3 number of samples per slab; zero, for no slabs.
+   */
+  public void setSlabSize(int m3) {
+    Check.argument(m3>=0,"m3>=0");
+    _m3 = m3;
+  }
   
   /**
    * Applies this filter to estimate orientation angles.
@@ -443,10 +466,12 @@ public class LocalOrientFilter {
    * @return structure tensors.
    */
   public EigenTensors3 applyForTensors(float[][][] x, boolean compressed) {
-    int n1 = x[0][0].length;
-    int n2 = x[0].length;
-    int n3 = x.length;
-    float[][][] u2 = new float[n3][n2][n1];
+    final int n1 = x[0][0].length;
+    final int n2 = x[0].length;
+    final int n3 = x.length;
+    if (0<_m3 && _m3<n3)
+      return applyForTensorsInSlabs(x,compressed);
+    final float[][][] u2 = new float[n3][n2][n1];
     float[][][] u3 = new float[n3][n2][n1];
     float[][][] w1 = new float[n3][n2][n1];
     float[][][] w2 = new float[n3][n2][n1];
@@ -462,23 +487,28 @@ public class LocalOrientFilter {
       null,null);
 
     // Compute u1 such that u3 > 0.
-    float[][][] u1 = u3;
-    for (int i3=0; i3<n3; ++i3) {
+    final float[][][] u1 = u3;
+    Parallel.loop(n3,new Parallel.LoopInt() {
+    public void compute(int i3) {
       for (int i2=0; i2<n2; ++i2) {
+        float[] u1r = u1[i3][i2];
+        float[] u2r = u2[i3][i2];
         for (int i1=0; i1<n1; ++i1) {
-          float u2i = u2[i3][i2][i1];
-          float u3i = u3[i3][i2][i1];
+          float u2i = u2r[i1];
+          float u3i = u1r[i1];
           float u1s = 1.0f-u2i*u2i-u3i*u3i;
           float u1i = (u1s>0.0f)?sqrt(u1s):0.0f;
           if (u3i<0.0f) {
             u1i = -u1i;
             u2i = -u2i;
           }
-          u1[i3][i2][i1] = u1i;
-          u2[i3][i2][i1] = u2i;
+          u1r[i1] = u1i;
+          u2r[i1] = u2i;
         }
       }
-    }
+    }});
+
+    // Store (and maybe compress) rows of eigen-tensors in parallel.
     return new EigenTensors3(u1,u2,w1,w2,eu,ev,ew,compressed);
   }
 
@@ -531,64 +561,18 @@ public class LocalOrientFilter {
     if (ep!=null) t[nt++] = ep;
     if (el!=null) t[nt++] = el;
 
-    // Gradient.
+    // Structure tensors.
     int n1 = x[0][0].length;
     int n2 = x[0].length;
     int n3 = x.length;
-    float[][][] g1 = (nt>0)?t[0]:new float[n3][n2][n1];
-    float[][][] g2 = (nt>1)?t[1]:new float[n3][n2][n1];
-    float[][][] g3 = (nt>2)?t[2]:new float[n3][n2][n1];
-    _rgfGradient1.apply100(x,g1);
-    _rgfGradient2.apply010(x,g2);
-    _rgfGradient3.apply001(x,g3);
-
-    // Gradient products.
-    float[][][] g11 = g1;
-    float[][][] g22 = g2;
-    float[][][] g33 = g3;
+    float[][][] g11 = (nt>0)?t[0]:new float[n3][n2][n1];
+    float[][][] g22 = (nt>1)?t[1]:new float[n3][n2][n1];
+    float[][][] g33 = (nt>2)?t[2]:new float[n3][n2][n1];
     float[][][] g12 = (nt>3)?t[3]:new float[n3][n2][n1];
     float[][][] g13 = (nt>4)?t[4]:new float[n3][n2][n1];
     float[][][] g23 = (nt>5)?t[5]:new float[n3][n2][n1];
-    computeGradientProducts(g1,g2,g3,g11,g12,g13,g22,g23,g33);
-    /*
-    for (int i3=0; i3<n3; ++i3) {
-      for (int i2=0; i2<n2; ++i2) {
-        for (int i1=0; i1<n1; ++i1) {
-          float g1i = g1[i3][i2][i1];
-          float g2i = g2[i3][i2][i1];
-          float g3i = g3[i3][i2][i1];
-          g11[i3][i2][i1] = g1i*g1i;
-          g22[i3][i2][i1] = g2i*g2i;
-          g33[i3][i2][i1] = g3i*g3i;
-          g12[i3][i2][i1] = g1i*g2i;
-          g13[i3][i2][i1] = g1i*g3i;
-          g23[i3][i2][i1] = g2i*g3i;
-        }
-      }
-    }
-    */
-    
-    // Smoothed gradient products comprise the structure tensor.
-    if (_rgfSmoother1!=null || _rgfSmoother2!=null || _rgfSmoother3!=null) {
-      float[][][] h = (nt>6)?t[6]:new float[n3][n2][n1];
-      float[][][][] gs = {g11,g22,g33,g12,g13,g23};
-      for (float[][][] g:gs) {
-        if (_rgfSmoother1!=null) {
-          _rgfSmoother1.apply0XX(g,h);
-        } else {
-          copy(g,h);
-        }
-        if (_rgfSmoother2!=null) {
-          _rgfSmoother2.applyX0X(h,g);
-        } else {
-          copy(h,g);
-        }
-        if (_rgfSmoother3!=null) {
-          _rgfSmoother3.applyXX0(g,h);
-          copy(h,g);
-        }
-      }
-    }
+    float[][][] h = (nt>6)?t[6]:null;
+    computeStructureTensors(x,g11,g12,g13,g22,g23,g33,h);
 
     // Compute eigenvectors, eigenvalues, and outputs that depend on them.
     solveEigenproblems(g11,g12,g13,g22,g23,g33,
@@ -669,6 +653,103 @@ public class LocalOrientFilter {
   private RecursiveGaussianFilter _rgfSmoother1;
   private RecursiveGaussianFilter _rgfSmoother2;
   private RecursiveGaussianFilter _rgfSmoother3;
+  private double _sigma3; // half-width of window in 3rd dimension
+  private double _sigmaGradient3; // half-width of derivative in 3rd dim
+  private int _m3; // number of samples per slab; zero, for no slabs
+
+  // Halo half-width of slabs, in multiples of sums of filter half-widths.
+  private static final double SLAB_HALO = 8.0;
+
+  // Computes smoothed gradient products g11, g12, ... for a 3-D image.
+  // The arrays g11, g22 and g33 also store gradients g1, g2 and g3.
+  // The array h is workspace for smoothing; if null, it is allocated.
+  private void computeStructureTensors(float[][][] x,
+    float[][][] g11, float[][][] g12, float[][][] g13,
+    float[][][] g22, float[][][] g23, float[][][] g33,
+    float[][][] h)
+  {
+    // Gradient.
+    int n1 = x[0][0].length;
+    int n2 = x[0].length;
+    int n3 = x.length;
+    float[][][] g1 = g11;
+    float[][][] g2 = g22;
+    float[][][] g3 = g33;
+    _rgfGradient1.apply100(x,g1);
+    _rgfGradient2.apply010(x,g2);
+    _rgfGradient3.apply001(x,g3);
+
+    // Gradient products.
+    computeGradientProducts(g1,g2,g3,g11,g12,g13,g22,g23,g33);
+
+    // Smoothed gradient products comprise the structure tensor.
+    if (_rgfSmoother1!=null || _rgfSmoother2!=null || _rgfSmoother3!=null) {
+      if (h==null)
+        h = new float[n3][n2][n1];
+      float[][][][] gs = {g11,g22,g33,g12,g13,g23};
+      for (float[][][] g:gs) {
+        if (_rgfSmoother1!=null) {
+          _rgfSmoother1.apply0XX(g,h);
+        } else {
+          copy(g,h);
+        }
+        if (_rgfSmoother2!=null) {
+          _rgfSmoother2.applyX0X(h,g);
+        } else {
+          copy(h,g);
+        }
+        if (_rgfSmoother3!=null) {
+          _rgfSmoother3.applyXX0(g,h);
+          copy(h,g);
+        }
+      }
+    }
+  }
+
+  // Computes structure tensors for one slab of a 3-D image at a time.
+  // Each slab is extended by halos on either side, for which tensors are
+  // computed but not stored, so that tensors stored for slabs match
+  // those that would be computed for the entire image.
+  private EigenTensors3 applyForTensorsInSlabs(
+    float[][][] x, boolean compressed)
+  {
+    int n1 = x[0][0].length;
+    int n2 = x[0].length;
+    int n3 = x.length;
+    double sigma3 = _sigmaGradient3;
+    if (_rgfSmoother3!=null)
+      sigma3 += _sigma3;
+    int l3 = (int)ceil(SLAB_HALO*sigma3);
+    int ms = min(n3,_m3+2*l3);
+    float[][][][] gs = new float[7][ms][n2][n1];
+    final EigenTensors3 et = new EigenTensors3(n1,n2,n3,compressed);
+    for (int j3=0; j3<n3; j3+=_m3) {
+      int k3 = max(0,j3-l3);
+      int ns = min(n3,j3+_m3+l3)-k3;
+      float[][][] xs = new float[ns][][];
+      for (int is=0; is<ns; ++is)
+        xs[is] = x[k3+is];
+      float[][][][] g = new float[7][ns][][];
+      for (int ig=0; ig<7; ++ig)
+        for (int is=0; is<ns; ++is)
+          g[ig][is] = gs[ig][is];
+      final float[][][] g11 = g[0], g12 = g[1], g13 = g[2];
+      final float[][][] g22 = g[3], g23 = g[4], g33 = g[5];
+      computeStructureTensors(xs,g11,g12,g13,g22,g23,g33,g[6]);
+      final int m2 = n2;
+      final int o3 = k3;
+      Parallel.loop(j3,min(n3,j3+_m3),new Parallel.LoopInt() {
+      public void compute(int i3) {
+        int is = i3-o3;
+        for (int i2=0; i2<m2; ++i2) {
+          et.setTensors(i2,i3,
+            g11[is][i2],g12[is][i2],g13[is][i2],
+            g22[is][i2],g23[is][i2],g33[is][i2]);
+        }
+      }});
+    }
+    return et;
+  }
 
   private void computeGradientProducts(
     final float[][][] g1, final float[][][] g2, final float[][][] g3,
@@ -678,29 +759,27 @@ public class LocalOrientFilter {
     final int n1 = g1[0][0].length;
     final int n2 = g1[0].length;
     final int n3 = g1.length;
-    Parallel.loop(n3,new Parallel.LoopInt() {
-      public void compute(int i3) {
-        for (int i2=0; i2<n2; ++i2) {
-          float[] g1i = g1[i3][i2];
-          float[] g2i = g2[i3][i2];
-          float[] g3i = g3[i3][i2];
-          float[] g11i = g11[i3][i2];
-          float[] g12i = g12[i3][i2];
-          float[] g13i = g13[i3][i2];
-          float[] g22i = g22[i3][i2];
-          float[] g23i = g23[i3][i2];
-          float[] g33i = g33[i3][i2];
-          for (int i1=0; i1<n1; ++i1) {
-            float g1ii = g1i[i1];
-            float g2ii = g2i[i1];
-            float g3ii = g3i[i1];
-            g11i[i1] = g1ii*g1ii;
-            g22i[i1] = g2ii*g2ii;
-            g33i[i1] = g3ii*g3ii;
-            g12i[i1] = g1ii*g2ii;
-            g13i[i1] = g1ii*g3ii;
-            g23i[i1] = g2ii*g3ii;
-          }
+    Parallel.loop2(n2,n3,new Parallel.LoopInt2() {
+      public void compute(int i2, int i3) {
+        float[] g1i = g1[i3][i2];
+        float[] g2i = g2[i3][i2];
+        float[] g3i = g3[i3][i2];
+        float[] g11i = g11[i3][i2];
+        float[] g12i = g12[i3][i2];
+        float[] g13i = g13[i3][i2];
+        float[] g22i = g22[i3][i2];
+        float[] g23i = g23[i3][i2];
+        float[] g33i = g33[i3][i2];
+        for (int i1=0; i1<n1; ++i1) {
+          float g1ii = g1i[i1];
+          float g2ii = g2i[i1];
+          float g3ii = g3i[i1];
+          g11i[i1] = g1ii*g1ii;
+          g22i[i1] = g2ii*g2ii;
+          g33i[i1] = g3ii*g3ii;
+          g12i[i1] = g1ii*g2ii;
+          g13i[i1] = g1ii*g3ii;
+          g23i[i1] = g2ii*g3ii;
         }
       }
     });
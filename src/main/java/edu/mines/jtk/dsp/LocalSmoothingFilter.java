@@ -17,6 +17,7 @@ package edu.mines.jtk.dsp;
 import java.util.logging.Logger;
 
 import edu.mines.jtk.util.Parallel;
+import edu.mines.jtk.util.Profiler;
 import static edu.mines.jtk.util.ArrayMath.*;
 
 /**
@@ -108,6 +109,22 @@ public class LocalSmoothingFilter {
     _pc = pc;
   }
 
+  /**
+   * Sets the use of a multigrid preconditioner in this local smoothing
+   * filter. Each application of this preconditioner is one multigrid
+   * V-cycle on a hierarchy of grids, each coarser by a factor of two in
+   * every dimension. A multigrid preconditioner requires more memory and
+   * computing time per iteration than the simple preconditioner enabled
+   * by {@link #setPreconditioner(boolean)}, but the number of iterations
+   * grows much more slowly with the scale factor for tensors. If enabled, 
+   * the multigrid preconditioner is used instead of the simple one.
+   * The default is to not use a multigrid preconditioner.
+   * @param mg true, to use a multigrid preconditioner; false, otherwise.
+   */
+  public void setMultigrid(boolean mg) {
+    _mg = mg;
+  }
+
   /**
    * Applies this filter for specified constant scale factor.
    * Local smoothing for 1D arrays is a special case that requires no tensors. 
@@ -227,13 +244,21 @@ public class LocalSmoothingFilter {
   public void apply(
     Tensors2 d, float c, float[][] s, float[][] x, float[][] y) 
   {
-    Operator2 a = new A2(_ldk,d,c,s);
-    scopy(x,y);
-    if (_pc) {
-      Operator2 m = new M2(d,c,s,x);
-      solve(a,m,x,y);
-    } else {
-      solve(a,x,y);
+    Profiler.start(PROFILE_APPLY);
+    try {
+      Operator2 a = new A2(_ldk,d,c,s);
+      scopy(x,y);
+      if (_mg) {
+        Operator2 m = new MG2(_ldk,d,c,s,x[0].length,x.length);
+        solve(a,m,x,y);
+      } else if (_pc) {
+        Operator2 m = new M2(d,c,s,x[0].length,x.length);
+        solve(a,m,x,y);
+      } else {
+        solve(a,x,y);
+      }
+    } finally {
+      Profiler.stop(PROFILE_APPLY);
     }
   }
 
@@ -301,13 +326,24 @@ public class LocalSmoothingFilter {
   public void apply(
     Tensors3 d, float c, float[][][] s, float[][][] x, float[][][] y) 
   {
-    Operator3 a = new A3(_ldk,d,c,s);
-    scopy(x,y);
-    if (_pc) {
-      Operator3 m = new M3(d,c,s,x);
-      solve(a,m,x,y);
-    } else {
-      solve(a,x,y);
+    Profiler.start(PROFILE_APPLY);
+    try {
+      Operator3 a = new A3(_ldk,d,c,s);
+      scopy(x,y);
+      if (_mg) {
+        int n1 = x[0][0].length;
+        int n2 = x[0].length;
+        int n3 = x.length;
+        Operator3 m = new MG3(_ldk,d,c,s,n1,n2,n3);
+        solve(a,m,x,y);
+      } else if (_pc) {
+        Operator3 m = new M3(d,c,s,x[0][0].length,x[0].length,x.length);
+        solve(a,m,x,y);
+      } else {
+        solve(a,x,y);
+      }
+    } finally {
+      Profiler.stop(PROFILE_APPLY);
     }
   }
 
@@ -358,12 +394,21 @@ public class LocalSmoothingFilter {
 
   private static final boolean PARALLEL = true; // false for single-threaded
 
+  // Names of phases and counters for the profiler.
+  private static final String PROFILE_APPLY = "LocalSmoothingFilter.apply";
+  private static final String PROFILE_SOLVE = "LocalSmoothingFilter.solve";
+  private static final String PROFILE_ITERATIONS =
+    "LocalSmoothingFilter.iterations";
+  private static final String PROFILE_BYTES =
+    "LocalSmoothingFilter.bytesAllocated";
+
   private static Logger log = 
     Logger.getLogger(LocalSmoothingFilter.class.getName());
 
   private float _small; // stop iterations when residuals are small
   private int _niter; // number of iterations
   private boolean _pc; // true, for preconditioned CG iterations
+  private boolean _mg; // true, for multigrid-preconditioned CG iterations
   private LocalDiffusionKernel _ldk; // computes y += (I+G'DG)x
   private BandPassFilter _lpf; // lowpass filter, null until applied
   private double _kmax; // maximum wavenumber for lowpass filter
@@ -396,9 +441,7 @@ public class LocalSmoothingFilter {
   }
 
   private static class M2 implements Operator2 {
-    M2(Tensors2 d, float c, float[][] s, float[][] x)  {
-      int n1 = x[0].length;
-      int n2 = x.length;
+    M2(Tensors2 d, float c, float[][] s, int n1, int n2)  {
       _p = fillfloat(1.0f,n1,n2);
       c *= 0.25f;
       float[] di = new float[3];
@@ -447,15 +490,14 @@ public class LocalSmoothingFilter {
   }
 
   private static class M3 implements Operator3 {
-    M3(Tensors3 d, float c, float[][][] s, float[][][] x)  {
-      int n1 = x[0][0].length;
-      int n2 = x[0].length;
-      int n3 = x.length;
+    M3(Tensors3 d, float c, float[][][] s, int n1, int n2, int n3)  {
       _p = fillfloat(1.0f,n1,n2,n3);
       c *= 0.0625f;
-      float[] di = new float[6];
+      float[][] di = new float[6][n1];
       for (int i3=1,m3=0; i3<n3; ++i3,++m3) {
         for (int i2=1,m2=0; i2<n2; ++i2,++m2) {
+          if (d!=null)
+            LocalDiffusionKernel.getTensors(d,i2,i3,di);
           for (int i1=1,m1=0; i1<n1; ++i1,++m1) {
             float si = s!=null?s[i3][i2][i1]:1.0f;
             float csi = c*si;
@@ -466,13 +508,12 @@ public class LocalSmoothingFilter {
             float d23 = 0.0f;
             float d33 = csi;
             if (d!=null) {
-              d.getTensor(i1,i2,i3,di);
-              d11 = di[0]*csi;
-              d12 = di[1]*csi;
-              d13 = di[2]*csi;
-              d22 = di[3]*csi;
-              d23 = di[4]*csi;
-              d33 = di[5]*csi;
+              d11 = di[0][i1]*csi;
+              d12 = di[1][i1]*csi;
+              d13 = di[2][i1]*csi;
+              d22 = di[3][i1]*csi;
+              d23 = di[4][i1]*csi;
+              d33 = di[5][i1]*csi;
             }
             _p[i3][i2][i1] += ( d11+d12+d13)+( d12+d22+d23)+( d13+d23+d33);
             _p[m3][m2][m1] += ( d11+d12+d13)+( d12+d22+d23)+( d13+d23+d33);
@@ -493,6 +534,286 @@ public class LocalSmoothingFilter {
     private float[][][] _p;
   }
 
+  /*
+   * Multigrid preconditioners. Each application is one V-cycle with an
+   * initial solution of zero. On each grid, the operator A = I+G'DG is
+   * smoothed with damped Jacobi iterations, using the inverse diagonal
+   * computed by M2 or M3. The next coarser grid has every other sample
+   * in each dimension, with tensors and scale factors sampled likewise,
+   * and with the constant scale factor c reduced by four, because the
+   * gradient operator G on that grid has twice the sampling interval.
+   * Prolongation is linear interpolation and restriction is its scaled
+   * transpose. The V-cycle uses the same number of Jacobi iterations
+   * before and after each coarse-grid correction, so that it is an SPD
+   * operator, as required for preconditioned CG iterations.
+   */
+  private static final int MG_NMIN = 8; // no coarser grid if n<2*MG_NMIN
+  private static final int MG_NSMOOTH = 2; // Jacobi iterations per V-cycle
+  private static final int MG_NCOARSE = 8; // Jacobi iterations on coarsest
+  private static final float MG_OMEGA = 0.5f; // weight for Jacobi updates
+
+  private static class MG2 implements Operator2 {
+    MG2(LocalDiffusionKernel ldk, 
+        Tensors2 d, float c, float[][] s, int n1, int n2) 
+    {
+      _a = new A2(ldk,d,c,s);
+      _m = new M2(d,c,s,n1,n2);
+      _r = new float[n2][n1];
+      _t = new float[n2][n1];
+      if (n1>=2*MG_NMIN && n2>=2*MG_NMIN) {
+        int m1 = (n1+1)/2;
+        int m2 = (n2+1)/2;
+        Tensors2 dc = (d!=null)?new CoarseTensors2(d):null;
+        float[][] sc = (s!=null)?coarsen(s):null;
+        _coarse = new MG2(ldk,dc,0.25f*c,sc,m1,m2);
+        _rc = new float[m2][m1];
+        _ec = new float[m2][m1];
+      }
+    }
+    public void apply(float[][] b, float[][] x) {
+      int nsmooth = (_coarse!=null)?MG_NSMOOTH:MG_NCOARSE;
+      _m.apply(b,x);
+      mul(MG_OMEGA,x,x);
+      smooth(nsmooth-1,b,x);
+      if (_coarse!=null) {
+        residual(b,x,_r);
+        restrict(_r,_rc);
+        _coarse.apply(_rc,_ec);
+        prolong(_ec,_r,x);
+        smooth(nsmooth,b,x);
+      }
+    }
+    private A2 _a;
+    private M2 _m;
+    private MG2 _coarse;
+    private float[][] _r,_t; // work arrays for this grid
+    private float[][] _rc,_ec; // work arrays for coarser grid
+    private void residual(float[][] b, float[][] x, float[][] r) {
+      _a.apply(x,r);
+      sxpay(-1.0f,b,r);
+    }
+    private void smooth(int nsmooth, float[][] b, float[][] x) {
+      for (int ismooth=0; ismooth<nsmooth; ++ismooth) {
+        residual(b,x,_r);
+        _m.apply(_r,_t);
+        saxpy(MG_OMEGA,_t,x);
+      }
+    }
+  }
+
+  private static class MG3 implements Operator3 {
+    MG3(LocalDiffusionKernel ldk, 
+        Tensors3 d, float c, float[][][] s, int n1, int n2, int n3) 
+    {
+      _a = new A3(ldk,d,c,s);
+      _m = new M3(d,c,s,n1,n2,n3);
+      _r = new float[n3][n2][n1];
+      _t = new float[n3][n2][n1];
+      if (n1>=2*MG_NMIN && n2>=2*MG_NMIN && n3>=2*MG_NMIN) {
+        int m1 = (n1+1)/2;
+        int m2 = (n2+1)/2;
+        int m3 = (n3+1)/2;
+        Tensors3 dc = (d!=null)?new CoarseTensors3(d):null;
+        float[][][] sc = (s!=null)?coarsen(s):null;
+        _coarse = new MG3(ldk,dc,0.25f*c,sc,m1,m2,m3);
+        _rc = new float[m3][m2][m1];
+        _ec = new float[m3][m2][m1];
+      }
+    }
+    public void apply(float[][][] b, float[][][] x) {
+      int nsmooth = (_coarse!=null)?MG_NSMOOTH:MG_NCOARSE;
+      _m.apply(b,x);
+      mul(MG_OMEGA,x,x);
+      smooth(nsmooth-1,b,x);
+      if (_coarse!=null) {
+        residual(b,x,_r);
+        restrict(_r,_rc);
+        _coarse.apply(_rc,_ec);
+        prolong(_ec,_r,x);
+        smooth(nsmooth,b,x);
+      }
+    }
+    private A3 _a;
+    private M3 _m;
+    private MG3 _coarse;
+    private float[][][] _r,_t; // work arrays for this grid
+    private float[][][] _rc,_ec; // work arrays for coarser grid
+    private void residual(float[][][] b, float[][][] x, float[][][] r) {
+      _a.apply(x,r);
+      sxpay(-1.0f,b,r);
+    }
+    private void smooth(int nsmooth, float[][][] b, float[][][] x) {
+      for (int ismooth=0; ismooth<nsmooth; ++ismooth) {
+        residual(b,x,_r);
+        _m.apply(_r,_t);
+        saxpy(MG_OMEGA,_t,x);
+      }
+    }
+  }
+
+  // Tensors for a coarse grid, sampled from tensors on the finer grid.
+  private static class CoarseTensors2 implements Tensors2 {
+    CoarseTensors2(Tensors2 d) {
+      _d = d;
+    }
+    public void getTensor(int i1, int i2, float[] a) {
+      _d.getTensor(2*i1,2*i2,a);
+    }
+    private Tensors2 _d;
+  }
+  private static class CoarseTensors3 implements Tensors3 {
+    CoarseTensors3(Tensors3 d) {
+      _d = d;
+    }
+    public void getTensor(int i1, int i2, int i3, float[] a) {
+      _d.getTensor(2*i1,2*i2,2*i3,a);
+    }
+    private Tensors3 _d;
+  }
+
+  // Returns every other sample of an array in every dimension.
+  private static float[][] coarsen(float[][] s) {
+    int m2 = (s.length+1)/2;
+    float[][] sc = new float[m2][];
+    for (int i2=0; i2<m2; ++i2)
+      sc[i2] = copy((s[0].length+1)/2,0,2,s[2*i2]);
+    return sc;
+  }
+  private static float[][][] coarsen(float[][][] s) {
+    int m3 = (s.length+1)/2;
+    float[][][] sc = new float[m3][][];
+    for (int i3=0; i3<m3; ++i3)
+      sc[i3] = coarsen(s[2*i3]);
+    return sc;
+  }
+
+  // Restriction from fine array r to coarse array rc. Restriction is
+  // the transpose of linear interpolation, scaled by 1/2 for each
+  // dimension so that constant arrays are preserved. Overwrites r.
+  private static void restrict(float[] r, float[] rc) {
+    int n1 = r.length;
+    int m1 = rc.length;
+    for (int j1=0,i1=0; j1<m1; ++j1,i1+=2) {
+      float rci = 0.5f*r[i1];
+      if (i1>0) rci += 0.25f*r[i1-1];
+      if (i1<n1-1) rci += 0.25f*r[i1+1];
+      rc[j1] = rci;
+    }
+  }
+  private static void restrict(float[][] r, float[][] rc) {
+    restrictRows(r);
+    int m2 = rc.length;
+    for (int i2=0; i2<m2; ++i2)
+      restrict(r[i2],rc[i2]);
+  }
+  private static void restrict(final float[][][] r, final float[][][] rc) {
+    final int n3 = r.length;
+    final int m3 = rc.length;
+    final int n2 = r[0].length;
+    Parallel.loop(n2,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        float[][] r2 = new float[n3][];
+        for (int i3=0; i3<n3; ++i3)
+          r2[i3] = r[i3][i2];
+        restrictRows(r2);
+      }
+    });
+    Parallel.loop(m3,new Parallel.LoopInt() {
+      public void compute(int i3) {
+        restrict(r[i3],rc[i3]);
+      }
+    });
+  }
+
+  // Restricts the 2nd dimension of r in place; the restricted rows
+  // replace the first (n2+1)/2 rows of r.
+  private static void restrictRows(float[][] r) {
+    int n2 = r.length;
+    int n1 = r[0].length;
+    int m2 = (n2+1)/2;
+    for (int j2=0,i2=0; j2<m2; ++j2,i2+=2) {
+      float[] r0 = r[i2];
+      float[] rm = (i2>0)?r[i2-1]:null;
+      float[] rp = (i2<n2-1)?r[i2+1]:null;
+      float[] rj = r[j2];
+      for (int i1=0; i1<n1; ++i1) {
+        float ri = 0.5f*r0[i1];
+        if (rm!=null) ri += 0.25f*rm[i1];
+        if (rp!=null) ri += 0.25f*rp[i1];
+        rj[i1] = ri;
+      }
+    }
+  }
+
+  // Prolongation by linear interpolation from coarse array ec. For 1D
+  // arrays, stores interpolated values in t. For 2D and 3D arrays,
+  // accumulates interpolated values in x, and overwrites the array t,
+  // which has the same dimensions as x.
+  private static void prolong(float[] ec, float[] t) {
+    int n1 = t.length;
+    int m1 = ec.length;
+    for (int j1=0,i1=0; j1<m1; ++j1,i1+=2) {
+      t[i1] = ec[j1];
+      if (i1<n1-1)
+        t[i1+1] = (j1<m1-1)?0.5f*(ec[j1]+ec[j1+1]):0.5f*ec[j1];
+    }
+  }
+  private static void prolong(float[][] ec, float[][] t, float[][] x) {
+    int m2 = ec.length;
+    for (int i2=0; i2<m2; ++i2)
+      prolong(ec[i2],t[i2]);
+    prolongRows(m2,t,x);
+  }
+  private static void prolong(
+    final float[][][] ec, final float[][][] t, final float[][][] x)
+  {
+    final int n3 = x.length;
+    final int m3 = ec.length;
+    final int n2 = x[0].length;
+    Parallel.loop(m3,new Parallel.LoopInt() {
+      public void compute(int i3) {
+        float[][] t3 = t[i3];
+        float[][] ec3 = ec[i3];
+        int m2 = ec3.length;
+        for (int i2=0; i2<m2; ++i2)
+          prolong(ec3[i2],t3[i2]);
+        prolongRows(m2,t3,t3);
+      }
+    });
+    Parallel.loop(n2,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        float[][] t2 = new float[n3][];
+        float[][] x2 = new float[n3][];
+        for (int i3=0; i3<n3; ++i3) {
+          t2[i3] = t[i3][i2];
+          x2[i3] = x[i3][i2];
+        }
+        prolongRows(m3,t2,x2);
+      }
+    });
+  }
+
+  // Interpolates the 2nd dimension from the first m2 rows of t, and
+  // accumulates the interpolated rows in x. If x is the same array as
+  // t, then replaces the rows of t with the interpolated rows.
+  private static void prolongRows(int m2, float[][] t, float[][] x) {
+    int n2 = x.length;
+    int n1 = x[0].length;
+    boolean add = (x!=t);
+    for (int i2=n2-1; i2>=0; --i2) {
+      int j2 = i2/2;
+      boolean odd = (i2%2==1);
+      float[] t0 = t[j2];
+      float[] tp = (odd && j2<m2-1)?t[j2+1]:null;
+      float[] x2 = x[i2];
+      for (int i1=0; i1<n1; ++i1) {
+        float ti = t0[i1];
+        if (odd) ti = (tp!=null)?0.5f*(ti+tp[i1]):0.5f*ti;
+        x2[i1] = add?x2[i1]+ti:ti;
+      }
+    }
+  }
+
   /*
    * Computes y = lowpass(x). Arrays x and y may be the same array.
    */
@@ -611,69 +932,83 @@ public class LocalSmoothingFilter {
   private void solve(Operator2 a, float[][] b, float[][] x) {
     int n1 = b[0].length;
     int n2 = b.length;
-    float[][] d = new float[n2][n1];
-    float[][] q = new float[n2][n1];
-    float[][] r = new float[n2][n1];
-    scopy(b,r);
-    a.apply(x,q);
-    saxpy(-1.0f,q,r); // r = b-Ax
-    scopy(r,d); // d = r
-    float delta = sdot(r,r); // delta = r'r
-    float bnorm = sqrt(sdot(b,b));
-    float rnorm = sqrt(delta);
-    float rnormBegin = rnorm;
-    float rnormSmall = bnorm*_small;
-    int iter;
-    log.fine("solve: bnorm="+bnorm+" rnorm="+rnorm);
-    for (iter=0; iter<_niter && rnorm>rnormSmall; ++iter) {
-      log.finer("  iter="+iter+" rnorm="+rnorm+" ratio="+rnorm/rnormBegin);
-      a.apply(d,q); // q = Ad
-      float dq = sdot(d,q); // d'q = d'Ad
-      float alpha = delta/dq; // alpha = r'r/d'Ad
-      saxpy( alpha,d,x); // x = x+alpha*d
-      saxpy(-alpha,q,r); // r = r-alpha*q
-      float deltaOld = delta;
-      delta = sdot(r,r); // delta = r'r
-      float beta = delta/deltaOld;
-      sxpay(beta,r,d); // d = r+beta*d
-      rnorm = sqrt(delta);
-    }
-    log.fine("  iter="+iter+" rnorm="+rnorm+" ratio="+rnorm/rnormBegin);
+    Profiler.start(PROFILE_SOLVE);
+    try {
+      Profiler.count(PROFILE_BYTES,4*3L*n1*n2); // work arrays
+      float[][] d = new float[n2][n1];
+      float[][] q = new float[n2][n1];
+      float[][] r = new float[n2][n1];
+      scopy(b,r);
+      a.apply(x,q);
+      saxpy(-1.0f,q,r); // r = b-Ax
+      scopy(r,d); // d = r
+      float delta = sdot(r,r); // delta = r'r
+      float bnorm = sqrt(sdot(b,b));
+      float rnorm = sqrt(delta);
+      float rnormBegin = rnorm;
+      float rnormSmall = bnorm*_small;
+      int iter;
+      log.fine("solve: bnorm="+bnorm+" rnorm="+rnorm);
+      for (iter=0; iter<_niter && rnorm>rnormSmall; ++iter) {
+        log.finer("  iter="+iter+" rnorm="+rnorm+" ratio="+rnorm/rnormBegin);
+        a.apply(d,q); // q = Ad
+        float dq = sdot(d,q); // d'q = d'Ad
+        float alpha = delta/dq; // alpha = r'r/d'Ad
+        saxpy( alpha,d,x); // x = x+alpha*d
+        saxpy(-alpha,q,r); // r = r-alpha*q
+        float deltaOld = delta;
+        delta = sdot(r,r); // delta = r'r
+        float beta = delta/deltaOld;
+        sxpay(beta,r,d); // d = r+beta*d
+        rnorm = sqrt(delta);
+      }
+      log.fine("  iter="+iter+" rnorm="+rnorm+" ratio="+rnorm/rnormBegin);
+      Profiler.count(PROFILE_ITERATIONS,iter);
+    } finally {
+      Profiler.stop(PROFILE_SOLVE);
+    }
   }
   private void solve(Operator3 a, float[][][] b, float[][][] x) {
     int n1 = b[0][0].length;
     int n2 = b[0].length;
     int n3 = b.length;
-    float[][][] d = new float[n3][n2][n1];
-    float[][][] q = new float[n3][n2][n1];
-    float[][][] r = new float[n3][n2][n1];
-    scopy(b,r); a.apply(x,q); saxpy(-1.0f,q,r); // r = b-Ax
-    scopy(r,d);
-    float delta = sdot(r,r);
-    float bnorm = sqrt(sdot(b,b));
-    float rnorm = sqrt(delta);
-    float rnormBegin = rnorm;
-    float rnormSmall = bnorm*_small;
-    int iter;
-    log.fine("solve: bnorm="+bnorm+" rnorm="+rnorm);
-    for (iter=0; iter<_niter && rnorm>rnormSmall; ++iter) {
-      log.finer("  iter="+iter+" rnorm="+rnorm+" ratio="+rnorm/rnormBegin);
-      a.apply(d,q);
-      float dq = sdot(d,q);
-      float alpha = delta/dq;
-      saxpy( alpha,d,x);
-      if (iter%100<99) {
-        saxpy(-alpha,q,r);
-      } else {
-        scopy(b,r); a.apply(x,q); saxpy(-1.0f,q,r);
+    Profiler.start(PROFILE_SOLVE);
+    try {
+      Profiler.count(PROFILE_BYTES,4*3L*n1*n2*n3); // work arrays
+      float[][][] d = new float[n3][n2][n1];
+      float[][][] q = new float[n3][n2][n1];
+      float[][][] r = new float[n3][n2][n1];
+      scopy(b,r); a.apply(x,q); saxpy(-1.0f,q,r); // r = b-Ax
+      scopy(r,d);
+      float delta = sdot(r,r);
+      float bnorm = sqrt(sdot(b,b));
+      float rnorm = sqrt(delta);
+      float rnormBegin = rnorm;
+      float rnormSmall = bnorm*_small;
+      int iter;
+      log.fine("solve: bnorm="+bnorm+" rnorm="+rnorm);
+      for (iter=0; iter<_niter && rnorm>rnormSmall; ++iter) {
+        log.finer("  iter="+iter+" rnorm="+rnorm+" ratio="+rnorm/rnormBegin);
+        a.apply(d,q);
+        float dq = sdot(d,q);
+        float alpha = delta/dq;
+        saxpy( alpha,d,x);
+        if (iter%100<99) {
+          saxpy(-alpha,q,r);
+        } else {
+          scopy(b,r); a.apply(x,q); saxpy(-1.0f,q,r);
+        }
+        float deltaOld = delta;
+        delta = sdot(r,r);
+        float beta = delta/deltaOld;
+        sxpay(beta,r,d);
+        rnorm = sqrt(delta);
       }
-      float deltaOld = delta;
-      delta = sdot(r,r);
-      float beta = delta/deltaOld;
-      sxpay(beta,r,d);
-      rnorm = sqrt(delta);
+      log.fine("  iter="+iter+" rnorm="+rnorm+" ratio="+rnorm/rnormBegin);
+      Profiler.count(PROFILE_ITERATIONS,iter);
+    } finally {
+      Profiler.stop(PROFILE_SOLVE);
     }
-    log.fine("  iter="+iter+" rnorm="+rnorm+" ratio="+rnorm/rnormBegin);
   }
 
   // Conjugate-gradient solution of Ax = b, with preconditioner M.
@@ -681,73 +1016,87 @@ public class LocalSmoothingFilter {
   private void solve(Operator2 a, Operator2 m, float[][] b, float[][] x) {
     int n1 = b[0].length;
     int n2 = b.length;
-    float[][] d = new float[n2][n1];
-    float[][] q = new float[n2][n1];
-    float[][] r = new float[n2][n1];
-    float[][] s = new float[n2][n1];
-    scopy(b,r);
-    a.apply(x,q);
-    saxpy(-1.0f,q,r); // r = b-Ax
-    float bnorm = sqrt(sdot(b,b));
-    float rnorm = sqrt(sdot(r,r));
-    float rnormBegin = rnorm;
-    float rnormSmall = bnorm*_small;
-    m.apply(r,s); // s = Mr
-    scopy(s,d); // d = s
-    float delta = sdot(r,s); // r's = r'Mr
-    int iter;
-    log.fine("msolve: bnorm="+bnorm+" rnorm="+rnorm);
-    for (iter=0; iter<_niter && rnorm>rnormSmall; ++iter) {
-      log.finer("  iter="+iter+" rnorm="+rnorm+" ratio="+rnorm/rnormBegin);
-      a.apply(d,q); // q = Ad
-      float alpha = delta/sdot(d,q); // alpha = r'Mr/d'Ad
-      saxpy( alpha,d,x); // x = x+alpha*d
-      saxpy(-alpha,q,r); // r = r-alpha*q
+    Profiler.start(PROFILE_SOLVE);
+    try {
+      Profiler.count(PROFILE_BYTES,4*4L*n1*n2); // work arrays
+      float[][] d = new float[n2][n1];
+      float[][] q = new float[n2][n1];
+      float[][] r = new float[n2][n1];
+      float[][] s = new float[n2][n1];
+      scopy(b,r);
+      a.apply(x,q);
+      saxpy(-1.0f,q,r); // r = b-Ax
+      float bnorm = sqrt(sdot(b,b));
+      float rnorm = sqrt(sdot(r,r));
+      float rnormBegin = rnorm;
+      float rnormSmall = bnorm*_small;
       m.apply(r,s); // s = Mr
-      float deltaOld = delta;
-      delta = sdot(r,s); // delta = r's = r'Mr
-      float beta = delta/deltaOld;
-      sxpay(beta,s,d); // d = s+beta*d
-      rnorm  = sqrt(sdot(r,r));
+      scopy(s,d); // d = s
+      float delta = sdot(r,s); // r's = r'Mr
+      int iter;
+      log.fine("msolve: bnorm="+bnorm+" rnorm="+rnorm);
+      for (iter=0; iter<_niter && rnorm>rnormSmall; ++iter) {
+        log.finer("  iter="+iter+" rnorm="+rnorm+" ratio="+rnorm/rnormBegin);
+        a.apply(d,q); // q = Ad
+        float alpha = delta/sdot(d,q); // alpha = r'Mr/d'Ad
+        saxpy( alpha,d,x); // x = x+alpha*d
+        saxpy(-alpha,q,r); // r = r-alpha*q
+        m.apply(r,s); // s = Mr
+        float deltaOld = delta;
+        delta = sdot(r,s); // delta = r's = r'Mr
+        float beta = delta/deltaOld;
+        sxpay(beta,s,d); // d = s+beta*d
+        rnorm  = sqrt(sdot(r,r));
+      }
+      log.fine("  iter="+iter+" rnorm="+rnorm+" ratio="+rnorm/rnormBegin);
+      Profiler.count(PROFILE_ITERATIONS,iter);
+    } finally {
+      Profiler.stop(PROFILE_SOLVE);
     }
-    log.fine("  iter="+iter+" rnorm="+rnorm+" ratio="+rnorm/rnormBegin);
   }
   private void solve(Operator3 a, Operator3 m, float[][][] b, float[][][] x) {
     int n1 = b[0][0].length;
     int n2 = b[0].length;
     int n3 = b.length;
-    float[][][] d = new float[n3][n2][n1];
-    float[][][] q = new float[n3][n2][n1];
-    float[][][] r = new float[n3][n2][n1];
-    float[][][] s = new float[n3][n2][n1];
-    scopy(b,r); a.apply(x,q); saxpy(-1.0f,q,r); // r = b-Ax
-    float bnorm = sqrt(sdot(b,b));
-    float rnorm = sqrt(sdot(r,r));
-    float rnormBegin = rnorm;
-    float rnormSmall = bnorm*_small;
-    m.apply(r,s); // s = Mr
-    scopy(s,d); // d = s
-    float delta = sdot(r,s); // r's = r'Mr
-    int iter;
-    log.fine("msolve: bnorm="+bnorm+" rnorm="+rnorm);
-    for (iter=0; iter<_niter && rnorm>rnormSmall; ++iter) {
-      log.finer("  iter="+iter+" rnorm="+rnorm+" ratio="+rnorm/rnormBegin);
-      a.apply(d,q); // q = Ad
-      float alpha = delta/sdot(d,q); // alpha = r'Mr/d'Ad
-      saxpy( alpha,d,x); // x = x+alpha*d
-      if (iter%100<99) {
-        saxpy(-alpha,q,r); // r = r-alpha*q
-      } else {
-        scopy(b,r); a.apply(x,q); saxpy(-1.0f,q,r); // r = b-Ax
-      }
+    Profiler.start(PROFILE_SOLVE);
+    try {
+      Profiler.count(PROFILE_BYTES,4*4L*n1*n2*n3); // work arrays
+      float[][][] d = new float[n3][n2][n1];
+      float[][][] q = new float[n3][n2][n1];
+      float[][][] r = new float[n3][n2][n1];
+      float[][][] s = new float[n3][n2][n1];
+      scopy(b,r); a.apply(x,q); saxpy(-1.0f,q,r); // r = b-Ax
+      float bnorm = sqrt(sdot(b,b));
+      float rnorm = sqrt(sdot(r,r));
+      float rnormBegin = rnorm;
+      float rnormSmall = bnorm*_small;
       m.apply(r,s); // s = Mr
-      float deltaOld = delta;
-      delta = sdot(r,s); // delta = r's = r'Mr
-      float beta = delta/deltaOld;
-      sxpay(beta,s,d); // d = s+beta*d
-      rnorm  = sqrt(sdot(r,r));
+      scopy(s,d); // d = s
+      float delta = sdot(r,s); // r's = r'Mr
+      int iter;
+      log.fine("msolve: bnorm="+bnorm+" rnorm="+rnorm);
+      for (iter=0; iter<_niter && rnorm>rnormSmall; ++iter) {
+        log.finer("  iter="+iter+" rnorm="+rnorm+" ratio="+rnorm/rnormBegin);
+        a.apply(d,q); // q = Ad
+        float alpha = delta/sdot(d,q); // alpha = r'Mr/d'Ad
+        saxpy( alpha,d,x); // x = x+alpha*d
+        if (iter%100<99) {
+          saxpy(-alpha,q,r); // r = r-alpha*q
+        } else {
+          scopy(b,r); a.apply(x,q); saxpy(-1.0f,q,r); // r = b-Ax
+        }
+        m.apply(r,s); // s = Mr
+        float deltaOld = delta;
+        delta = sdot(r,s); // delta = r's = r'Mr
+        float beta = delta/deltaOld;
+        sxpay(beta,s,d); // d = s+beta*d
+        rnorm  = sqrt(sdot(r,r));
+      }
+      log.fine("  iter="+iter+" rnorm="+rnorm+" ratio="+rnorm/rnormBegin);
+      Profiler.count(PROFILE_ITERATIONS,iter);
+    } finally {
+      Profiler.stop(PROFILE_SOLVE);
     }
-    log.fine("  iter="+iter+" rnorm="+rnorm+" ratio="+rnorm/rnormBegin);
   }
 
   // Zeros array x.
@@ -823,10 +1172,15 @@ public class LocalSmoothingFilter {
   private static void saxpy(
     final float a, final float[][][] x, final float[][][] y)
   {
-    final int n3 = x.length;
-    Parallel.loop(n3,new Parallel.LoopInt() {
-      public void compute(int i3) {
-        saxpy(a,x[i3],y[i3]);
+    final int n1 = x[0][0].length;
+    int n2 = x[0].length;
+    int n3 = x.length;
+    Parallel.loop2(n2,n3,new Parallel.LoopInt2() {
+      public void compute(int i2, int i3) {
+        float[] x2 = x[i3][i2], y2 = y[i3][i2];
+        for (int i1=0; i1<n1; ++i1) {
+          y2[i1] += a*x2[i1];
+        }
       }
     });
   }
@@ -845,10 +1199,15 @@ public class LocalSmoothingFilter {
   private static void sxpay(
     final float a, final float[][][] x, final float[][][] y)
   {
-    final int n3 = x.length;
-    Parallel.loop(n3,new Parallel.LoopInt() {
-      public void compute(int i3) {
-        sxpay(a,x[i3],y[i3]);
+    final int n1 = x[0][0].length;
+    int n2 = x[0].length;
+    int n3 = x.length;
+    Parallel.loop2(n2,n3,new Parallel.LoopInt2() {
+      public void compute(int i2, int i3) {
+        float[] x2 = x[i3][i2], y2 = y[i3][i2];
+        for (int i1=0; i1<n1; ++i1) {
+          y2[i1] = a*y2[i1]+x2[i1];
+        }
       }
     });
   }
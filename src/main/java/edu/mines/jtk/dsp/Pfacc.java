@@ -1352,6 +1352,22 @@ class Pfacc {
    * @param z array[nfft][2*n1] of n1*nfft packed complex numbers.
    */
   static void transform2a(int sign, int n1, int nfft, float[][] z) {
+    transform2a(sign,0,n1,nfft,z);
+  }
+
+  /**
+   * Prime-factor complex-to-complex multiple FFT, for only some of the
+   * transforms of {@link #transform2a(int,int,int,float[][])}. Performs
+   * transforms with indices k1 &lt;= i1 &lt; l1 in the 1st dimension, and
+   * neither reads nor writes other elements of the array z. Therefore, 
+   * disjoint ranges of transforms may be computed concurrently.
+   * @param sign the sign of the exponent in the Fourier transform.
+   * @param k1 the index of the first transform.
+   * @param l1 the index of the transform after the last.
+   * @param nfft the FFT length (slow dimension).
+   * @param z array[nfft][2*n1] of n1*nfft packed complex numbers.
+   */
+  static void transform2a(int sign, int k1, int l1, int nfft, float[][] z) {
 
     // What is left of n after dividing by factors.
     int nleft = nfft;
@@ -1387,28 +1403,28 @@ class Pfacc {
 
       // Factor 2.
       if (ifac==2) {
-        pfa2a(n1,z,m,j0,j1);
+        pfa2a(k1,l1,z,m,j0,j1);
         continue;
       }
       int j2 = (j1+jinc)%jmax;
 
       // Factor 3.
       if (ifac==3) {
-        pfa3a(n1,z,mu,m,j0,j1,j2);
+        pfa3a(k1,l1,z,mu,m,j0,j1,j2);
         continue;
       }
       int j3 = (j2+jinc)%jmax;
 
       // Factor 4.
       if (ifac==4) {
-        pfa4a(n1,z,mu,m,j0,j1,j2,j3);
+        pfa4a(k1,l1,z,mu,m,j0,j1,j2,j3);
         continue;
       }
       int j4 = (j3+jinc)%jmax;
 
       // Factor 5.
       if (ifac==5) {
-        pfa5a(n1,z,mu,m,j0,j1,j2,j3,j4);
+        pfa5a(k1,l1,z,mu,m,j0,j1,j2,j3,j4);
         continue;
       }
       int j5 = (j4+jinc)%jmax;
@@ -1416,21 +1432,21 @@ class Pfacc {
 
       // Factor 7.
       if (ifac==7) {
-        pfa7a(n1,z,mu,m,j0,j1,j2,j3,j4,j5,j6);
+        pfa7a(k1,l1,z,mu,m,j0,j1,j2,j3,j4,j5,j6);
         continue;
       }
       int j7 = (j6+jinc)%jmax;
 
       // Factor 8.
       if (ifac==8) {
-        pfa8a(n1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7);
+        pfa8a(k1,l1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7);
         continue;
       }
       int j8 = (j7+jinc)%jmax;
 
       // Factor 9.
       if (ifac==9) {
-        pfa9a(n1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7,j8);
+        pfa9a(k1,l1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7,j8);
         continue;
       }
       int j9 = (j8+jinc)%jmax;
@@ -1438,7 +1454,7 @@ class Pfacc {
 
       // Factor 11.
       if (ifac==11) {
-        pfa11a(n1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7,j8,j9,j10);
+        pfa11a(k1,l1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7,j8,j9,j10);
         continue;
       }
       int j11 = (j10+jinc)%jmax;
@@ -1446,7 +1462,7 @@ class Pfacc {
 
       // Factor 13.
       if (ifac==13) {
-        pfa13a(n1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7,j8,j9,j10,j11,j12);
+        pfa13a(k1,l1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7,j8,j9,j10,j11,j12);
         continue;
       }
       int j13 = (j12+jinc)%jmax;
@@ -1455,17 +1471,18 @@ class Pfacc {
 
       // Factor 16.
       if (ifac==16) {
-        pfa16a(n1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7,j8,j9,j10,j11,j12,j13,j14,j15);
+        pfa16a(k1,l1,z,mu,m,
+          j0,j1,j2,j3,j4,j5,j6,j7,j8,j9,j10,j11,j12,j13,j14,j15);
       }
     }
   }
-  private static void pfa2a(int n1, float[][] z, int m, int j0, int j1)
+  private static void pfa2a(int k1, int l1, float[][] z, int m, int j0, int j1)
   {
-    int m1 = 2*n1;
+    int m1 = 2*l1;
     for (int i=0; i<m; ++i) {
       float[] zj0 = z[j0];
       float[] zj1 = z[j1];
-      for (int i1=0; i1<m1; i1+=2) {
+      for (int i1=2*k1; i1<m1; i1+=2) {
         float t1r = zj0[i1  ]-zj1[i1  ];
         float t1i = zj0[i1+1]-zj1[i1+1];
         zj0[i1  ] = zj0[i1  ]+zj1[i1  ];
@@ -1478,10 +1495,10 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa3a(int n1, float[][] z, int mu, int m,
+  private static void pfa3a(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2)
   {
-    int m1 = 2*n1;
+    int m1 = 2*l1;
     float c1;
     if (mu==1) {
       c1 =  P866;
@@ -1492,7 +1509,7 @@ class Pfacc {
       float[] zj0 = z[j0];
       float[] zj1 = z[j1];
       float[] zj2 = z[j2];
-      for (int i1=0; i1<m1; i1+=2) {
+      for (int i1=2*k1; i1<m1; i1+=2) {
         float t1r = zj1[i1  ]+zj2[i1  ];
         float t1i = zj1[i1+1]+zj2[i1+1];
         float y1r = zj0[i1  ]-0.5f*t1r;
@@ -1512,10 +1529,10 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa4a(int n1, float[][] z, int mu, int m,
+  private static void pfa4a(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2, int j3)
   {
-    int m1 = 2*n1;
+    int m1 = 2*l1;
     float c1;
     if (mu==1) {
       c1 =  PONE;
@@ -1527,7 +1544,7 @@ class Pfacc {
       float[] zj1 = z[j1];
       float[] zj2 = z[j2];
       float[] zj3 = z[j3];
-      for (int i1=0; i1<m1; i1+=2) {
+      for (int i1=2*k1; i1<m1; i1+=2) {
         float t1r = zj0[i1  ]+zj2[i1  ];
         float t1i = zj0[i1+1]+zj2[i1+1];
         float t2r = zj1[i1  ]+zj3[i1  ];
@@ -1552,10 +1569,10 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa5a(int n1, float[][] z, int mu, int m,
+  private static void pfa5a(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2, int j3, int j4)
   {
-    int m1 = 2*n1;
+    int m1 = 2*l1;
     float c1,c2,c3;
     if (mu==1) {
       c1 =  P559;
@@ -1580,7 +1597,7 @@ class Pfacc {
       float[] zj2 = z[j2];
       float[] zj3 = z[j3];
       float[] zj4 = z[j4];
-      for (int i1=0; i1<m1; i1+=2) {
+      for (int i1=2*k1; i1<m1; i1+=2) {
         float t1r = zj1[i1  ]+zj4[i1  ];
         float t1i = zj1[i1+1]+zj4[i1+1];
         float t2r = zj2[i1  ]+zj3[i1  ];
@@ -1622,10 +1639,10 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa7a(int n1, float[][] z, int mu, int m,
+  private static void pfa7a(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2, int j3, int j4, int j5, int j6)
   {
-    int m1 = 2*n1;
+    int m1 = 2*l1;
     float c1,c2,c3,c4,c5,c6;
     if (mu==1) {
       c1 =  P623;
@@ -1678,7 +1695,7 @@ class Pfacc {
       float[] zj4 = z[j4];
       float[] zj5 = z[j5];
       float[] zj6 = z[j6];
-      for (int i1=0; i1<m1; i1+=2) {
+      for (int i1=2*k1; i1<m1; i1+=2) {
         float t1r = zj1[i1  ]+zj6[i1  ];
         float t1i = zj1[i1+1]+zj6[i1+1];
         float t2r = zj2[i1  ]+zj5[i1  ];
@@ -1734,10 +1751,10 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa8a(int n1, float[][] z, int mu, int m,
+  private static void pfa8a(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2, int j3, int j4, int j5, int j6, int j7)
   {
-    int m1 = 2*n1;
+    int m1 = 2*l1;
     float c1,c2,c3;
     if (mu==1) {
       c1 =  PONE;
@@ -1762,7 +1779,7 @@ class Pfacc {
       float[] zj5 = z[j5];
       float[] zj6 = z[j6];
       float[] zj7 = z[j7];
-      for (int i1=0; i1<m1; i1+=2) {
+      for (int i1=2*k1; i1<m1; i1+=2) {
         float t1r = zj0[i1  ]+zj4[i1  ];
         float t1i = zj0[i1+1]+zj4[i1+1];
         float t2r = zj0[i1  ]-zj4[i1  ];
@@ -1827,10 +1844,10 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa9a(int n1, float[][] z, int mu, int m,
+  private static void pfa9a(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2, int j3, int j4, int j5, int j6, int j7, int j8)
   {
-    int m1 = 2*n1;
+    int m1 = 2*l1;
     float c1,c2,c3,c4,c5,c6,c7,c8,c9;
     if (mu==1) {
       c1 =  P866;
@@ -1883,7 +1900,7 @@ class Pfacc {
       float[] zj6 = z[j6];
       float[] zj7 = z[j7];
       float[] zj8 = z[j8];
-      for (int i1=0; i1<m1; i1+=2) {
+      for (int i1=2*k1; i1<m1; i1+=2) {
         float t1r  = zj3[i1  ]+zj6[i1  ];
         float t1i  = zj3[i1+1]+zj6[i1+1];
         float t2r  = zj0[i1  ]-0.5f*t1r;
@@ -1977,11 +1994,11 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa11a(int n1, float[][] z, int mu, int m,
+  private static void pfa11a(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2, int j3, int j4, int j5, 
     int j6, int j7, int j8, int j9, int j10)
   {
-    int m1 = 2*n1;
+    int m1 = 2*l1;
     float c1,c2,c3,c4,c5,c6,c7,c8,c9,c10;
     if (mu==1) {
       c1  =  P841;
@@ -2106,7 +2123,7 @@ class Pfacc {
       float[] zj8 = z[j8];
       float[] zj9 = z[j9];
       float[] zj10 = z[j10];
-      for (int i1=0; i1<m1; i1+=2) {
+      for (int i1=2*k1; i1<m1; i1+=2) {
         float t1r  = zj1[i1  ]+zj10[i1  ];
         float t1i  = zj1[i1+1]+zj10[i1+1];
         float t2r  = zj2[i1  ]+zj9[i1  ];
@@ -2194,11 +2211,11 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa13a(int n1, float[][] z, int mu, int m,
+  private static void pfa13a(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2, int j3, int j4, int j5, int j6, 
     int j7, int j8, int j9, int j10, int j11, int j12)
   {
-    int m1 = 2*n1;
+    int m1 = 2*l1;
     float c1,c2,c3,c4,c5,c6,c7,c8,c9,c10,c11,c12;
     if (mu==1) {
       c1  =  P885;
@@ -2371,7 +2388,7 @@ class Pfacc {
       float[] zj10 = z[j10];
       float[] zj11 = z[j11];
       float[] zj12 = z[j12];
-      for (int i1=0; i1<m1; i1+=2) {
+      for (int i1=2*k1; i1<m1; i1+=2) {
         float t1r  = zj1[i1  ]+zj12[i1  ];
         float t1i  = zj1[i1+1]+zj12[i1+1];
         float t2r  = zj2[i1  ]+zj11[i1  ];
@@ -2475,11 +2492,11 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa16a(int n1, float[][] z, int mu, int m,
+  private static void pfa16a(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2, int j3, int j4, int j5, int j6, int j7, int j8, 
     int j9, int j10, int j11, int j12, int j13, int j14, int j15)
   {
-    int m1 = 2*n1;
+    int m1 = 2*l1;
     float c1,c2,c3,c4,c5,c6,c7;
     if (mu==1) {
       c1 =  PONE;
@@ -2542,7 +2559,7 @@ class Pfacc {
       float[] zj13 = z[j13];
       float[] zj14 = z[j14];
       float[] zj15 = z[j15];
-      for (int i1=0; i1<m1; i1+=2) {
+      for (int i1=2*k1; i1<m1; i1+=2) {
         float t1r  = zj0[i1  ]+zj8[i1  ];
         float t1i  = zj0[i1+1]+zj8[i1+1];
         float t2r  = zj4[i1  ]+zj12[i1  ];
@@ -2719,6 +2736,22 @@ class Pfacc {
    * @param z array[nfft*2][n1] of nfft*n1 complex numbers.
    */
   static void transform2b(int sign, int n1, int nfft, float[][] z) {
+    transform2b(sign,0,n1,nfft,z);
+  }
+
+  /**
+   * Prime-factor complex-to-complex multiple FFT, for only some of the
+   * transforms of {@link #transform2b(int,int,int,float[][])}. Performs
+   * transforms with indices k1 &lt;= i1 &lt; l1 in the 1st dimension, and
+   * neither reads nor writes other elements of the array z. Therefore, 
+   * disjoint ranges of transforms may be computed concurrently.
+   * @param sign the sign of the exponent in the Fourier transform.
+   * @param k1 the index of the first transform.
+   * @param l1 the index of the transform after the last.
+   * @param nfft the FFT length (slow dimension).
+   * @param z array[nfft*2][n1] of nfft*n1 complex numbers.
+   */
+  static void transform2b(int sign, int k1, int l1, int nfft, float[][] z) {
 
     // What is left of n after dividing by factors.
     int nleft = nfft;
@@ -2754,28 +2787,28 @@ class Pfacc {
 
       // Factor 2.
       if (ifac==2) {
-        pfa2b(n1,z,m,j0,j1);
+        pfa2b(k1,l1,z,m,j0,j1);
         continue;
       }
       int j2 = (j1+jinc)%jmax;
 
       // Factor 3.
       if (ifac==3) {
-        pfa3b(n1,z,mu,m,j0,j1,j2);
+        pfa3b(k1,l1,z,mu,m,j0,j1,j2);
         continue;
       }
       int j3 = (j2+jinc)%jmax;
 
       // Factor 4.
       if (ifac==4) {
-        pfa4b(n1,z,mu,m,j0,j1,j2,j3);
+        pfa4b(k1,l1,z,mu,m,j0,j1,j2,j3);
         continue;
       }
       int j4 = (j3+jinc)%jmax;
 
       // Factor 5.
       if (ifac==5) {
-        pfa5b(n1,z,mu,m,j0,j1,j2,j3,j4);
+        pfa5b(k1,l1,z,mu,m,j0,j1,j2,j3,j4);
         continue;
       }
       int j5 = (j4+jinc)%jmax;
@@ -2783,21 +2816,21 @@ class Pfacc {
 
       // Factor 7.
       if (ifac==7) {
-        pfa7b(n1,z,mu,m,j0,j1,j2,j3,j4,j5,j6);
+        pfa7b(k1,l1,z,mu,m,j0,j1,j2,j3,j4,j5,j6);
         continue;
       }
       int j7 = (j6+jinc)%jmax;
 
       // Factor 8.
       if (ifac==8) {
-        pfa8b(n1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7);
+        pfa8b(k1,l1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7);
         continue;
       }
       int j8 = (j7+jinc)%jmax;
 
       // Factor 9.
       if (ifac==9) {
-        pfa9b(n1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7,j8);
+        pfa9b(k1,l1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7,j8);
         continue;
       }
       int j9 = (j8+jinc)%jmax;
@@ -2805,7 +2838,7 @@ class Pfacc {
 
       // Factor 11.
       if (ifac==11) {
-        pfa11b(n1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7,j8,j9,j10);
+        pfa11b(k1,l1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7,j8,j9,j10);
         continue;
       }
       int j11 = (j10+jinc)%jmax;
@@ -2813,7 +2846,7 @@ class Pfacc {
 
       // Factor 13.
       if (ifac==13) {
-        pfa13b(n1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7,j8,j9,j10,j11,j12);
+        pfa13b(k1,l1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7,j8,j9,j10,j11,j12);
         continue;
       }
       int j13 = (j12+jinc)%jmax;
@@ -2822,18 +2855,19 @@ class Pfacc {
 
       // Factor 16.
       if (ifac==16) {
-        pfa16b(n1,z,mu,m,j0,j1,j2,j3,j4,j5,j6,j7,j8,j9,j10,j11,j12,j13,j14,j15);
+        pfa16b(k1,l1,z,mu,m,
+          j0,j1,j2,j3,j4,j5,j6,j7,j8,j9,j10,j11,j12,j13,j14,j15);
       }
     }
   }
-  private static void pfa2b(int n1, float[][] z, int m, int j0, int j1)
+  private static void pfa2b(int k1, int l1, float[][] z, int m, int j0, int j1)
   {
     for (int i=0; i<m; ++i) {
       float[] zj0r = z[j0  ];
       float[] zj0i = z[j0+1];
       float[] zj1r = z[j1  ];
       float[] zj1i = z[j1+1];
-      for (int i1=0; i1<n1; ++i1) {
+      for (int i1=k1; i1<l1; ++i1) {
         float t1r = zj0r[i1]-zj1r[i1];
         float t1i = zj0i[i1]-zj1i[i1];
         zj0r[i1] = zj0r[i1]+zj1r[i1];
@@ -2846,7 +2880,7 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa3b(int n1, float[][] z, int mu, int m,
+  private static void pfa3b(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2)
   {
     float c1;
@@ -2862,7 +2896,7 @@ class Pfacc {
       float[] zj1i = z[j1+1];
       float[] zj2r = z[j2  ];
       float[] zj2i = z[j2+1];
-      for (int i1=0; i1<n1; ++i1) {
+      for (int i1=k1; i1<l1; ++i1) {
         float t1r = zj1r[i1]+zj2r[i1];
         float t1i = zj1i[i1]+zj2i[i1];
         float y1r = zj0r[i1]-0.5f*t1r;
@@ -2882,7 +2916,7 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa4b(int n1, float[][] z, int mu, int m,
+  private static void pfa4b(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2, int j3)
   {
     float c1;
@@ -2900,7 +2934,7 @@ class Pfacc {
       float[] zj2i = z[j2+1];
       float[] zj3r = z[j3  ];
       float[] zj3i = z[j3+1];
-      for (int i1=0; i1<n1; ++i1) {
+      for (int i1=k1; i1<l1; ++i1) {
         float t1r = zj0r[i1]+zj2r[i1];
         float t1i = zj0i[i1]+zj2i[i1];
         float t2r = zj1r[i1]+zj3r[i1];
@@ -2925,7 +2959,7 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa5b(int n1, float[][] z, int mu, int m,
+  private static void pfa5b(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2, int j3, int j4)
   {
     float c1,c2,c3;
@@ -2957,7 +2991,7 @@ class Pfacc {
       float[] zj3i = z[j3+1];
       float[] zj4r = z[j4  ];
       float[] zj4i = z[j4+1];
-      for (int i1=0; i1<n1; ++i1) {
+      for (int i1=k1; i1<l1; ++i1) {
         float t1r = zj1r[i1]+zj4r[i1];
         float t1i = zj1i[i1]+zj4i[i1];
         float t2r = zj2r[i1]+zj3r[i1];
@@ -2999,7 +3033,7 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa7b(int n1, float[][] z, int mu, int m,
+  private static void pfa7b(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2, int j3, int j4, int j5, int j6)
   {
     float c1,c2,c3,c4,c5,c6;
@@ -3061,7 +3095,7 @@ class Pfacc {
       float[] zj5i = z[j5+1];
       float[] zj6r = z[j6  ];
       float[] zj6i = z[j6+1];
-      for (int i1=0; i1<n1; ++i1) {
+      for (int i1=k1; i1<l1; ++i1) {
         float t1r = zj1r[i1]+zj6r[i1];
         float t1i = zj1i[i1]+zj6i[i1];
         float t2r = zj2r[i1]+zj5r[i1];
@@ -3117,7 +3151,7 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa8b(int n1, float[][] z, int mu, int m,
+  private static void pfa8b(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2, int j3, int j4, int j5, int j6, int j7)
   {
     float c1,c2,c3;
@@ -3152,7 +3186,7 @@ class Pfacc {
       float[] zj6i = z[j6+1];
       float[] zj7r = z[j7  ];
       float[] zj7i = z[j7+1];
-      for (int i1=0; i1<n1; ++i1) {
+      for (int i1=k1; i1<l1; ++i1) {
         float t1r = zj0r[i1]+zj4r[i1];
         float t1i = zj0i[i1]+zj4i[i1];
         float t2r = zj0r[i1]-zj4r[i1];
@@ -3217,7 +3251,7 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa9b(int n1, float[][] z, int mu, int m,
+  private static void pfa9b(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2, int j3, int j4, int j5, int j6, int j7, int j8)
   {
     float c1,c2,c3,c4,c5,c6,c7,c8,c9;
@@ -3281,7 +3315,7 @@ class Pfacc {
       float[] zj7i = z[j7+1];
       float[] zj8r = z[j8  ];
       float[] zj8i = z[j8+1];
-      for (int i1=0; i1<n1; ++i1) {
+      for (int i1=k1; i1<l1; ++i1) {
         float t1r  = zj3r[i1]+zj6r[i1];
         float t1i  = zj3i[i1]+zj6i[i1];
         float t2r  = zj0r[i1]-0.5f*t1r;
@@ -3375,7 +3409,7 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa11b(int n1, float[][] z, int mu, int m,
+  private static void pfa11b(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2, int j3, int j4, int j5, 
     int j6, int j7, int j8, int j9, int j10)
   {
@@ -3514,7 +3548,7 @@ class Pfacc {
       float[] zj9i = z[j9+1];
       float[] zj10r = z[j10  ];
       float[] zj10i = z[j10+1];
-      for (int i1=0; i1<n1; ++i1) {
+      for (int i1=k1; i1<l1; ++i1) {
         float t1r  = zj1r[i1]+zj10r[i1];
         float t1i  = zj1i[i1]+zj10i[i1];
         float t2r  = zj2r[i1]+zj9r[i1];
@@ -3602,7 +3636,7 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa13b(int n1, float[][] z, int mu, int m,
+  private static void pfa13b(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2, int j3, int j4, int j5, int j6, 
     int j7, int j8, int j9, int j10, int j11, int j12)
   {
@@ -3791,7 +3825,7 @@ class Pfacc {
       float[] zj11i = z[j11+1];
       float[] zj12r = z[j12  ];
       float[] zj12i = z[j12+1];
-      for (int i1=0; i1<n1; ++i1) {
+      for (int i1=k1; i1<l1; ++i1) {
         float t1r  = zj1r[i1]+zj12r[i1];
         float t1i  = zj1i[i1]+zj12i[i1];
         float t2r  = zj2r[i1]+zj11r[i1];
@@ -3895,7 +3929,7 @@ class Pfacc {
       j0 = jt;
     }
   }
-  private static void pfa16b(int n1, float[][] z, int mu, int m,
+  private static void pfa16b(int k1, int l1, float[][] z, int mu, int m,
     int j0, int j1, int j2, int j3, int j4, int j5, int j6, int j7, int j8, 
     int j9, int j10, int j11, int j12, int j13, int j14, int j15)
   {
@@ -3977,7 +4011,7 @@ class Pfacc {
       float[] zj14i = z[j14+1];
       float[] zj15r = z[j15  ];
       float[] zj15i = z[j15+1];
-      for (int i1=0; i1<n1; ++i1) {
+      for (int i1=k1; i1<l1; ++i1) {
         float t1r  = zj0r[i1]+zj8r[i1];
         float t1i  = zj0i[i1]+zj8i[i1];
         float t2r  = zj4r[i1]+zj12r[i1];
@@ -492,7 +492,47 @@ public class RecursiveGaussianFilter {
 
     abstract void applyN(int nd, float[] x, float[] y);
 
-    abstract void applyXN(int nd, float[][] x, float[][] y);
+    // Applies the filter along the 2nd dimension of a 2-D array. Arrays
+    // with a long 1st dimension are filtered in vertical strips, so that
+    // the forward and reverse recursions for each strip stay in cache.
+    // Strips are independent, and are filtered in parallel. Each thread
+    // reuses one pair of strips; only the last, narrower strip (if any)
+    // requires its own.
+    void applyXN(final int nd, final float[][] x, final float[][] y) {
+      checkArrays(x,y);
+      final int m2 = y.length;
+      final int m1 = y[0].length;
+      final int mb = stripWidth(m1,m2);
+      if (mb==m1) {
+        applyXNBlock(nd,x,y);
+        return;
+      }
+      int nb = (m1+mb-1)/mb;
+      final Parallel.Unsafe<float[][][]> wu =
+        new Parallel.Unsafe<float[][][]>();
+      Parallel.loop(nb,new Parallel.LoopInt() {
+        public void compute(int ib) {
+          int j1 = ib*mb;
+          int l1 = min(mb,m1-j1);
+          float[][][] w = (l1==mb)?wu.get():null;
+          if (w==null) {
+            w = new float[2][m2][l1];
+            if (l1==mb)
+              wu.set(w);
+          }
+          float[][] xb = w[0];
+          float[][] yb = w[1];
+          for (int i2=0; i2<m2; ++i2)
+            System.arraycopy(x[i2],j1,xb[i2],0,l1);
+          applyXNBlock(nd,xb,yb);
+          for (int i2=0; i2<m2; ++i2)
+            System.arraycopy(yb[i2],0,y[i2],j1,l1);
+        }
+      });
+    }
+
+    // Applies the filter along the 2nd dimension of an entire array.
+    abstract void applyXNBlock(int nd, float[][] x, float[][] y);
 
     void applyNX(int nd, float[][] x, float[][] y) {
       int m2 = y.length;
@@ -552,6 +592,15 @@ public class RecursiveGaussianFilter {
       }
     }
     */
+
+    // Returns the width of strips for a 2-D array[m2][m1]. Strips are
+    // multiples of 16 samples wide, sized so that input and output
+    // strips together fit easily in a typical L2 cache.
+    private static int stripWidth(int m1, int m2) {
+      int mb = max(16,STRIP_SIZE/m2/16*16);
+      return (mb<m1)?mb:m1;
+    }
+    private static final int STRIP_SIZE = 16384; // floats per strip
   }
 
   ///////////////////////////////////////////////////////////////////////////
@@ -597,7 +646,7 @@ public class RecursiveGaussianFilter {
       }
     }
 
-    void applyXN(int nd, float[][] x, float[][] y) {
+    void applyXNBlock(int nd, float[][] x, float[][] y) {
       checkArrays(x,y);
       if (sameArrays(x,y))
         x = copy(x);
@@ -849,7 +898,7 @@ public class RecursiveGaussianFilter {
       _g[nd][1][1].accumulateReverse(x,y);
     }
 
-    void applyXN(int nd, float[][] x, float[][] y) {
+    void applyXNBlock(int nd, float[][] x, float[][] y) {
       checkArrays(x,y);
       if (sameArrays(x,y))
         x = copy(x);
@@ -18,6 +18,7 @@ import java.util.HashMap;
 
 import static edu.mines.jtk.util.ArrayMath.*;
 import edu.mines.jtk.util.Check;
+import edu.mines.jtk.util.Parallel;
 
 /**
  * A sinc interpolator for bandlimited uniformly-sampled functions y(x). 
@@ -264,6 +265,100 @@ public class SincInterp {
     }
   }
 
+  /**
+   * Interpolates multiple real values y(x) for multiple sequences. All
+   * sequences have the same input sampling and are interpolated at the
+   * same x values, so that sample indices and interpolation coefficients
+   * are computed only once. Sequences are interpolated in parallel.
+   * @param nxu number of input samples.
+   * @param dxu input sampling interval.
+   * @param fxu first input sampled x value.
+   * @param yu input array[n2][nxu] of sampled values y(x).
+   * @param nxi number of output samples.
+   * @param xi input array of x values at which to interpolate.
+   * @param yi output array[n2][nxi] of interpolated values y(x).
+   */
+  public void interpolate(
+    int nxu, double dxu, double fxu, float[][] yu,
+    int nxi, float[] xi, float[][] yi)
+  {
+    int[] kyu = new int[nxi];
+    int[] ksinc = new int[nxi];
+    indices(dxu,fxu,nxi,xi,0.0,0.0,kyu,ksinc);
+    interpolate(nxu,kyu,ksinc,yu,yi);
+  }
+
+  /**
+   * Interpolates multiple real values y(x) for multiple sequences. All
+   * sequences have the same input and output samplings, so that sample
+   * indices and interpolation coefficients are computed only once.
+   * Sequences are interpolated in parallel.
+   * @param nxu number of input samples.
+   * @param dxu input sampling interval.
+   * @param fxu first input sampled x value.
+   * @param yu input array[n2][nxu] of sampled values y(x).
+   * @param nxi number of output samples.
+   * @param dxi output sampling interval.
+   * @param fxi first output sampled x value.
+   * @param yi output array[n2][nxi] of interpolated values y(x).
+   */
+  public void interpolate(
+    int nxu, double dxu, double fxu, float[][] yu,
+    int nxi, double dxi, double fxi, float[][] yi)
+  {
+    int[] kyu = new int[nxi];
+    int[] ksinc = new int[nxi];
+    indices(dxu,fxu,nxi,null,dxi,fxi,kyu,ksinc);
+    interpolate(nxu,kyu,ksinc,yu,yi);
+  }
+
+  /**
+   * Interpolates multiple real values y(x) for multiple sequences. All
+   * sequences have the same input sampling and are interpolated at the
+   * same x values, so that sample indices and interpolation coefficients
+   * are computed only once. Sequences are interpolated in parallel.
+   * @param nxu number of input samples.
+   * @param dxu input sampling interval.
+   * @param fxu first input sampled x value.
+   * @param yu input array[n3][n2][nxu] of sampled values y(x).
+   * @param nxi number of output samples.
+   * @param xi input array of x values at which to interpolate.
+   * @param yi output array[n3][n2][nxi] of interpolated values y(x).
+   */
+  public void interpolate(
+    int nxu, double dxu, double fxu, float[][][] yu,
+    int nxi, float[] xi, float[][][] yi)
+  {
+    int[] kyu = new int[nxi];
+    int[] ksinc = new int[nxi];
+    indices(dxu,fxu,nxi,xi,0.0,0.0,kyu,ksinc);
+    interpolate(nxu,kyu,ksinc,yu,yi);
+  }
+
+  /**
+   * Interpolates multiple real values y(x) for multiple sequences. All
+   * sequences have the same input and output samplings, so that sample
+   * indices and interpolation coefficients are computed only once.
+   * Sequences are interpolated in parallel.
+   * @param nxu number of input samples.
+   * @param dxu input sampling interval.
+   * @param fxu first input sampled x value.
+   * @param yu input array[n3][n2][nxu] of sampled values y(x).
+   * @param nxi number of output samples.
+   * @param dxi output sampling interval.
+   * @param fxi first output sampled x value.
+   * @param yi output array[n3][n2][nxi] of interpolated values y(x).
+   */
+  public void interpolate(
+    int nxu, double dxu, double fxu, float[][][] yu,
+    int nxi, double dxi, double fxi, float[][][] yi)
+  {
+    int[] kyu = new int[nxi];
+    int[] ksinc = new int[nxi];
+    indices(dxu,fxu,nxi,null,dxi,fxi,kyu,ksinc);
+    interpolate(nxu,kyu,ksinc,yu,yi);
+  }
+
   /**
    * Interpolates one real value y(x1,x2).
    * @param nx1u number of input samples in 1st dimension.
@@ -373,6 +468,48 @@ public class SincInterp {
     }
   }
 
+  /**
+   * Interpolates multiple real values y(x) for multiple sequences.
+   * All sequences have the same input and output samplings.
+   * @param sxu sampling of input samples.
+   * @param yu input array[n2][] of uniformly sampled values y(x).
+   * @param sxi sampling of output samples.
+   * @param yi output array[n2][] of interpolated values y(x).
+   */
+  public void interpolate(
+    Sampling sxu, float[][] yu,
+    Sampling sxi, float[][] yi)
+  {
+    Check.argument(sxu.isUniform(),"input sampling is uniform");
+    int nxu = sxu.getCount();
+    int nxi = sxi.getCount();
+    int[] kyu = new int[nxi];
+    int[] ksinc = new int[nxi];
+    indices(sxu.getDelta(),sxu.getFirst(),sxi,kyu,ksinc);
+    interpolate(nxu,kyu,ksinc,yu,yi);
+  }
+
+  /**
+   * Interpolates multiple real values y(x) for multiple sequences.
+   * All sequences have the same input and output samplings.
+   * @param sxu sampling of input samples.
+   * @param yu input array[n3][n2][] of uniformly sampled values y(x).
+   * @param sxi sampling of output samples.
+   * @param yi output array[n3][n2][] of interpolated values y(x).
+   */
+  public void interpolate(
+    Sampling sxu, float[][][] yu,
+    Sampling sxi, float[][][] yi)
+  {
+    Check.argument(sxu.isUniform(),"input sampling is uniform");
+    int nxu = sxu.getCount();
+    int nxi = sxi.getCount();
+    int[] kyu = new int[nxi];
+    int[] ksinc = new int[nxi];
+    indices(sxu.getDelta(),sxu.getFirst(),sxi,kyu,ksinc);
+    interpolate(nxu,kyu,ksinc,yu,yi);
+  }
+
   /**
    * Interpolates one real value y(x1,x2).
    * @param sx1u sampling of input x in 1st dimension.
@@ -816,6 +953,112 @@ public class SincInterp {
     return yr;
   }
 
+  /**
+   * Computes indices of first uniform samples and of sinc approximations
+   * for the specified x values, or, if xi is null, for nxi uniformly
+   * sampled x values.
+   */
+  private void indices(
+    double dxu, double fxu,
+    int nxi, float[] xi, double dxi, double fxi,
+    int[] kyu, int[] ksinc)
+  {
+    double xscale = 1.0/dxu;
+    double xshift = _lsinc-fxu*xscale;
+    for (int ixi=0; ixi<nxi; ++ixi) {
+      double x = (xi!=null)?xi[ixi]:fxi+ixi*dxi;
+      index(xscale,xshift,x,ixi,kyu,ksinc);
+    }
+  }
+  private void indices(
+    double dxu, double fxu, Sampling sxi,
+    int[] kyu, int[] ksinc)
+  {
+    double xscale = 1.0/dxu;
+    double xshift = _lsinc-fxu*xscale;
+    int nxi = sxi.getCount();
+    for (int ixi=0; ixi<nxi; ++ixi)
+      index(xscale,xshift,sxi.getValue(ixi),ixi,kyu,ksinc);
+  }
+  private void index(
+    double xscale, double xshift, double x,
+    int ixi, int[] kyu, int[] ksinc)
+  {
+    double xn = xshift+x*xscale;
+    int ixn = (int)xn;
+    double frac = xn-ixn;
+    if (frac<0.0)
+      frac += 1.0;
+    kyu[ixi] = _ishift+ixn;
+    ksinc[ixi] = (int)(frac*_nsincm1+0.5);
+  }
+
+  /**
+   * Interpolates one sequence for precomputed indices. Samples that
+   * require no extrapolation are computed in a loop with no tests.
+   */
+  private void interpolate(
+    int nxu, int[] kyu, int[] ksinc, float[] yu, float[] yi)
+  {
+    int nxi = kyu.length;
+    int nxum = nxu-_lsinc;
+    int lsinc = _lsinc;
+    for (int ixi=0; ixi<nxi; ++ixi) {
+      int k = kyu[ixi];
+      float[] asinc = _asinc[ksinc[ixi]];
+      if (k>=0 && k<=nxum) {
+        float yr = 0.0f;
+        for (int isinc=0; isinc<lsinc; ++isinc)
+          yr += yu[k+isinc]*asinc[isinc];
+        yi[ixi] = yr;
+      } else {
+        yi[ixi] = extrapolate(nxu,k,asinc,yu);
+      }
+    }
+  }
+  private void interpolate(
+    final int nxu, final int[] kyu, final int[] ksinc,
+    final float[][] yu, final float[][] yi)
+  {
+    int n2 = yu.length;
+    Parallel.loop(n2,new Parallel.LoopInt() {
+    public void compute(int i2) {
+      interpolate(nxu,kyu,ksinc,yu[i2],yi[i2]);
+    }});
+  }
+  private void interpolate(
+    final int nxu, final int[] kyu, final int[] ksinc,
+    final float[][][] yu, final float[][][] yi)
+  {
+    int n3 = yu.length;
+    Parallel.loop(n3,new Parallel.LoopInt() {
+    public void compute(int i3) {
+      int n2 = yu[i3].length;
+      for (int i2=0; i2<n2; ++i2)
+        interpolate(nxu,kyu,ksinc,yu[i3][i2],yi[i3][i2]);
+    }});
+  }
+
+  /**
+   * Interpolates one value, beginning with the uniform sample with
+   * index kyu, extrapolating uniform samples as necessary.
+   */
+  private float extrapolate(int nxu, int kyu, float[] asinc, float[] yu) {
+    float yr = 0.0f;
+    if (_extrap==Extrapolation.ZERO) {
+      for (int isinc=0; isinc<_lsinc; ++isinc,++kyu) {
+        if (0<=kyu && kyu<nxu)
+          yr += yu[kyu]*asinc[isinc];
+      }
+    } else if (_extrap==Extrapolation.CONSTANT) {
+      for (int isinc=0; isinc<_lsinc; ++isinc,++kyu) {
+        int jyu = (kyu<0)?0:(nxu<=kyu)?nxu-1:kyu;
+        yr += yu[jyu]*asinc[isinc];
+      }
+    }
+    return yr;
+  }
+
   private void shift(
     int nxu, double dxu, double fxu, float[] yu,
     int nxi,             double fxi, float[] yi)
@@ -951,7 +1194,7 @@ public class SincInterp {
       }
     } else if (_extrap==Extrapolation.CONSTANT) {
       for (int i2sinc=0; i2sinc<_lsinc; ++i2sinc,++ky2u) {
-        int jy2u = (ky2u<0)?0:(nx2u<=ky2u)?nx2u-2:ky2u;
+        int jy2u = (ky2u<0)?0:(nx2u<=ky2u)?nx2u-1:ky2u;
         for (int i1sinc=0,my1u=ky1u; i1sinc<_lsinc; ++i1sinc,++my1u) {
           int jy1u = (my1u<0)?0:(nx1u<=my1u)?nx1u-1:my1u;
           yr += yu[jy2u][jy1u]*asinc2[i2sinc]*asinc1[i1sinc];
@@ -1033,9 +1276,9 @@ public class SincInterp {
       }
     } else if (_extrap==Extrapolation.CONSTANT) {
       for (int i3sinc=0; i3sinc<_lsinc; ++i3sinc,++ky3u) {
-        int jy3u = (ky3u<0)?0:(nx3u<=ky3u)?nx3u-2:ky3u;
+        int jy3u = (ky3u<0)?0:(nx3u<=ky3u)?nx3u-1:ky3u;
         for (int i2sinc=0,my2u=ky2u; i2sinc<_lsinc; ++i2sinc,++my2u) {
-          int jy2u = (my2u<0)?0:(nx2u<=my2u)?nx2u-2:my2u;
+          int jy2u = (my2u<0)?0:(nx2u<=my2u)?nx2u-1:my2u;
           for (int i1sinc=0,my1u=ky1u; i1sinc<_lsinc; ++i1sinc,++my1u) {
             int jy1u = (my1u<0)?0:(nx1u<=my1u)?nx1u-1:my1u;
             yr += yu[jy3u][jy2u][jy1u] *
@@ -72,7 +72,8 @@ public class SibsonGridder2 extends SibsonInterpolator2 implements Gridder2 {
    * Computes gridded sample values from the known sample values.
    * Before interpolating, this method sets the bounds to be consistent 
    * with the first and last values of the specified samplings, so that
-   * interpolated values will never be null.
+   * interpolated values will never be null. Gridded values are computed
+   * in parallel.
    * @param s1 sampling of x1.
    * @param s2 sampling of x2.
    * @return array of gridded sample values.
@@ -74,7 +74,8 @@ public class SibsonGridder3 extends SibsonInterpolator3 implements Gridder3 {
    * Computes gridded sample values from the known sample values.
    * Before interpolating, this method sets the bounds to be consistent 
    * with the first and last values of the specified samplings, so that
-   * interpolated values will never be null.
+   * interpolated values will never be null. Gridded values are computed
+   * in parallel.
    * @param s1 sampling of x1.
    * @param s2 sampling of x2.
    * @param s3 sampling of x3.
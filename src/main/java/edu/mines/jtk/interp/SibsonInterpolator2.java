@@ -15,6 +15,7 @@ limitations under the License.
 package edu.mines.jtk.interp;
 
 import java.util.ArrayList;
+import java.util.Arrays;
 
 import edu.mines.jtk.dsp.Sampling;
 import edu.mines.jtk.la.DMatrix;
@@ -22,6 +23,7 @@ import edu.mines.jtk.la.DMatrixQrd;
 import edu.mines.jtk.mesh.Geometry;
 import edu.mines.jtk.mesh.TriMesh;
 import edu.mines.jtk.util.Check;
+import edu.mines.jtk.util.Parallel;
 
 /**
  * Sibson interpolation of scattered samples of 2D functions f(x1,x2).
@@ -189,16 +191,9 @@ public class SibsonInterpolator2 {
   public SibsonInterpolator2(
     Method method, float[] f, float[] x1, float[] x2) 
   {
+    _method = method;
+    _query = new Query(method);
     makeMesh(f,x1,x2);
-    _nodeList = new TriMesh.NodeList();
-    _triList = new TriMesh.TriList();
-    if (method==Method.WATSON_SAMBRIDGE) {
-      _va = new WatsonSambridge();
-    } else if (method==Method.BRAUN_SAMBRIDGE) {
-      _va = new BraunSambridge();
-    } else if (method==Method.HALE_LIANG) {
-      _va = new HaleLiang();
-    }
   }
 
   /**
@@ -338,16 +333,34 @@ public class SibsonInterpolator2 {
    * @return the interpolated value.
    */
   public float interpolate(float x1, float x2) {
-    if (!inBounds(x1,x2))
-      return _fnull;
-    double asum = computeAreas(x1,x2);
-    if (asum<=0.0)
-      return _fnull;
-    if (usingGradients()) {
-      return interpolate1(asum,x1,x2);
-    } else {
-      return interpolate0(asum);
-    }
+    return interpolate(_query,x1,x2);
+  }
+
+  /**
+   * Returns an array of values interpolated at specified points.
+   * Points are interpolated in parallel, in chunks of consecutive points,
+   * so that this method is most efficient when consecutive points are 
+   * near one another.
+   * @param x1 array of x1 coordinates of the points.
+   * @param x2 array of x2 coordinates of the points.
+   * @return array of interpolated values.
+   */
+  public float[] interpolate(final float[] x1, final float[] x2) {
+    final int n = x1.length;
+    final float[] f = new float[n];
+    if (n==0)
+      return f;
+    final int nc = 1+(n-1)/CHUNK;
+    final Parallel.Unsafe<Query> qu = new Parallel.Unsafe<Query>();
+    Parallel.loop(nc,new Parallel.LoopInt() {
+    public void compute(int ic) {
+      Query q = query(qu);
+      int jlo = ic*CHUNK;
+      int jhi = Math.min(jlo+CHUNK,n);
+      for (int j=jlo; j<jhi; ++j)
+        f[j] = interpolate(q,x1[j],x2[j]);
+    }});
+    return f;
   }
 
   /**
@@ -356,17 +369,20 @@ public class SibsonInterpolator2 {
    * @param s2 the sampling of n2 x2 coordinates.
    * @return array[n2][n1] of interpolated values.
    */
-  public float[][] interpolate(Sampling s1, Sampling s2) {
-    int n1 = s1.getCount();
-    int n2 = s2.getCount();
-    float[][] f = new float[n2][n1];
-    for (int i2=0; i2<n2; ++i2) {
+  public float[][] interpolate(final Sampling s1, final Sampling s2) {
+    final int n1 = s1.getCount();
+    final int n2 = s2.getCount();
+    final float[][] f = new float[n2][n1];
+    final Parallel.Unsafe<Query> qu = new Parallel.Unsafe<Query>();
+    Parallel.loop(n2,new Parallel.LoopInt() {
+    public void compute(int i2) {
+      Query q = query(qu);
       float x2 = (float)s2.getValue(i2);
       for (int i1=0; i1<n1; ++i1) {
         float x1 = (float)s1.getValue(i1);
-        f[i2][i1] = interpolate(x1,x2);
+        f[i2][i1] = interpolate(q,x1,x2);
       }
-    }
+    }});
     return f;
   }
 
@@ -385,21 +401,34 @@ public class SibsonInterpolator2 {
    * @return array of sample indices and weights; null if none.
    */
   public IndexWeight[] getIndexWeights(float x1, float x2) {
-    if (!inBounds(x1,x2))
-      return null;
-    float wsum = (float)computeAreas(x1,x2);
-    if (wsum==0.0f)
-      return null;
-    float wscl = 1.0f/wsum;
-    int nnode = _nodeList.nnode();
-    TriMesh.Node[] nodes = _nodeList.nodes();
-    IndexWeight[] iw = new IndexWeight[nnode];
-    for (int inode=0; inode<nnode; ++inode) {
-      TriMesh.Node node = nodes[inode];
-      int i = node.index;
-      float w = (float)area(node)*wscl;
-      iw[inode] = new IndexWeight(i,w);
-    }
+    return getIndexWeights(_query,x1,x2);
+  }
+
+  /**
+   * Gets sample indices and interpolation weights for specified points.
+   * Points are processed in parallel, in chunks of consecutive points,
+   * so that this method is most efficient when consecutive points are 
+   * near one another.
+   * @param x1 array of x1 coordinates of the points.
+   * @param x2 array of x2 coordinates of the points.
+   * @return array of arrays of sample indices and weights, one array for
+   *  each point; null for any point that has no indices and weights.
+   */
+  public IndexWeight[][] getIndexWeights(final float[] x1, final float[] x2) {
+    final int n = x1.length;
+    final IndexWeight[][] iw = new IndexWeight[n][];
+    if (n==0)
+      return iw;
+    final int nc = 1+(n-1)/CHUNK;
+    final Parallel.Unsafe<Query> qu = new Parallel.Unsafe<Query>();
+    Parallel.loop(nc,new Parallel.LoopInt() {
+    public void compute(int ic) {
+      Query q = query(qu);
+      int jlo = ic*CHUNK;
+      int jhi = Math.min(jlo+CHUNK,n);
+      for (int j=jlo; j<jhi; ++j)
+        iw[j] = getIndexWeights(q,x1[j],x2[j]);
+    }});
     return iw;
   }
 
@@ -459,7 +488,6 @@ public class SibsonInterpolator2 {
   // Data associated with all nodes in the tri mesh.
   private static class NodeData {
     float f,gx,gy; // function values and gradient
-    double area; // area for Sibson weight
   }
   private static NodeData data(TriMesh.Node node) {
     return (NodeData)node.data;
@@ -473,18 +501,14 @@ public class SibsonInterpolator2 {
   private static float gy(TriMesh.Node node) {
     return data(node).gy;
   }
-  private static double area(TriMesh.Node node) {
-    return data(node).area;
-  }
   private static boolean ghost(TriMesh.Node node) {
     return node.index<0;
   }
 
   private TriMesh _mesh; // the mesh
   private TriMesh.Node[] _nodes; // array of real (not ghost) nodes
-  private TriMesh.NodeList _nodeList; // list of natural neighbor nodes
-  private TriMesh.TriList _triList; // list of natural neighbor tris
-  private AreaAccumulator _va; // accumulates Sibson's areas
+  private Method _method; // method used to accumulate Sibson's areas
+  private Query _query; // for queries of one point at a time
   private boolean _haveGradients; // true if mesh nodes have gradients
   private double _gradientPower; // power of gradients
   private float _fnull; // returned when interpolation point out of bounds
@@ -638,12 +662,140 @@ public class SibsonInterpolator2 {
       _mesh.removeNode(gnode);
   }
 
+  // Number of consecutive points processed together in parallel queries.
+  private static final int CHUNK = 256;
+
+  // Workspace for queries of natural neighbors and their Sibson areas.
+  // Nodes and tris are marked in this workspace, not in the mesh, and 
+  // the mesh is not otherwise modified by queries. Therefore, threads
+  // may perform queries in parallel, if each has its own workspace.
+  private static class Query {
+    TriMesh.NodeList nodeList = new TriMesh.NodeList(); // natural nabors
+    TriMesh.TriList triList = new TriMesh.TriList(); // their tris
+    MarkMap marks = new MarkMap(); // marked nodes and tris
+    double[] areas = new double[32]; // areas of nodes in node list
+    AreaAccumulator va; // accumulates Sibson's areas
+    TriMesh.Tri tri; // tri in which the last point was located; or null
+    long version; // version of mesh when that tri was located
+    Query(Method method) {
+      if (method==Method.WATSON_SAMBRIDGE) {
+        va = new WatsonSambridge();
+      } else if (method==Method.BRAUN_SAMBRIDGE) {
+        va = new BraunSambridge();
+      } else if (method==Method.HALE_LIANG) {
+        va = new HaleLiang();
+      }
+      va._query = this;
+    }
+    boolean isMarked(Object o) {
+      return marks.get(o)>=0;
+    }
+  }
+
+  // Returns the workspace for the current thread, constructing it if 
+  // necessary.
+  private Query query(Parallel.Unsafe<Query> qu) {
+    Query q = qu.get();
+    if (q==null) qu.set(q=new Query(_method));
+    return q;
+  }
+
+  // Maps nodes and tris (compared by identity) to non-negative integers.
+  // Entries are removed by incrementing a stamp, so that clearing is
+  // cheap; the arrays of entries grow as necessary but never shrink.
+  private static class MarkMap {
+    int get(Object key) {
+      int mask = _keys.length-1;
+      for (int i=hash(key)&mask; _stamps[i]==_stamp; i=(i+1)&mask) {
+        if (_keys[i]==key)
+          return _values[i];
+      }
+      return -1;
+    }
+    void put(Object key, int value) { // key must not already be in map
+      if (2*(_n+1)>_keys.length)
+        grow();
+      int mask = _keys.length-1;
+      int i = hash(key)&mask;
+      while (_stamps[i]==_stamp)
+        i = (i+1)&mask;
+      _keys[i] = key;
+      _values[i] = value;
+      _stamps[i] = _stamp;
+      ++_n;
+    }
+    void clear() {
+      _n = 0;
+      if (++_stamp==Integer.MAX_VALUE) { // rarely!
+        Arrays.fill(_stamps,0);
+        _stamp = 1;
+      }
+    }
+    private int _n;
+    private int _stamp = 1;
+    private Object[] _keys = new Object[128];
+    private int[] _values = new int[128];
+    private int[] _stamps = new int[128];
+    private static int hash(Object key) {
+      int h = System.identityHashCode(key);
+      return h^(h>>>16);
+    }
+    private void grow() {
+      Object[] keys = _keys;
+      int[] values = _values;
+      int[] stamps = _stamps;
+      int n = keys.length;
+      _keys = new Object[2*n];
+      _values = new int[2*n];
+      _stamps = new int[2*n];
+      _n = 0;
+      for (int i=0; i<n; ++i) {
+        if (stamps[i]==_stamp)
+          put(keys[i],values[i]);
+      }
+    }
+  }
+
+  // Returns a value interpolated at point (x1,x2) using a workspace.
+  private float interpolate(Query q, float x1, float x2) {
+    if (!inBounds(x1,x2))
+      return _fnull;
+    double asum = computeAreas(q,x1,x2);
+    if (asum<=0.0)
+      return _fnull;
+    if (usingGradients()) {
+      return interpolate1(q,asum,x1,x2);
+    } else {
+      return interpolate0(q,asum);
+    }
+  }
+
+  // Returns indices and weights for point (x1,x2) using a workspace.
+  private IndexWeight[] getIndexWeights(Query q, float x1, float x2) {
+    if (!inBounds(x1,x2))
+      return null;
+    float wsum = (float)computeAreas(q,x1,x2);
+    if (wsum==0.0f)
+      return null;
+    float wscl = 1.0f/wsum;
+    int nnode = q.nodeList.nnode();
+    TriMesh.Node[] nodes = q.nodeList.nodes();
+    IndexWeight[] iw = new IndexWeight[nnode];
+    for (int inode=0; inode<nnode; ++inode) {
+      TriMesh.Node node = nodes[inode];
+      int i = node.index;
+      float w = (float)q.areas[inode]*wscl;
+      iw[inode] = new IndexWeight(i,w);
+    }
+    return iw;
+  }
+
   // Computes Sibson areas for the specified point (x,y).
   // Returns true, if successful; false, otherwise.
-  private double computeAreas(float x, float y) {
-    if (!getNaturalNabors(x,y))
+  private double computeAreas(Query q, float x, float y) {
+    if (!getNaturalNabors(q,x,y))
       return 0.0;
-    return _va.accumulateAreas(x,y,_mesh,_nodeList,_triList);
+    return q.va.accumulateAreas(x,y,_mesh,q.nodeList,q.triList);
   }
 
   // Returns true if not using bounding box or if point is inside the box.
@@ -653,45 +805,58 @@ public class SibsonInterpolator2 {
            _x2bmn<=x2 && x2<=_x2bmx;
   }
 
+  // Locates the point (x,y), beginning with the tri in which the
+  // last point was located, if the mesh has not changed since then.
+  private TriMesh.PointLocation locatePoint(Query q, float x, float y) {
+    long version = _mesh.getVersion();
+    TriMesh.PointLocation pl = (q.tri!=null && q.version==version) ?
+      _mesh.locatePoint(q.tri,x,y) :
+      _mesh.locatePoint(x,y);
+    q.tri = pl.tri();
+    q.version = version;
+    return pl;
+  }
+
   // Gets lists of natural neighbor nodes and tris of point (x,y).
   // Before building the lists, node and tri marks are cleared. Then,
   // as nodes and tris are added to the lists, they are marked, and 
   // node areas are initialized to zero.
   // Returns true, if the lists are not empty; false, otherwise.
-  private boolean getNaturalNabors(float x, float y) {
-    _mesh.clearNodeMarks();
-    _mesh.clearTriMarks();
-    _nodeList.clear();
-    _triList.clear();
-    TriMesh.PointLocation pl = _mesh.locatePoint(x,y);
+  private boolean getNaturalNabors(Query q, float x, float y) {
+    q.marks.clear();
+    q.nodeList.clear();
+    q.triList.clear();
+    TriMesh.PointLocation pl = locatePoint(q,x,y);
     if (pl.isOutside())
       return false;
-    addTri(x,y,pl.tri());
+    addTri(q,x,y,pl.tri());
     return true;
   }
-  private void addTri(double xp, double yp, TriMesh.Tri tri) {
-    _mesh.mark(tri);
-    _triList.add(tri);
-    addNode(tri.nodeA());
-    addNode(tri.nodeB());
-    addNode(tri.nodeC());
+  private void addTri(Query q, double xp, double yp, TriMesh.Tri tri) {
+    q.marks.put(tri,0);
+    q.triList.add(tri);
+    addNode(q,tri.nodeA());
+    addNode(q,tri.nodeB());
+    addNode(q,tri.nodeC());
     TriMesh.Tri ta = tri.triA();
     TriMesh.Tri tb = tri.triB();
     TriMesh.Tri tc = tri.triC();
-    if (needTri(xp,yp,ta)) addTri(xp,yp,ta);
-    if (needTri(xp,yp,tb)) addTri(xp,yp,tb);
-    if (needTri(xp,yp,tc)) addTri(xp,yp,tc);
+    if (needTri(q,xp,yp,ta)) addTri(q,xp,yp,ta);
+    if (needTri(q,xp,yp,tb)) addTri(q,xp,yp,tb);
+    if (needTri(q,xp,yp,tc)) addTri(q,xp,yp,tc);
   }
-  private void addNode(TriMesh.Node node) {
-    if (_mesh.isMarked(node))
+  private void addNode(Query q, TriMesh.Node node) {
+    if (q.isMarked(node))
       return;
-    _mesh.mark(node);
-    _nodeList.add(node);
-    NodeData data = data(node);
-    data.area = 0.0;
+    int inode = q.nodeList.nnode();
+    q.marks.put(node,inode);
+    q.nodeList.add(node);
+    if (inode==q.areas.length)
+      q.areas = Arrays.copyOf(q.areas,2*inode);
+    q.areas[inode] = 0.0;
   }
-  private boolean needTri(double xp, double yp, TriMesh.Tri tri) {
-    if (tri==null || _mesh.isMarked(tri))
+  private boolean needTri(Query q, double xp, double yp, TriMesh.Tri tri) {
+    if (tri==null || q.isMarked(tri))
       return false;
     TriMesh.Node na = tri.nodeA();
     TriMesh.Node nb = tri.nodeB();
@@ -703,23 +868,23 @@ public class SibsonInterpolator2 {
   }
 
   // C0 interpolation; does not use gradients.
-  private float interpolate0(double asum) {
+  private float interpolate0(Query q, double asum) {
     double afsum = 0.0;
-    int nnode = _nodeList.nnode();
-    TriMesh.Node[] nodes = _nodeList.nodes();
+    int nnode = q.nodeList.nnode();
+    TriMesh.Node[] nodes = q.nodeList.nodes();
     for (int inode=0; inode<nnode; ++inode) {
       TriMesh.Node node = nodes[inode];
       float f = f(node);
-      double a = area(node);
+      double a = q.areas[inode];
       afsum += a*f;
     }
     return (float)(afsum/asum);
   }
 
   // C1 interpolation; uses gradients.
-  private float interpolate1(double asum, double x, double y) {
-    int nnode = _nodeList.nnode();
-    TriMesh.Node[] nodes = _nodeList.nodes();
+  private float interpolate1(Query q, double asum, double x, double y) {
+    int nnode = q.nodeList.nnode();
+    TriMesh.Node[] nodes = q.nodeList.nodes();
     double fs = 0.0;
     double es = 0.0;
     double wds = 0.0;
@@ -730,7 +895,7 @@ public class SibsonInterpolator2 {
       double f = f(n);
       double gx = gx(n);
       double gy = gy(n);
-      double a = area(n);
+      double a = q.areas[inode];
       double w = a/asum;
       double xn = n.xp();
       double yn = n.yp();
@@ -777,11 +942,11 @@ public class SibsonInterpolator2 {
     double xn = n.xp();
     double yn = n.yp();
     _mesh.removeNode(n);
-    double asum = computeAreas((float)xn,(float)yn);
+    double asum = computeAreas(_query,(float)xn,(float)yn);
     _mesh.addNode(n);
     if (asum>0.0) {
-      int nm = _nodeList.nnode();
-      TriMesh.Node[] ms = _nodeList.nodes();
+      int nm = _query.nodeList.nnode();
+      TriMesh.Node[] ms = _query.nodeList.nodes();
       double hxx = 0.0, hxy = 0.0, hyy = 0.0;
       double px = 0.0, py = 0.0;
       double nr = 0; // number of real (not ghost) natural neighbor nodes
@@ -789,7 +954,7 @@ public class SibsonInterpolator2 {
         TriMesh.Node m = ms[im];
         if (!ghost(m)) {
           double fm = f(m);
-          double wm = area(m);
+          double wm = _query.areas[im];
           double xm = m.xp();
           double ym = m.yp();
           double df = fn-fm;
@@ -837,11 +1002,14 @@ public class SibsonInterpolator2 {
     }
     protected void accumulate(TriMesh.Node node, double area) {
       if (ghost(node)) return; // ignore ghost nodes!
-      NodeData data = data(node);
-      data.area += area;
+      _query.areas[_query.marks.get(node)] += area;
       _sum += area;
     }
+    protected boolean isMarked(TriMesh.Tri tri) {
+      return _query.isMarked(tri);
+    }
     private double _sum;
+    private Query _query; // workspace with areas being accumulated
   }
  
   ///////////////////////////////////////////////////////////////////////////
@@ -1003,7 +1171,7 @@ public class SibsonInterpolator2 {
       TriMesh.Node nb, TriMesh.Node nc)
     {
       boolean saveEdge = true;
-      if (ta!=null && mesh.isMarked(ta)) {
+      if (ta!=null && isMarked(ta)) {
         ta.centerCircle(_xy);
         double xa = _xy[0]-xp;
         double ya = _xy[1]-yp;
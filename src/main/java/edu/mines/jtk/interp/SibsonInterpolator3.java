@@ -15,6 +15,7 @@ limitations under the License.
 package edu.mines.jtk.interp;
 
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.logging.Logger;
 
 import edu.mines.jtk.dsp.Sampling;
@@ -23,6 +24,7 @@ import edu.mines.jtk.la.DMatrixQrd;
 import edu.mines.jtk.mesh.Geometry;
 import edu.mines.jtk.mesh.TetMesh;
 import edu.mines.jtk.util.Check;
+import edu.mines.jtk.util.Parallel;
 
 /**
  * Sibson interpolation of scattered samples of 3D functions f(x1,x2,x3).
@@ -191,16 +193,9 @@ public class SibsonInterpolator3 {
   public SibsonInterpolator3(
     Method method, float[] f, float[] x1, float[] x2, float[] x3) 
   {
+    _method = method;
+    _query = new Query(method);
     makeMesh(f,x1,x2,x3);
-    _nodeList = new TetMesh.NodeList();
-    _tetList = new TetMesh.TetList();
-    if (method==Method.WATSON_SAMBRIDGE) {
-      _va = new WatsonSambridge();
-    } else if (method==Method.BRAUN_SAMBRIDGE) {
-      _va = new BraunSambridge();
-    } else if (method==Method.HALE_LIANG) {
-      _va = new HaleLiang();
-    }
   }
 
   /**
@@ -360,16 +355,37 @@ public class SibsonInterpolator3 {
    * @return the interpolated value.
    */
   public float interpolate(float x1, float x2, float x3) {
-    if (!inBounds(x1,x2,x3))
-      return _fnull;
-    double vsum = computeVolumes(x1,x2,x3);
-    if (vsum<=0.0)
-      return _fnull;
-    if (usingGradients()) {
-      return interpolate1(vsum,x1,x2,x3);
-    } else {
-      return interpolate0(vsum);
-    }
+    return interpolate(_query,x1,x2,x3);
+  }
+
+  /**
+   * Returns an array of values interpolated at specified points.
+   * Points are interpolated in parallel, in chunks of consecutive points,
+   * so that this method is most efficient when consecutive points are 
+   * near one another.
+   * @param x1 array of x1 coordinates of the points.
+   * @param x2 array of x2 coordinates of the points.
+   * @param x3 array of x3 coordinates of the points.
+   * @return array of interpolated values.
+   */
+  public float[] interpolate(
+    final float[] x1, final float[] x2, final float[] x3) 
+  {
+    final int n = x1.length;
+    final float[] f = new float[n];
+    if (n==0)
+      return f;
+    final int nc = 1+(n-1)/CHUNK;
+    final Parallel.Unsafe<Query> qu = new Parallel.Unsafe<Query>();
+    Parallel.loop(nc,new Parallel.LoopInt() {
+    public void compute(int ic) {
+      Query q = query(qu);
+      int jlo = ic*CHUNK;
+      int jhi = Math.min(jlo+CHUNK,n);
+      for (int j=jlo; j<jhi; ++j)
+        f[j] = interpolate(q,x1[j],x2[j],x3[j]);
+    }});
+    return f;
   }
 
   /**
@@ -379,24 +395,26 @@ public class SibsonInterpolator3 {
    * @param s3 the sampling of n3 x3 coordinates.
    * @return array[n3][n2][n1] of interpolated values.
    */
-  public float[][][] interpolate(Sampling s1, Sampling s2, Sampling s3) {
+  public float[][][] interpolate(
+    final Sampling s1, final Sampling s2, final Sampling s3) 
+  {
     log.fine("interpolate: begin");
-    int n1 = s1.getCount();
-    int n2 = s2.getCount();
-    int n3 = s2.getCount();
-    float[][][] f = new float[n3][n2][n1];
-    for (int i3=0; i3<n3; ++i3) {
-      log.fine("interpolate: i3="+i3);
+    final int n1 = s1.getCount();
+    final int n2 = s2.getCount();
+    final int n3 = s3.getCount();
+    final float[][][] f = new float[n3][n2][n1];
+    final Parallel.Unsafe<Query> qu = new Parallel.Unsafe<Query>();
+    Parallel.loop2(n2,n3,new Parallel.LoopInt2() {
+    public void compute(int i2, int i3) {
+      Query q = query(qu);
+      float x2 = (float)s2.getValue(i2);
       float x3 = (float)s3.getValue(i3);
-      for (int i2=0; i2<n2; ++i2) {
-        log.finer("interpolate: i2="+i2);
-        float x2 = (float)s2.getValue(i2);
-        for (int i1=0; i1<n1; ++i1) {
-          float x1 = (float)s1.getValue(i1);
-          f[i3][i2][i1] = interpolate(x1,x2,x3);
-        }
+      float[] f32 = f[i3][i2];
+      for (int i1=0; i1<n1; ++i1) {
+        float x1 = (float)s1.getValue(i1);
+        f32[i1] = interpolate(q,x1,x2,x3);
       }
-    }
+    }});
     log.fine("interpolate: end");
     return f;
   }
@@ -417,21 +435,37 @@ public class SibsonInterpolator3 {
    * @return array of sample indices and weights; null if none.
    */
   public IndexWeight[] getIndexWeights(float x1, float x2, float x3) {
-    if (!inBounds(x1,x2,x3))
-      return null;
-    float wsum = (float)computeVolumes(x1,x2,x3);
-    if (wsum==0.0f)
-      return null;
-    float wscl = 1.0f/wsum;
-    int nnode = _nodeList.nnode();
-    TetMesh.Node[] nodes = _nodeList.nodes();
-    IndexWeight[] iw = new IndexWeight[nnode];
-    for (int inode=0; inode<nnode; ++inode) {
-      TetMesh.Node node = nodes[inode];
-      int i = node.index;
-      float w = (float)volume(node)*wscl;
-      iw[inode] = new IndexWeight(i,w);
-    }
+    return getIndexWeights(_query,x1,x2,x3);
+  }
+
+  /**
+   * Gets sample indices and interpolation weights for specified points.
+   * Points are processed in parallel, in chunks of consecutive points,
+   * so that this method is most efficient when consecutive points are 
+   * near one another.
+   * @param x1 array of x1 coordinates of the points.
+   * @param x2 array of x2 coordinates of the points.
+   * @param x3 array of x3 coordinates of the points.
+   * @return array of arrays of sample indices and weights, one array for
+   *  each point; null for any point that has no indices and weights.
+   */
+  public IndexWeight[][] getIndexWeights(
+    final float[] x1, final float[] x2, final float[] x3) 
+  {
+    final int n = x1.length;
+    final IndexWeight[][] iw = new IndexWeight[n][];
+    if (n==0)
+      return iw;
+    final int nc = 1+(n-1)/CHUNK;
+    final Parallel.Unsafe<Query> qu = new Parallel.Unsafe<Query>();
+    Parallel.loop(nc,new Parallel.LoopInt() {
+    public void compute(int ic) {
+      Query q = query(qu);
+      int jlo = ic*CHUNK;
+      int jhi = Math.min(jlo+CHUNK,n);
+      for (int j=jlo; j<jhi; ++j)
+        iw[j] = getIndexWeights(q,x1[j],x2[j],x3[j]);
+    }});
     return iw;
   }
 
@@ -495,7 +529,6 @@ public class SibsonInterpolator3 {
   // Data associated with all nodes in the tet mesh.
   private static class NodeData {
     float f,gx,gy,gz; // function values and gradient
-    double volume; // volume for Sibson weight
   }
   private static NodeData data(TetMesh.Node node) {
     return (NodeData)node.data;
@@ -512,18 +545,14 @@ public class SibsonInterpolator3 {
   private static float gz(TetMesh.Node node) {
     return data(node).gz;
   }
-  private static double volume(TetMesh.Node node) {
-    return data(node).volume;
-  }
   private static boolean ghost(TetMesh.Node node) {
     return node.index<0;
   }
 
   private TetMesh _mesh; // the mesh
   private TetMesh.Node[] _nodes; // array of real (not ghost) nodes
-  private TetMesh.NodeList _nodeList; // list of natural neighbor nodes
-  private TetMesh.TetList _tetList; // list of natural neighbor tets
-  private VolumeAccumulator _va; // accumulates Sibson's volumes
+  private Method _method; // method used to accumulate Sibson's volumes
+  private Query _query; // for queries of one point at a time
   private boolean _haveGradients; // true if mesh nodes have gradients
   private double _gradientPower; // power of gradients
   private float _fnull; // returned when interpolation point out of bounds
@@ -691,12 +720,142 @@ public class SibsonInterpolator3 {
       _mesh.removeNode(gnode);
   }
 
+  // Number of consecutive points processed together in parallel queries.
+  private static final int CHUNK = 256;
+
+  // Workspace for queries of natural neighbors and their Sibson volumes.
+  // Nodes and tets are marked in this workspace, not in the mesh, and 
+  // the mesh is not otherwise modified by queries. Therefore, threads
+  // may perform queries in parallel, if each has its own workspace.
+  private static class Query {
+    TetMesh.NodeList nodeList = new TetMesh.NodeList(); // natural nabors
+    TetMesh.TetList tetList = new TetMesh.TetList(); // their tets
+    MarkMap marks = new MarkMap(); // marked nodes and tets
+    double[] volumes = new double[64]; // volumes of nodes in node list
+    VolumeAccumulator va; // accumulates Sibson's volumes
+    TetMesh.Tet tet; // tet in which the last point was located; or null
+    long version; // version of mesh when that tet was located
+    Query(Method method) {
+      if (method==Method.WATSON_SAMBRIDGE) {
+        va = new WatsonSambridge();
+      } else if (method==Method.BRAUN_SAMBRIDGE) {
+        va = new BraunSambridge();
+      } else if (method==Method.HALE_LIANG) {
+        va = new HaleLiang();
+      }
+      va._query = this;
+    }
+    boolean isMarked(Object o) {
+      return marks.get(o)>=0;
+    }
+  }
+
+  // Returns the workspace for the current thread, constructing it if 
+  // necessary.
+  private Query query(Parallel.Unsafe<Query> qu) {
+    Query q = qu.get();
+    if (q==null) qu.set(q=new Query(_method));
+    return q;
+  }
+
+  // Maps nodes and tets (compared by identity) to non-negative integers.
+  // Entries are removed by incrementing a stamp, so that clearing is
+  // cheap; the arrays of entries grow as necessary but never shrink.
+  private static class MarkMap {
+    int get(Object key) {
+      int mask = _keys.length-1;
+      for (int i=hash(key)&mask; _stamps[i]==_stamp; i=(i+1)&mask) {
+        if (_keys[i]==key)
+          return _values[i];
+      }
+      return -1;
+    }
+    void put(Object key, int value) { // key must not already be in map
+      if (2*(_n+1)>_keys.length)
+        grow();
+      int mask = _keys.length-1;
+      int i = hash(key)&mask;
+      while (_stamps[i]==_stamp)
+        i = (i+1)&mask;
+      _keys[i] = key;
+      _values[i] = value;
+      _stamps[i] = _stamp;
+      ++_n;
+    }
+    void clear() {
+      _n = 0;
+      if (++_stamp==Integer.MAX_VALUE) { // rarely!
+        Arrays.fill(_stamps,0);
+        _stamp = 1;
+      }
+    }
+    private int _n;
+    private int _stamp = 1;
+    private Object[] _keys = new Object[256];
+    private int[] _values = new int[256];
+    private int[] _stamps = new int[256];
+    private static int hash(Object key) {
+      int h = System.identityHashCode(key);
+      return h^(h>>>16);
+    }
+    private void grow() {
+      Object[] keys = _keys;
+      int[] values = _values;
+      int[] stamps = _stamps;
+      int n = keys.length;
+      _keys = new Object[2*n];
+      _values = new int[2*n];
+      _stamps = new int[2*n];
+      _n = 0;
+      for (int i=0; i<n; ++i) {
+        if (stamps[i]==_stamp)
+          put(keys[i],values[i]);
+      }
+    }
+  }
+
+  // Returns a value interpolated at point (x1,x2,x3) using a workspace.
+  private float interpolate(Query q, float x1, float x2, float x3) {
+    if (!inBounds(x1,x2,x3))
+      return _fnull;
+    double vsum = computeVolumes(q,x1,x2,x3);
+    if (vsum<=0.0)
+      return _fnull;
+    if (usingGradients()) {
+      return interpolate1(q,vsum,x1,x2,x3);
+    } else {
+      return interpolate0(q,vsum);
+    }
+  }
+
+  // Returns indices and weights for point (x1,x2,x3) using a workspace.
+  private IndexWeight[] getIndexWeights(
+    Query q, float x1, float x2, float x3) 
+  {
+    if (!inBounds(x1,x2,x3))
+      return null;
+    float wsum = (float)computeVolumes(q,x1,x2,x3);
+    if (wsum==0.0f)
+      return null;
+    float wscl = 1.0f/wsum;
+    int nnode = q.nodeList.nnode();
+    TetMesh.Node[] nodes = q.nodeList.nodes();
+    IndexWeight[] iw = new IndexWeight[nnode];
+    for (int inode=0; inode<nnode; ++inode) {
+      TetMesh.Node node = nodes[inode];
+      int i = node.index;
+      float w = (float)q.volumes[inode]*wscl;
+      iw[inode] = new IndexWeight(i,w);
+    }
+    return iw;
+  }
+
   // Computes Sibson volumes for the specified point (x,y,z).
   // Returns true, if successful; false, otherwise.
-  private double computeVolumes(float x, float y, float z) {
-    if (!getNaturalNabors(x,y,z))
+  private double computeVolumes(Query q, float x, float y, float z) {
+    if (!getNaturalNabors(q,x,y,z))
       return 0.0;
-    return _va.accumulateVolumes(x,y,z,_mesh,_nodeList,_tetList);
+    return q.va.accumulateVolumes(x,y,z,_mesh,q.nodeList,q.tetList);
   }
 
   // Returns true if not using bounding box or if point is inside the box.
@@ -707,48 +866,67 @@ public class SibsonInterpolator3 {
            _x3bmn<=x3 && x3<=_x3bmx;
   }
 
+  // Locates the point (x,y,z), beginning with the tet in which the
+  // last point was located, if the mesh has not changed since then.
+  private TetMesh.PointLocation locatePoint(
+    Query q, float x, float y, float z) 
+  {
+    long version = _mesh.getVersion();
+    TetMesh.PointLocation pl = (q.tet!=null && q.version==version) ?
+      _mesh.locatePoint(q.tet,x,y,z) :
+      _mesh.locatePoint(x,y,z);
+    q.tet = pl.tet();
+    q.version = version;
+    return pl;
+  }
+
   // Gets lists of natural neighbor nodes and tets of point (x,y,z).
   // Before building the lists, node and tet marks are cleared. Then,
   // as nodes and tets are added to the lists, they are marked, and 
   // node volumes are initialized to zero.
   // Returns true, if the lists are not empty; false, otherwise.
-  private boolean getNaturalNabors(float x, float y, float z) {
-    _mesh.clearNodeMarks();
-    _mesh.clearTetMarks();
-    _nodeList.clear();
-    _tetList.clear();
-    TetMesh.PointLocation pl = _mesh.locatePoint(x,y,z);
+  private boolean getNaturalNabors(Query q, float x, float y, float z) {
+    q.marks.clear();
+    q.nodeList.clear();
+    q.tetList.clear();
+    TetMesh.PointLocation pl = locatePoint(q,x,y,z);
     if (pl.isOutside())
       return false;
-    addTet(x,y,z,pl.tet());
+    addTet(q,x,y,z,pl.tet());
     return true;
   }
-  private void addTet(double xp, double yp, double zp, TetMesh.Tet tet) {
-    _mesh.mark(tet);
-    _tetList.add(tet);
-    addNode(tet.nodeA());
-    addNode(tet.nodeB());
-    addNode(tet.nodeC());
-    addNode(tet.nodeD());
+  private void addTet(
+    Query q, double xp, double yp, double zp, TetMesh.Tet tet) 
+  {
+    q.marks.put(tet,0);
+    q.tetList.add(tet);
+    addNode(q,tet.nodeA());
+    addNode(q,tet.nodeB());
+    addNode(q,tet.nodeC());
+    addNode(q,tet.nodeD());
     TetMesh.Tet ta = tet.tetA();
     TetMesh.Tet tb = tet.tetB();
     TetMesh.Tet tc = tet.tetC();
     TetMesh.Tet td = tet.tetD();
-    if (needTet(xp,yp,zp,ta)) addTet(xp,yp,zp,ta);
-    if (needTet(xp,yp,zp,tb)) addTet(xp,yp,zp,tb);
-    if (needTet(xp,yp,zp,tc)) addTet(xp,yp,zp,tc);
-    if (needTet(xp,yp,zp,td)) addTet(xp,yp,zp,td);
+    if (needTet(q,xp,yp,zp,ta)) addTet(q,xp,yp,zp,ta);
+    if (needTet(q,xp,yp,zp,tb)) addTet(q,xp,yp,zp,tb);
+    if (needTet(q,xp,yp,zp,tc)) addTet(q,xp,yp,zp,tc);
+    if (needTet(q,xp,yp,zp,td)) addTet(q,xp,yp,zp,td);
   }
-  private void addNode(TetMesh.Node node) {
-    if (_mesh.isMarked(node))
+  private void addNode(Query q, TetMesh.Node node) {
+    if (q.isMarked(node))
       return;
-    _mesh.mark(node);
-    _nodeList.add(node);
-    NodeData data = data(node);
-    data.volume = 0.0;
+    int inode = q.nodeList.nnode();
+    q.marks.put(node,inode);
+    q.nodeList.add(node);
+    if (inode==q.volumes.length)
+      q.volumes = Arrays.copyOf(q.volumes,2*inode);
+    q.volumes[inode] = 0.0;
   }
-  private boolean needTet(double xp, double yp, double zp, TetMesh.Tet tet) {
-    if (tet==null || _mesh.isMarked(tet))
+  private boolean needTet(
+    Query q, double xp, double yp, double zp, TetMesh.Tet tet) 
+  {
+    if (tet==null || q.isMarked(tet))
       return false;
     TetMesh.Node na = tet.nodeA();
     TetMesh.Node nb = tet.nodeB();
@@ -762,23 +940,25 @@ public class SibsonInterpolator3 {
   }
 
   // C0 interpolation; does not use gradients.
-  private float interpolate0(double vsum) {
+  private float interpolate0(Query q, double vsum) {
     double vfsum = 0.0;
-    int nnode = _nodeList.nnode();
-    TetMesh.Node[] nodes = _nodeList.nodes();
+    int nnode = q.nodeList.nnode();
+    TetMesh.Node[] nodes = q.nodeList.nodes();
     for (int inode=0; inode<nnode; ++inode) {
       TetMesh.Node node = nodes[inode];
       float f = f(node);
-      double v = volume(node);
+      double v = q.volumes[inode];
       vfsum += v*f;
     }
     return (float)(vfsum/vsum);
   }
 
   // C1 interpolation; uses gradients.
-  private float interpolate1(double vsum, double x, double y, double z) {
-    int nnode = _nodeList.nnode();
-    TetMesh.Node[] nodes = _nodeList.nodes();
+  private float interpolate1(
+    Query q, double vsum, double x, double y, double z) 
+  {
+    int nnode = q.nodeList.nnode();
+    TetMesh.Node[] nodes = q.nodeList.nodes();
     double fs = 0.0;
     double es = 0.0;
     double wds = 0.0;
@@ -790,7 +970,7 @@ public class SibsonInterpolator3 {
       double gx = gx(n);
       double gy = gy(n);
       double gz = gz(n);
-      double v = volume(n);
+      double v = q.volumes[inode];
       double w = v/vsum;
       double xn = n.xp();
       double yn = n.yp();
@@ -840,11 +1020,11 @@ public class SibsonInterpolator3 {
     double yn = n.yp();
     double zn = n.zp();
     _mesh.removeNode(n);
-    double vsum = computeVolumes((float)xn,(float)yn,(float)zn);
+    double vsum = computeVolumes(_query,(float)xn,(float)yn,(float)zn);
     _mesh.addNode(n);
     if (vsum>0.0) {
-      int nm = _nodeList.nnode();
-      TetMesh.Node[] ms = _nodeList.nodes();
+      int nm = _query.nodeList.nnode();
+      TetMesh.Node[] ms = _query.nodeList.nodes();
       double hxx = 0.0, hxy = 0.0, hxz = 0.0,
                         hyy = 0.0, hyz = 0.0,
                                    hzz = 0.0;
@@ -854,7 +1034,7 @@ public class SibsonInterpolator3 {
         TetMesh.Node m = ms[im];
         if (!ghost(m)) {
           double fm = f(m);
-          double wm = volume(m);
+          double wm = _query.volumes[im];
           double xm = m.xp();
           double ym = m.yp();
           double zm = m.zp();
@@ -915,11 +1095,14 @@ public class SibsonInterpolator3 {
     }
     protected void accumulate(TetMesh.Node node, double volume) {
       if (ghost(node)) return; // ignore ghost nodes!
-      NodeData data = data(node);
-      data.volume += volume;
+      _query.volumes[_query.marks.get(node)] += volume;
       _sum += volume;
     }
+    protected boolean isMarked(TetMesh.Tet tet) {
+      return _query.isMarked(tet);
+    }
     private double _sum;
+    private Query _query; // workspace with volumes being accumulated
   }
   
   ///////////////////////////////////////////////////////////////////////////
@@ -1097,7 +1280,7 @@ public class SibsonInterpolator3 {
       TetMesh.Node nb, TetMesh.Node nc, TetMesh.Node nd)
     {
       boolean saveFace = true;
-      if (ta!=null && mesh.isMarked(ta)) {
+      if (ta!=null && isMarked(ta)) {
         ta.centerSphere(_xyz);
         double xa = _xyz[0]-xp, ya = _xyz[1]-yp, za = _xyz[2]-zp;
         double xb = nb.xp()-xp, yb = nb.yp()-yp, zb = nb.zp()-zp;
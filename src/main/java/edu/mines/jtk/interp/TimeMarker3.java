@@ -21,6 +21,7 @@ import java.util.logging.Logger;
 
 import edu.mines.jtk.dsp.Tensors3;
 import edu.mines.jtk.util.Parallel;
+import edu.mines.jtk.util.Profiler;
 import edu.mines.jtk.util.Stopwatch;
 import static edu.mines.jtk.util.ArrayMath.*;
 
@@ -64,7 +65,15 @@ public class TimeMarker3 {
   public enum Concurrency {
     PARALLELX,
     PARALLEL,
-    SERIAL
+    SERIAL,
+    /**
+     * Splits samples into blocks, each with its own active list. Blocks 
+     * are processed in parallel until converged locally, and times near 
+     * block boundaries are exchanged between blocks after each round. 
+     * Blocks processed concurrently are never adjacent, so that fewer 
+     * synchronizations are required than for waves of the active list.
+     */
+    BLOCKED
   }
   
   /**
@@ -109,51 +118,57 @@ public class TimeMarker3 {
     Stopwatch sw = new Stopwatch();
     sw.start();
     log.fine("TimeMarker3.apply: begin time="+(int)sw.time());
-
-    // Initialize all unknown times to infinity.
-    for (int i3=0; i3<_n3; ++i3) {
-      for (int i2=0; i2<_n2; ++i2) {
-        for (int i1=0; i1<_n1; ++i1) {
-          if (times[i3][i2][i1]!=0.0f)
-            times[i3][i2][i1] = INFINITY;
+    Profiler.start(PROFILE_APPLY);
+    try {
+      // Initialize all unknown times to infinity.
+      for (int i3=0; i3<_n3; ++i3) {
+        for (int i2=0; i2<_n2; ++i2) {
+          for (int i1=0; i1<_n1; ++i1) {
+            if (times[i3][i2][i1]!=0.0f)
+              times[i3][i2][i1] = INFINITY;
+          }
         }
       }
-    }
 
-    // Indices of known samples in random order.
-    short[][] kk = indexKnownSamples(times);
-    short[] k1 = kk[0];
-    short[] k2 = kk[1];
-    short[] k3 = kk[2];
-    shuffle(k1,k2,k3);
-    int nk = k1.length;
+      // Indices of known samples in random order.
+      short[][] kk = indexKnownSamples(times);
+      short[] k1 = kk[0];
+      short[] k2 = kk[1];
+      short[] k3 = kk[2];
+      shuffle(k1,k2,k3);
+      int nk = k1.length;
+      Profiler.count(PROFILE_KNOWN,nk);
 
-    // Array for the eikonal solution times.
-    float[][][] t = new float[_n3][_n2][_n1];
+      // Array for the eikonal solution times.
+      float[][][] t = new float[_n3][_n2][_n1];
+      Profiler.count(PROFILE_BYTES,4L*_n1*_n2*_n3);
 
-    // Active list of samples used to compute times.
-    ActiveList al = new ActiveList();
+      // Active list of samples used to compute times.
+      ActiveList al = new ActiveList();
 
-    // For all known samples, ...
-    for (int ik=0; ik<nk; ++ik) {
-      if (ik%(1+(nk-1)/100)==0)
-        log.fine("  apply: ik/nk="+ik+"/"+nk+" time="+(int)sw.time());
-      int i1 = k1[ik];
-      int i2 = k2[ik];
-      int i3 = k3[ik];
+      // For all known samples, ...
+      for (int ik=0; ik<nk; ++ik) {
+        if (ik%(1+(nk-1)/100)==0)
+          log.fine("  apply: ik/nk="+ik+"/"+nk+" time="+(int)sw.time());
+        int i1 = k1[ik];
+        int i2 = k2[ik];
+        int i3 = k3[ik];
 
-      // Clear activated flags so we can tell which samples become activated.
-      clearActivated();
+        // Clear activated flags so we can tell which samples become activated.
+        clearActivated();
 
-      // Put the known sample with time zero into the active list.
-      t[i3][i2][i1] = 0.0f;
-      al.append(_s[i3][i2][i1]);
+        // Put the known sample with time zero into the active list.
+        t[i3][i2][i1] = 0.0f;
+        al.append(_s[i3][i2][i1]);
 
-      // The mark for the known sample.
-      int m = marks[i3][i2][i1];
+        // The mark for the known sample.
+        int m = marks[i3][i2][i1];
 
-      // Process the active list until empty.
-      solve(al,t,m,times,marks);
+        // Process the active list until empty.
+        solve(al,t,m,times,marks);
+      }
+    } finally {
+      Profiler.stop(PROFILE_APPLY);
     }
 
     // Log elapsed time.
@@ -164,12 +179,19 @@ public class TimeMarker3 {
   private void solve(
     ActiveList al, float[][][] t, int m, float[][][] times, int[][][] marks) 
   {
-    if (_concurrency==Concurrency.PARALLEL) {
-      solveParallel(al,t,m,times,marks);
-    } else if (_concurrency==Concurrency.PARALLELX) {
-      solveParallelX(al,t,m,times,marks);
-    } else {
-      solveSerial(al,t,m,times,marks);
+    Profiler.start(PROFILE_SOLVE);
+    try {
+      if (_concurrency==Concurrency.PARALLEL) {
+        solveParallel(al,t,m,times,marks);
+      } else if (_concurrency==Concurrency.PARALLELX) {
+        solveParallelX(al,t,m,times,marks);
+      } else if (_concurrency==Concurrency.BLOCKED) {
+        solveBlocked(al,t,m,times,marks);
+      } else {
+        solveSerial(al,t,m,times,marks);
+      }
+    } finally {
+      Profiler.stop(PROFILE_SOLVE);
     }
   }
 
@@ -179,6 +201,14 @@ public class TimeMarker3 {
   private static Logger log = 
     Logger.getLogger(NearestGridder3.class.getName());
 
+  // Names of phases and counters for the profiler.
+  private static final String PROFILE_APPLY = "TimeMarker3.apply";
+  private static final String PROFILE_SOLVE = "TimeMarker3.solve";
+  private static final String PROFILE_BLOCK = "TimeMarker3.solveBlock";
+  private static final String PROFILE_KNOWN = "TimeMarker3.knownSamples";
+  private static final String PROFILE_SAMPLES = "TimeMarker3.samplesSolved";
+  private static final String PROFILE_BYTES = "TimeMarker3.bytesAllocated";
+
   // Default time for samples not yet computed.
   private static final float INFINITY = Float.MAX_VALUE;
 
@@ -262,6 +292,12 @@ public class TimeMarker3 {
 
   // List of active samples.
   private class ActiveList {
+    ActiveList() {
+      this(1024);
+    }
+    ActiveList(int capacity) {
+      _a = new Sample[capacity];
+    }
     void append(Sample s) {
       s.activated = _activated;
       if (_n==_a.length)
@@ -284,6 +320,12 @@ public class TimeMarker3 {
       for (int i=0; i<_n; ++i)
         _a[i].absent = true;
     }
+    void appendIfAbsent(Sample s) {
+      if (s.absent) {
+        append(s);
+        s.absent = false;
+      }
+    }
     void appendIfAbsent(ActiveList al) {
       if (_n+al._n>_a.length)
         growTo(2*(_n+al._n));
@@ -314,7 +356,7 @@ public class TimeMarker3 {
       }
     }
     private int _n;
-    private Sample[] _a = new Sample[1024];
+    private Sample[] _a;
     private void growTo(int capacity) {
       Sample[] a = new Sample[capacity];
       System.arraycopy(_a,0,a,0,_n);
@@ -454,6 +496,7 @@ public class TimeMarker3 {
       al.appendIfAbsent(bl);
       bl.clear();
     }
+    Profiler.count(PROFILE_SAMPLES,ntotal);
     trace("solveSerial: ntotal="+ntotal);
     trace("             nratio="+(float)ntotal/(float)(_n1*_n2*_n3));
   }
@@ -481,6 +524,7 @@ public class TimeMarker3 {
     while (!al.isEmpty()) {
       ai.set(0); // initialize the shared block index to zero
       final int n = al.size(); // number of samples in active (A) list
+      Profiler.count(PROFILE_SAMPLES,n);
       //ntotal += n;
       final int mb = 32; // size of blocks of samples
       final int nb = 1+(n-1)/mb; // number of blocks of samples
@@ -539,6 +583,7 @@ public class TimeMarker3 {
     final ActiveList[] bltask = new ActiveList[nbmax];
     while (!al.isEmpty()) {
       final int n = al.size(); // number of samples in active (A) list
+      Profiler.count(PROFILE_SAMPLES,n);
       final int mbmax = max(mbmin,1+(n-1)/nbmax); // max samples per block
       final int nb = 1+(n-1)/mbmax; // number of blocks <= nbmax
       final int mb = 1+(n-1)/nb; // evenly distribute samples per block
@@ -572,6 +617,170 @@ public class TimeMarker3 {
     }
   }
 
+  // Number of samples per block in each dimension, for blocked solves. 
+  // Must be at least four, so that blocks processed concurrently never 
+  // read or write the same samples.
+  private static final int BLOCK_SIZE = 16;
+
+  // A block of samples with its own active lists.
+  private class Block {
+    int j1,j2,j3; // indices of first sample in block
+    int k1,k2,k3; // indices of first sample beyond block
+    ActiveList al = new ActiveList(8); // samples to process in this block
+    ActiveList bl = new ActiveList(8); // samples activated by this block
+    ActiveList ol = new ActiveList(8); // activated samples in other blocks
+    ActiveList il = new ActiveList(8); // samples from other blocks
+    float[] d = new float[6]; // work array for tensor coefficients
+    int ig; // index of group of blocks that are not adjacent
+    boolean queued; // true, if in the queue of blocks to be processed
+    Block(int j1, int j2, int j3) {
+      this.j1 = j1;
+      this.j2 = j2;
+      this.j3 = j3;
+      int ib1 = j1/BLOCK_SIZE, ib2 = j2/BLOCK_SIZE, ib3 = j3/BLOCK_SIZE;
+      ig = ((ib3&1)<<2)|((ib2&1)<<1)|(ib1&1);
+      k1 = min(j1+BLOCK_SIZE,_n1);
+      k2 = min(j2+BLOCK_SIZE,_n2);
+      k3 = min(j3+BLOCK_SIZE,_n3);
+    }
+    boolean contains(Sample s) {
+      return j1<=s.i1 && s.i1<k1 &&
+             j2<=s.i2 && s.i2<k2 &&
+             j3<=s.i3 && s.i3<k3;
+    }
+  }
+  private int _nb1,_nb2,_nb3; // numbers of blocks
+  private Block[][][] _b; // blocks, constructed only if necessary
+  private Block[][] _bq; // for each group, queue of blocks with samples
+  private int[] _nq; // for each group, number of blocks queued
+  private Block[] _bg; // blocks in one group processed concurrently
+  private void makeBlocks() {
+    _nb1 = 1+(_n1-1)/BLOCK_SIZE;
+    _nb2 = 1+(_n2-1)/BLOCK_SIZE;
+    _nb3 = 1+(_n3-1)/BLOCK_SIZE;
+    _b = new Block[_nb3][_nb2][_nb1];
+    int[] mq = new int[8];
+    for (int ib3=0; ib3<_nb3; ++ib3) {
+      for (int ib2=0; ib2<_nb2; ++ib2) {
+        for (int ib1=0; ib1<_nb1; ++ib1) {
+          Block b = new Block(ib1*BLOCK_SIZE,ib2*BLOCK_SIZE,ib3*BLOCK_SIZE);
+          _b[ib3][ib2][ib1] = b;
+          ++mq[b.ig];
+        }
+      }
+    }
+    _bq = new Block[8][];
+    for (int ig=0; ig<8; ++ig)
+      _bq[ig] = new Block[mq[ig]];
+    _nq = new int[8];
+    _bg = new Block[max(mq)];
+  }
+  private Block blockOf(Sample s) {
+    return _b[s.i3/BLOCK_SIZE][s.i2/BLOCK_SIZE][s.i1/BLOCK_SIZE];
+  }
+
+  // Appends a sample from another block to the I list of its block,
+  // and queues that block to be processed, if not already queued.
+  private void appendToBlock(Sample s) {
+    Block b = blockOf(s);
+    b.il.append(s);
+    if (!b.queued) {
+      b.queued = true;
+      _bq[b.ig][_nq[b.ig]++] = b;
+    }
+  }
+
+  /*
+   * Solves for times by processing blocks of samples in parallel.
+   * In each round, blocks are processed in eight groups, such that 
+   * no two blocks in a group are adjacent. Each block processes its
+   * own active list until converged, and collects samples activated
+   * in other blocks. Those samples are exchanged after each group.
+   * Only blocks queued with samples from other blocks are processed.
+   */
+  private void solveBlocked(
+    final ActiveList al,
+    final float[][][] t, final int m,
+    final float[][][] times, final int[][][] marks)
+  {
+    if (_b==null)
+      makeBlocks();
+    int n = al.size();
+    for (int i=0; i<n; ++i)
+      appendToBlock(al.get(i));
+    al.clear();
+    final Block[] bg = _bg;
+    for (boolean active=true; active;) {
+      active = false;
+      for (int ig=0; ig<8; ++ig) {
+        int ng = _nq[ig];
+        if (ng==0) continue;
+        active = true;
+        System.arraycopy(_bq[ig],0,bg,0,ng);
+        _nq[ig] = 0;
+        for (int ib=0; ib<ng; ++ib)
+          bg[ib].queued = false;
+        Parallel.loop(ng,new Parallel.LoopInt() { // for all blocks, ...
+          public void compute(int ib) {
+            solveBlock(bg[ib],t,m,times,marks);
+          }
+        });
+        // Exchange samples activated in other blocks. Samples appended
+        // more than once are removed when those blocks are processed.
+        // Adjacent blocks are never in this group, so none are queued
+        // in this group while exchanging.
+        for (int ib=0; ib<ng; ++ib) {
+          ActiveList ol = bg[ib].ol;
+          int no = ol.size();
+          for (int io=0; io<no; ++io)
+            appendToBlock(ol.get(io));
+          ol.clear();
+        }
+      }
+    }
+  }
+
+  /*
+   * Processes the active list of one block until empty. Samples
+   * activated and not in this block are appended to its O list.
+   */
+  private void solveBlock(
+    Block b, float[][][] t, int m, float[][][] times, int[][][] marks)
+  {
+    ActiveList al = b.al;
+    ActiveList bl = b.bl;
+    ActiveList ol = b.ol;
+    Profiler.start(PROFILE_BLOCK);
+    try {
+      b.il.setAllAbsent();
+      al.clear();
+      al.appendIfAbsent(b.il);
+      b.il.clear();
+      long ntotal = 0;
+      while (!al.isEmpty()) {
+        int n = al.size();
+        ntotal += n;
+        for (int i=0; i<n; ++i)
+          solveOne(t,m,times,marks,al.get(i),bl,b.d);
+        bl.setAllAbsent();
+        al.clear();
+        n = bl.size();
+        for (int i=0; i<n; ++i) {
+          Sample s = bl.get(i);
+          if (b.contains(s)) {
+            al.appendIfAbsent(s);
+          } else {
+            ol.appendIfAbsent(s);
+          }
+        }
+        bl.clear();
+      }
+      Profiler.count(PROFILE_SAMPLES,ntotal);
+    } finally {
+      Profiler.stop(PROFILE_BLOCK);
+    }
+  }
+
   /*
    * Gets the current times during one solution of the eikonal equation.
    * Times for samples not yet activated are infinite.
@@ -16,6 +16,7 @@ package edu.mines.jtk.io;
 
 import java.io.*;
 import java.nio.ByteOrder;
+import java.nio.channels.FileChannel;
 
 /**
  * An array file expands the capabilities of {@link java.io.RandomAccessFile}. 
@@ -111,6 +112,15 @@ public class ArrayFile implements ArrayInput, ArrayOutput, Closeable {
     return _bow;
   }
 
+  /**
+   * Gets the file channel for this file. The channel may be used to
+   * memory-map regions of this file; its position is that of this file.
+   * @return the file channel.
+   */
+  public FileChannel getChannel() {
+    return _raf.getChannel();
+  }
+
   /**
    * Reads a byte value from this file. 
    * The returned value will be in the range 0 to 255.
@@ -19,6 +19,8 @@ import static java.lang.Math.min;
 import java.nio.*;
 import java.nio.channels.ReadableByteChannel;
 
+import edu.mines.jtk.util.Profiler;
+
 /**
  * Implements {@link ArrayInput} by wrapping {@link java.io.DataInput}.
  * This adapter wraps a specified data input to provide methods for reading 
@@ -28,7 +30,12 @@ import java.nio.channels.ReadableByteChannel;
  * use the default BIG_ENDIAN byte order.
  * <p>
  * When an adapter is constructed from an object that has a file channel, 
- * the channel enables more efficient reads of arrays of values.
+ * the channel enables more efficient reads of arrays of values. Bytes are
+ * then read from the channel into a direct byte buffer, and are converted
+ * to values in the specified byte order by bulk gets from views of that
+ * buffer, without any intermediate byte arrays. Reads of 2-D and 3-D
+ * arrays fill that buffer with elements for as many array rows as will
+ * fit, so that short rows do not require separate reads.
  * @author Dave Hale, Colorado School of Mines
  * @version 2006.08.05
  */
@@ -104,9 +111,9 @@ public class ArrayInputAdapter implements ArrayInput {
     _di = input;
     _bo = order;
     if (_rbc!=null) {
-      _bb = ByteBuffer.allocateDirect(4096);
+      _bb = ByteBuffer.allocateDirect(NBYTE_DIRECT);
     } else {
-      _buffer = new byte[4096];
+      _buffer = new byte[NBYTE_HEAP];
       _bb = ByteBuffer.wrap(_buffer);
     }
     if (order==ByteOrder.BIG_ENDIAN) {
@@ -245,12 +252,7 @@ public class ArrayInputAdapter implements ArrayInput {
     int m = _cb.capacity();
     for (int j=0; j<n; j+=m) {
       int l = min(n-j,m);
-      if (_rbc!=null) {
-        _bb.position(0).limit(l*2);
-        _rbc.read(_bb);
-      } else {
-        _di.readFully(_buffer,0,l*2);
-      }
+      fill(l*2);
       _cb.position(0).limit(l);
       _cb.get(v,k+j,l);
     }
@@ -295,12 +297,7 @@ public class ArrayInputAdapter implements ArrayInput {
     int m = _sb.capacity();
     for (int j=0; j<n; j+=m) {
       int l = min(n-j,m);
-      if (_rbc!=null) {
-        _bb.position(0).limit(l*2);
-        _rbc.read(_bb);
-      } else {
-        _di.readFully(_buffer,0,l*2);
-      }
+      fill(l*2);
       _sb.position(0).limit(l);
       _sb.get(v,k+j,l);
     }
@@ -345,12 +342,7 @@ public class ArrayInputAdapter implements ArrayInput {
     int m = _ib.capacity();
     for (int j=0; j<n; j+=m) {
       int l = min(n-j,m);
-      if (_rbc!=null) {
-        _bb.position(0).limit(l*4);
-        _rbc.read(_bb);
-      } else {
-        _di.readFully(_buffer,0,l*4);
-      }
+      fill(l*4);
       _ib.position(0).limit(l);
       _ib.get(v,k+j,l);
     }
@@ -395,12 +387,7 @@ public class ArrayInputAdapter implements ArrayInput {
     int m = _lb.capacity();
     for (int j=0; j<n; j+=m) {
       int l = min(n-j,m);
-      if (_rbc!=null) {
-        _bb.position(0).limit(l*8);
-        _rbc.read(_bb);
-      } else {
-        _di.readFully(_buffer,0,l*8);
-      }
+      fill(l*8);
       _lb.position(0).limit(l);
       _lb.get(v,k+j,l);
     }
@@ -445,12 +432,7 @@ public class ArrayInputAdapter implements ArrayInput {
     int m = _fb.capacity();
     for (int j=0; j<n; j+=m) {
       int l = min(n-j,m);
-      if (_rbc!=null) {
-        _bb.position(0).limit(l*4);
-        _rbc.read(_bb);
-      } else {
-        _di.readFully(_buffer,0,l*4);
-      }
+      fill(l*4);
       _fb.position(0).limit(l);
       _fb.get(v,k+j,l);
     }
@@ -471,8 +453,27 @@ public class ArrayInputAdapter implements ArrayInput {
    * @param v the array.
    */
   public void readFloats(float[][] v) throws IOException {
-    for (float[] vi:v)
-      readFloats(vi);
+    int m = _fb.capacity();
+    int n = v.length;
+    for (int i=0,j=0; i<n;) {
+      int l = 0;
+      for (int ii=i,jj=j; ii<n && l<m; ++ii,jj=0)
+        l += min(m-l,v[ii].length-jj);
+      fill(l*4);
+      _fb.position(0).limit(l);
+      while (i<n) {
+        int lj = min(l,v[i].length-j);
+        _fb.get(v[i],j,lj);
+        j += lj;
+        l -= lj;
+        if (j<v[i].length)
+          break;
+        ++i;
+        j = 0;
+        if (l==0)
+          break;
+      }
+    }
   }
 
   /**
@@ -495,12 +496,7 @@ public class ArrayInputAdapter implements ArrayInput {
     int m = _db.capacity();
     for (int j=0; j<n; j+=m) {
       int l = min(n-j,m);
-      if (_rbc!=null) {
-        _bb.position(0).limit(l*8);
-        _rbc.read(_bb);
-      } else {
-        _di.readFully(_buffer,0,l*8);
-      }
+      fill(l*8);
       _db.position(0).limit(l);
       _db.get(v,k+j,l);
     }
@@ -521,8 +517,27 @@ public class ArrayInputAdapter implements ArrayInput {
    * @param v the array.
    */
   public void readDoubles(double[][] v) throws IOException {
-    for (double[] vi:v)
-      readDoubles(vi);
+    int m = _db.capacity();
+    int n = v.length;
+    for (int i=0,j=0; i<n;) {
+      int l = 0;
+      for (int ii=i,jj=j; ii<n && l<m; ++ii,jj=0)
+        l += min(m-l,v[ii].length-jj);
+      fill(l*8);
+      _db.position(0).limit(l);
+      while (i<n) {
+        int lj = min(l,v[i].length-j);
+        _db.get(v[i],j,lj);
+        j += lj;
+        l -= lj;
+        if (j<v[i].length)
+          break;
+        ++i;
+        j = 0;
+        if (l==0)
+          break;
+      }
+    }
   }
 
   /**
@@ -537,6 +552,14 @@ public class ArrayInputAdapter implements ArrayInput {
 
   ///////////////////////////////////////////////////////////////////////////
   // private
+
+  // Buffer sizes, in bytes, for reads via channels and data inputs.
+  private static final int NBYTE_DIRECT = 65536;
+  private static final int NBYTE_HEAP = 4096;
+
+  // Name of counter for the profiler.
+  private static final String PROFILE_BYTES_READ = "ArrayInput.bytesRead";
+
   private byte[] _buffer;
   private ReadableByteChannel _rbc;
   private DataInput _di;
@@ -548,4 +571,18 @@ public class ArrayInputAdapter implements ArrayInput {
   private LongBuffer _lb;
   private FloatBuffer _fb;
   private DoubleBuffer _db;
+
+  // Fills the buffer with the specified number of bytes.
+  private void fill(int nbyte) throws IOException {
+    Profiler.count(PROFILE_BYTES_READ,nbyte);
+    if (_rbc!=null) {
+      _bb.position(0).limit(nbyte);
+      while (_bb.hasRemaining()) {
+        if (_rbc.read(_bb)<0)
+          throw new EOFException();
+      }
+    } else {
+      _di.readFully(_buffer,0,nbyte);
+    }
+  }
 }
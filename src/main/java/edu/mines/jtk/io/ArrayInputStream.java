@@ -100,6 +100,30 @@ public class ArrayInputStream
     this(new FileInputStream(file),bo);
   }
 
+  /**
+   * Constructs an array input stream for the specified file input stream,
+   * byte order, and method of reading arrays. If direct, arrays of values
+   * are read from the file channel of the file input stream into a direct
+   * byte buffer and converted in bulk, without intermediate byte arrays.
+   * Individual values are then not buffered, so direct reading is most
+   * efficient for streams of large arrays, such as float[n3][n2][n1].
+   * @param fis the file input stream.
+   * @param bo the byte order.
+   * @param direct true, to read arrays directly from the file channel;
+   *  false, to read through a buffered input stream.
+   */
+  public ArrayInputStream(FileInputStream fis, ByteOrder bo, boolean direct) {
+    super(fis);
+    if (direct) {
+      _dis = new DataInputStream(fis);
+      _ai = new ArrayInputAdapter(fis.getChannel(),_dis,bo);
+    } else {
+      _dis = new DataInputStream(new BufferedInputStream(fis));
+      _ai = new ArrayInputAdapter(_dis,bo);
+    }
+    _bo = bo;
+  }
+
   /**
    * Closes this array input stream.
    */
@@ -19,6 +19,8 @@ import static java.lang.Math.min;
 import java.nio.*;
 import java.nio.channels.WritableByteChannel;
 
+import edu.mines.jtk.util.Profiler;
+
 /**
  * Implements {@link ArrayOutput} by wrapping {@link java.io.DataOutput}.
  * This adapter wraps a specified data output to provide methods for writing 
@@ -28,7 +30,12 @@ import java.nio.channels.WritableByteChannel;
  * use the default BIG_ENDIAN byte order.
  * <p>
  * When an adapter is constructed from an object that has a file channel, 
- * the channel enables more efficient writes of arrays of values.
+ * the channel enables more efficient writes of arrays of values. Values
+ * are then converted to bytes in the specified byte order by bulk puts
+ * into views of a direct byte buffer, which is written to the channel
+ * without any intermediate byte arrays. Writes of 2-D and 3-D arrays fill
+ * that buffer with elements from as many array rows as will fit, so that
+ * short rows do not require separate writes.
  * @author Dave Hale, Colorado School of Mines
  * @version 2006.08.05
  */
@@ -104,9 +111,9 @@ public class ArrayOutputAdapter implements ArrayOutput {
     _do = output;
     _bo = order;
     if (_wbc!=null) {
-      _bb = ByteBuffer.allocateDirect(4096);
+      _bb = ByteBuffer.allocateDirect(NBYTE_DIRECT);
     } else {
-      _buffer = new byte[4096];
+      _buffer = new byte[NBYTE_HEAP];
       _bb = ByteBuffer.wrap(_buffer);
     }
     if (order==ByteOrder.BIG_ENDIAN) {
@@ -260,12 +267,7 @@ public class ArrayOutputAdapter implements ArrayOutput {
       int l = min(n-j,m);
       _cb.position(0).limit(l);
       _cb.put(v,k+j,l);
-      if (_wbc!=null) {
-        _bb.position(0).limit(l*2);
-        _wbc.write(_bb);
-      } else {
-        _do.write(_buffer,0,l*2);
-      }
+      drain(l*2);
     }
   }
 
@@ -308,12 +310,7 @@ public class ArrayOutputAdapter implements ArrayOutput {
       int l = min(n-j,m);
       _sb.position(0).limit(l);
       _sb.put(v,k+j,l);
-      if (_wbc!=null) {
-        _bb.position(0).limit(l*2);
-        _wbc.write(_bb);
-      } else {
-        _do.write(_buffer,0,l*2);
-      }
+      drain(l*2);
     }
   }
 
@@ -356,12 +353,7 @@ public class ArrayOutputAdapter implements ArrayOutput {
       int l = min(n-j,m);
       _ib.position(0).limit(l);
       _ib.put(v,k+j,l);
-      if (_wbc!=null) {
-        _bb.position(0).limit(l*4);
-        _wbc.write(_bb);
-      } else {
-        _do.write(_buffer,0,l*4);
-      }
+      drain(l*4);
     }
   }
 
@@ -404,12 +396,7 @@ public class ArrayOutputAdapter implements ArrayOutput {
       int l = min(n-j,m);
       _lb.position(0).limit(l);
       _lb.put(v,k+j,l);
-      if (_wbc!=null) {
-        _bb.position(0).limit(l*8);
-        _wbc.write(_bb);
-      } else {
-        _do.write(_buffer,0,l*8);
-      }
+      drain(l*8);
     }
   }
 
@@ -452,12 +439,7 @@ public class ArrayOutputAdapter implements ArrayOutput {
       int l = min(n-j,m);
       _fb.position(0).limit(l);
       _fb.put(v,k+j,l);
-      if (_wbc!=null) {
-        _bb.position(0).limit(l*4);
-        _wbc.write(_bb);
-      } else {
-        _do.write(_buffer,0,l*4);
-      }
+      drain(l*4);
     }
   }
 
@@ -475,8 +457,25 @@ public class ArrayOutputAdapter implements ArrayOutput {
    * @param v the array.
    */
   public void writeFloats(float[][] v) throws IOException {
-    for (float[] vi:v)
-      writeFloats(vi);
+    int m = _fb.capacity();
+    int n = v.length;
+    for (int i=0,j=0; i<n;) {
+      _fb.position(0).limit(m);
+      int l = 0;
+      while (i<n) {
+        int lj = min(m-l,v[i].length-j);
+        _fb.put(v[i],j,lj);
+        j += lj;
+        l += lj;
+        if (j<v[i].length)
+          break;
+        ++i;
+        j = 0;
+        if (l==m)
+          break;
+      }
+      drain(l*4);
+    }
   }
 
   /**
@@ -500,12 +499,7 @@ public class ArrayOutputAdapter implements ArrayOutput {
       int l = min(n-j,m);
       _db.position(0).limit(l);
       _db.put(v,k+j,l);
-      if (_wbc!=null) {
-        _bb.position(0).limit(l*8);
-        _wbc.write(_bb);
-      } else {
-        _do.write(_buffer,0,l*8);
-      }
+      drain(l*8);
     }
   }
 
@@ -523,8 +517,25 @@ public class ArrayOutputAdapter implements ArrayOutput {
    * @param v the array.
    */
   public void writeDoubles(double[][] v) throws IOException {
-    for (double[] vi:v)
-      writeDoubles(vi);
+    int m = _db.capacity();
+    int n = v.length;
+    for (int i=0,j=0; i<n;) {
+      _db.position(0).limit(m);
+      int l = 0;
+      while (i<n) {
+        int lj = min(m-l,v[i].length-j);
+        _db.put(v[i],j,lj);
+        j += lj;
+        l += lj;
+        if (j<v[i].length)
+          break;
+        ++i;
+        j = 0;
+        if (l==m)
+          break;
+      }
+      drain(l*8);
+    }
   }
 
   /**
@@ -539,6 +550,13 @@ public class ArrayOutputAdapter implements ArrayOutput {
   ///////////////////////////////////////////////////////////////////////////
   // private
 
+  // Buffer sizes, in bytes, for writes via channels and data outputs.
+  private static final int NBYTE_DIRECT = 65536;
+  private static final int NBYTE_HEAP = 4096;
+
+  // Name of counter for the profiler.
+  private static final String PROFILE_BYTES_WRITTEN = "ArrayOutput.bytesWritten";
+
   private byte[] _buffer;
   private WritableByteChannel _wbc;
   private DataOutput _do;
@@ -550,4 +568,16 @@ public class ArrayOutputAdapter implements ArrayOutput {
   private LongBuffer _lb;
   private FloatBuffer _fb;
   private DoubleBuffer _db;
+
+  // Drains the specified number of bytes from the buffer.
+  private void drain(int nbyte) throws IOException {
+    Profiler.count(PROFILE_BYTES_WRITTEN,nbyte);
+    if (_wbc!=null) {
+      _bb.position(0).limit(nbyte);
+      while (_bb.hasRemaining())
+        _wbc.write(_bb);
+    } else {
+      _do.write(_buffer,0,nbyte);
+    }
+  }
 }
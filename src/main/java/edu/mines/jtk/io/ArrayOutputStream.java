@@ -100,6 +100,32 @@ public class ArrayOutputStream
     this(new FileOutputStream(file),bo);
   }
 
+  /**
+   * Constructs an array output stream for the specified file output stream,
+   * byte order, and method of writing arrays. If direct, arrays of values
+   * are converted in bulk into a direct byte buffer and written to the file
+   * channel of the file output stream, without intermediate byte arrays.
+   * Individual values are then not buffered, so direct writing is most
+   * efficient for streams of large arrays, such as float[n3][n2][n1].
+   * @param fos the file output stream.
+   * @param bo the byte order.
+   * @param direct true, to write arrays directly to the file channel;
+   *  false, to write through a buffered output stream.
+   */
+  public ArrayOutputStream(
+    FileOutputStream fos, ByteOrder bo, boolean direct) 
+  {
+    super(fos);
+    if (direct) {
+      _dos = new DataOutputStream(fos);
+      _ao = new ArrayOutputAdapter(fos.getChannel(),_dos,bo);
+    } else {
+      _dos = new DataOutputStream(new BufferedOutputStream(fos));
+      _ao = new ArrayOutputAdapter(_dos,bo);
+    }
+    _bo = bo;
+  }
+
   public void flush() throws IOException {
     _dos.flush();
     super.flush();
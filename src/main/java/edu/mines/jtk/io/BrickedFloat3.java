@@ -0,0 +1,405 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.io;
+
+import java.io.IOException;
+import java.nio.ByteOrder;
+import java.nio.FloatBuffer;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.channels.NonWritableChannelException;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import static java.lang.Math.max;
+import static java.lang.Math.min;
+
+import edu.mines.jtk.util.Check;
+import edu.mines.jtk.util.Float3;
+
+/**
+ * A 3-D array of floats stored in bricks in an array file. Implements the
+ * generic interface {@link edu.mines.jtk.util.Float3} without reading the
+ * entire array into memory. Only those bricks that contain the elements
+ * of a requested subarray are memory-mapped, and the number of mapped
+ * bricks is bounded by a specified cache size. Bricks not recently used
+ * are released first.
+ * <p>
+ * The 3-D array is logically float a[n3][n2][n1]. It is stored as an
+ * array of bricks, each brick with dimensions [m3][m2][m1], such that
+ * n1 is the fastest dimension within each brick, and bricks are stored
+ * in the same order (1st dimension fastest) as their elements. Bricks
+ * that extend beyond the array bounds are padded in the file, so that
+ * every brick has the same size.
+ * <p>
+ * Bricks with dimensions [1][n2][n1] correspond to the usual unbricked
+ * layout of a[n3][n2][n1], so that files written by, for example,
+ * {@link ArrayOutput#writeFloats(float[][][])} may be accessed without
+ * conversion. Smaller bricks, such as [64][64][64], make access to slices
+ * in the 2nd and 3rd dimensions efficient as well.
+ * <p>
+ * Elements are stored with the byte order for reading of the array file.
+ * If the array file may be written, then it will be lengthened as
+ * necessary when bricks are mapped. If read-only, then attempts to set
+ * elements will cause {@link java.nio.ReadOnlyBufferException}. Other
+ * i/o errors are rethrown as runtime exceptions, because the methods of
+ * the interface Float3 cannot throw checked exceptions.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+public class BrickedFloat3 implements Float3 {
+
+  /**
+   * Constructs a bricked array for the specified file.
+   * The array is stored beginning at byte offset zero in the file, and
+   * the cache can hold at least one layer of bricks in any dimension.
+   * @param af the array file.
+   * @param n1 the 1st dimension of the array[n3][n2][n1].
+   * @param n2 the 2nd dimension of the array[n3][n2][n1].
+   * @param n3 the 3rd dimension of the array[n3][n2][n1].
+   * @param m1 the 1st dimension of bricks in the file.
+   * @param m2 the 2nd dimension of bricks in the file.
+   * @param m3 the 3rd dimension of bricks in the file.
+   */
+  public BrickedFloat3(
+    ArrayFile af,
+    int n1, int n2, int n3,
+    int m1, int m2, int m3)
+  {
+    this(af,0L,n1,n2,n3,m1,m2,m3,0);
+  }
+
+  /**
+   * Constructs a bricked array for the specified file.
+   * @param af the array file.
+   * @param offset the byte offset in the file of the first brick.
+   * @param n1 the 1st dimension of the array[n3][n2][n1].
+   * @param n2 the 2nd dimension of the array[n3][n2][n1].
+   * @param n3 the 3rd dimension of the array[n3][n2][n1].
+   * @param m1 the 1st dimension of bricks in the file.
+   * @param m2 the 2nd dimension of bricks in the file.
+   * @param m3 the 3rd dimension of bricks in the file.
+   * @param nc the maximum number of bricks mapped at any time. If zero,
+   *  the cache can hold at least one layer of bricks in any dimension.
+   */
+  public BrickedFloat3(
+    ArrayFile af, long offset,
+    int n1, int n2, int n3,
+    int m1, int m2, int m3,
+    int nc)
+  {
+    Check.argument(offset>=0,"offset>=0");
+    Check.argument(n1>0 && n2>0 && n3>0,"n1, n2 and n3 are positive");
+    Check.argument(m1>0 && m2>0 && m3>0,"m1, m2 and m3 are positive");
+    Check.argument(4L*m1*m2*m3<=Integer.MAX_VALUE,"brick size < 2 GB");
+    Check.argument(nc>=0,"nc>=0");
+    _n1 = n1;  _n2 = n2;  _n3 = n3;
+    _m1 = m1;  _m2 = m2;  _m3 = m3;
+    _nb1 = 1+(n1-1)/m1;
+    _nb2 = 1+(n2-1)/m2;
+    _nb3 = 1+(n3-1)/m3;
+    _nm12 = m1*m2;
+    _nbyte = 4L*m1*m2*m3;
+    _offset = offset;
+    _bo = af.getByteOrderRead();
+    _fc = af.getChannel();
+    if (nc==0)
+      nc = max(_nb1*_nb2,max(_nb1*_nb3,_nb2*_nb3));
+    _nc = nc;
+    _cache = new LinkedHashMap<Long,Brick>(16,0.75f,true) {
+      protected boolean removeEldestEntry(Map.Entry<Long,Brick> eldest) {
+        return size()>_nc;
+      }
+    };
+    try {
+      _mode = FileChannel.MapMode.READ_WRITE;
+      try {
+        _fc.map(_mode,offset,0);
+      } catch (NonWritableChannelException e) {
+        _mode = FileChannel.MapMode.READ_ONLY;
+      }
+      if (_mode==FileChannel.MapMode.READ_ONLY) {
+        long nbyte = offset+_nbyte*_nb1*_nb2*_nb3;
+        Check.argument(_fc.size()>=nbyte,"read-only file is long enough");
+      }
+    } catch (IOException ioe) {
+      throw new RuntimeException(ioe);
+    }
+  }
+
+  /**
+   * Gets the maximum number of bricks mapped at any time.
+   * @return the cache size, in bricks.
+   */
+  public int getCacheSize() {
+    return _nc;
+  }
+
+  /**
+   * Determines whether elements of this array can be set.
+   * @return true, if writable; false, if read-only.
+   */
+  public boolean isWritable() {
+    return _mode==FileChannel.MapMode.READ_WRITE;
+  }
+
+  /**
+   * Gets the element with specified indices.
+   * @param i1 index in 1st dimension.
+   * @param i2 index in 2nd dimension.
+   * @param i3 index in 3rd dimension.
+   * @return the element.
+   */
+  public float get(int i1, int i2, int i3) {
+    return brick(i1/_m1,i2/_m2,i3/_m3).get(index(i1,i2,i3));
+  }
+
+  /**
+   * Sets the element with specified indices.
+   * @param i1 index in 1st dimension.
+   * @param i2 index in 2nd dimension.
+   * @param i3 index in 3rd dimension.
+   * @param v the element value.
+   */
+  public void set(int i1, int i2, int i3, float v) {
+    brick(i1/_m1,i2/_m2,i3/_m3).put(index(i1,i2,i3),v);
+  }
+
+  /**
+   * Forces any changes for bricks currently mapped to be written to
+   * the storage device that contains the file. Changes to bricks that
+   * are no longer in the cache will be written by the operating system.
+   */
+  public synchronized void flush() {
+    for (Brick b:_cache.values())
+      b.bb.force();
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // interface Float3
+
+  public int getN1() {
+    return _n1;
+  }
+
+  public int getN2() {
+    return _n2;
+  }
+
+  public int getN3() {
+    return _n3;
+  }
+
+  public void get1(int m1, int j1, int j2, int j3, float[] s) {
+    getRow(m1,j1,j2,j3,s,0);
+  }
+
+  public void get2(int m2, int j1, int j2, int j3, float[] s) {
+    int k1 = j1/_m1, k3 = j3/_m3;
+    for (int i2=j2,i2e=j2+m2,is=0; i2<i2e;) {
+      int k2 = i2/_m2;
+      int l2 = min(i2e,(k2+1)*_m2)-i2;
+      FloatBuffer fb = brick(k1,k2,k3);
+      for (int i=index(j1,i2,j3),ie=i+l2*_m1; i<ie; i+=_m1)
+        s[is++] = fb.get(i);
+      i2 += l2;
+    }
+  }
+
+  public void get3(int m3, int j1, int j2, int j3, float[] s) {
+    int k1 = j1/_m1, k2 = j2/_m2;
+    for (int i3=j3,i3e=j3+m3,is=0; i3<i3e;) {
+      int k3 = i3/_m3;
+      int l3 = min(i3e,(k3+1)*_m3)-i3;
+      FloatBuffer fb = brick(k1,k2,k3);
+      for (int i=index(j1,j2,i3),ie=i+l3*_nm12; i<ie; i+=_nm12)
+        s[is++] = fb.get(i);
+      i3 += l3;
+    }
+  }
+
+  public void get12(int m1, int m2, int j1, int j2, int j3, float[][] s) {
+    for (int i2=0; i2<m2; ++i2)
+      getRow(m1,j1,j2+i2,j3,s[i2],0);
+  }
+
+  public void get13(int m1, int m3, int j1, int j2, int j3, float[][] s) {
+    for (int i3=0; i3<m3; ++i3)
+      getRow(m1,j1,j2,j3+i3,s[i3],0);
+  }
+
+  public void get23(int m2, int m3, int j1, int j2, int j3, float[][] s) {
+    for (int i3=0; i3<m3; ++i3)
+      get2(m2,j1,j2,j3+i3,s[i3]);
+  }
+
+  public void get123(
+    int m1, int m2, int m3,
+    int j1, int j2, int j3,
+    float[][][] s)
+  {
+    for (int i3=0; i3<m3; ++i3)
+      for (int i2=0; i2<m2; ++i2)
+        getRow(m1,j1,j2+i2,j3+i3,s[i3][i2],0);
+  }
+
+  public void get123(
+    int m1, int m2, int m3,
+    int j1, int j2, int j3,
+    float[] s)
+  {
+    for (int i3=0,is=0; i3<m3; ++i3)
+      for (int i2=0; i2<m2; ++i2,is+=m1)
+        getRow(m1,j1,j2+i2,j3+i3,s,is);
+  }
+
+  public void set1(int m1, int j1, int j2, int j3, float[] s) {
+    setRow(m1,j1,j2,j3,s,0);
+  }
+
+  public void set2(int m2, int j1, int j2, int j3, float[] s) {
+    int k1 = j1/_m1, k3 = j3/_m3;
+    for (int i2=j2,i2e=j2+m2,is=0; i2<i2e;) {
+      int k2 = i2/_m2;
+      int l2 = min(i2e,(k2+1)*_m2)-i2;
+      FloatBuffer fb = brick(k1,k2,k3);
+      for (int i=index(j1,i2,j3),ie=i+l2*_m1; i<ie; i+=_m1)
+        fb.put(i,s[is++]);
+      i2 += l2;
+    }
+  }
+
+  public void set3(int m3, int j1, int j2, int j3, float[] s) {
+    int k1 = j1/_m1, k2 = j2/_m2;
+    for (int i3=j3,i3e=j3+m3,is=0; i3<i3e;) {
+      int k3 = i3/_m3;
+      int l3 = min(i3e,(k3+1)*_m3)-i3;
+      FloatBuffer fb = brick(k1,k2,k3);
+      for (int i=index(j1,j2,i3),ie=i+l3*_nm12; i<ie; i+=_nm12)
+        fb.put(i,s[is++]);
+      i3 += l3;
+    }
+  }
+
+  public void set12(int m1, int m2, int j1, int j2, int j3, float[][] s) {
+    for (int i2=0; i2<m2; ++i2)
+      setRow(m1,j1,j2+i2,j3,s[i2],0);
+  }
+
+  public void set13(int m1, int m3, int j1, int j2, int j3, float[][] s) {
+    for (int i3=0; i3<m3; ++i3)
+      setRow(m1,j1,j2,j3+i3,s[i3],0);
+  }
+
+  public void set23(int m2, int m3, int j1, int j2, int j3, float[][] s) {
+    for (int i3=0; i3<m3; ++i3)
+      set2(m2,j1,j2,j3+i3,s[i3]);
+  }
+
+  public void set123(
+    int m1, int m2, int m3,
+    int j1, int j2, int j3,
+    float[][][] s)
+  {
+    for (int i3=0; i3<m3; ++i3)
+      for (int i2=0; i2<m2; ++i2)
+        setRow(m1,j1,j2+i2,j3+i3,s[i3][i2],0);
+  }
+
+  public void set123(
+    int m1, int m2, int m3,
+    int j1, int j2, int j3,
+    float[] s)
+  {
+    for (int i3=0,is=0; i3<m3; ++i3)
+      for (int i2=0; i2<m2; ++i2,is+=m1)
+        setRow(m1,j1,j2+i2,j3+i3,s,is);
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // private
+
+  private int _n1,_n2,_n3; // array dimensions
+  private int _m1,_m2,_m3; // brick dimensions
+  private int _nb1,_nb2,_nb3; // numbers of bricks in each dimension
+  private int _nm12; // number of elements in one 2-D slice of a brick
+  private long _nbyte; // number of bytes per brick
+  private long _offset; // byte offset of first brick in file
+  private int _nc; // maximum number of bricks in cache
+  private ByteOrder _bo;
+  private FileChannel _fc;
+  private FileChannel.MapMode _mode;
+  private LinkedHashMap<Long,Brick> _cache;
+
+  // A mapped brick. The float buffer is shared by all threads, and
+  // must therefore be accessed only with absolute gets and puts, or
+  // via duplicates with their own positions.
+  private static class Brick {
+    MappedByteBuffer bb;
+    FloatBuffer fb;
+  }
+
+  // Index of the specified element within the brick that contains it.
+  private int index(int i1, int i2, int i3) {
+    return i1%_m1+_m1*(i2%_m2)+_nm12*(i3%_m3);
+  }
+
+  // Returns the float buffer for the brick with specified indices,
+  // mapping that brick and releasing the least recently used brick
+  // if necessary.
+  private synchronized FloatBuffer brick(int k1, int k2, int k3) {
+    long kb = k1+_nb1*(k2+(long)_nb2*k3);
+    Brick b = _cache.get(kb);
+    if (b==null) {
+      b = new Brick();
+      try {
+        b.bb = _fc.map(_mode,_offset+kb*_nbyte,_nbyte);
+      } catch (IOException ioe) {
+        throw new RuntimeException(ioe);
+      }
+      b.bb.order(_bo);
+      b.fb = b.bb.asFloatBuffer();
+      _cache.put(kb,b);
+    }
+    return b.fb;
+  }
+
+  // Gets m1 contiguous elements in the 1st dimension.
+  private void getRow(int m1, int j1, int j2, int j3, float[] s, int js) {
+    int k2 = j2/_m2, k3 = j3/_m3;
+    for (int i1=j1,i1e=j1+m1; i1<i1e;) {
+      int k1 = i1/_m1;
+      int l1 = min(i1e,(k1+1)*_m1)-i1;
+      FloatBuffer fb = brick(k1,k2,k3).duplicate();
+      fb.position(index(i1,j2,j3));
+      fb.get(s,js,l1);
+      i1 += l1;
+      js += l1;
+    }
+  }
+
+  // Sets m1 contiguous elements in the 1st dimension.
+  private void setRow(int m1, int j1, int j2, int j3, float[] s, int js) {
+    int k2 = j2/_m2, k3 = j3/_m3;
+    for (int i1=j1,i1e=j1+m1; i1<i1e;) {
+      int k1 = i1/_m1;
+      int l1 = min(i1e,(k1+1)*_m1)-i1;
+      FloatBuffer fb = brick(k1,k2,k3).duplicate();
+      fb.position(index(i1,j2,j3));
+      fb.put(s,js,l1);
+      i1 += l1;
+      js += l1;
+    }
+  }
+}
@@ -0,0 +1,239 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.io;
+
+import java.util.ArrayList;
+import java.util.concurrent.*;
+import static java.lang.Math.max;
+import static java.lang.Math.min;
+
+import edu.mines.jtk.util.Check;
+import edu.mines.jtk.util.Float3;
+
+/**
+ * A pipeline of filters applied to a 3-D array one slab at a time.
+ * Each slab is a contiguous range of indices in the 3rd (slowest)
+ * dimension of arrays logically indexed as a[n3][n2][n1]. Memory
+ * required by the pipeline is proportional to the slab size, not to
+ * the size of the entire array.
+ * <p>
+ * Slabs are read from an input {@link edu.mines.jtk.util.Float3}, such
+ * as a {@link BrickedFloat3} for an array file, by a background thread
+ * that reads the next slab while filters are applied to the current
+ * slab. Filtered slabs are written to an output Float3 by another
+ * background thread, so that input, computation and output overlap.
+ * <p>
+ * Filters that depend on samples in adjacent slices, such as smoothing
+ * filters, require a halo of slices on both sides of each slab. The
+ * halo should be large enough that the filtered output for slices in
+ * the slab interior does not depend significantly on slices outside
+ * the halo. Slices in halos are read and filtered, but only those for
+ * the slab interior are written. For example,
+ * <pre><code>
+ * final RecursiveGaussianFilter rgf = new RecursiveGaussianFilter(2.0);
+ * SlabPipeline sp = new SlabPipeline(32,8); // 8 &gt; 3*sigma
+ * sp.addFilter(new SlabPipeline.Filter() {
+ *   public void apply(int j3, float[][][] x, float[][][] y) {
+ *     rgf.apply000(x,y);
+ *   }
+ * });
+ * sp.apply(new BrickedFloat3(...),new BrickedFloat3(...));
+ * </code></pre>
+ * Input and output arrays must be distinct, because the input halo for
+ * one slab may be read while output for the previous slab is written.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+public class SlabPipeline {
+
+  /**
+   * A filter applied to a slab of a 3-D array.
+   */
+  public interface Filter {
+
+    /**
+     * Applies this filter to the specified slab.
+     * Input and output arrays are distinct and have the same dimensions.
+     * Values in the output array on entry are unspecified, and arrays
+     * are reused for later slabs, so filters must not retain them.
+     * @param j3 index in the 3rd dimension of the first slice in the
+     *  slab, including any halo.
+     * @param x input array[m3][n2][n1] for the slab.
+     * @param y output array[m3][n2][n1] for the slab.
+     */
+    public void apply(int j3, float[][][] x, float[][][] y);
+  }
+
+  /**
+   * Constructs a pipeline with specified slab size and no halo.
+   * @param m3 the number of slices in the interior of each slab.
+   */
+  public SlabPipeline(int m3) {
+    this(m3,0);
+  }
+
+  /**
+   * Constructs a pipeline with specified slab and halo sizes.
+   * @param m3 the number of slices in the interior of each slab.
+   * @param h3 the number of slices in the halo on each side of a slab.
+   */
+  public SlabPipeline(int m3, int h3) {
+    Check.argument(m3>0,"m3>0");
+    Check.argument(h3>=0,"h3>=0");
+    _m3 = m3;
+    _h3 = h3;
+  }
+
+  /**
+   * Appends the specified filter to this pipeline. Filters are applied
+   * to each slab in the order in which they were added.
+   * @param filter the filter.
+   */
+  public void addFilter(Filter filter) {
+    _filters.add(filter);
+  }
+
+  /**
+   * Applies the filters in this pipeline to all slabs of an array.
+   * If this pipeline has no filters, the input array is copied.
+   * @param x input array.
+   * @param y output array, distinct from the input array.
+   */
+  public void apply(final Float3 x, final Float3 y) {
+    Check.argument(x!=y,"x and y are distinct");
+    final int n1 = x.getN1();
+    final int n2 = x.getN2();
+    final int n3 = x.getN3();
+    Check.argument(y.getN1()==n1,"y.getN1()==x.getN1()");
+    Check.argument(y.getN2()==n2,"y.getN2()==x.getN2()");
+    Check.argument(y.getN3()==n3,"y.getN3()==x.getN3()");
+    final SlicePool pool = new SlicePool(n1,n2);
+    ExecutorService reader = Executors.newSingleThreadExecutor();
+    ExecutorService writer = Executors.newSingleThreadExecutor();
+    try {
+      Future<Slab> next = reader.submit(readTask(pool,x,0));
+      Future<?> written = null;
+      for (int k3=0; k3<n3; k3+=_m3) {
+        final Slab s = next.get();
+        if (k3+_m3<n3)
+          next = reader.submit(readTask(pool,x,k3+_m3));
+        filter(pool,s);
+        if (written!=null)
+          written.get();
+        written = writer.submit(new Runnable() {
+          public void run() {
+            int l3 = s.k3-s.j3;
+            int m1 = y.getN1();
+            int m2 = y.getN2();
+            for (int i3=0; i3<s.m3; ++i3)
+              y.set12(m1,m2,0,0,s.k3+i3,s.a[l3+i3]);
+            pool.give(s.a);
+          }
+        });
+      }
+      written.get();
+    } catch (InterruptedException e) {
+      Thread.currentThread().interrupt();
+      throw new RuntimeException(e);
+    } catch (ExecutionException e) {
+      Throwable t = e.getCause();
+      if (t instanceof RuntimeException)
+        throw (RuntimeException)t;
+      if (t instanceof Error)
+        throw (Error)t;
+      throw new RuntimeException(t);
+    } finally {
+      reader.shutdownNow();
+      writer.shutdownNow();
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // private
+
+  private int _m3; // number of slices in slab interior
+  private int _h3; // number of slices in halo on each side
+  private ArrayList<Filter> _filters = new ArrayList<Filter>();
+
+  // A slab with halo. Slices [j3,j3+a.length) are in the array a, but
+  // only the interior slices [k3,k3+m3) are written to output.
+  private static class Slab {
+    int j3,k3,m3;
+    float[][][] a;
+  }
+
+  // Slices shared by all slabs in one application of the pipeline.
+  // A slab holds at most m3+2*h3 slices, and at most four slabs' worth
+  // are in use at once: one read, one filtered in place of another,
+  // and one written. Slices are allocated only when the pool is empty,
+  // so after the first few slabs no more are allocated.
+  private static class SlicePool {
+    SlicePool(int n1, int n2) {
+      _n1 = n1;
+      _n2 = n2;
+    }
+    float[][][] take(int l3) {
+      float[][][] a = new float[l3][][];
+      for (int i3=0; i3<l3; ++i3) {
+        a[i3] = _free.poll();
+        if (a[i3]==null)
+          a[i3] = new float[_n2][_n1];
+      }
+      return a;
+    }
+    void give(float[][][] a) {
+      for (float[][] ai : a)
+        _free.offer(ai);
+    }
+    private int _n1,_n2;
+    private ConcurrentLinkedQueue<float[][]> _free =
+      new ConcurrentLinkedQueue<float[][]>();
+  }
+
+  private Callable<Slab> readTask(
+    final SlicePool pool, final Float3 x, final int k3)
+  {
+    return new Callable<Slab>() {
+      public Slab call() {
+        int n1 = x.getN1();
+        int n2 = x.getN2();
+        int n3 = x.getN3();
+        Slab s = new Slab();
+        s.k3 = k3;
+        s.m3 = min(_m3,n3-k3);
+        s.j3 = max(0,k3-_h3);
+        int l3 = min(n3,k3+s.m3+_h3)-s.j3;
+        s.a = pool.take(l3);
+        x.get123(n1,n2,l3,0,0,s.j3,s.a);
+        return s;
+      }
+    };
+  }
+
+  // Applies all filters to the slab, replacing its array with the output.
+  private void filter(SlicePool pool, Slab s) {
+    int nf = _filters.size();
+    if (nf==0)
+      return;
+    float[][][] a = s.a;
+    float[][][] b = pool.take(a.length);
+    for (int jf=0; jf<nf; ++jf) {
+      _filters.get(jf).apply(s.j3,a,b);
+      float[][][] t = a;  a = b;  b = t;
+    }
+    s.a = a;
+    pool.give(b);
+  }
+}
@@ -684,21 +684,7 @@ public class DMatrix {
     Check.argument(_n==b._m,
       "number of columns in A equals number of rows in B");
     DMatrix c = new DMatrix(_m,b._n);
-    double[][] aa = _a;
-    double[][] ba = b._a;
-    double[][] ca = c._a;
-    double[] bj = new double[_n];
-    for (int j=0; j<b._n; ++j) {
-      for (int k=0; k<_n; ++k)
-        bj[k] = ba[k][j];
-      for (int i=0; i<_m; ++i) {
-        double[] ai = aa[i];
-        double s = 0.0;
-        for (int k=0; k<_n; ++k)
-          s += ai[k]*bj[k];
-        ca[i][j] = s;
-      }
-    }
+    Dgemm.mul(false,false,_m,b._n,_n,1.0,_a,0,0,b._a,0,0,1.0,c._a,0,0);
     return c;
   }
 
@@ -52,50 +52,61 @@ public class DMatrixLud {
     for (int i=0; i<m; ++i)
       _piv[i] = i;
     _pivsign = 1;
-    double[] lurowi;
-    double[] lucolj = new double[m];
-
-    // A left-looking, dot-product, Crout/Doolittle algorithm.
-    for (int j=0; j<n; ++j) {
-
-      // Copy the j'th column to reduce cost in inner dot-product loop.
-      for (int i=0; i<m; ++i)
-        lucolj[i] = lu[i][j];
-
-      // Apply previous transformations
-      for (int i=0; i<m; ++i) {
-        lurowi = lu[i];
-
-        // Dot product.
-        int kmax = min(i,j);
-        double s = 0.0;
-        for (int k=0; k<kmax; ++k)
-          s += lurowi[k]*lucolj[k];
-        lurowi[j] = lucolj[i] -= s;
-      }
 
-      // Find pivot and exchange if necessary.
-      int p = j;
-      for (int i=j+1; i<m; ++i) {
-        if (abs(lucolj[i])>abs(lucolj[p]))
-          p = i;
+    // A right-looking algorithm, blocked so that most of the work is in
+    // matrix multiplication. For each block of NB columns, (1) factor
+    // the block, exchanging entire rows while pivoting, (2) solve for
+    // the corresponding rows of U, and (3) update the trailing submatrix.
+    int mn = min(m,n);
+    for (int j0=0; j0<mn; j0+=NB) {
+      int j1 = min(j0+NB,mn);
+
+      // (1) Factor columns in this block.
+      for (int j=j0; j<j1; ++j) {
+
+        // Find pivot and exchange rows if necessary.
+        int p = j;
+        for (int i=j+1; i<m; ++i) {
+          if (abs(lu[i][j])>abs(lu[p][j]))
+            p = i;
+        }
+        if (p!=j) {
+          double[] t = lu[p];
+          lu[p] = lu[j];
+          lu[j] = t;
+          int k = _piv[p];
+          _piv[p] = _piv[j];
+          _piv[j] = k;
+          _pivsign = -_pivsign;
+        }
+
+        // Compute multipliers and update remaining columns in block.
+        double[] luj = lu[j];
+        if (luj[j]!=0.0) {
+          for (int i=j+1; i<m; ++i) {
+            double[] lui = lu[i];
+            double lij = lui[j] /= luj[j];
+            for (int k=j+1; k<j1; ++k)
+              lui[k] -= lij*luj[k];
+          }
+        }
       }
-      if (p!=j) {
-        for (int k=0; k<n; ++k) {
-          double t = lu[p][k];
-          lu[p][k] = lu[j][k];
-          lu[j][k] = t;
+
+      // (2) Solve L11*U12 = A12 for the rows U12 of U.
+      for (int j=j0; j<j1; ++j) {
+        double[] luj = lu[j];
+        for (int i=j+1; i<j1; ++i) {
+          double[] lui = lu[i];
+          double lij = lui[j];
+          for (int k=j1; k<n; ++k)
+            lui[k] -= lij*luj[k];
         }
-        int k = _piv[p];
-        _piv[p] = _piv[j];
-        _piv[j] = k;
-        _pivsign = -_pivsign;
       }
 
-      // Compute multipliers.
-      if (j<m && lu[j][j]!=0.0) {
-        for (int i=j+1; i<m; ++i)
-          lu[i][j] /= lu[j][j];
+      // (3) Update the trailing submatrix A22 -= L21*U12.
+      if (j1<m && j1<n) {
+        Dgemm.mul(false,false,m-j1,n-j1,j1-j0,
+                  -1.0,lu,j1,j0,lu,j0,j1,1.0,lu,j1,j1);
       }
     }
   }
@@ -227,6 +238,9 @@ public class DMatrixLud {
   ///////////////////////////////////////////////////////////////////////////
   // private
 
+  // Number of columns in blocks.
+  private static final int NB = 32;
+
   int _m,_n;
   double[][] _lu;
   int[] _piv;
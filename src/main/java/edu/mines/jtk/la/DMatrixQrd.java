@@ -15,6 +15,7 @@ limitations under the License.
 package edu.mines.jtk.la;
 
 import static java.lang.Math.hypot;
+import static java.lang.Math.min;
 
 import edu.mines.jtk.util.Check;
 
@@ -51,34 +52,41 @@ public class DMatrixQrd {
     _qr = a.get();
     _rdiag = new double[_n];
 
-    // Main loop.
-    for (int k=0; k<n; ++k) {
+    // For each block of NB columns, compute Householder transformations
+    // and apply them to remaining columns in that block. Then apply all 
+    // transformations for the block to the trailing columns at once.
+    for (int k0=0; k0<n; k0+=NB) {
+      int k1 = min(k0+NB,n);
+      for (int k=k0; k<k1; ++k) {
 
-      // Compute 2-norm of k-th column without under/overflow.
-      double nrm = 0;
-      for (int i=k; i<m; ++i)
-        nrm = hypot(nrm,_qr[i][k]);
-
-      if (nrm!=0.0) {
-
-        // Form k-th Householder vector.
-        if (_qr[k][k]<0.0)
-          nrm = -nrm;
+        // Compute 2-norm of k-th column without under/overflow.
+        double nrm = 0;
         for (int i=k; i<m; ++i)
-          _qr[i][k] /= nrm;
-        _qr[k][k] += 1.0;
+          nrm = hypot(nrm,_qr[i][k]);
 
-        // Apply transformation to remaining columns.
-        for (int j=k+1; j<n; ++j) {
-          double s = 0.0; 
-          for (int i=k; i<m; ++i)
-            s += _qr[i][k]*_qr[i][j];
-          s = -s/_qr[k][k];
+        if (nrm!=0.0) {
+
+          // Form k-th Householder vector.
+          if (_qr[k][k]<0.0)
+            nrm = -nrm;
           for (int i=k; i<m; ++i)
-            _qr[i][j] += s*_qr[i][k];
+            _qr[i][k] /= nrm;
+          _qr[k][k] += 1.0;
+
+          // Apply transformation to remaining columns in block.
+          for (int j=k+1; j<k1; ++j) {
+            double s = 0.0; 
+            for (int i=k; i<m; ++i)
+              s += _qr[i][k]*_qr[i][j];
+            s = -s/_qr[k][k];
+            for (int i=k; i<m; ++i)
+              _qr[i][j] += s*_qr[i][k];
+          }
         }
+        _rdiag[k] = -nrm;
       }
-      _rdiag[k] = -nrm;
+      if (k1<n)
+        applyBlock(k0,k1);
     }
   }
 
@@ -183,7 +191,72 @@ public class DMatrixQrd {
   ///////////////////////////////////////////////////////////////////////////
   // private
 
+  // Number of columns in blocks.
+  private static final int NB = 32;
+
   int _m,_n;
   double[][] _qr;
   double[] _rdiag;
+
+  /**
+   * Applies the Householder transformations for columns [k0,k1) to the
+   * trailing columns [k1,n). The product of these transformations is
+   * H = I - V*T*V', where columns of V are the Householder vectors and
+   * T is upper triangular, so that the trailing columns A2 are replaced
+   * by H'*A2 = A2 - V*(T'*(V'*A2)), with most work done by matrix
+   * multiplication.
+   */
+  private void applyBlock(int k0, int k1) {
+    int m = _m-k0;
+    int nb = k1-k0;
+    int n2 = _n-k1;
+
+    // Householder vectors V, with zeros above the diagonal, and scale
+    // factors tau, such that each transformation is I - tau*v*v'.
+    double[][] v = new double[m][nb];
+    double[] tau = new double[nb];
+    for (int j=0; j<nb; ++j) {
+      for (int i=j; i<m; ++i)
+        v[i][j] = _qr[k0+i][k0+j];
+      tau[j] = (v[j][j]!=0.0)?1.0/v[j][j]:0.0;
+    }
+
+    // Upper triangular T, computed column by column.
+    double[][] t = new double[nb][nb];
+    double[] z = new double[nb];
+    for (int j=0; j<nb; ++j) {
+      for (int jj=0; jj<j; ++jj) {
+        double s = 0.0;
+        for (int i=j; i<m; ++i)
+          s += v[i][jj]*v[i][j];
+        z[jj] = s;
+      }
+      for (int ii=0; ii<j; ++ii) {
+        double s = 0.0;
+        for (int jj=ii; jj<j; ++jj)
+          s += t[ii][jj]*z[jj];
+        t[ii][j] = -tau[j]*s;
+      }
+      t[j][j] = tau[j];
+    }
+
+    // W = T'*(V'*A2), where T' is lower triangular.
+    double[][] w = new double[nb][n2];
+    Dgemm.mul(true,false,nb,n2,m,1.0,v,0,0,_qr,k0,k1,0.0,w,0,0);
+    for (int i=nb-1; i>=0; --i) {
+      double[] wi = w[i];
+      double tii = t[i][i];
+      for (int j=0; j<n2; ++j)
+        wi[j] *= tii;
+      for (int ii=0; ii<i; ++ii) {
+        double[] wii = w[ii];
+        double tiii = t[ii][i];
+        for (int j=0; j<n2; ++j)
+          wi[j] += tiii*wii[j];
+      }
+    }
+
+    // A2 -= V*W.
+    Dgemm.mul(false,false,m,n2,nb,-1.0,v,0,0,w,0,0,1.0,_qr,k0,k1);
+  }
 }
@@ -0,0 +1,415 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.la;
+
+import edu.mines.jtk.util.Check;
+import edu.mines.jtk.util.Parallel;
+
+/**
+ * General double-precision matrix multiplication C = alpha*op(A)*op(B)
+ * + beta*C, where op(X) is either X or X transposed.
+ * <p>
+ * Matrices may be stored either in arrays of arrays, x[i][j], as in
+ * {@link DMatrix}, or in column-major packed arrays, x[i+j*ldx], as
+ * required by BLAS and LAPACK. For both storage formats, methods of
+ * this class multiply blocks of rows of op(A) and columns of op(B)
+ * that are copied (packed) into contiguous arrays small enough to
+ * remain in cache, and accumulate 4-by-4 tiles of C in registers.
+ * Blocks of C are computed in parallel.
+ * <p>
+ * The result matrix C must not share elements with either A or B.
+ * Blocks of C are computed in an order that does not depend on the
+ * number of threads, so results are reproducible. However, because
+ * sums are accumulated in an order that differs from that of simple
+ * dot products, results may differ from those of simple loops by
+ * rounding errors.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+public class Dgemm {
+
+  /**
+   * Computes C = alpha*op(A)*op(B) + beta*C for arrays of arrays.
+   * @param ta true, if op(A) = A'; false, if op(A) = A.
+   * @param tb true, if op(B) = B'; false, if op(B) = B.
+   * @param alpha the scale factor alpha.
+   * @param a array of elements of the matrix A.
+   * @param b array of elements of the matrix B.
+   * @param beta the scale factor beta.
+   * @param c array of elements of the matrix C.
+   */
+  public static void mul(
+    boolean ta, boolean tb, double alpha,
+    double[][] a, double[][] b, double beta, double[][] c)
+  {
+    int m = c.length;
+    if (m==0)
+      return;
+    int n = c[0].length;
+    int k = (ta)?a.length:a[0].length;
+    Check.argument(m==((ta)?a[0].length:a.length),
+      "number of rows in op(A) equals number of rows in C");
+    Check.argument(n==((tb)?b.length:b[0].length),
+      "number of columns in op(B) equals number of columns in C");
+    Check.argument(k==((tb)?b[0].length:b.length),
+      "number of columns in op(A) equals number of rows in op(B)");
+    mul(m,n,k,alpha,
+        new Rows(ta,a,0,0),new Rows(tb,b,0,0),beta,new Rows(false,c,0,0));
+  }
+
+  /**
+   * Computes C = alpha*op(A)*op(B) + beta*C for blocks of arrays of arrays.
+   * The m-by-n block of C begins with element c[ic][jc], the m-by-k
+   * block of op(A) with element op(A)[ia][ja], and the k-by-n block of
+   * op(B) begins with element op(B)[ib][jb]. For example, if op(A) = A',
+   * then the first element of A used is a[ja][ia].
+   * @param ta true, if op(A) = A'; false, if op(A) = A.
+   * @param tb true, if op(B) = B'; false, if op(B) = B.
+   * @param m the number of rows in the blocks of op(A) and C.
+   * @param n the number of columns in the blocks of op(B) and C.
+   * @param k the number of columns in op(A) and rows in op(B).
+   * @param alpha the scale factor alpha.
+   * @param a array of elements of the matrix A.
+   * @param ia the row index in op(A) of the first element.
+   * @param ja the column index in op(A) of the first element.
+   * @param b array of elements of the matrix B.
+   * @param ib the row index in op(B) of the first element.
+   * @param jb the column index in op(B) of the first element.
+   * @param beta the scale factor beta.
+   * @param c array of elements of the matrix C.
+   * @param ic the row index in C of the first element.
+   * @param jc the column index in C of the first element.
+   */
+  public static void mul(
+    boolean ta, boolean tb, int m, int n, int k, double alpha,
+    double[][] a, int ia, int ja,
+    double[][] b, int ib, int jb, double beta,
+    double[][] c, int ic, int jc)
+  {
+    mul(m,n,k,alpha,
+        new Rows(ta,a,ia,ja),new Rows(tb,b,ib,jb),beta,
+        new Rows(false,c,ic,jc));
+  }
+
+  /**
+   * Computes C = alpha*op(A)*op(B) + beta*C for column-major arrays.
+   * Arguments are those of the BLAS function dgemm, except that
+   * transposes are specified by booleans.
+   * @param ta true, if op(A) = A'; false, if op(A) = A.
+   * @param tb true, if op(B) = B'; false, if op(B) = B.
+   * @param m the number of rows in op(A) and C.
+   * @param n the number of columns in op(B) and C.
+   * @param k the number of columns in op(A) and rows in op(B).
+   * @param alpha the scale factor alpha.
+   * @param a array of elements of A.
+   * @param lda the leading dimension of A.
+   * @param b array of elements of B.
+   * @param ldb the leading dimension of B.
+   * @param beta the scale factor beta.
+   * @param c array of elements of C.
+   * @param ldc the leading dimension of C.
+   */
+  public static void mul(
+    boolean ta, boolean tb, int m, int n, int k, double alpha,
+    double[] a, int lda, double[] b, int ldb, double beta,
+    double[] c, int ldc)
+  {
+    Check.argument(ldc>=m,"ldc is not less than m");
+    mul(m,n,k,alpha,
+        new Columns(ta,a,lda),new Columns(tb,b,ldb),beta,
+        new Columns(false,c,ldc));
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // private
+
+  // Block sizes. An MC-by-KC block of op(A) and a KC-by-NC block of op(B)
+  // are packed at a time. Each parallel task multiplies the block of op(A)
+  // by an NT-column slice of the block of op(B), in tiles of MR-by-NR.
+  private static final int MR = 4;
+  private static final int NR = 4;
+  private static final int MC = 128;
+  private static final int KC = 256;
+  private static final int NC = 4096;
+  private static final int NT = 256;
+
+  // Products with fewer multiply-adds are computed serially.
+  private static final long PARALLEL_MIN = 1L<<18;
+
+  /**
+   * Access to elements of op(X), where X is stored in some format.
+   */
+  private static abstract class Storage {
+
+    // Copies the mb-by-kb block of op(X) beginning at (i0,p0) into w, in
+    // panels of MR rows. An incomplete last panel is padded with zeros.
+    abstract void packRows(int i0, int mb, int p0, int kb, double[] w);
+
+    // Copies the kb-by-nb block of op(X) beginning at (p0,j0) into w,
+    // beginning at w[iw], in panels of NR columns. An incomplete last
+    // panel is padded with zeros.
+    abstract void packColumns(
+      int p0, int kb, int j0, int nb, double[] w, int iw);
+
+    // Scales the m-by-n matrix X by beta.
+    abstract void scale(int m, int n, double beta);
+
+    // Adds an mr-by-nr tile t (stored with row stride NR) to X at (i,j).
+    abstract void add(int i, int j, int mr, int nr, double[] t);
+  }
+
+  /**
+   * Elements stored in arrays of arrays, with offsets.
+   */
+  private static class Rows extends Storage {
+    Rows(boolean t, double[][] x, int i0, int j0) {
+      _t = t;
+      _x = x;
+      _i0 = (t)?j0:i0;
+      _j0 = (t)?i0:j0;
+    }
+    void packRows(int i0, int mb, int p0, int kb, double[] w) {
+      for (int i=0,iw=0; i<mb; i+=MR,iw+=MR*kb) {
+        int mr = Math.min(MR,mb-i);
+        for (int ir=0; ir<mr; ++ir) {
+          if (_t) {
+            int jx = _j0+i0+i+ir;
+            for (int p=0,jw=iw+ir; p<kb; ++p,jw+=MR)
+              w[jw] = _x[_i0+p0+p][jx];
+          } else {
+            double[] xi = _x[_i0+i0+i+ir];
+            for (int p=0,jw=iw+ir,jx=_j0+p0; p<kb; ++p,jw+=MR,++jx)
+              w[jw] = xi[jx];
+          }
+        }
+        pad(mr,MR,kb,iw,w);
+      }
+    }
+    void packColumns(int p0, int kb, int j0, int nb, double[] w, int iw) {
+      for (int j=0; j<nb; j+=NR,iw+=NR*kb) {
+        int nr = Math.min(NR,nb-j);
+        for (int jr=0; jr<nr; ++jr) {
+          if (_t) {
+            double[] xj = _x[_i0+j0+j+jr];
+            for (int p=0,jw=iw+jr,jx=_j0+p0; p<kb; ++p,jw+=NR,++jx)
+              w[jw] = xj[jx];
+          } else {
+            int jx = _j0+j0+j+jr;
+            for (int p=0,jw=iw+jr; p<kb; ++p,jw+=NR)
+              w[jw] = _x[_i0+p0+p][jx];
+          }
+        }
+        pad(nr,NR,kb,iw,w);
+      }
+    }
+    void scale(int m, int n, double beta) {
+      for (int i=0; i<m; ++i) {
+        double[] xi = _x[_i0+i];
+        for (int j=0,jx=_j0; j<n; ++j,++jx)
+          xi[jx] = (beta==0.0)?0.0:beta*xi[jx];
+      }
+    }
+    void add(int i, int j, int mr, int nr, double[] t) {
+      for (int ir=0; ir<mr; ++ir) {
+        double[] xi = _x[_i0+i+ir];
+        for (int jr=0,jx=_j0+j,it=ir*NR; jr<nr; ++jr,++jx,++it)
+          xi[jx] += t[it];
+      }
+    }
+    private boolean _t;
+    private double[][] _x;
+    private int _i0,_j0;
+  }
+
+  /**
+   * Elements stored in column-major packed arrays.
+   */
+  private static class Columns extends Storage {
+    Columns(boolean t, double[] x, int ldx) {
+      _t = t;
+      _x = x;
+      _ldx = ldx;
+    }
+    void packRows(int i0, int mb, int p0, int kb, double[] w) {
+      for (int i=0,iw=0; i<mb; i+=MR,iw+=MR*kb) {
+        int mr = Math.min(MR,mb-i);
+        for (int ir=0; ir<mr; ++ir) {
+          if (_t) {
+            int jx = p0+(i0+i+ir)*_ldx;
+            for (int p=0,jw=iw+ir; p<kb; ++p,jw+=MR,++jx)
+              w[jw] = _x[jx];
+          } else {
+            int jx = i0+i+ir+p0*_ldx;
+            for (int p=0,jw=iw+ir; p<kb; ++p,jw+=MR,jx+=_ldx)
+              w[jw] = _x[jx];
+          }
+        }
+        pad(mr,MR,kb,iw,w);
+      }
+    }
+    void packColumns(int p0, int kb, int j0, int nb, double[] w, int iw) {
+      for (int j=0; j<nb; j+=NR,iw+=NR*kb) {
+        int nr = Math.min(NR,nb-j);
+        for (int jr=0; jr<nr; ++jr) {
+          if (_t) {
+            int jx = j0+j+jr+p0*_ldx;
+            for (int p=0,jw=iw+jr; p<kb; ++p,jw+=NR,jx+=_ldx)
+              w[jw] = _x[jx];
+          } else {
+            int jx = p0+(j0+j+jr)*_ldx;
+            for (int p=0,jw=iw+jr; p<kb; ++p,jw+=NR,++jx)
+              w[jw] = _x[jx];
+          }
+        }
+        pad(nr,NR,kb,iw,w);
+      }
+    }
+    void scale(int m, int n, double beta) {
+      for (int j=0; j<n; ++j) {
+        for (int i=0,jx=j*_ldx; i<m; ++i,++jx)
+          _x[jx] = (beta==0.0)?0.0:beta*_x[jx];
+      }
+    }
+    void add(int i, int j, int mr, int nr, double[] t) {
+      for (int jr=0; jr<nr; ++jr) {
+        for (int ir=0,jx=i+(j+jr)*_ldx,it=jr; ir<mr; ++ir,++jx,it+=NR)
+          _x[jx] += t[it];
+      }
+    }
+    private boolean _t;
+    private double[] _x;
+    private int _ldx;
+  }
+
+  // Zeros the rows mr, mr+1, ..., nr-1 of a panel of width nr in w.
+  private static void pad(int mr, int nr, int kb, int iw, double[] w) {
+    for (int ir=mr; ir<nr; ++ir) {
+      for (int p=0,jw=iw+ir; p<kb; ++p,jw+=nr)
+        w[jw] = 0.0;
+    }
+  }
+
+  private static void mul(
+    final int m, final int n, final int k, final double alpha,
+    final Storage a, final Storage b, double beta, final Storage c)
+  {
+    if (m<=0 || n<=0)
+      return;
+    if (beta!=1.0)
+      c.scale(m,n,beta);
+    if (k<=0 || alpha==0.0)
+      return;
+    final boolean parallel = (long)m*n*k>=PARALLEL_MIN;
+
+    // Workspace for a packed block of op(A) and one tile of C. Parallel
+    // tasks must be given their own workspace.
+    final int lap = roundUp(Math.min(MC,m),MR)*Math.min(KC,k);
+    final double[][] ws = (parallel)?null:workspace(lap);
+    final Parallel.Unsafe<double[][]> wu = 
+      (parallel)?new Parallel.Unsafe<double[][]>():null;
+
+    final int nim = (m+MC-1)/MC;
+    double[] bp = null;
+    for (int j0=0; j0<n; j0+=NC) {
+      final int nb = Math.min(NC,n-j0);
+      final int njt = (nb+NT-1)/NT;
+      final int jb = j0;
+      for (int p0=0; p0<k; p0+=KC) {
+        final int kb = Math.min(KC,k-p0);
+        final int pb = p0;
+        final int lbp = kb*roundUp(nb,NR);
+        if (bp==null || bp.length<lbp)
+          bp = new double[lbp];
+        final double[] bpf = bp;
+        if (parallel) {
+          Parallel.loop(0,nb,NT,new Parallel.LoopInt() {
+          public void compute(int j) {
+            int nj = Math.min(NT,nb-j);
+            b.packColumns(pb,kb,jb+j,nj,bpf,j*kb);
+          }});
+        } else {
+          b.packColumns(pb,kb,jb,nb,bpf,0);
+        }
+        Parallel.LoopInt body = new Parallel.LoopInt() {
+        public void compute(int itask) {
+          int i0 = (itask/njt)*MC;
+          int j = (itask%njt)*NT;
+          int mb = Math.min(MC,m-i0);
+          int nj = Math.min(NT,nb-j);
+          double[][] w = ws;
+          if (w==null) {
+            w = wu.get();
+            if (w==null) wu.set(w=workspace(lap));
+          }
+          double[] ap = w[0];
+          double[] t = w[1];
+          a.packRows(i0,mb,pb,kb,ap);
+          for (int jr=0; jr<nj; jr+=NR) {
+            int nr = Math.min(NR,nj-jr);
+            int ib = (j+jr)*kb;
+            for (int ir=0; ir<mb; ir+=MR) {
+              int mr = Math.min(MR,mb-ir);
+              tile(kb,alpha,ap,ir*kb,bpf,ib,t);
+              c.add(i0+ir,jb+j+jr,mr,nr,t);
+            }
+          }
+        }};
+        int ntask = nim*njt;
+        if (parallel && ntask>1) {
+          Parallel.loop(ntask,body);
+        } else {
+          for (int itask=0; itask<ntask; ++itask)
+            body.compute(itask);
+        }
+      }
+    }
+  }
+
+  private static double[][] workspace(int lap) {
+    return new double[][]{new double[lap],new double[MR*NR]};
+  }
+
+  private static int roundUp(int n, int r) {
+    return ((n+r-1)/r)*r;
+  }
+
+  // Multiplies an MR-by-kb panel of op(A) by a kb-by-NR panel of op(B),
+  // both packed, and stores alpha times the product in the tile t.
+  private static void tile(
+    int kb, double alpha, double[] ap, int ia, double[] bp, int ib,
+    double[] t)
+  {
+    double c00 = 0.0, c01 = 0.0, c02 = 0.0, c03 = 0.0;
+    double c10 = 0.0, c11 = 0.0, c12 = 0.0, c13 = 0.0;
+    double c20 = 0.0, c21 = 0.0, c22 = 0.0, c23 = 0.0;
+    double c30 = 0.0, c31 = 0.0, c32 = 0.0, c33 = 0.0;
+    for (int p=0; p<kb; ++p,ia+=MR,ib+=NR) {
+      double a0 = ap[ia  ], a1 = ap[ia+1], a2 = ap[ia+2], a3 = ap[ia+3];
+      double b0 = bp[ib  ], b1 = bp[ib+1], b2 = bp[ib+2], b3 = bp[ib+3];
+      c00 += a0*b0;  c01 += a0*b1;  c02 += a0*b2;  c03 += a0*b3;
+      c10 += a1*b0;  c11 += a1*b1;  c12 += a1*b2;  c13 += a1*b3;
+      c20 += a2*b0;  c21 += a2*b1;  c22 += a2*b2;  c23 += a2*b3;
+      c30 += a3*b0;  c31 += a3*b1;  c32 += a3*b2;  c33 += a3*b3;
+    }
+    t[ 0] = alpha*c00;  t[ 1] = alpha*c01;
+    t[ 2] = alpha*c02;  t[ 3] = alpha*c03;
+    t[ 4] = alpha*c10;  t[ 5] = alpha*c11;
+    t[ 6] = alpha*c12;  t[ 7] = alpha*c13;
+    t[ 8] = alpha*c20;  t[ 9] = alpha*c21;
+    t[10] = alpha*c22;  t[11] = alpha*c23;
+    t[12] = alpha*c30;  t[13] = alpha*c31;
+    t[14] = alpha*c32;  t[15] = alpha*c33;
+  }
+}
@@ -16,6 +16,7 @@ package edu.mines.jtk.lapack;
 
 import org.netlib.blas.BLAS;
 import static edu.mines.jtk.util.ArrayMath.*;
+import edu.mines.jtk.la.Dgemm;
 import edu.mines.jtk.util.Check;
 
 /**
@@ -832,7 +833,11 @@ public class DMatrix {
     Check.argument(_n==b._m,
       "number of columns in A equals number of rows in B");
     DMatrix c = new DMatrix(_m,b._n);
-    _blas.dgemm("N","N",_m,b._n,_n,1.0,_a,_m,b._a,b._m,1.0,c._a,c._m);
+    if (JAVA_BLAS) {
+      Dgemm.mul(false,false,_m,b._n,_n,1.0,_a,_m,b._a,b._m,1.0,c._a,c._m);
+    } else {
+      _blas.dgemm("N","N",_m,b._n,_n,1.0,_a,_m,b._a,b._m,1.0,c._a,c._m);
+    }
     return c;
   }
 
@@ -847,7 +852,11 @@ public class DMatrix {
     Check.argument(_n==b._n,
       "number of columns in A equals number of columns in B");
     DMatrix c = new DMatrix(_m,b._m);
-    _blas.dgemm("N","T",_m,b._n,_n,1.0,_a,_m,b._a,b._m,1.0,c._a,c._m);
+    if (JAVA_BLAS) {
+      Dgemm.mul(false,true,_m,b._m,_n,1.0,_a,_m,b._a,b._m,1.0,c._a,c._m);
+    } else {
+      _blas.dgemm("N","T",_m,b._m,_n,1.0,_a,_m,b._a,b._m,1.0,c._a,c._m);
+    }
     return c;
   }
 
@@ -862,7 +871,11 @@ public class DMatrix {
     Check.argument(_m==b._m,
       "number of rows in A equals number of rows in B");
     DMatrix c = new DMatrix(_n,b._n);
-    _blas.dgemm("T","N",_n,b._n,_m,1.0,_a,_m,b._a,b._m,1.0,c._a,c._m);
+    if (JAVA_BLAS) {
+      Dgemm.mul(true,false,_n,b._n,_m,1.0,_a,_m,b._a,b._m,1.0,c._a,c._m);
+    } else {
+      _blas.dgemm("T","N",_n,b._n,_m,1.0,_a,_m,b._a,b._m,1.0,c._a,c._m);
+    }
     return c;
   }
 
@@ -998,6 +1011,11 @@ public class DMatrix {
 
   private static final BLAS _blas = BLAS.getInstance();
 
+  // If BLAS is not native, but is implemented in Java (translated from
+  // Fortran by F2J), then matrix multiplication is faster with Dgemm.
+  private static final boolean JAVA_BLAS = 
+    _blas.getClass().getName().equals("org.netlib.blas.JBLAS");
+
   private int _m; // number of rows
   private int _n; // number of columns
   private double[] _a; // array[_m*_n] of matrix elements
@@ -0,0 +1,211 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.mesh;
+
+import java.util.Random;
+
+import static edu.mines.jtk.util.ArrayMath.quickIndexSort;
+
+/**
+ * Orders points for incremental insertion into Delaunay meshes.
+ * <p>
+ * Points are ordered by a biased randomized insertion order (BRIO).
+ * After a random shuffle, points are partitioned into rounds of sizes
+ * that approximately double, and the points within each round are
+ * sorted along a Hilbert curve. Consecutive points are then usually
+ * near one another, so that point location can walk a short distance
+ * from the previously inserted point, while the randomness between
+ * rounds preserves the expected complexity of incremental insertion.
+ * <p>
+ * For reference, see Amenta, N., Choi, S., and Rote, G., 2003,
+ * Incremental constructions con BRIO: Proceedings of the 19th Annual
+ * Symposium on Computational Geometry, 211-219.
+ *
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+class SpatialOrder {
+
+  /**
+   * Returns a BRIO ordering of the specified 2-D points.
+   * @param x array of x coordinates.
+   * @param y array of y coordinates.
+   * @return array of point indices, in order of insertion.
+   */
+  static int[] brio(float[] x, float[] y) {
+    int n = x.length;
+    float[][] p = {x,y};
+    return brio(n,hilbertKeys(n,16,p));
+  }
+
+  /**
+   * Returns a BRIO ordering of the specified 3-D points.
+   * @param x array of x coordinates.
+   * @param y array of y coordinates.
+   * @param z array of z coordinates.
+   * @return array of point indices, in order of insertion.
+   */
+  static int[] brio(float[] x, float[] y, float[] z) {
+    int n = x.length;
+    float[][] p = {x,y,z};
+    return brio(n,hilbertKeys(n,21,p));
+  }
+
+  /**
+   * Returns the order of the specified 3-D points along a Hilbert curve.
+   * @param x array of x coordinates.
+   * @param y array of y coordinates.
+   * @param z array of z coordinates.
+   * @return array of point indices, in order along the curve.
+   */
+  static int[] hilbert(float[] x, float[] y, float[] z) {
+    int n = x.length;
+    float[][] p = {x,y,z};
+    int[] order = new int[n];
+    for (int i=0; i<n; ++i)
+      order[i] = i;
+    sortRound(0,n,false,order,hilbertKeys(n,21,p));
+    return order;
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // private
+
+  // Rounds smaller than this are merged into the next larger round.
+  private static final int ROUND_MIN = 64;
+
+  private static int[] brio(int n, long[] keys) {
+
+    // Random shuffle, with a fixed seed so that meshes are reproducible.
+    int[] order = new int[n];
+    for (int i=0; i<n; ++i)
+      order[i] = i;
+    Random r = new Random(314159);
+    for (int i=n-1; i>0; --i) {
+      int j = r.nextInt(i+1);
+      int t = order[i];
+      order[i] = order[j];
+      order[j] = t;
+    }
+
+    // Rounds [lo,hi), each about half the size of the next, sorted.
+    // The direction of sorting alternates, so that each round begins
+    // near the end of the previous round.
+    boolean reverse = false;
+    for (int lo=0,hi=0; hi<n; lo=hi,reverse=!reverse) {
+      hi = (hi<ROUND_MIN)?min(n,ROUND_MIN):min(n,2*hi);
+      sortRound(lo,hi,reverse,order,keys);
+    }
+    return order;
+  }
+
+  private static int min(int a, int b) {
+    return (a<b)?a:b;
+  }
+
+  private static void sortRound(
+    int lo, int hi, boolean reverse, int[] order, long[] keys)
+  {
+    int m = hi-lo;
+    long[] k = new long[m];
+    int[] j = new int[m];
+    int[] o = new int[m];
+    for (int i=0; i<m; ++i) {
+      o[i] = order[lo+i];
+      k[i] = keys[o[i]];
+      j[i] = i;
+    }
+    quickIndexSort(k,j);
+    for (int i=0; i<m; ++i)
+      order[lo+i] = o[j[reverse?m-1-i:i]];
+  }
+
+  /**
+   * Computes Hilbert keys for n points with coordinates in p[0], p[1], ...
+   * quantized to nb bits over their common bounding cube.
+   */
+  private static long[] hilbertKeys(int n, int nb, float[][] p) {
+    int nd = p.length;
+    double[] pmin = new double[nd];
+    double pmax = 0.0;
+    for (int id=0; id<nd; ++id) {
+      float[] pd = p[id];
+      double dmin = Double.MAX_VALUE;
+      double dmax = -Double.MAX_VALUE;
+      for (int i=0; i<n; ++i) {
+        if (pd[i]<dmin) dmin = pd[i];
+        if (pd[i]>dmax) dmax = pd[i];
+      }
+      pmin[id] = dmin;
+      pmax = Math.max(pmax,dmax-dmin);
+    }
+    long qmax = (1L<<nb)-1L;
+    double scale = (pmax>0.0)?qmax/pmax:0.0;
+    long[] keys = new long[n];
+    long[] q = new long[nd];
+    for (int i=0; i<n; ++i) {
+      for (int id=0; id<nd; ++id) {
+        long qi = (long)((p[id][i]-pmin[id])*scale);
+        q[id] = (qi<0L)?0L:(qi>qmax)?qmax:qi;
+      }
+      keys[i] = hilbertKey(nb,q);
+    }
+    return keys;
+  }
+
+  /**
+   * Returns the Hilbert index of the point with nb-bit coordinates q.
+   * Uses the transpose algorithm of Skilling, J., 2004, Programming the
+   * Hilbert curve: AIP Conference Proceedings, 707, 381-387. The array
+   * q is modified.
+   */
+  private static long hilbertKey(int nb, long[] q) {
+    int nd = q.length;
+    long m = 1L<<(nb-1);
+
+    // Inverse undo excess work.
+    for (long b=m; b>1L; b>>=1) {
+      long c = b-1L;
+      for (int id=0; id<nd; ++id) {
+        if ((q[id]&b)!=0L) {
+          q[0] ^= c;
+        } else {
+          long t = (q[0]^q[id])&c;
+          q[0] ^= t;
+          q[id] ^= t;
+        }
+      }
+    }
+
+    // Gray encode.
+    for (int id=1; id<nd; ++id)
+      q[id] ^= q[id-1];
+    long t = 0L;
+    for (long b=m; b>1L; b>>=1) {
+      if ((q[nd-1]&b)!=0L)
+        t ^= b-1L;
+    }
+    for (int id=0; id<nd; ++id)
+      q[id] ^= t;
+
+    // Interleave the transposed bits, most significant first.
+    long key = 0L;
+    for (int ib=nb-1; ib>=0; --ib) {
+      for (int id=0; id<nd; ++id)
+        key = (key<<1)|((q[id]>>ib)&1L);
+    }
+    return key;
+  }
+}
@@ -19,6 +19,7 @@ import java.util.*;
 import javax.swing.event.EventListenerList;
 
 import edu.mines.jtk.util.Check;
+import edu.mines.jtk.util.Profiler;
 import static edu.mines.jtk.util.MathPlus.*;
 
 /**
@@ -2008,88 +2009,89 @@ public class TetMesh implements Serializable {
    * @return true, if the node was added; false, otherwise.
    */
   public synchronized boolean addNode(Node node) {
+    return addNode(node,false);
+  }
 
-    // Where is the point?
-    PointLocation pl = locatePoint(node._x,node._y,node._z);
-
-    // Cannot have two nodes with the same coordinates.
-    if (pl.isOnNode())
-      return false;
-
-    // Tell listeners that node will be added.
-    fireNodeWillBeAdded(node);
-
-    // The new node becomes the root node.
-    if (_nroot==null) {
-      _nroot = node;
-      _nroot._prev = _nroot._next = _nroot;
-    } else {
-      node._next = _nroot;
-      node._prev = _nroot._prev;
-      _nroot._prev._next = node;
-      _nroot._prev = node;
-      _nroot = node;
-    }
-    ++_nnode;
-
-    // Update node property values so they are consistent with this mesh.
-    updatePropertyValues(node);
-
-    // Maintain adequate sampling of O(N^(1/4)) nodes for fast point location.
-    // The scale factor 0.5 was used by Mucke et al., 1996.
-    double factor = 0.5*_sampledNodes.size();
-    if (factor*factor*factor*factor<_nnode) {
-      _sampledNodes.add(node);
-      //trace("addNode: sampling "+_sampledNodes.size()+" nodes");
-    }
-
-    // If we do not yet have a tet, perhaps we have enough nodes to make one.
-    if (pl.isOutside() && _nnode<=4) {
-      if (_nnode==4)
-        createFirstTet();
-
-    // Otherwise, if we have at least one tet, ...
-    } else {
-
-      // Get the set of Delaunay faces that bound the star-shaped 
-      // polyhedron containing all tets that are not Delaunay with 
-      // respect to the new node.
-      clearTetMarks();
-      _faceSet.clear();
-      if (pl.isInside()) {
-        getDelaunayFacesInside(node,pl.tet());
-      } else {
-        getDelaunayFacesOutside(node,pl.tet());
+  /**
+   * Adds the specified nodes to the mesh. Nodes are added in a biased
+   * randomized insertion order, in which nodes that are inserted
+   * consecutively tend to be near one another. Each point location then
+   * begins in the tet most recently created, so that adding many nodes
+   * this way is much faster than adding them one at a time in an
+   * arbitrary order.
+   * <p>
+   * As for the method {@link #addNode(Node)}, no node is added if the
+   * mesh already contains a node with the same (x,y,z) coordinates.
+   * @param nodes array of nodes to add.
+   * @return the number of nodes added.
+   */
+  public synchronized int addNodes(Node[] nodes) {
+    Profiler.start(PROFILE_ADD_NODES);
+    try {
+      int n = nodes.length;
+      float[] x = new float[n];
+      float[] y = new float[n];
+      float[] z = new float[n];
+      for (int i=0; i<n; ++i) {
+        x[i] = nodes[i].x();
+        y[i] = nodes[i].y();
+        z[i] = nodes[i].z();
+      }
+      int[] order;
+      Profiler.start(PROFILE_ORDER);
+      try {
+        order = SpatialOrder.brio(x,y,z);
+      } finally {
+        Profiler.stop(PROFILE_ORDER);
+      }
+      int nadd = 0;
+      for (int i=0; i<n; ++i) {
+        if (addNode(nodes[order[i]],true))
+          ++nadd;
+      }
+      return nadd;
+    } finally {
+      Profiler.stop(PROFILE_ADD_NODES);
+    }
+  }
+
+  /**
+   * Adds nodes with the specified coordinates to the mesh.
+   * The nodes are added as for the method {@link #addNodes(Node[])}.
+   * The index of each new node is the index of its coordinates.
+   * @param x array of x coordinates.
+   * @param y array of y coordinates.
+   * @param z array of z coordinates.
+   * @return array of new nodes; null for any node not added, because
+   *  the mesh already contained a node with the same coordinates.
+   */
+  public synchronized Node[] addNodes(float[] x, float[] y, float[] z) {
+    Check.argument(x.length==y.length,"x.length==y.length");
+    Check.argument(x.length==z.length,"x.length==z.length");
+    Profiler.start(PROFILE_ADD_NODES);
+    try {
+      int n = x.length;
+      Node[] nodes = new Node[n];
+      for (int i=0; i<n; ++i) {
+        nodes[i] = new Node(x[i],y[i],z[i]);
+        nodes[i].index = i;
       }
-
-      // With each Delaunay face in the set, create a new tet with 
-      // the new node. Use an edge set to link tets when a tet and 
-      // its nabor have been created.
-      _edgeSet.clear();
-      for (boolean more=_faceSet.first(); more; more=_faceSet.next()) {
-        Node a = _faceSet.a;
-        Node b = _faceSet.b;
-        Node c = _faceSet.c;
-        Node d = _faceSet.d;
-        Tet abcd = _faceSet.abcd;
-        Tet nabc = makeTet(node,a,b,c);
-        linkTets(nabc,node,abcd,d);
-        if (!_edgeSet.add(a,b,c,nabc))
-          linkTets(_edgeSet.nabc,_edgeSet.c,nabc,c);
-        if (!_edgeSet.add(b,c,a,nabc))
-          linkTets(_edgeSet.nabc,_edgeSet.c,nabc,a);
-        if (!_edgeSet.add(c,a,b,nabc))
-          linkTets(_edgeSet.nabc,_edgeSet.c,nabc,b);
+      int[] order;
+      Profiler.start(PROFILE_ORDER);
+      try {
+        order = SpatialOrder.brio(x,y,z);
+      } finally {
+        Profiler.stop(PROFILE_ORDER);
+      }
+      for (int i=0; i<n; ++i) {
+        int j = order[i];
+        if (!addNode(nodes[j],true))
+          nodes[j] = null;
       }
+      return nodes;
+    } finally {
+      Profiler.stop(PROFILE_ADD_NODES);
     }
-
-    if (DEBUG)
-      validate();
-
-    // Tell listeners that node has been added.
-    fireNodeAdded(node);
-
-    return true;
   }
 
   /**
@@ -2362,6 +2364,23 @@ public class TetMesh implements Serializable {
     return locatePoint((double)x,(double)y,(double)z);
   }
 
+  /**
+   * Locates a point with specified coordinates, beginning in a specified 
+   * tet. The search is fastest when that tet is near the point, as when 
+   * it is the tet returned for a previous nearby point. Unlike the other
+   * method for locating points, this method does not modify any state
+   * of the mesh. Therefore, multiple threads may locate points in this 
+   * way concurrently, provided that no thread modifies the mesh.
+   * @param tet the tet in the mesh in which to begin the search.
+   * @param x the x coordinate.
+   * @param y the y coordinate.
+   * @param z the z coordinate.
+   * @return the {@link PointLocation}.
+   */
+  public PointLocation locatePoint(Tet tet, float x, float y, float z) {
+    return locatePoint(tet,(double)x,(double)y,(double)z,false);
+  }
+
   /**
    * Gets an iterator for all nodes in the mesh.
    * @return the iterator.
@@ -2407,6 +2426,100 @@ public class TetMesh implements Serializable {
     };
   }
 
+  /**
+   * Gets a compact read-only snapshot of this mesh. Nodes and tets in
+   * the snapshot are represented by arrays of coordinates and indices,
+   * which require much less memory than the nodes and tets in this mesh.
+   * @return the snapshot.
+   */
+  public synchronized TetMeshSnapshot getSnapshot() {
+
+    // Nodes, in order along a Hilbert curve.
+    int nnode = _nnode;
+    Node[] nodes = new Node[nnode];
+    float[] xn = new float[nnode];
+    float[] yn = new float[nnode];
+    float[] zn = new float[nnode];
+    NodeIterator ni = getNodes();
+    for (int inode=0; inode<nnode; ++inode) {
+      Node node = nodes[inode] = ni.next();
+      xn[inode] = node.x();
+      yn[inode] = node.y();
+      zn[inode] = node.z();
+    }
+    int[] jnode = SpatialOrder.hilbert(xn,yn,zn);
+    float[] x = new float[nnode];
+    float[] y = new float[nnode];
+    float[] z = new float[nnode];
+    int[] nodeIndices = new int[nnode];
+    for (int inode=0; inode<nnode; ++inode) {
+      int j = jnode[inode];
+      x[inode] = xn[j];
+      y[inode] = yn[j];
+      z[inode] = zn[j];
+      nodeIndices[inode] = nodes[j].index;
+    }
+
+    // Tets, in order of their centroids along a Hilbert curve.
+    int ntet = _ntet;
+    Tet[] tets = new Tet[ntet];
+    float[] xc = new float[ntet];
+    float[] yc = new float[ntet];
+    float[] zc = new float[ntet];
+    TetIterator ti = getTetsInternal();
+    for (int itet=0; itet<ntet; ++itet) {
+      Tet tet = tets[itet] = ti.next();
+      Node n0 = tet._n0, n1 = tet._n1, n2 = tet._n2, n3 = tet._n3;
+      xc[itet] = 0.25f*(n0.x()+n1.x()+n2.x()+n3.x());
+      yc[itet] = 0.25f*(n0.y()+n1.y()+n2.y()+n3.y());
+      zc[itet] = 0.25f*(n0.z()+n1.z()+n2.z()+n3.z());
+    }
+    int[] jtet = SpatialOrder.hilbert(xc,yc,zc);
+
+    // Temporarily replace marks with indices of nodes and tets.
+    int[] nodeMarks = new int[nnode];
+    for (int inode=0; inode<nnode; ++inode) {
+      Node node = nodes[jnode[inode]];
+      nodeMarks[inode] = node._mark;
+      node._mark = inode;
+    }
+    int[] tetMarks = new int[ntet];
+    for (int itet=0; itet<ntet; ++itet) {
+      Tet tet = tets[jtet[itet]];
+      tetMarks[itet] = tet._mark;
+      tet._mark = itet;
+    }
+
+    // Arrays of indices.
+    int[] nodeTets = new int[nnode];
+    for (int inode=0; inode<nnode; ++inode) {
+      Tet tet = nodes[jnode[inode]]._tet;
+      nodeTets[inode] = (tet!=null && ntet>0)?tet._mark:-1;
+    }
+    int[] tetNodes = new int[4*ntet];
+    int[] tetNabors = new int[4*ntet];
+    for (int itet=0,i=0; itet<ntet; ++itet,i+=4) {
+      Tet tet = tets[jtet[itet]];
+      tetNodes[i  ] = tet._n0._mark;
+      tetNodes[i+1] = tet._n1._mark;
+      tetNodes[i+2] = tet._n2._mark;
+      tetNodes[i+3] = tet._n3._mark;
+      tetNabors[i  ] = (tet._t0!=null)?tet._t0._mark:-1;
+      tetNabors[i+1] = (tet._t1!=null)?tet._t1._mark:-1;
+      tetNabors[i+2] = (tet._t2!=null)?tet._t2._mark:-1;
+      tetNabors[i+3] = (tet._t3!=null)?tet._t3._mark:-1;
+    }
+
+    // Restore marks.
+    for (int inode=0; inode<nnode; ++inode)
+      nodes[jnode[inode]]._mark = nodeMarks[inode];
+    for (int itet=0; itet<ntet; ++itet)
+      tets[jtet[itet]]._mark = tetMarks[itet];
+
+    return new TetMeshSnapshot(_version,
+      x,y,z,nodeIndices,nodeTets,tetNodes,tetNabors);
+  }
+
   /**
    * Gets an iterator for all edges in the mesh.
    * @return the iterator.
@@ -3511,6 +3624,13 @@ public class TetMesh implements Serializable {
   ///////////////////////////////////////////////////////////////////////////
   // private
 
+  // Names of phases and counters for the profiler.
+  private static final String PROFILE_ADD_NODES = "TetMesh.addNodes";
+  private static final String PROFILE_ORDER = "TetMesh.orderNodes";
+  private static final String PROFILE_LOCATE = "TetMesh.locatePoint";
+  private static final String PROFILE_NODES = "TetMesh.nodesAdded";
+  private static final String PROFILE_TETS = "TetMesh.tetsCreated";
+
   private static final int NODE_MARK_MAX = Integer.MAX_VALUE-1;
   private static final int TET_MARK_MAX = Integer.MAX_VALUE-1;
 
@@ -4669,6 +4789,108 @@ public class TetMesh implements Serializable {
       findNodeNaborNearestPlane(a,b,c,d,node,tc);
   }
 
+  /**
+   * Adds a node to the mesh. If near is true, point location begins in
+   * the tet most recently created, which is efficient if that tet is
+   * near the node to be added.
+   */
+  private boolean addNode(Node node, boolean near) {
+
+    // Where is the point?
+    PointLocation pl;
+    Profiler.start(PROFILE_LOCATE);
+    try {
+      pl = (near && _troot!=null) ?
+        locatePoint(_troot,node._x,node._y,node._z,true) :
+        locatePoint(node._x,node._y,node._z);
+    } finally {
+      Profiler.stop(PROFILE_LOCATE);
+    }
+
+    // Cannot have two nodes with the same coordinates.
+    if (pl.isOnNode())
+      return false;
+
+    // Tell listeners that node will be added.
+    fireNodeWillBeAdded(node);
+
+    // The new node becomes the root node.
+    if (_nroot==null) {
+      _nroot = node;
+      _nroot._prev = _nroot._next = _nroot;
+    } else {
+      node._next = _nroot;
+      node._prev = _nroot._prev;
+      _nroot._prev._next = node;
+      _nroot._prev = node;
+      _nroot = node;
+    }
+    ++_nnode;
+
+    // Update node property values so they are consistent with this mesh.
+    updatePropertyValues(node);
+
+    // Maintain adequate sampling of O(N^(1/4)) nodes for fast point location.
+    // The scale factor 0.5 was used by Mucke et al., 1996.
+    double factor = 0.5*_sampledNodes.size();
+    if (factor*factor*factor*factor<_nnode) {
+      _sampledNodes.add(node);
+      //trace("addNode: sampling "+_sampledNodes.size()+" nodes");
+    }
+
+    // If we do not yet have a tet, perhaps we have enough nodes to make one.
+    if (pl.isOutside() && _nnode<=4) {
+      if (_nnode==4)
+        createFirstTet();
+
+    // Otherwise, if we have at least one tet, ...
+    } else {
+
+      // Get the set of Delaunay faces that bound the star-shaped 
+      // polyhedron containing all tets that are not Delaunay with 
+      // respect to the new node.
+      clearTetMarks();
+      _faceSet.clear();
+      if (pl.isInside()) {
+        getDelaunayFacesInside(node,pl.tet());
+      } else {
+        getDelaunayFacesOutside(node,pl.tet());
+      }
+
+      // With each Delaunay face in the set, create a new tet with 
+      // the new node. Use an edge set to link tets when a tet and 
+      // its nabor have been created.
+      _edgeSet.clear();
+      int ntet = 0;
+      for (boolean more=_faceSet.first(); more; more=_faceSet.next()) {
+        Node a = _faceSet.a;
+        Node b = _faceSet.b;
+        Node c = _faceSet.c;
+        Node d = _faceSet.d;
+        Tet abcd = _faceSet.abcd;
+        Tet nabc = makeTet(node,a,b,c);
+        ++ntet;
+        linkTets(nabc,node,abcd,d);
+        if (!_edgeSet.add(a,b,c,nabc))
+          linkTets(_edgeSet.nabc,_edgeSet.c,nabc,c);
+        if (!_edgeSet.add(b,c,a,nabc))
+          linkTets(_edgeSet.nabc,_edgeSet.c,nabc,a);
+        if (!_edgeSet.add(c,a,b,nabc))
+          linkTets(_edgeSet.nabc,_edgeSet.c,nabc,b);
+      }
+      Profiler.count(PROFILE_TETS,ntet);
+    }
+    Profiler.count(PROFILE_NODES,1);
+
+    if (DEBUG)
+      validate();
+
+    // Tell listeners that node has been added.
+    fireNodeAdded(node);
+
+    return true;
+  }
+
   /**
    * Locates a point.
    */
@@ -4699,17 +4921,21 @@ public class TetMesh implements Serializable {
       }
     }
     Tet tet = nmin._tet;
-    return locatePoint(tet,x,y,z);
+    return locatePoint(tet,x,y,z,true);
   }
 
   /**
    * Recursively searches tets beginning with the specified tet,
-   * to locate the point (x,y,z).
+   * to locate the point (x,y,z). If root is true, future searches 
+   * will begin in the last tet searched.
    */
-  private PointLocation locatePoint(Tet tet, double x, double y, double z) {
+  private PointLocation locatePoint(
+    Tet tet, double x, double y, double z, boolean root) 
+  {
 
     // Begin future searches in the specified tet.
-    _troot = tet;
+    if (root)
+      _troot = tet;
 
     // Node coordinates.
     Node n0 = tet._n0;
@@ -4753,7 +4979,7 @@ public class TetMesh implements Serializable {
     if (d0>0.0) {
       Tet tetNabor = tet.tetNabor(n0);
       if (tetNabor!=null) {
-        return locatePoint(tetNabor,x,y,z);
+        return locatePoint(tetNabor,x,y,z,root);
       } else {
         return new PointLocation(tet,false);
       }
@@ -4762,7 +4988,7 @@ public class TetMesh implements Serializable {
     if (d1>0.0) {
       Tet tetNabor = tet.tetNabor(n1);
       if (tetNabor!=null) {
-        return locatePoint(tetNabor,x,y,z);
+        return locatePoint(tetNabor,x,y,z,root);
       } else {
         return new PointLocation(tet,false);
       }
@@ -4771,7 +4997,7 @@ public class TetMesh implements Serializable {
     if (d2>0.0) {
       Tet tetNabor = tet.tetNabor(n2);
       if (tetNabor!=null) {
-        return locatePoint(tetNabor,x,y,z);
+        return locatePoint(tetNabor,x,y,z,root);
       } else {
         return new PointLocation(tet,false);
       }
@@ -4780,7 +5006,7 @@ public class TetMesh implements Serializable {
     if (d3>0.0) {
       Tet tetNabor = tet.tetNabor(n3);
       if (tetNabor!=null) {
-        return locatePoint(tetNabor,x,y,z);
+        return locatePoint(tetNabor,x,y,z,root);
       } else {
         return new PointLocation(tet,false);
       }
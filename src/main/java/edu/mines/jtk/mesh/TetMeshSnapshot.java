@@ -0,0 +1,238 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.mesh;
+
+/**
+ * A compact read-only snapshot of a tetrahedral mesh.
+ * <p>
+ * A snapshot stores a mesh in arrays. Nodes are represented by float
+ * coordinates and tets by int indices of nodes and tet nabors, so that
+ * a snapshot requires only 20 bytes per node and 32 bytes per tet.
+ * Nodes and tets are ordered along a Hilbert curve, so that nodes and
+ * tets near each other in space tend to be near each other in memory.
+ * <p>
+ * The four nodes of tet itet have indices tetNodes[4*itet+k] for k = 0,
+ * 1, 2, 3, in the order of nodes A, B, C, D of {@link TetMesh.Tet}. The
+ * tet nabor opposite node k has index tetNabors[4*itet+k], which is -1
+ * for tets on the convex hull.
+ * <p>
+ * A snapshot does not reference the mesh from which it was made, nor
+ * any of its nodes or tets. Instead, the public index of each mesh node
+ * is copied into the snapshot. A snapshot is unchanged by subsequent
+ * changes to the mesh; the mesh version number for which the snapshot
+ * was made can be used to determine whether the snapshot is stale.
+ *
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+public class TetMeshSnapshot {
+
+  /**
+   * Returns the number of nodes in this snapshot.
+   * @return the number of nodes.
+   */
+  public int countNodes() {
+    return _nnode;
+  }
+
+  /**
+   * Returns the number of tets in this snapshot.
+   * @return the number of tets.
+   */
+  public int countTets() {
+    return _ntet;
+  }
+
+  /**
+   * Gets the version number of the mesh when this snapshot was made.
+   * @return the version number.
+   */
+  public long getVersion() {
+    return _version;
+  }
+
+  /**
+   * Gets the x coordinates of nodes. The returned array is by reference,
+   * and should not be modified.
+   * @return array[nnode] of x coordinates.
+   */
+  public float[] getX() {
+    return _x;
+  }
+
+  /**
+   * Gets the y coordinates of nodes. The returned array is by reference,
+   * and should not be modified.
+   * @return array[nnode] of y coordinates.
+   */
+  public float[] getY() {
+    return _y;
+  }
+
+  /**
+   * Gets the z coordinates of nodes. The returned array is by reference,
+   * and should not be modified.
+   * @return array[nnode] of z coordinates.
+   */
+  public float[] getZ() {
+    return _z;
+  }
+
+  /**
+   * Gets the public indices that mesh nodes had when this snapshot was
+   * made. The returned array is by reference, and should not be modified.
+   * @return array[nnode] of mesh node indices.
+   */
+  public int[] getNodeIndices() {
+    return _nodeIndices;
+  }
+
+  /**
+   * Gets the index of one tet that references each node. The returned
+   * array is by reference, and should not be modified.
+   * @return array[nnode] of tet indices; -1, if no tets.
+   */
+  public int[] getNodeTets() {
+    return _nodeTets;
+  }
+
+  /**
+   * Gets the indices of nodes referenced by tets. The returned array is
+   * by reference, and should not be modified.
+   * @return array[4*ntet] of node indices.
+   */
+  public int[] getTetNodes() {
+    return _tetNodes;
+  }
+
+  /**
+   * Gets the indices of tet nabors. The returned array is by reference,
+   * and should not be modified.
+   * @return array[4*ntet] of tet indices; -1 for nabors on the hull.
+   */
+  public int[] getTetNabors() {
+    return _tetNabors;
+  }
+
+  /**
+   * Returns the index of a tet that contains the specified point.
+   * The search walks from the specified tet towards the point, and is
+   * fastest when that tet is near the point.
+   * @param x the point x coordinate.
+   * @param y the point y coordinate.
+   * @param z the point z coordinate.
+   * @param itet index of the tet in which to begin the search.
+   * @return the index of the tet; -1, if the point is outside the mesh.
+   */
+  public int locateTet(float x, float y, float z, int itet) {
+    if (_ntet==0)
+      return -1;
+    if (itet<0 || itet>=_ntet)
+      itet = 0;
+
+    // Walk through the face with the most positive left-of-plane test.
+    // Because coordinates are unperturbed, such a walk may cycle for
+    // degenerate meshes; in that case, fall back to a linear search.
+    for (int nstep=0; nstep<_ntet; ++nstep) {
+      int k = exitFace(itet,x,y,z);
+      if (k<0)
+        return itet;
+      int jtet = _tetNabors[4*itet+k];
+      if (jtet<0)
+        return -1;
+      itet = jtet;
+    }
+    for (itet=0; itet<_ntet; ++itet) {
+      if (exitFace(itet,x,y,z)<0)
+        return itet;
+    }
+    return -1;
+  }
+
+  /**
+   * Returns the index of a tet that contains the specified point.
+   * @param x the point x coordinate.
+   * @param y the point y coordinate.
+   * @param z the point z coordinate.
+   * @return the index of the tet; -1, if the point is outside the mesh.
+   */
+  public int locateTet(float x, float y, float z) {
+    return locateTet(x,y,z,0);
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // package
+
+  /**
+   * Constructs a snapshot with the specified arrays, which are used
+   * by reference. Called only by {@link TetMesh#getSnapshot()}.
+   */
+  TetMeshSnapshot(
+    long version,
+    float[] x, float[] y, float[] z, int[] nodeIndices, int[] nodeTets,
+    int[] tetNodes, int[] tetNabors)
+  {
+    _version = version;
+    _nnode = x.length;
+    _ntet = tetNodes.length/4;
+    _x = x;
+    _y = y;
+    _z = z;
+    _nodeIndices = nodeIndices;
+    _nodeTets = nodeTets;
+    _tetNodes = tetNodes;
+    _tetNabors = tetNabors;
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // private
+
+  private long _version; // mesh version when snapshot was made
+  private int _nnode; // number of nodes
+  private int _ntet; // number of tets
+  private float[] _x,_y,_z; // node coordinates
+  private int[] _nodeIndices; // public indices of mesh nodes
+  private int[] _nodeTets; // one tet for each node
+  private int[] _tetNodes; // four nodes for each tet
+  private int[] _tetNabors; // four tet nabors for each tet
+
+  /**
+   * Returns the index k of the face of the specified tet through
+   * which a walk towards the point (x,y,z) should exit, or -1 if the
+   * point is inside or on the boundary of the tet.
+   */
+  private int exitFace(int itet, double x, double y, double z) {
+    int i = 4*itet;
+    int i0 = _tetNodes[i  ];
+    int i1 = _tetNodes[i+1];
+    int i2 = _tetNodes[i+2];
+    int i3 = _tetNodes[i+3];
+    double x0 = _x[i0], y0 = _y[i0], z0 = _z[i0];
+    double x1 = _x[i1], y1 = _y[i1], z1 = _z[i1];
+    double x2 = _x[i2], y2 = _y[i2], z2 = _z[i2];
+    double x3 = _x[i3], y3 = _y[i3], z3 = _z[i3];
+    double d0 = Geometry.leftOfPlane(x1,y1,z1,x2,y2,z2,x3,y3,z3,x,y,z);
+    double d1 = Geometry.leftOfPlane(x3,y3,z3,x2,y2,z2,x0,y0,z0,x,y,z);
+    double d2 = Geometry.leftOfPlane(x3,y3,z3,x0,y0,z0,x1,y1,z1,x,y,z);
+    double d3 = Geometry.leftOfPlane(x0,y0,z0,x2,y2,z2,x1,y1,z1,x,y,z);
+    int k = -1;
+    double dmax = 0.0;
+    if (d0>dmax) { dmax = d0; k = 0; }
+    if (d1>dmax) { dmax = d1; k = 1; }
+    if (d2>dmax) { dmax = d2; k = 2; }
+    if (d3>dmax) { k = 3; }
+    return k;
+  }
+}
@@ -1419,85 +1419,63 @@ public class TriMesh implements Serializable {
    * @return true, if the node was added; false, otherwise.
    */
   public synchronized boolean addNode(Node node) {
+    return addNode(node,false);
+  }
 
-    // Where is the point?
-    PointLocation pl = locatePoint(node._x,node._y);
-
-    // Cannot have two nodes with the same coordinates.
-    if (pl.isOnNode())
-      return false;
-
-    // Tell listeners that node will be added.
-    fireNodeWillBeAdded(node);
-
-    // The new node becomes the root node.
-    if (_nroot==null) {
-      _nroot = node;
-      _nroot._prev = _nroot._next = _nroot;
-    } else {
-      node._next = _nroot;
-      node._prev = _nroot._prev;
-      _nroot._prev._next = node;
-      _nroot._prev = node;
-      _nroot = node;
-    }
-    ++_nnode;
-
-    // Update node property values so they are consistent with this mesh.
-    updatePropertyValues(node);
-
-    // Maintain adequate sampling of O(N^(1/3)) nodes for fast point location.
-    // The scale factor 0.45 was used by Shewchuk, 1997.
-    double factor = 0.45*_sampledNodes.size();
-    if (factor*factor*factor<_nnode) {
-      _sampledNodes.add(node);
-      //trace("addNode: sampling "+_sampledNodes.size()+" nodes");
-    }
-
-    // If we do not yet have a tri, perhaps we have enough nodes to make one.
-    if (pl.isOutside() && _nnode<=3) {
-      if (_nnode==3)
-        createFirstTri();
-
-    // Otherwise, if we have at least one tri, ...
-    } else {
-
-      // Get the set of Delaunay edges that bound the star-shaped 
-      // polygon containing all tris that are not Delaunay with 
-      // respect to the new node.
-      clearTriMarks();
-      _edgeSet.clear();
-      if (pl.isInside()) {
-        getDelaunayEdgesInside(node,pl.tri());
-      } else {
-        getDelaunayEdgesOutside(node,pl.tri());
-      }
-
-      // With each Delaunay edge in the set, create a new tri with 
-      // the new node. Use a node set to link tris when a tri and 
-      // its nabor have been created.
-      _nodeSet.clear();
-      for (boolean more=_edgeSet.first(); more; more=_edgeSet.next()) {
-        Node a = _edgeSet.a;
-        Node b = _edgeSet.b;
-        Node c = _edgeSet.c;
-        Tri abc = _edgeSet.abc;
-        Tri nba = makeTri(node,b,a);
-        linkTris(nba,node,abc,c);
-        if (!_nodeSet.add(a,b,nba))
-          linkTris(_nodeSet.nba,_nodeSet.b,nba,b);
-        if (!_nodeSet.add(b,a,nba))
-          linkTris(_nodeSet.nba,_nodeSet.b,nba,a);
-      }
-    }
-
-    if (DEBUG)
-      validate();
-
-    // Tell listeners that node has been added.
-    fireNodeAdded(node);
+  /**
+   * Adds the specified nodes to the mesh. Nodes are added in a biased
+   * randomized insertion order, in which nodes that are inserted
+   * consecutively tend to be near one another. Each point location then
+   * begins in the tri most recently created, so that adding many nodes
+   * this way is much faster than adding them one at a time in an
+   * arbitrary order.
+   * <p>
+   * As for the method {@link #addNode(Node)}, no node is added if the
+   * mesh already contains a node with the same (x,y) coordinates.
+   * @param nodes array of nodes to add.
+   * @return the number of nodes added.
+   */
+  public synchronized int addNodes(Node[] nodes) {
+    int n = nodes.length;
+    float[] x = new float[n];
+    float[] y = new float[n];
+    for (int i=0; i<n; ++i) {
+      x[i] = nodes[i].x();
+      y[i] = nodes[i].y();
+    }
+    int[] order = SpatialOrder.brio(x,y);
+    int nadd = 0;
+    for (int i=0; i<n; ++i) {
+      if (addNode(nodes[order[i]],true))
+        ++nadd;
+    }
+    return nadd;
+  }
 
-    return true;
+  /**
+   * Adds nodes with the specified coordinates to the mesh.
+   * The nodes are added as for the method {@link #addNodes(Node[])}.
+   * The index of each new node is the index of its coordinates.
+   * @param x array of x coordinates.
+   * @param y array of y coordinates.
+   * @return array of new nodes; null for any node not added, because
+   *  the mesh already contained a node with the same coordinates.
+   */
+  public synchronized Node[] addNodes(float[] x, float[] y) {
+    Check.argument(x.length==y.length,"x.length==y.length");
+    int n = x.length;
+    Node[] nodes = new Node[n];
+    for (int i=0; i<n; ++i) {
+      nodes[i] = new Node(x[i],y[i]);
+      nodes[i].index = i;
+    }
+    int[] order = SpatialOrder.brio(x,y);
+    for (int i=0; i<n; ++i) {
+      int j = order[i];
+      if (!addNode(nodes[j],true))
+        nodes[j] = null;
+    }
+    return nodes;
   }
 
   /**
@@ -1730,6 +1708,22 @@ public class TriMesh implements Serializable {
     return locatePoint((double)x,(double)y);
   }
 
+  /**
+   * Locates a point with specified coordinates, beginning in a specified 
+   * tri. The search is fastest when that tri is near the point, as when 
+   * it is the tri returned for a previous nearby point. Unlike the other
+   * method for locating points, this method does not modify any state
+   * of the mesh. Therefore, multiple threads may locate points in this 
+   * way concurrently, provided that no thread modifies the mesh.
+   * @param tri the tri in the mesh in which to begin the search.
+   * @param x the x coordinate.
+   * @param y the y coordinate.
+   * @return the {@link PointLocation}.
+   */
+  public PointLocation locatePoint(Tri tri, float x, float y) {
+    return locatePoint(tri,(double)x,(double)y,false);
+  }
+
   /**
    * Gets an iterator for all nodes in the mesh.
    * @return the iterator.
@@ -2886,6 +2880,95 @@ public class TriMesh implements Serializable {
     return null;
   }
 
+  /**
+   * Adds a node to the mesh. If near is true, point location begins in
+   * the tri most recently created, which is efficient if that tri is
+   * near the node to be added.
+   */
+  private boolean addNode(Node node, boolean near) {
+
+    // Where is the point?
+    PointLocation pl = (near && _troot!=null) ?
+      locatePoint(_troot,node._x,node._y,true) :
+      locatePoint(node._x,node._y);
+
+    // Cannot have two nodes with the same coordinates.
+    if (pl.isOnNode())
+      return false;
+
+    // Tell listeners that node will be added.
+    fireNodeWillBeAdded(node);
+
+    // The new node becomes the root node.
+    if (_nroot==null) {
+      _nroot = node;
+      _nroot._prev = _nroot._next = _nroot;
+    } else {
+      node._next = _nroot;
+      node._prev = _nroot._prev;
+      _nroot._prev._next = node;
+      _nroot._prev = node;
+      _nroot = node;
+    }
+    ++_nnode;
+
+    // Update node property values so they are consistent with this mesh.
+    updatePropertyValues(node);
+
+    // Maintain adequate sampling of O(N^(1/3)) nodes for fast point location.
+    // The scale factor 0.45 was used by Shewchuk, 1997.
+    double factor = 0.45*_sampledNodes.size();
+    if (factor*factor*factor<_nnode) {
+      _sampledNodes.add(node);
+      //trace("addNode: sampling "+_sampledNodes.size()+" nodes");
+    }
+
+    // If we do not yet have a tri, perhaps we have enough nodes to make one.
+    if (pl.isOutside() && _nnode<=3) {
+      if (_nnode==3)
+        createFirstTri();
+
+    // Otherwise, if we have at least one tri, ...
+    } else {
+
+      // Get the set of Delaunay edges that bound the star-shaped 
+      // polygon containing all tris that are not Delaunay with 
+      // respect to the new node.
+      clearTriMarks();
+      _edgeSet.clear();
+      if (pl.isInside()) {
+        getDelaunayEdgesInside(node,pl.tri());
+      } else {
+        getDelaunayEdgesOutside(node,pl.tri());
+      }
+
+      // With each Delaunay edge in the set, create a new tri with 
+      // the new node. Use a node set to link tris when a tri and 
+      // its nabor have been created.
+      _nodeSet.clear();
+      for (boolean more=_edgeSet.first(); more; more=_edgeSet.next()) {
+        Node a = _edgeSet.a;
+        Node b = _edgeSet.b;
+        Node c = _edgeSet.c;
+        Tri abc = _edgeSet.abc;
+        Tri nba = makeTri(node,b,a);
+        linkTris(nba,node,abc,c);
+        if (!_nodeSet.add(a,b,nba))
+          linkTris(_nodeSet.nba,_nodeSet.b,nba,b);
+        if (!_nodeSet.add(b,a,nba))
+          linkTris(_nodeSet.nba,_nodeSet.b,nba,a);
+      }
+    }
+
+    if (DEBUG)
+      validate();
+
+    // Tell listeners that node has been added.
+    fireNodeAdded(node);
+
+    return true;
+  }
+
   /**
    * Locates a point.
    */
@@ -2916,17 +2999,21 @@ public class TriMesh implements Serializable {
       }
     }
     Tri tri = nmin._tri;
-    return locatePoint(tri,x,y);
+    return locatePoint(tri,x,y,true);
   }
 
   /**
    * Recursively searches tris beginning with the specified tri,
-   * to locate the point (x,y).
+   * to locate the point (x,y). If root is true, future searches 
+   * will begin in the last tri searched.
    */
-  private PointLocation locatePoint(Tri tri, double x, double y) {
+  private PointLocation locatePoint(
+    Tri tri, double x, double y, boolean root) 
+  {
 
     // Begin future searches in the specified tri.
-    _troot = tri;
+    if (root)
+      _troot = tri;
 
     // Node coordinates.
     Node n0 = tri._n0;
@@ -2961,7 +3048,7 @@ public class TriMesh implements Serializable {
     if (d0>0.0) {
       Tri triNabor = tri.triNabor(n0);
       if (triNabor!=null) {
-        return locatePoint(triNabor,x,y);
+        return locatePoint(triNabor,x,y,root);
       } else {
         return new PointLocation(tri,false);
       }
@@ -2970,7 +3057,7 @@ public class TriMesh implements Serializable {
     if (d1>0.0) {
       Tri triNabor = tri.triNabor(n1);
       if (triNabor!=null) {
-        return locatePoint(triNabor,x,y);
+        return locatePoint(triNabor,x,y,root);
       } else {
         return new PointLocation(tri,false);
       }
@@ -2979,7 +3066,7 @@ public class TriMesh implements Serializable {
     if (d2>0.0) {
       Tri triNabor = tri.triNabor(n2);
       if (triNabor!=null) {
-        return locatePoint(triNabor,x,y);
+        return locatePoint(triNabor,x,y,root);
       } else {
         return new PointLocation(tri,false);
       }
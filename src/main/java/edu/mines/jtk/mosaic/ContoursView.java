@@ -18,6 +18,7 @@ import java.awt.*;
 import java.awt.image.IndexColorModel;
 import java.util.ArrayList;
 import java.util.Iterator;
+import java.util.LinkedHashMap;
 
 import edu.mines.jtk.awt.ColorMap;
 import edu.mines.jtk.awt.ColorMapListener;
@@ -25,12 +26,18 @@ import edu.mines.jtk.dsp.Sampling;
 import edu.mines.jtk.util.AxisTics;
 import edu.mines.jtk.util.Check;
 import edu.mines.jtk.util.Clips;
+import edu.mines.jtk.util.Parallel;
 import edu.mines.jtk.awt.ColorMapped;
 import static edu.mines.jtk.util.ArrayMath.*;
 
 /**
  * A view of a sampled function f(x1,x2), displayed with contour lines.
  * <p>
+ * Contours are computed in parallel, for rectangular tiles of samples and
+ * for all contour values. Contours for each value are cached, so that
+ * changing contour values recomputes contours only for new values. Only 
+ * contours in tiles that intersect the visible part of this view are drawn.
+ * <p>
  * @author Dave Hale and Chris Engelsma, Colorado School of Mines
  * @version 2009.07.06
  */
@@ -100,11 +107,12 @@ public class ContoursView extends TiledView implements ColorMapped {
     Check.argument(s2.getCount()==f.length,"s2 consistent with f");
     _s1 = s1;
     _s2 = s2;
-    _f = copy(f);
+    _tiles = makeTiles(s1,s2,f);
     _clips = new Clips(f);
     updateArraySampling();
     _cs = null;
     _cl = null;
+    _cache.clear();
   }
 
  
@@ -258,7 +266,7 @@ public class ContoursView extends TiledView implements ColorMapped {
     updateContourSampling();
     float[] values = new float[_cs.getCount()];
     for (int n=0; n<values.length; n++)
-      values[n] = _cl.get(n).fc;
+      values[n] = (float)_cs.getValue(n);
     return values;
   }
 
@@ -476,12 +484,33 @@ public class ContoursView extends TiledView implements ColorMapped {
     
     IndexColorModel cm = _colorMap.getColorModel();
 
+    // Sample coordinates of the clip rectangle, enlarged by a margin for
+    // the width of contour lines. Tiles outside these bounds are not drawn.
+    int m = 3+(int)width;
+    double xa = hp.v(ts.x(clipRect.x-m));
+    double xb = hp.v(ts.x(clipRect.x+clipRect.width+m));
+    double ya = vp.v(ts.y(clipRect.y-m));
+    double yb = vp.v(ts.y(clipRect.y+clipRect.height+m));
+    double x1a,x1b,x2a,x2b;
+    if (_transposed) {
+      x1a = min(ya,yb);
+      x1b = max(ya,yb);
+      x2a = min(xa,xb);
+      x2b = max(xa,xb);
+    } else {
+      x1a = min(xa,xb);
+      x1b = max(xa,xb);
+      x2a = min(ya,yb);
+      x2b = max(ya,yb);
+    }
+    int nt = _tiles.length;
+    boolean[] visible = new boolean[nt];
+    for (int it=0; it<nt; ++it)
+      visible[it] = _tiles[it].intersects(x1a,x1b,x2a,x2b);
+
     for (int is=0; is<_cs.getCount(); ++is) {
-      float fc = _cl.get(is).fc;
-      ArrayList<float[]> cx1 = _cl.get(is).x1;
-      ArrayList<float[]> cx2 = _cl.get(is).x2;
-      Iterator<float[]> it1 = cx1.iterator();
-      Iterator<float[]> it2 = cx2.iterator();
+      Contour[] cs = _cl.get(is);
+      float fc = cs[0].fc;
       // If assigning a ColorMap to the contours, then assign the values
       // of the contours to their ColorMap equivalents within a 0-255 range.
       if (cm!=null) {
@@ -500,19 +529,59 @@ public class ContoursView extends TiledView implements ColorMapped {
         if (fc>=0.0f) gline.setStroke(bs);
       }
 
-      while (it1.hasNext()) {
-        float[] xc1 = it1.next();
-        float[] xc2 = it2.next();
-        int n = xc1.length;
-        int[] xcon = new int[xc1.length];
-        int[] ycon = new int[xc2.length];
-        computeXY(hp,vp,ts,n,xc1,xc2,xcon,ycon);
-        if (gline!=null) 
-          gline.drawPolyline(xcon,ycon,n);
+      for (int it=0; it<nt; ++it) {
+        if (!visible[it])
+          continue;
+        Iterator<float[]> it1 = cs[it].x1.iterator();
+        Iterator<float[]> it2 = cs[it].x2.iterator();
+        while (it1.hasNext()) {
+          float[] xc1 = it1.next();
+          float[] xc2 = it2.next();
+          int n = xc1.length;
+          int[] xcon = new int[xc1.length];
+          int[] ycon = new int[xc2.length];
+          computeXY(hp,vp,ts,n,xc1,xc2,xcon,ycon);
+          if (gline!=null) 
+            gline.drawPolyline(xcon,ycon,n);
+        }
       }
     }
   }
   
+  ///////////////////////////////////////////////////////////////////////////
+  // package
+
+  /**
+   * Returns segments of contours for the specified contour value index,
+   * for all tiles. Segments are computed or taken from the cache, as
+   * they are when this view is painted.
+   * @return array[ns][2][] of x1 and x2 coordinates for ns segments.
+   */
+  float[][][] getSegments(int ic) {
+    updateContourSampling();
+    updateContours();
+    return segments(_cl.get(ic));
+  }
+
+  /**
+   * Returns the number of contours computed since this view was
+   * constructed, counting one for each contour value and tile.
+   */
+  int countContoursComputed() {
+    return _ncomputed;
+  }
+
+  /**
+   * Returns segments of contours for the specified value, traced for
+   * all samples in one tile.
+   * @return array[ns][2][] of x1 and x2 coordinates for ns segments.
+   */
+  static float[][][] traceSegments(
+    float fc, Sampling s1, Sampling s2, float[][] f)
+  {
+    return segments(new Contour[]{makeContour(fc,s1,s2,f)});
+  }
+
   ///////////////////////////////////////////////////////////////////////////
   // private
 
@@ -531,6 +600,22 @@ public class ContoursView extends TiledView implements ColorMapped {
     }
   }
 
+  // A tile of samples, including the last sample of any adjacent tile
+  // so that contours in adjacent tiles meet at the boundary between them.
+  private static class Tile {
+    Sampling s1,s2;
+    float[][] f;
+    Tile(Sampling s1, Sampling s2, float[][] f) {
+      this.s1 = s1;
+      this.s2 = s2;
+      this.f = f;
+    }
+    boolean intersects(double x1a, double x1b, double x2a, double x2b) {
+      return s1.getFirst()<=x1b && x1a<=s1.getLast() &&
+             s2.getFirst()<=x2b && x2a<=s2.getLast();
+    }
+  }
+
   private static class FloatList {
     public int n;
     public float[] a = new float[64];
@@ -560,7 +645,7 @@ public class ContoursView extends TiledView implements ColorMapped {
   // The sampled floats.
   private Sampling _s1; // sampling of 1st dimension
   private Sampling _s2; // sampling of 2nd dimension
-  private float[][] _f; // copy of array of floats
+  private Tile[] _tiles; // copy of array of floats, in tiles
 
   // View orientation
   private Orientation _orientation = Orientation.X1RIGHT_X2UP;
@@ -585,7 +670,14 @@ public class ContoursView extends TiledView implements ColorMapped {
   private int _nc = 25; // number of contours; maybe less if readable contours
   private boolean _readableContours = true; // true, for readable contour vals
   private Sampling _cs; // contour sampling
-  private ArrayList<Contour> _cl; // list of contours
+  private ArrayList<Contour[]> _cl; // list of contours, one per tile
+
+  // Contours most recently computed, for each contour value.
+  private static final int TILE_SIZE = 128; // samples per tile per dimension
+  private static final int CACHE_SIZE = 256; // at least, contour values
+  private LinkedHashMap<Float,Contour[]> _cache =
+    new LinkedHashMap<Float,Contour[]>(16,0.75f,true);
+  private int _ncomputed; // number of contours computed, for all tiles
   
   /**
    * Update the clips if necessary.
@@ -725,18 +817,81 @@ public class ContoursView extends TiledView implements ColorMapped {
   }
 
   /**
-   * Updates the contours for this view.
+   * Returns tiles that contain copies of the specified sampled floats.
+   */
+  private static Tile[] makeTiles(Sampling s1, Sampling s2, float[][] f) {
+    int n1 = s1.getCount();
+    int n2 = s2.getCount();
+    int nt1 = max(1,(n1-1+TILE_SIZE-1)/TILE_SIZE);
+    int nt2 = max(1,(n2-1+TILE_SIZE-1)/TILE_SIZE);
+    Tile[] tiles = new Tile[nt1*nt2];
+    for (int it2=0,it=0; it2<nt2; ++it2) {
+      int j2 = it2*TILE_SIZE;
+      int m2 = min(TILE_SIZE,n2-1-j2)+1;
+      Sampling t2 = new Sampling(m2,s2.getDelta(),s2.getValue(j2));
+      for (int it1=0; it1<nt1; ++it1,++it) {
+        int j1 = it1*TILE_SIZE;
+        int m1 = min(TILE_SIZE,n1-1-j1)+1;
+        Sampling t1 = new Sampling(m1,s1.getDelta(),s1.getValue(j1));
+        float[][] ft = new float[m2][m1];
+        for (int i2=0; i2<m2; ++i2)
+          System.arraycopy(f[j2+i2],j1,ft[i2],0,m1);
+        tiles[it] = new Tile(t1,t2,ft);
+      }
+    }
+    return tiles;
+  }
+
+  /**
+   * Updates the contours for this view. Contours for values not cached
+   * are computed in parallel, for all such values and all tiles.
    */
   private void updateContours() {
     if (_cl==null) {
       int nc = _cs.getCount();
-      _cl = new ArrayList<Contour>();
+      final int nt = _tiles.length;
+      final ArrayList<Contour[]> cl = new ArrayList<Contour[]>(nc);
+      final ArrayList<Integer> missing = new ArrayList<Integer>();
       for (int ic=0; ic<nc; ++ic) {
         float fc = (float)_cs.getValue(ic);
-        Contour c = makeContour(fc,_s1,_s2,_f);
-        _cl.add(c);
+        Contour[] cs = _cache.get(fc);
+        if (cs==null) {
+          cs = new Contour[nt];
+          missing.add(ic);
+        }
+        cl.add(cs);
+      }
+      Parallel.loop(missing.size()*nt,new Parallel.LoopInt() {
+        public void compute(int i) {
+          int ic = missing.get(i/nt);
+          int it = i%nt;
+          float fc = (float)_cs.getValue(ic);
+          Tile t = _tiles[it];
+          cl.get(ic)[it] = makeContour(fc,t.s1,t.s2,t.f);
+        }
+      });
+      _ncomputed += missing.size()*nt;
+      for (int ic=0; ic<nc; ++ic)
+        _cache.put((float)_cs.getValue(ic),cl.get(ic));
+      Iterator<Contour[]> it = _cache.values().iterator();
+      while (_cache.size()>max(CACHE_SIZE,nc)) {
+        it.next();
+        it.remove();
       }
+      _cl = cl;
+    }
+  }
+
+  /**
+   * Returns x1 and x2 coordinates for all segments of the contours.
+   */
+  private static float[][][] segments(Contour[] cs) {
+    ArrayList<float[][]> xs = new ArrayList<float[][]>();
+    for (Contour c:cs) {
+      for (int is=0; is<c.ns; ++is)
+        xs.add(new float[][]{c.x1.get(is),c.x2.get(is)});
     }
+    return xs.toArray(new float[xs.size()][][]);
   }
 
   /**
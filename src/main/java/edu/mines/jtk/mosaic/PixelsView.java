@@ -16,6 +16,10 @@ package edu.mines.jtk.mosaic;
 
 import java.awt.*;
 import java.awt.image.*;
+import java.util.ArrayList;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.concurrent.*;
 
 import edu.mines.jtk.awt.*;
 import edu.mines.jtk.dsp.Sampling;
@@ -51,6 +55,15 @@ import static edu.mines.jtk.util.ArrayMath.*;
  * directly as color components red, green, and blue (and alpha). In this 
  * case, any indexed color model specified is not used. The number of color 
  * components equals the number of sampled functions specified.
+ * <p>
+ * Pixels are computed in square tiles, and only for tiles that are visible.
+ * Tiles are cached, so that repainting or panning need not recompute them.
+ * When clips change, cached tiles recompute only their bytes; when the
+ * color model changes, they need not recompute anything. When zoomed out 
+ * so that many samples contribute to each pixel, linear interpolation uses
+ * a decimated copy of the sampled functions, in which each sample is the
+ * average of 2x2, 4x4, ... samples. Tiles adjacent to the visible tiles 
+ * are computed in background threads, in anticipation of panning.
  *
  * @author Dave Hale, Colorado School of Mines
  * @version 2005.09.27
@@ -198,6 +211,8 @@ public class PixelsView extends TiledView implements ColorMapped {
     _clipMin = null;
     _clipMax = null;
     updateSampling();
+    dirtyPyramid();
+    dirtyTiles();
     repaint();
   }
 
@@ -209,6 +224,7 @@ public class PixelsView extends TiledView implements ColorMapped {
     if (_orientation!=orientation) {
       _orientation = orientation;
       updateSampling();
+      dirtyTiles();
       repaint();
     }
   }
@@ -229,6 +245,7 @@ public class PixelsView extends TiledView implements ColorMapped {
     if (_interpolation!=interpolation) {
       _interpolation = interpolation;
       updateBestProjectors();
+      dirtyTiles();
       repaint();
     }
   }
@@ -452,103 +469,59 @@ public class PixelsView extends TiledView implements ColorMapped {
     clipRect = clipRect.intersection(viewRect);
     if (clipRect.isEmpty())
       return;
-    
-    // Sample coordinates corresponding to the clip rectangle.
-    int xc = clipRect.x;
-    int yc = clipRect.y;
-    int wc = clipRect.width;
-    int hc = clipRect.height;
-    double xu = ts.x(xc);
-    double yu = ts.y(yc);
-    double wu = ts.width(wc);
-    double hu = ts.height(hc);
-    double x0 = hp.v(xu);
-    double y0 = vp.v(yu);
-    double x1 = hp.v(xu+wu);
-    double y1 = vp.v(yu+hu);
-
-    // Image pixel sampling.
-    int nx = wc;
-    int ny = hc;
-    int nxy = nx*ny;
-    double dx = (x1-x0)/max(1,nx-1);
-    double dy = (y1-y0)/max(1,ny-1);
-    double fx = x0;
-    double fy = y0;
-
-    // If only one component (using index color model) ...
-    if (_nc==1) {
-      float[][] f = _f[0];
-      float clipMin = _clipMin[0];
-      float clipMax = _clipMax[0];
-      byte[] b = (_interpolation==Interpolation.LINEAR) ?
-        interpolateImageBytesLinear(f,clipMin,clipMax,nx,dx,fx,ny,dy,fy) :
-        interpolateImageBytesNearest(f,clipMin,clipMax,nx,dx,fx,ny,dy,fy);
-      ColorModel cm = _colorMap.getColorModel();
-      DataBuffer db = new DataBufferByte(b,nxy,0);
-      int dt = DataBuffer.TYPE_BYTE;
-      int[] bm = new int[]{0xff};
-      SampleModel sm = new SinglePixelPackedSampleModel(dt,nx,ny,bm);
-      WritableRaster wr = Raster.createWritableRaster(sm,db,null);
-      BufferedImage bi = new BufferedImage(cm,wr,false,null);
-      g2d.drawImage(bi,xc,yc,null);
-    }
-
-    // else, if three or four components (using direct color model) ...
-    else {
-      byte[][] b = new byte[_nc][];
-      for (int ic=0; ic<_nc; ++ic) {
-        float[][] f = _f[ic];
-        float clipMin = _clipMin[ic];
-        float clipMax = _clipMax[ic];
-        b[ic] = (_interpolation==Interpolation.LINEAR) ?
-          interpolateImageBytesLinear(f,clipMin,clipMax,nx,dx,fx,ny,dy,fy) :
-          interpolateImageBytesNearest(f,clipMin,clipMax,nx,dx,fx,ny,dy,fy);
+
+    // Cache tiles for a few times the area visible in the tile.
+    int mvx = 2+ts.width(1.0)/TILE_SIZE;
+    int mvy = 2+ts.height(1.0)/TILE_SIZE;
+    _tileCache.setCapacity(TILE_CACHE_VIEWS*mvx*mvy);
+
+    // Sample coordinates of the left and top edges of the view rectangle,
+    // and sample increments per pixel. These and the view size determine 
+    // the contents of tiles, which can be reused while panning.
+    double xl = (ux0<=ux1)?vx0:vx1;
+    double yt = (uy0<=uy1)?vy0:vy1;
+    double dxp = ((ux0<=ux1)?vx1-vx0:vx0-vx1)/wd;
+    double dyp = ((uy0<=uy1)?vy1-vy0:vy0-vy1)/hd;
+    Level level = getLevel(abs(dxp),abs(dyp));
+
+    // Tiles that intersect the clip rectangle.
+    int jx0 = (clipRect.x-xd)/TILE_SIZE;
+    int jy0 = (clipRect.y-yd)/TILE_SIZE;
+    int jx1 = (clipRect.x+clipRect.width-1-xd)/TILE_SIZE;
+    int jy1 = (clipRect.y+clipRect.height-1-yd)/TILE_SIZE;
+
+    // Get tiles from the cache, and compute in parallel any not cached.
+    int njx = jx1-jx0+1;
+    final Tile[] tiles = new Tile[njx*(jy1-jy0+1)];
+    final ArrayList<Integer> missing = new ArrayList<Integer>();
+    for (int jy=jy0,k=0; jy<=jy1; ++jy) {
+      for (int jx=jx0; jx<=jx1; ++jx,++k) {
+        TileKey key = new TileKey(wd,hd,xl,yt,jx,jy);
+        tiles[k] = _tileCache.get(key,_tileVersion);
+        if (tiles[k]==null) {
+          tiles[k] = new Tile(key,_tileVersion,level,dxp,dyp);
+          missing.add(k);
+        }
       }
-      ColorModel cm;
-      int[] bm;
-      int[] i = new int[nxy];
-      if (_nc==3) {
-        cm = new DirectColorModel(24,
-          0x00ff0000,
-          0x0000ff00,
-          0x000000ff);
-        bm = new int[]{
-          0x00ff0000,
-          0x0000ff00,
-          0x000000ff,
-        };
-        byte[] b0 = b[0], b1 = b[1], b2 = b[2];
-        for (int ixy=0; ixy<nxy; ++ixy)
-          i[ixy] = ((b0[ixy]&0xff)<<16) | 
-                   ((b1[ixy]&0xff)<< 8) | 
-                   ((b2[ixy]&0xff)    );
-      } else {
-        cm = new DirectColorModel(32,
-          0x00ff0000,
-          0x0000ff00,
-          0x000000ff, 
-          0xff000000);
-        bm = new int[]{
-          0x00ff0000,
-          0x0000ff00,
-          0x000000ff,
-          0xff000000,
-        };
-        byte[] b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3];
-        for (int ixy=0; ixy<nxy; ++ixy)
-          i[ixy] = ((b3[ixy]&0xff)<<24) |
-                   ((b0[ixy]&0xff)<<16) | 
-                   ((b1[ixy]&0xff)<< 8) | 
-                   ((b2[ixy]&0xff)    );
+    }
+    Parallel.loop(missing.size(),new Parallel.LoopInt() {
+      public void compute(int i) {
+        tiles[missing.get(i)].interpolate();
+      }
+    });
+    for (int k:missing)
+      _tileCache.put(tiles[k]);
+
+    // Draw the tiles.
+    for (int jy=jy0,k=0; jy<=jy1; ++jy) {
+      for (int jx=jx0; jx<=jx1; ++jx,++k) {
+        BufferedImage bi = tiles[k].getImage();
+        g2d.drawImage(bi,xd+jx*TILE_SIZE,yd+jy*TILE_SIZE,null);
       }
-      DataBuffer db = new DataBufferInt(i,nxy,0);
-      int dt = DataBuffer.TYPE_INT;
-      SampleModel sm = new SinglePixelPackedSampleModel(dt,nx,ny,bm);
-      WritableRaster wr = Raster.createWritableRaster(sm,db,null);
-      BufferedImage bi = new BufferedImage(cm,wr,false,null);
-      g2d.drawImage(bi,xc,yc,null);
     }
+
+    // Compute in the background tiles adjacent to those visible.
+    prefetchTiles(wd,hd,xl,yt,dxp,dyp,level,jx0,jx1,jy0,jy1);
   }
 
   public ColorMap getColorMap() {
@@ -589,6 +562,210 @@ public class PixelsView extends TiledView implements ColorMapped {
   private double _dy;
   private double _fy;
 
+  // Tiles of pixels, cached so that they need not be recomputed when 
+  // repainting or panning. Tiles are anchored to the top-left corner of 
+  // the view rectangle. Cached tiles with an old version are invalid.
+  // The cache holds tiles for TILE_CACHE_VIEWS times the visible area.
+  private static final int TILE_SIZE = 128;
+  private static final int TILE_CACHE_VIEWS = 3;
+  private TileCache _tileCache = new TileCache(TILE_CACHE_VIEWS*4);
+  private volatile int _tileVersion;
+  private Future<?> _prefetch;
+
+  // Multi-resolution pyramid of sampled floats; level zero is _f.
+  private ArrayList<float[][][]> _pyramid = new ArrayList<float[][][]>();
+
+  // Daemon threads that compute tiles adjacent to those visible.
+  private static ExecutorService _workers = Executors.newFixedThreadPool(
+    max(1,Runtime.getRuntime().availableProcessors()-1),
+    new ThreadFactory() {
+      public Thread newThread(Runnable r) {
+        Thread t = new Thread(r,"PixelsView");
+        t.setDaemon(true);
+        t.setPriority(Thread.NORM_PRIORITY-1);
+        return t;
+      }
+    });
+
+  // One level of the pyramid, with sampling in (x,y) coordinates.
+  private static class Level {
+    float[][][] f;
+    int nx,ny;
+    double dx,dy,fx,fy;
+  }
+
+  // Identifies a tile by its indices (jx,jy) and the view rectangle.
+  private static class TileKey {
+    int wd,hd,jx,jy;
+    double xl,yt;
+    TileKey(int wd, int hd, double xl, double yt, int jx, int jy) {
+      this.wd = wd;
+      this.hd = hd;
+      this.xl = xl;
+      this.yt = yt;
+      this.jx = jx;
+      this.jy = jy;
+    }
+    public boolean equals(Object obj) {
+      if (this==obj)
+        return true;
+      if (obj==null || getClass()!=obj.getClass())
+        return false;
+      TileKey that = (TileKey)obj;
+      return this.wd==that.wd && this.hd==that.hd &&
+             this.jx==that.jx && this.jy==that.jy &&
+             this.xl==that.xl && this.yt==that.yt;
+    }
+    public int hashCode() {
+      long bits = Double.doubleToLongBits(xl)^
+                  Double.doubleToLongBits(yt)*31L;
+      int h = (int)(bits^(bits>>>32));
+      h = 31*h+wd;
+      h = 31*h+hd;
+      h = 31*h+jx;
+      h = 31*h+jy;
+      return h;
+    }
+  }
+
+  // A tile of pixels. Interpolated floats are computed once, perhaps in
+  // a background thread; bytes are recomputed only when clips change, and
+  // an image is made again only when bytes or the color model change.
+  private class Tile {
+    TileKey key;
+    int version;
+    Tile(TileKey key, int version, Level level, double dxp, double dyp) {
+      this.key = key;
+      this.version = version;
+      _level = level;
+      _nx = min(TILE_SIZE,key.wd-key.jx*TILE_SIZE);
+      _ny = min(TILE_SIZE,key.hd-key.jy*TILE_SIZE);
+      _dx = dxp;
+      _dy = dyp;
+      _fx = key.xl+dxp*(key.jx*TILE_SIZE+0.5);
+      _fy = key.yt+dyp*(key.jy*TILE_SIZE+0.5);
+      _transposed = PixelsView.this._transposed;
+      _linear = _interpolation==Interpolation.LINEAR;
+    }
+    void interpolate() {
+      int nc = _level.f.length;
+      float[][] f = new float[nc][];
+      for (int ic=0; ic<nc; ++ic) {
+        float[][] fl = _level.f[ic];
+        f[ic] = (_linear) ?
+          interpolateImageFloatsLinear(
+            _level,fl,_transposed,_nx,_dx,_fx,_ny,_dy,_fy) :
+          interpolateImageFloatsNearest(
+            _level,fl,_transposed,_nx,_dx,_fx,_ny,_dy,_fy);
+      }
+      _f = f;
+    }
+    BufferedImage getImage() {
+      int nc = _f.length;
+      if (_bytes==null) {
+        _bytes = new byte[nc][_nx*_ny];
+        _clipMin = new float[nc];
+        _clipMax = new float[nc];
+      }
+      boolean dirty = _image==null;
+      for (int ic=0; ic<nc; ++ic) {
+        float clipMin = PixelsView.this._clipMin[ic];
+        float clipMax = PixelsView.this._clipMax[ic];
+        if (_image==null || _clipMin[ic]!=clipMin || _clipMax[ic]!=clipMax) {
+          floatsToBytes(_f[ic],clipMin,clipMax,_bytes[ic]);
+          _clipMin[ic] = clipMin;
+          _clipMax[ic] = clipMax;
+          dirty = true;
+        }
+      }
+      if (nc==1) {
+        ColorModel cm = _colorMap.getColorModel();
+        if (dirty || cm!=_image.getColorModel()) {
+          DataBuffer db = new DataBufferByte(_bytes[0],_nx*_ny,0);
+          int dataType = DataBuffer.TYPE_BYTE;
+          int[] bitMasks = new int[]{0xff};
+          SampleModel sm = new SinglePixelPackedSampleModel(
+            dataType,_nx,_ny,bitMasks);
+          WritableRaster wr = Raster.createWritableRaster(sm,db,null);
+          _image = new BufferedImage(cm,wr,false,null);
+        }
+      } else if (dirty) {
+        byte[] r = _bytes[0];
+        byte[] g = _bytes[1];
+        byte[] b = _bytes[2];
+        byte[] a = (nc==4)?_bytes[3]:null;
+        int nxy = _nx*_ny;
+        int[] i = new int[nxy];
+        if (a==null) {
+          for (int ixy=0; ixy<nxy; ++ixy)
+            i[ixy] = ((r[ixy]&0xff)<<16)|
+                     ((g[ixy]&0xff)<< 8)|
+                     ((b[ixy]&0xff));
+        } else {
+          for (int ixy=0; ixy<nxy; ++ixy)
+            i[ixy] = ((a[ixy]&0xff)<<24)|
+                     ((r[ixy]&0xff)<<16)|
+                     ((g[ixy]&0xff)<< 8)|
+                     ((b[ixy]&0xff));
+        }
+        ColorModel cm = (a==null) ?
+          new DirectColorModel(24,0xff0000,0x00ff00,0x0000ff) :
+          new DirectColorModel(32,0xff0000,0x00ff00,0x0000ff,0xff000000);
+        DataBuffer db = new DataBufferInt(i,nxy,0);
+        int[] bitMasks = (a==null) ?
+          new int[]{0xff0000,0x00ff00,0x0000ff} :
+          new int[]{0xff0000,0x00ff00,0x0000ff,0xff000000};
+        SampleModel sm = new SinglePixelPackedSampleModel(
+          DataBuffer.TYPE_INT,_nx,_ny,bitMasks);
+        WritableRaster wr = Raster.createWritableRaster(sm,db,null);
+        _image = new BufferedImage(cm,wr,false,null);
+      }
+      return _image;
+    }
+    private Level _level;
+    private int _nx,_ny;
+    private double _dx,_dy,_fx,_fy;
+    private boolean _transposed,_linear;
+    private volatile float[][] _f;
+    private byte[][] _bytes;
+    private float[] _clipMin,_clipMax;
+    private BufferedImage _image;
+  }
+
+  // A least-recently-used cache of tiles, shared with background threads.
+  private static class TileCache {
+    TileCache(int capacity) {
+      _capacity = capacity;
+    }
+    synchronized Tile get(TileKey key, int version) {
+      Tile tile = _map.get(key);
+      return (tile!=null && tile.version==version)?tile:null;
+    }
+    synchronized void put(Tile tile) {
+      _map.put(tile.key,tile);
+      trim();
+    }
+    synchronized void setCapacity(int capacity) {
+      if (_capacity!=capacity) {
+        _capacity = capacity;
+        trim();
+      }
+    }
+    synchronized void clear() {
+      _map.clear();
+    }
+    private int _capacity;
+    private LinkedHashMap<TileKey,Tile> _map =
+      new LinkedHashMap<TileKey,Tile>(16,0.75f,true);
+    private void trim() {
+      Iterator<Tile> it = _map.values().iterator();
+      while (_map.size()>_capacity) {
+        it.next();
+        it.remove();
+      }
+    }
+  }
+
   private void checkComponent(int ic) {
     Check.argument(ic<_nc,"valid index for color component");
   }
@@ -705,17 +882,160 @@ public class PixelsView extends TiledView implements ColorMapped {
   }
 
   /**
-   * Linear interpolation of sampled floats to image bytes. The bytes in 
-   * the returned array[nx*ny] will be used as indices in a color-mapped 
-   * buffered image.
+   * Gets the level of the multi-resolution pyramid appropriate for the
+   * specified sample increments per pixel. Level zero is the sampled 
+   * floats. Each successive level averages 2x2 samples of the level
+   * before it, and is computed only when first needed. Decimated levels
+   * are used only for linear interpolation, and only if more than two 
+   * samples would otherwise contribute to each pixel, in both dimensions.
    */
-  private byte[] interpolateImageBytesLinear(
-    float[][] f, float clipMin, float clipMax,
+  private Level getLevel(double dxp, double dyp) {
+    double spp = min(dxp/_dx,dyp/_dy); // samples per pixel
+    int nx = _nx, ny = _ny;
+    int il = 0;
+    if (_interpolation==Interpolation.LINEAR) {
+      for (double scale=2.0; scale<=spp; scale*=2.0) {
+        nx = (nx+1)/2;
+        ny = (ny+1)/2;
+        if (nx<2 || ny<2)
+          break;
+        ++il;
+      }
+    }
+    while (_pyramid.size()<=il) {
+      float[][][] f = _pyramid.get(_pyramid.size()-1);
+      float[][][] g = new float[_nc][][];
+      for (int ic=0; ic<_nc; ++ic)
+        g[ic] = halve(f[ic]);
+      _pyramid.add(g);
+    }
+    double scale = (double)(1<<il);
+    Level level = new Level();
+    level.f = _pyramid.get(il);
+    level.nx = (_transposed)?level.f[0].length:level.f[0][0].length;
+    level.ny = (_transposed)?level.f[0][0].length:level.f[0].length;
+    level.dx = _dx*scale;
+    level.dy = _dy*scale;
+    level.fx = _fx+0.5*_dx*(scale-1.0);
+    level.fy = _fy+0.5*_dy*(scale-1.0);
+    return level;
+  }
+
+  /**
+   * Returns an array with half the number of samples in each dimension,
+   * each the average of a 2x2 block of samples in the specified array.
+   */
+  private static float[][] halve(final float[][] f) {
+    final int n1 = f[0].length;
+    final int n2 = f.length;
+    final int m1 = (n1+1)/2;
+    final int m2 = (n2+1)/2;
+    final float[][] g = new float[m2][m1];
+    Parallel.loop(m2,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        float[] fa = f[2*i2];
+        float[] fb = f[min(2*i2+1,n2-1)];
+        float[] g2 = g[i2];
+        for (int i1=0; i1<m1; ++i1) {
+          int j1a = 2*i1;
+          int j1b = min(j1a+1,n1-1);
+          g2[i1] = 0.25f*(fa[j1a]+fa[j1b]+fb[j1a]+fb[j1b]);
+        }
+      }
+    });
+    return g;
+  }
+
+  /**
+   * Computes in the background any tiles, adjacent to those in the 
+   * specified range, that are not already cached. Cancels any such 
+   * computations already begun for tiles that were adjacent before.
+   */
+  private void prefetchTiles(
+    int wd, int hd, double xl, double yt, double dxp, double dyp,
+    Level level, int jx0, int jx1, int jy0, int jy1)
+  {
+    if (_prefetch!=null)
+      _prefetch.cancel(true);
+    _prefetch = null;
+    int mx = (wd-1)/TILE_SIZE;
+    int my = (hd-1)/TILE_SIZE;
+    final int version = _tileVersion;
+    final ArrayList<Tile> tiles = new ArrayList<Tile>();
+    for (int jy=max(0,jy0-1); jy<=min(my,jy1+1); ++jy) {
+      for (int jx=max(0,jx0-1); jx<=min(mx,jx1+1); ++jx) {
+        if (jx<jx0 || jx>jx1 || jy<jy0 || jy>jy1) {
+          TileKey key = new TileKey(wd,hd,xl,yt,jx,jy);
+          if (_tileCache.get(key,version)==null)
+            tiles.add(new Tile(key,version,level,dxp,dyp));
+        }
+      }
+    }
+    if (tiles.isEmpty())
+      return;
+    _prefetch = _workers.submit(new Runnable() {
+      public void run() {
+        for (Tile tile:tiles) {
+          if (Thread.currentThread().isInterrupted() || 
+              version!=_tileVersion)
+            return;
+          tile.interpolate();
+          _tileCache.put(tile);
+        }
+      }
+    });
+  }
+
+  /**
+   * Discards all cached tiles and any tiles being computed.
+   */
+  private void dirtyTiles() {
+    if (_prefetch!=null)
+      _prefetch.cancel(true);
+    _prefetch = null;
+    ++_tileVersion;
+    _tileCache.clear();
+  }
+
+  /**
+   * Forgets all levels of the multi-resolution pyramid, except the first.
+   */
+  private void dirtyPyramid() {
+    _pyramid.clear();
+    _pyramid.add(_f);
+  }
+
+  /**
+   * Converts floats to unsigned bytes. Maps clipMin to 0 and clipMax
+   * to 255, and clips values outside that range.
+   */
+  private static void floatsToBytes(
+    float[] f, float clipMin, float clipMax, byte[] b) 
+  {
+    float fscale = 255.0f/(clipMax-clipMin);
+    float fshift = clipMin;
+    for (int i=0; i<f.length; ++i) {
+      float fi = (f[i]-fshift)*fscale;
+      if (fi<0.0f)
+        fi = 0.0f;
+      if (fi>255.0f)
+        fi = 255.0f;
+      b[i] = (byte)(fi+0.5f);
+    }
+  }
+
+  /**
+   * Linear interpolation of sampled floats to image floats. The floats 
+   * in the returned array[nx*ny] will be converted to bytes used as 
+   * indices or components for colors in a buffered image.
+   */
+  private static float[] interpolateImageFloatsLinear(
+    Level lv, float[][] f, boolean transposed,
     int nx, double dx, double fx,
     int ny, double dy, double fy)
   {
-    // Array of bytes.
-    byte[] b = new byte[nx*ny];
+    // Array of floats.
+    float[] b = new float[nx*ny];
 
     // Array temp1 will contain one row of sampled floats, interpolated to
     // pixel resolution. Likewise, array temp2 will contain an adjacent row
@@ -732,12 +1052,12 @@ public class PixelsView extends TiledView implements ColorMapped {
     float[] wf = new float[nx];
     for (int ix=0; ix<nx; ++ix) {
       double xi = fx+ix*dx;
-      double xn = (xi-_fx)/_dx;
+      double xn = (xi-lv.fx)/lv.dx;
       if (xn<=0.0) {
         kf[ix] = 0;
         wf[ix] = 0.0f;
-      } else if (xn>=_nx-1) {
-        kf[ix] = _nx-2;
+      } else if (xn>=lv.nx-1) {
+        kf[ix] = lv.nx-2;
         wf[ix] = 1.0f;
       } else {
         kf[ix] = (int)xn;
@@ -750,8 +1070,8 @@ public class PixelsView extends TiledView implements ColorMapped {
       double yi = fy+iy*dy;
 
       // Index of sample y.
-      double yn = max(0.0,min(_ny-1,(yi-_fy)/_dy));
-      int jy = max(0,min(_ny-2,(int)yn));
+      double yn = max(0.0,min(lv.ny-1,(yi-lv.fy)/lv.dy));
+      int jy = max(0,min(lv.ny-2,(int)yn));
 
       // If image y is not between current sampled y, ...
       if (jy!=jy1 || iy==0) {
@@ -761,7 +1081,7 @@ public class PixelsView extends TiledView implements ColorMapped {
           float[] temp = temp1;
           temp1 = temp2;
           temp2 = temp;
-          interpx(f,clipMin,clipMax,min(jy+1,_ny-1),nx,kf,wf,temp2);
+          interpx(lv,f,transposed,min(jy+1,lv.ny-1),nx,kf,wf,temp2);
         }
 
         // Else if temp1 is still useful, make it temp2 and compute temp1.
@@ -769,13 +1089,13 @@ public class PixelsView extends TiledView implements ColorMapped {
           float[] temp = temp1;
           temp1 = temp2;
           temp2 = temp;
-          interpx(f,clipMin,clipMax,jy,nx,kf,wf,temp1);
+          interpx(lv,f,transposed,jy,nx,kf,wf,temp1);
         }
 
         // Else compute both temp1 and temp2. */
         else {
-          interpx(f,clipMin,clipMax,             jy,nx,kf,wf,temp1);
-          interpx(f,clipMin,clipMax,min(jy+1,_ny-1),nx,kf,wf,temp2);
+          interpx(lv,f,transposed,              jy,nx,kf,wf,temp1);
+          interpx(lv,f,transposed,min(jy+1,lv.ny-1),nx,kf,wf,temp2);
         }                 
 
         // Remember index jy1 corresponding to temp1.
@@ -791,40 +1111,37 @@ public class PixelsView extends TiledView implements ColorMapped {
 
   /**
    * Linear interpolation of one row of sampled floats to pixel resolution.
-   * Also maps clipMin to 0.0f, and clipMax to 255.0f.
    */
-  private void interpx(
-    float[][] f, float clipMin, float clipMax,
+  private static void interpx(
+    Level lv, float[][] f, boolean transposed,
     int jy, int nx, int[] kf, float[] wf, float[] t) 
   {
-    float fscale = 255.0f/(clipMax-clipMin);
-    float fshift = clipMin;
-    if (_transposed) {
-      if (_nx==1) {
-        float fc = (f[0][jy]-fshift)*fscale;
+    if (transposed) {
+      if (lv.nx==1) {
+        float fc = f[0][jy];
         for (int ix=0; ix<nx; ++ix)
           t[ix] = fc;
       } else {
         for (int ix=0; ix<nx; ++ix) {
           int kx = kf[ix];
           float wx = wf[ix];
-          float f1 = (f[kx  ][jy]-fshift)*fscale;
-          float f2 = (f[kx+1][jy]-fshift)*fscale;
+          float f1 = f[kx  ][jy];
+          float f2 = f[kx+1][jy];
           t[ix] = (1.0f-wx)*f1+wx*f2;
         }
       }
     } else {
       float[] fjy = f[jy];
-      if (_nx==1) {
-        float f0 = (fjy[0]-fshift)*fscale;
+      if (lv.nx==1) {
+        float f0 = fjy[0];
         for (int ix=0; ix<nx; ++ix)
           t[ix] = f0;
       } else {
         for (int ix=0; ix<nx; ++ix) {
           int kx = kf[ix];
           float wx = wf[ix];
-          float f1 = (fjy[kx  ]-fshift)*fscale;
-          float f2 = (fjy[kx+1]-fshift)*fscale;
+          float f1 = fjy[kx  ];
+          float f2 = fjy[kx+1];
           t[ix] = (1.0f-wx)*f1+wx*f2;
         }
       }
@@ -832,52 +1149,46 @@ public class PixelsView extends TiledView implements ColorMapped {
   }
 
   /**
-   * Linear interpolation of one row of bytes between temp1 and temp2.
+   * Linear interpolation of one row of floats between temp1 and temp2.
    */
-  private void interpy(
-    int nx, double frac, float[] temp1, float[] temp2, int kb, byte[] b)
+  private static void interpy(
+    int nx, double frac, float[] temp1, float[] temp2, int kb, float[] b)
   {
     float w2 = (float)frac;
     float w1 = 1.0f-w2;
-    for (int ix=0,ib=kb; ix<nx; ++ix,++ib) {
-      float ti = w1*temp1[ix]+w2*temp2[ix];
-      if (ti<0.0f)
-        ti = 0.0f;
-      if (ti>255.0f)
-        ti = 255.0f;
-      b[ib] = (byte)(ti+0.5f);
-    }
+    for (int ix=0,ib=kb; ix<nx; ++ix,++ib)
+      b[ib] = w1*temp1[ix]+w2*temp2[ix];
   }
 
   /**
-   * Nearest-neighbor interpolation of sampled floats to image bytes. The 
-   * bytes in the returned array[nx*ny] will be used as indices in a 
-   * color-mapped buffered image.
+   * Nearest-neighbor interpolation of sampled floats to image floats. 
+   * The floats in the returned array[nx*ny] will be converted to bytes
+   * used as indices or components for colors in a buffered image.
    */
-  private byte[] interpolateImageBytesNearest(
-    float[][] f, float clipMin, float clipMax,
+  private static float[] interpolateImageFloatsNearest(
+    Level lv, float[][] f, boolean transposed,
     int nx, double dx, double fx,
     int ny, double dy, double fy)
   {
-    // Array of bytes.
-    byte[] b = new byte[nx*ny];
+    // Array of floats.
+    float[] b = new float[nx*ny];
 
-    // Array temp will contain one row of bytes interpolated to pixel
+    // Array temp will contain one row of floats interpolated to pixel
     // resolution. The index jytemp is the row index of the sampled 
     // floats that correspond to the array temp. Initially, jytemp is 
     // garbage, because we have no values in temp.
-    byte[] temp = new byte[nx];
+    float[] temp = new float[nx];
     int jytemp = -1;
 
     // Precomputed indices for fast interpolation in x direction.
     int[] kf = new int[nx];
     for (int ix=0; ix<nx; ++ix) {
       double xi = fx+ix*dx;
-      double xn = (xi-_fx)/_dx;
+      double xn = (xi-lv.fx)/lv.dx;
       if (xn<=0.0) {
         kf[ix] = 0;
-      } else if (xn>=_nx-1) {
-        kf[ix] = _nx-1;
+      } else if (xn>=lv.nx-1) {
+        kf[ix] = lv.nx-1;
       } else {
         kf[ix] = (int)(xn+0.5);
       }
@@ -888,18 +1199,17 @@ public class PixelsView extends TiledView implements ColorMapped {
       double yi = fy+iy*dy;
 
       // Index of sample y.
-      double yn = max(0.0,min(_ny-1,(yi-_fy)/_dy));
-      int jy = max(0,min(_ny-1,(int)(yn+0.5)));
+      double yn = max(0.0,min(lv.ny-1,(yi-lv.fy)/lv.dy));
+      int jy = max(0,min(lv.ny-1,(int)(yn+0.5)));
 
-      // If necessary, interpolate a new row of bytes.
+      // If necessary, interpolate a new row of floats.
       if (jy!=jytemp) {
-        interpx(f,clipMin,clipMax,jy,nx,kf,temp);
+        interpx(f,transposed,jy,nx,kf,temp);
         jytemp = jy;
       }
 
-      // Copy bytes to byte array.
-      for (int i=0,j=iy*nx; i<nx; ++i,++j)
-        b[j] = temp[i];
+      // Copy floats to float array.
+      System.arraycopy(temp,0,b,iy*nx,nx);
     }
 
     return b;
@@ -908,33 +1218,16 @@ public class PixelsView extends TiledView implements ColorMapped {
   /**
    * Nearest-neighbor interpolation of one row of sampled floats to pixels.
    */
-  private void interpx(
-    float[][] f, float clipMin, float clipMax, 
-    int jy, int nx, int[] kf, byte[] b) 
+  private static void interpx(
+    float[][] f, boolean transposed, int jy, int nx, int[] kf, float[] t) 
   {
-    float fscale = 255.0f/(clipMax-clipMin);
-    float fshift = clipMin;
-    if (_transposed) {
-      for (int ix=0; ix<nx; ++ix) {
-        int kx = kf[ix];
-        float fi = (f[kx][jy]-fshift)*fscale;
-        if (fi<0.0f)
-          fi = 0.0f;
-        if (fi>255.0f)
-          fi = 255.0f;
-        b[ix] = (byte)(fi+0.5f);
-      }
+    if (transposed) {
+      for (int ix=0; ix<nx; ++ix)
+        t[ix] = f[kf[ix]][jy];
     } else {
       float[] fjy = f[jy];
-      for (int ix=0; ix<nx; ++ix) {
-        int kx = kf[ix];
-        float fi = (fjy[kx]-fshift)*fscale;
-        if (fi<0.0f)
-          fi = 0.0f;
-        if (fi>255.0f)
-          fi = 255.0f;
-        b[ix] = (byte)(fi+0.5f);
-      }
+      for (int ix=0; ix<nx; ++ix)
+        t[ix] = fjy[kf[ix]];
     }
   }
 }
@@ -0,0 +1,113 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.ogl;
+
+import javax.media.opengl.GLContext;
+
+import static edu.mines.jtk.ogl.Gl.glDeleteBuffers;
+import static edu.mines.jtk.ogl.Gl.glGenBuffers;
+import edu.mines.jtk.util.Check;
+
+/**
+ * An OpenGL buffer object name. When constructed, a buffer name calls
+ * glGenBuffers to generate a single buffer name. When disposed, it 
+ * calls glDeleteBuffers to delete any OpenGL resources, such as vertex 
+ * or index data, bound to that name. If not disposed explicitly, a 
+ * buffer name will dispose itself when finalized during garbage 
+ * collection.
+ * <p>
+ * Like {@link GlTextureName}, this class exists to implement the finalize 
+ * method and thereby reduce the likelihood of OpenGL resource leaks, and
+ * it is not foolproof, for the same reasons. To call glDeleteBuffers, a 
+ * buffer name must lock the OpenGL context in which it was constructed.
+ * If that context has been disposed, buffer resources may be leaked in 
+ * any other context that shared them.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+public class GlBufferName {
+
+  /**
+   * Constructs a buffer name in the current OpenGL context.
+   * Calls glGenBuffers to create one buffer object.
+   * @exception IllegalStateException if the current OpenGL context is null.
+   */
+  public GlBufferName() {
+    _context = GLContext.getCurrent();
+    Check.state(_context!=null,"OpenGL context is not null");
+    int[] names = new int[1];
+    glGenBuffers(1,names,0);
+    _name = names[0];
+  }
+
+  /**
+   * Returns the integer name corresponding to this buffer name.
+   * @return the name; zero, if this buffer name has been disposed.
+   */
+  public int name() {
+    return _name;
+  }
+
+  /**
+   * Returns the OpenGL context in which this buffer name was constructed.
+   * @return the context; null, if this buffer name has been disposed.
+   */
+  public GLContext context() {
+    return _context;
+  }
+
+  /**
+   * Disposes this buffer name. When practical, this method should be called
+   * explicitly. Otherwise, it will be called when this object is finalized
+   * during garbage collection.
+   */
+  public synchronized void dispose() {
+    if (_context!=null) {
+      GLContext current = GLContext.getCurrent();
+      if (_context==current ||
+          _context.makeCurrent()==GLContext.CONTEXT_CURRENT) {
+        try {
+          int[] names = {_name};
+          glDeleteBuffers(1,names,0);
+        } finally {
+          if (_context!=current) {
+            _context.release();
+            if (current!=null)
+              current.makeCurrent();
+          }
+        }
+      }
+      _context = null;
+      _name = 0;
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // protected
+
+  protected void finalize() throws Throwable {
+    try {
+      dispose();
+    } finally {
+      super.finalize();
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // private
+
+  private GLContext _context;
+  private int _name;
+}
@@ -15,6 +15,7 @@ limitations under the License.
 package edu.mines.jtk.opt;
 
 import edu.mines.jtk.util.Almost;
+import edu.mines.jtk.util.Parallel;
 
 import java.io.IOException;
 import java.io.ObjectInputStream;
@@ -198,14 +199,52 @@ public class ArrayVect1f implements Vect {
     // VectConst
     @Override
     public double dot(final VectConst other) {
-        double result = 0;
-        final ArrayVect1f rhs = (ArrayVect1f) other;
-        for (int i = 0; /*Math.max(_firstSample,rhs._firstSample)//breaks transpose*/
-             i < _data.length;
-             ++i) {
-            result += (double) _data[i] * rhs._data[i];
+        final float[] x = _data;
+        final float[] y = ((ArrayVect1f) other)._data;
+        final int n = x.length;
+        if (n < PARALLEL_MIN) {
+            return dot(x, y, 0, n);
         }
-        return result;
+        final double[] d = new double[nchunk(n)];
+        Parallel.loop(d.length, new Parallel.LoopInt() {
+            public void compute(final int ic) {
+                d[ic] = dot(x, y, ic * CHUNK, Math.min(n, (ic + 1) * CHUNK));
+            }
+        });
+        return sum(d);
+    }
+
+    /**
+     * Add another vector to this one, and return the dot product of
+     * the updated vector with a third, in a single pass over the data.
+     * Equivalent to add(scaleThis, scaleOther, other) followed by
+     * dot(dotWith).
+     *
+     * @param scaleThis  Multiply this vector by this scalar before adding.
+     * @param scaleOther Multiply the other vector by this scalar before adding.
+     * @param other      The other vector to be multiplied and added.
+     * @param dotWith    The vector to be dotted with the updated vector.
+     * @return The dot product of the updated vector with dotWith.
+     */
+    public double addAndDot(final double scaleThis, final double scaleOther,
+                            final VectConst other, final VectConst dotWith) {
+        final float s1 = (float) scaleThis;
+        final float s2 = (float) scaleOther;
+        final float[] x = _data;
+        final float[] y = ((ArrayVect1f) other)._data;
+        final float[] z = ((ArrayVect1f) dotWith)._data;
+        final int n = x.length;
+        if (n < PARALLEL_MIN) {
+            return addAndDot(s1, s2, x, y, z, 0, n);
+        }
+        final double[] d = new double[nchunk(n)];
+        Parallel.loop(d.length, new Parallel.LoopInt() {
+            public void compute(final int ic) {
+                d[ic] = addAndDot(s1, s2, x, y, z,
+                        ic * CHUNK, Math.min(n, (ic + 1) * CHUNK));
+            }
+        });
+        return sum(d);
     }
 
     //Vect
@@ -232,10 +271,18 @@ public class ArrayVect1f implements Vect {
     public void add(final double scaleThis, final double scaleOther, final VectConst other) {
         final float s1 = (float) scaleThis;
         final float s2 = (float) scaleOther;
-        final ArrayVect1f rhs = (ArrayVect1f) other;
-        for (int i = 0; i < _data.length; ++i) {
-            _data[i] = s1 * _data[i] + s2 * rhs._data[i];
+        final float[] x = _data;
+        final float[] y = ((ArrayVect1f) other)._data;
+        final int n = x.length;
+        if (n < PARALLEL_MIN) {
+            add(s1, s2, x, y, 0, n);
+            return;
         }
+        Parallel.loop(nchunk(n), new Parallel.LoopInt() {
+            public void compute(final int ic) {
+                add(s1, s2, x, y, ic * CHUNK, Math.min(n, (ic + 1) * CHUNK));
+            }
+        });
     }
 
     // Vect
@@ -255,6 +302,55 @@ public class ArrayVect1f implements Vect {
     public void postCondition() {
     }
 
+    // Arrays with fewer samples are processed serially; larger arrays
+    // are processed in parallel, in chunks of samples.
+    private static final int PARALLEL_MIN = 1 << 16;
+    private static final int CHUNK = 1 << 14;
+
+    private static int nchunk(final int n) {
+        return (n + CHUNK - 1) / CHUNK;
+    }
+
+    // Sums partial results in index order, so that the sum does not
+    // depend on the order in which chunks were computed.
+    private static double sum(final double[] d) {
+        double result = 0.0;
+        for (int i = 0; i < d.length; ++i) {
+            result += d[i];
+        }
+        return result;
+    }
+
+    private static void add(final float s1, final float s2,
+                            final float[] x, final float[] y,
+                            final int i0, final int i1) {
+        for (int i = i0; i < i1; ++i) {
+            x[i] = s1 * x[i] + s2 * y[i];
+        }
+    }
+
+    private static double dot(final float[] x, final float[] y,
+                              final int i0, final int i1) {
+        double result = 0.0;
+        for (int i = i0; i < i1; ++i) {
+            result += (double) x[i] * y[i];
+        }
+        return result;
+    }
+
+    private static double addAndDot(final float s1, final float s2,
+                                    final float[] x, final float[] y,
+                                    final float[] z,
+                                    final int i0, final int i1) {
+        double result = 0.0;
+        for (int i = i0; i < i1; ++i) {
+            final float xi = s1 * x[i] + s2 * y[i];
+            x[i] = xi;
+            result += (double) xi * z[i];
+        }
+        return result;
+    }
+
     // Serializable
     private void writeObject(final ObjectOutputStream out)
             throws IOException {
@@ -15,6 +15,7 @@ limitations under the License.
 package edu.mines.jtk.opt;
 
 import edu.mines.jtk.util.Almost;
+import edu.mines.jtk.util.Parallel;
 
 import java.util.Arrays;
 import java.util.logging.Logger;
@@ -111,14 +112,21 @@ public class ArrayVect2f implements Vect {
   // Vect interface
   @Override
   public void add(double scaleThis, double scaleOther, VectConst other) {
-    float s1 = (float) scaleThis;
-    float s2 = (float) scaleOther;
-    ArrayVect2f o = (ArrayVect2f) other;
-    for (int i=0; i<_data.length; ++i) {
-      for (int j=0; j<_data[i].length; ++j) {
-        _data[i][j] = s1*_data[i][j] + s2*o._data[i][j];
+    final float s1 = (float) scaleThis;
+    final float s2 = (float) scaleOther;
+    final float[][] x = _data;
+    final float[][] y = ((ArrayVect2f) other)._data;
+    if (getSize() < PARALLEL_MIN) {
+      for (int i=0; i<x.length; ++i) {
+        add(s1, s2, x[i], y[i]);
       }
+      return;
     }
+    Parallel.loop(x.length, new Parallel.LoopInt() {
+      public void compute(int i) {
+        add(s1, s2, x[i], y[i]);
+      }
+    });
   }
 
   // Vect interface
@@ -183,12 +191,92 @@ public class ArrayVect2f implements Vect {
   // VectConst interface
   @Override
   public double dot(VectConst other) {
-    ArrayVect2f rhs = (ArrayVect2f) other;
-    double result = 0.;
-    for (int i=0; i<_data.length; ++i) {
-      for (int j=0; j<_data[i].length; ++j) {
-        result += (double) this._data[i][j] * rhs._data[i][j];
+    final float[][] x = _data;
+    final float[][] y = ((ArrayVect2f) other)._data;
+    if (getSize() < PARALLEL_MIN) {
+      double result = 0.;
+      for (int i=0; i<x.length; ++i) {
+        result += dot(x[i], y[i]);
+      }
+      return result;
+    }
+    final double[] d = new double[x.length];
+    Parallel.loop(x.length, new Parallel.LoopInt() {
+      public void compute(int i) {
+        d[i] = dot(x[i], y[i]);
       }
+    });
+    return sum(d);
+  }
+
+  /** Add another vector to this one, and return the dot product of
+      the updated vector with a third, in a single pass over the data.
+      Equivalent to add(scaleThis, scaleOther, other) followed by
+      dot(dotWith).
+      @param scaleThis Multiply this vector by this scalar before adding.
+      @param scaleOther Multiply the other vector by this scalar before adding.
+      @param other The other vector to be multiplied and added.
+      @param dotWith The vector to be dotted with the updated vector.
+      @return The dot product of the updated vector with dotWith.
+  */
+  public double addAndDot(double scaleThis, double scaleOther,
+                          VectConst other, VectConst dotWith) {
+    final float s1 = (float) scaleThis;
+    final float s2 = (float) scaleOther;
+    final float[][] x = _data;
+    final float[][] y = ((ArrayVect2f) other)._data;
+    final float[][] z = ((ArrayVect2f) dotWith)._data;
+    if (getSize() < PARALLEL_MIN) {
+      double result = 0.;
+      for (int i=0; i<x.length; ++i) {
+        result += addAndDot(s1, s2, x[i], y[i], z[i]);
+      }
+      return result;
+    }
+    final double[] d = new double[x.length];
+    Parallel.loop(x.length, new Parallel.LoopInt() {
+      public void compute(int i) {
+        d[i] = addAndDot(s1, s2, x[i], y[i], z[i]);
+      }
+    });
+    return sum(d);
+  }
+
+  // Arrays with fewer samples are processed serially; larger arrays
+  // are processed in parallel, one row at a time.
+  private static final int PARALLEL_MIN = 1<<16;
+
+  // Sums partial results for rows in index order, so that the sum
+  // does not depend on the order in which rows were computed.
+  private static double sum(double[] d) {
+    double result = 0.;
+    for (int i=0; i<d.length; ++i) {
+      result += d[i];
+    }
+    return result;
+  }
+
+  private static void add(float s1, float s2, float[] x, float[] y) {
+    for (int j=0; j<x.length; ++j) {
+      x[j] = s1*x[j] + s2*y[j];
+    }
+  }
+
+  private static double dot(float[] x, float[] y) {
+    double result = 0.;
+    for (int j=0; j<x.length; ++j) {
+      result += (double) x[j] * y[j];
+    }
+    return result;
+  }
+
+  private static double addAndDot(float s1, float s2,
+                                  float[] x, float[] y, float[] z) {
+    double result = 0.;
+    for (int j=0; j<x.length; ++j) {
+      float xj = s1*x[j] + s2*y[j];
+      x[j] = xj;
+      result += (double) xj * z[j];
     }
     return result;
   }
@@ -15,6 +15,7 @@ limitations under the License.
 package edu.mines.jtk.opt;
 
 import edu.mines.jtk.util.Almost;
+import edu.mines.jtk.util.Parallel;
 
 import java.io.IOException;
 import java.io.ObjectInputStream;
@@ -115,14 +116,19 @@ public class ArrayVect3f implements Vect {
     public void add(final double scaleThis, final double scaleOther, final VectConst other) {
         final float s1 = (float) scaleThis;
         final float s2 = (float) scaleOther;
-        final ArrayVect3f rhs = (ArrayVect3f) other;
-        for (int i = 0; i < _data.length; ++i) {
-            for (int j = 0; j < _data[0].length; ++j) {
-                for (int k = 0; k < _data[0][0].length; ++k) {
-                    _data[i][j][k] = s1 * _data[i][j][k] + s2 * rhs._data[i][j][k];
-                }
+        final float[][][] x = _data;
+        final float[][][] y = ((ArrayVect3f) other)._data;
+        if (!isLarge()) {
+            for (int i = 0; i < x.length; ++i) {
+                add(s1, s2, x[i], y[i]);
             }
+            return;
         }
+        Parallel.loop(x.length, new Parallel.LoopInt() {
+            public void compute(final int i) {
+                add(s1, s2, x[i], y[i]);
+            }
+        });
     }
 
     // Vect interface
@@ -183,13 +189,114 @@ public class ArrayVect3f implements Vect {
     // VectConst interface
     @Override
     public double dot(final VectConst other) {
+        final float[][][] x = _data;
+        final float[][][] y = ((ArrayVect3f) other)._data;
+        if (!isLarge()) {
+            double result = 0.0;
+            for (int i = 0; i < x.length; ++i) {
+                result += dot(x[i], y[i]);
+            }
+            return result;
+        }
+        final double[] d = new double[x.length];
+        Parallel.loop(x.length, new Parallel.LoopInt() {
+            public void compute(final int i) {
+                d[i] = dot(x[i], y[i]);
+            }
+        });
+        return sum(d);
+    }
+
+    /**
+     * Add another vector to this one, and return the dot product of
+     * the updated vector with a third, in a single pass over the data.
+     * Equivalent to add(scaleThis, scaleOther, other) followed by
+     * dot(dotWith).
+     *
+     * @param scaleThis  Multiply this vector by this scalar before adding.
+     * @param scaleOther Multiply the other vector by this scalar before adding.
+     * @param other      The other vector to be multiplied and added.
+     * @param dotWith    The vector to be dotted with the updated vector.
+     * @return The dot product of the updated vector with dotWith.
+     */
+    public double addAndDot(final double scaleThis, final double scaleOther,
+                            final VectConst other, final VectConst dotWith) {
+        final float s1 = (float) scaleThis;
+        final float s2 = (float) scaleOther;
+        final float[][][] x = _data;
+        final float[][][] y = ((ArrayVect3f) other)._data;
+        final float[][][] z = ((ArrayVect3f) dotWith)._data;
+        if (!isLarge()) {
+            double result = 0.0;
+            for (int i = 0; i < x.length; ++i) {
+                result += addAndDot(s1, s2, x[i], y[i], z[i]);
+            }
+            return result;
+        }
+        final double[] d = new double[x.length];
+        Parallel.loop(x.length, new Parallel.LoopInt() {
+            public void compute(final int i) {
+                d[i] = addAndDot(s1, s2, x[i], y[i], z[i]);
+            }
+        });
+        return sum(d);
+    }
+
+    // Arrays with fewer samples are processed serially; larger arrays
+    // are processed in parallel, one slice at a time.
+    private static final int PARALLEL_MIN = 1 << 16;
+
+    // Sums partial results for slices in index order, so that the sum
+    // does not depend on the order in which slices were computed.
+    private static double sum(final double[] d) {
         double result = 0.0;
-        final ArrayVect3f rhs = (ArrayVect3f) other;
-        for (int i = 0; i < _data.length; ++i) {
-            for (int j = 0; j < _data[0].length; ++j) {
-                for (int k = 0; k < _data[0][0].length; ++k) {
-                    result += (double) _data[i][j][k] * rhs._data[i][j][k];
-                }
+        for (int i = 0; i < d.length; ++i) {
+            result += d[i];
+        }
+        return result;
+    }
+
+    private boolean isLarge() {
+        return _data.length > 0 && _data[0].length > 0
+                && (long) _data.length * _data[0].length * _data[0][0].length
+                >= PARALLEL_MIN;
+    }
+
+    private static void add(final float s1, final float s2,
+                            final float[][] x, final float[][] y) {
+        for (int j = 0; j < x.length; ++j) {
+            final float[] xj = x[j];
+            final float[] yj = y[j];
+            for (int k = 0; k < xj.length; ++k) {
+                xj[k] = s1 * xj[k] + s2 * yj[k];
+            }
+        }
+    }
+
+    private static double dot(final float[][] x, final float[][] y) {
+        double result = 0.0;
+        for (int j = 0; j < x.length; ++j) {
+            final float[] xj = x[j];
+            final float[] yj = y[j];
+            for (int k = 0; k < xj.length; ++k) {
+                result += (double) xj[k] * yj[k];
+            }
+        }
+        return result;
+    }
+
+    private static double addAndDot(final float s1, final float s2,
+                                    final float[][] x, final float[][] y,
+                                    final float[][] z) {
+        double result = 0.0;
+        for (int j = 0; j < x.length; ++j) {
+            final float[] xj = x[j];
+            final float[] yj = y[j];
+            final float[] zj = z[j];
+            for (int k = 0; k < xj.length; ++k) {
+                final float xjk = s1 * xj[k] + s2 * yj[k];
+                xj[k] = xjk;
+                result += (double) xjk * zj[k];
             }
         }
         return result;
@@ -127,6 +127,11 @@ public class GaussNewtonSolver {
             linearizationIterations = 1;
         }
 
+        // reuse workspace vectors across linearizations
+        // (four for each quadratic solve, one for each line search)
+        final VectPool perturbations = new VectPool(4);
+        final VectPool models = new VectPool(1);
+
         // iteratively linearize transform
         LINEARIZE:
         for (int iter = 0; iter < linearizationIterations && !monitor.isCanceled(); ++iter) {
@@ -143,14 +148,14 @@ public class GaussNewtonSolver {
 
             // get perturbation
             final QuadraticSolver quadraticSolver
-                    = new QuadraticSolver(transformQuadratic);
+                    = new QuadraticSolver(transformQuadratic, perturbations);
             final Vect perturbation = quadraticSolver.solve
                     (conjugateGradIterations, new PartialMonitor(monitor, begin, mid));
 
             // terminate if perturbation is negligible
             final double pp = perturbation.dot(perturbation);
             if (Almost.FLOAT.zero(pp)) {
-                perturbation.dispose();
+                perturbations.give(perturbation);
                 transformQuadratic.dispose();
                 break LINEARIZE;
             }
@@ -160,7 +165,7 @@ public class GaussNewtonSolver {
             if (lineSearchIterations > 0) {
                 final TransformFunction transformFunction =
                         new TransformFunction(transform, data, m0,
-                                perturbation, dampOnlyPerturbation);
+                                perturbation, dampOnlyPerturbation, models);
                 final ScalarSolver scalarSolver = new ScalarSolver(transformFunction);
 
                 final double scalarMin = 0.0;
@@ -179,11 +184,13 @@ public class GaussNewtonSolver {
             // apply constraints to reference model
             m0.constrain();
 
-            perturbation.dispose();
+            perturbations.give(perturbation);
             transformQuadratic.dispose();
 
             monitor.report(end);
         }
+        perturbations.dispose();
+        models.dispose();
         monitor.report(1.0);
         return m0;
     }
@@ -195,6 +202,7 @@ public class GaussNewtonSolver {
         private final VectConst _perturbation;
         private final Vect _model;
         private final TransformQuadratic _transformQuadratic;
+        private final VectPool _pool;
 
         /* Constructor
           @param transform
@@ -202,14 +210,17 @@ public class GaussNewtonSolver {
           @param referenceModel
           @param perturbation
           @param dampOnlyPerturbation
+          @param pool of vectors interchangeable with referenceModel
         */
         private TransformFunction(final Transform transform,
                                   final VectConst data,
                                   final VectConst referenceModel,
                                   final VectConst perturbation,
-                                  final boolean dampOnlyPerturbation) {
+                                  final boolean dampOnlyPerturbation,
+                                  final VectPool pool) {
             _referenceModel = referenceModel;
-            _model = _referenceModel.clone();
+            _pool = pool;
+            _model = _pool.take(_referenceModel);
             _perturbation = perturbation;
             _transformQuadratic = new TransformQuadratic
                     (data, referenceModel, null, transform, dampOnlyPerturbation);
@@ -226,7 +237,7 @@ public class GaussNewtonSolver {
          * Free resources
          */
         public void dispose() {
-            _model.dispose();
+            _pool.give(_model);
         }
     }
 
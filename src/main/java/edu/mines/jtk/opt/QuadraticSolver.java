@@ -56,6 +56,7 @@ import java.util.logging.Logger;
  */
 public class QuadraticSolver {
     private Quadratic _quadratic = null;
+    private VectPool _pool = null;
     private static final Logger LOG = Logger.getLogger("edu.mines.jtk.opt");
 
     /**
@@ -70,6 +71,21 @@ public class QuadraticSolver {
         _quadratic = quadratic;
     }
 
+    /**
+     * Construct a solver that takes its workspace vectors from a pool,
+     * and gives them back to that pool when done.
+     *
+     * @param quadratic Defines the Hessian quadratic term.
+     * @param pool      Pool of vectors interchangeable with those
+     *                  returned by quadratic.getB(). Each solve takes
+     *                  four vectors from the pool, returns one of them
+     *                  as the solution, and gives back the other three.
+     */
+    QuadraticSolver(final Quadratic quadratic, final VectPool pool) {
+        _quadratic = quadratic;
+        _pool = pool;
+    }
+
     /**
      * Return a new solution after the number of conjugate gradient
      * iterations.
@@ -97,15 +113,16 @@ public class QuadraticSolver {
 
         final Vect g = (Vect) b;
         b = null;   // reuse b
-        final Vect x = VectUtil.cloneZero(g); // instance 2
-        final Vect p = x.clone();      // instance 3
-        final Vect u = x.clone();      // instance 4
+        final Vect x = takeZero(g);    // instance 2
+        final Vect p = takeCopy(x);    // instance 3
+        final Vect u = takeCopy(x);    // instance 4
         double pu = 0.0;
-        final Vect qa = g.clone();     // double use for instance 5
+        final Vect qa = takeCopy(g);   // double use for instance 5
 
         SOLVE:
         for (int iter = 0; iter < numberIterations && !monitor.isCanceled(); iter++) {
             double beta = 0.0;
+            double pg;
             {
                 final Vect q = qa;
                 VectUtil.copy(q, g);
@@ -131,9 +148,8 @@ public class QuadraticSolver {
                 VectUtil.copy(a, g);
                 _quadratic.inverseHessian(a);
                 a.postCondition();
-                p.add(beta, -1.0, a);
+                pg = VectUtil.addAndDot(p, beta, -1.0, a, g); // one pass over p
             }
-            final double pg = p.dot(g);
             checkNaN(pg);
             pu = p.dot(u);
             checkNaN(pu);
@@ -147,10 +163,10 @@ public class QuadraticSolver {
             }
             g.add(1.0, scalar, u);
         }
-        p.dispose();
-        u.dispose();
-        g.dispose();
-        qa.dispose();
+        giveBack(p);
+        giveBack(u);
+        g.dispose(); // allocated by getB, not taken from the pool
+        giveBack(qa);
         monitor.report(1.0);
         return x;
     }
@@ -196,6 +212,25 @@ public class QuadraticSolver {
         return result;
     }
 
+    // Take a zeroed vector from the pool, if any.
+    private Vect takeZero(final VectConst v) {
+        return (_pool != null) ? _pool.takeZero(v) : VectUtil.cloneZero(v);
+    }
+
+    // Take a copy of a vector from the pool, if any.
+    private Vect takeCopy(final VectConst v) {
+        return (_pool != null) ? _pool.take(v) : v.clone();
+    }
+
+    // Give a workspace vector back to the pool, if any.
+    private void giveBack(final Vect v) {
+        if (_pool != null) {
+            _pool.give(v);
+        } else {
+            v.dispose();
+        }
+    }
+
     /**
      * Abort if NaN's appear.
      *
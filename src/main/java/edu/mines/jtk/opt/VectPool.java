@@ -0,0 +1,108 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ ****************************************************************************/
+package edu.mines.jtk.opt;
+
+import java.util.ArrayList;
+
+/**
+ * A pool of workspace vectors, reused by solvers across iterations.
+ * Instead of cloning new vectors and disposing of them later, a solver
+ * takes vectors from this pool and gives them back when done.
+ * All vectors in a pool must be interchangeable, as are clones of
+ * one model. A pool holds no more than a specified number of vectors;
+ * vectors given to a full pool are disposed.
+ *
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+class VectPool {
+
+    private final int _capacity;
+    private final ArrayList<Vect> _vects = new ArrayList<Vect>();
+
+    /**
+     * Construct an empty pool.
+     *
+     * @param capacity Maximum number of vectors held by this pool.
+     */
+    public VectPool(final int capacity) {
+        _capacity = capacity;
+    }
+
+    /**
+     * Get the number of vectors now held by this pool.
+     *
+     * @return Number of vectors.
+     */
+    public int size() {
+        return _vects.size();
+    }
+
+    /**
+     * Take a vector from this pool, or clone one if the pool is empty.
+     *
+     * @param v Vector to clone if the pool is empty.
+     * @return A vector with the same state as v.
+     */
+    public Vect take(final VectConst v) {
+        final int n = _vects.size();
+        if (n == 0) {
+            return v.clone();
+        }
+        final Vect result = _vects.remove(n - 1);
+        VectUtil.copy(result, v);
+        return result;
+    }
+
+    /**
+     * Take a vector from this pool, or clone one if the pool is empty.
+     *
+     * @param v Vector to clone if the pool is empty.
+     * @return A vector like v, with zero magnitude.
+     */
+    public Vect takeZero(final VectConst v) {
+        final int n = _vects.size();
+        if (n == 0) {
+            return VectUtil.cloneZero(v);
+        }
+        final Vect result = _vects.remove(n - 1);
+        VectUtil.zero(result);
+        return result;
+    }
+
+    /**
+     * Give a vector back to this pool, for later reuse.
+     * If the pool is full, the vector is disposed instead.
+     *
+     * @param v Vector that the caller will no longer use.
+     */
+    public void give(final Vect v) {
+        if (_vects.size() < _capacity) {
+            _vects.add(v);
+        } else {
+            v.dispose();
+        }
+    }
+
+    /**
+     * Dispose of all vectors in this pool.
+     */
+    public void dispose() {
+        for (final Vect v : _vects) {
+            v.dispose();
+        }
+        _vects.clear();
+    }
+}
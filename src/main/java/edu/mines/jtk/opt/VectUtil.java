@@ -66,6 +66,42 @@ public class VectUtil {
         to.add(0.0, 1.0, from);
     }
 
+    /**
+     * Add another vector to a vector, and return the dot product of
+     * the updated vector with a third.  Equivalent to
+     * v.add(scaleThis, scaleOther, other) followed by v.dot(dotWith),
+     * but vectors implemented by ArrayVect1f, ArrayVect2f, and ArrayVect3f
+     * are updated and dotted in a single pass over their data.
+     *
+     * @param v          Vector to be updated.
+     * @param scaleThis  Multiply v by this scalar before adding.
+     * @param scaleOther Multiply the other vector by this scalar before adding.
+     * @param other      The other vector to be multiplied and added.
+     * @param dotWith    The vector to be dotted with the updated vector.
+     * @return The dot product of the updated vector with dotWith.
+     */
+    public static double addAndDot(final Vect v,
+                                   final double scaleThis,
+                                   final double scaleOther,
+                                   final VectConst other,
+                                   final VectConst dotWith) {
+        if (v instanceof ArrayVect1f && other instanceof ArrayVect1f
+                && dotWith instanceof ArrayVect1f) {
+            return ((ArrayVect1f) v).addAndDot
+                    (scaleThis, scaleOther, other, dotWith);
+        } else if (v instanceof ArrayVect2f && other instanceof ArrayVect2f
+                && dotWith instanceof ArrayVect2f) {
+            return ((ArrayVect2f) v).addAndDot
+                    (scaleThis, scaleOther, other, dotWith);
+        } else if (v instanceof ArrayVect3f && other instanceof ArrayVect3f
+                && dotWith instanceof ArrayVect3f) {
+            return ((ArrayVect3f) v).addAndDot
+                    (scaleThis, scaleOther, other, dotWith);
+        }
+        v.add(scaleThis, scaleOther, other);
+        return v.dot(dotWith);
+    }
+
     /**
      * Clone a vector and initialized to zero, so that
      * out.dot(out) == 0.
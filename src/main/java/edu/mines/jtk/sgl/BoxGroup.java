@@ -0,0 +1,51 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.sgl;
+
+/**
+ * A group with a bounding sphere that encloses a specified bounding box.
+ * For internal use only. Nodes built from a {@link BoundingBoxTree} use 
+ * these groups for interior nodes of that tree. The sphere that encloses 
+ * the box of a subtree is often much smaller than the default sphere that 
+ * encloses the spheres of all children, so that subtrees outside the 
+ * view frustum are culled sooner.
+ * <p>
+ * The specified box must contain everything drawn by this group.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+class BoxGroup extends Group {
+
+  /**
+   * Sets the bounding box that contains all children of this group.
+   * @param bb the bounding box.
+   */
+  public void setBoundingBox(BoundingBox bb) {
+    _bs = new BoundingSphere(bb);
+    dirtyBoundingSphere();
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // protected
+
+  protected BoundingSphere computeBoundingSphere(boolean finite) {
+    return (_bs!=null)?_bs:super.computeBoundingSphere(finite);
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // private
+
+  private BoundingSphere _bs;
+}
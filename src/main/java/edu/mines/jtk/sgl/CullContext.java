@@ -14,6 +14,7 @@ limitations under the License.
 ****************************************************************************/
 package edu.mines.jtk.sgl;
 
+import static edu.mines.jtk.util.MathPlus.*;
 
 /**
  * A context for view frustum culling.
@@ -67,6 +68,49 @@ public class CullContext extends TransformContext {
     return true;
   }
 
+  /**
+   * Returns the approximate diameter, in pixels, of the projection of the
+   * bounding sphere of the specified node. Nodes may use this diameter to
+   * select a level of detail. The node's bounding sphere is assumed to be
+   * in the local coordinates of the current node.
+   * @param node the node with a bounding sphere.
+   * @return the diameter; zero, if the bounding sphere is empty; infinite,
+   *  if the bounding sphere is infinite or contains points at or behind
+   *  the eye.
+   */
+  public double getPixelDiameterOf(Node node) {
+    BoundingSphere bs = node.getBoundingSphere(false);
+    if (bs.isEmpty())
+      return 0.0;
+    if (bs.isInfinite())
+      return Double.POSITIVE_INFINITY;
+    Point3 c = bs.getCenter();
+    double r = bs.getRadius();
+    double[] m = getLocalToPixel().m;
+
+    // If any point in the sphere has non-positive homogeneous coordinate
+    // w, that point lies at or behind the eye.
+    double wc = m[3]*c.x+m[7]*c.y+m[11]*c.z+m[15];
+    double wr = sqrt(m[3]*m[3]+m[7]*m[7]+m[11]*m[11]);
+    if (wc-r*wr<=0.0)
+      return Double.POSITIVE_INFINITY;
+
+    // Largest projected distance between the center and the center
+    // displaced by radius r along each of the local coordinate axes.
+    double xc = (m[0]*c.x+m[4]*c.y+m[ 8]*c.z+m[12])/wc;
+    double yc = (m[1]*c.x+m[5]*c.y+m[ 9]*c.z+m[13])/wc;
+    double dmax = 0.0;
+    for (int k=0; k<3; ++k) {
+      double w = wc+r*m[3+4*k];
+      double x = (m[0]*c.x+m[4]*c.y+m[ 8]*c.z+m[12]+r*m[4*k  ])/w;
+      double y = (m[1]*c.x+m[5]*c.y+m[ 9]*c.z+m[13]+r*m[4*k+1])/w;
+      double dx = x-xc;
+      double dy = y-yc;
+      dmax = max(dmax,dx*dx+dy*dy);
+    }
+    return 2.0*sqrt(dmax);
+  }
+
   /**
    * Appends the node stack to the draw list in this context.
    */
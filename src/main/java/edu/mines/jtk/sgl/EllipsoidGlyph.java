@@ -14,10 +14,6 @@ limitations under the License.
 ****************************************************************************/
 package edu.mines.jtk.sgl;
 
-import java.nio.FloatBuffer;
-
-import edu.mines.jtk.ogl.*;
-import edu.mines.jtk.util.*;
 import static edu.mines.jtk.ogl.Gl.*;
 import static edu.mines.jtk.util.ArrayMath.*;
 
@@ -29,8 +25,13 @@ import static edu.mines.jtk.util.ArrayMath.*;
  * each ellipsoid to be rendered. 
  * <p>
  * Internally, each ellipsoid is drawn by transforming an approximation to 
- * a unit sphere (with radius one) that has been precomputed and stored in 
- * an OpenGL display list.
+ * a unit sphere (with radius one) that has been precomputed and stored, 
+ * with vertices shared by adjacent triangles, in OpenGL buffer objects.
+ * <p>
+ * When drawing many ellipsoids, a node should bracket its calls to the 
+ * draw methods with calls to {@link #begin()} and {@link #end()}. Those 
+ * buffer objects are then bound only once, and each ellipsoid requires 
+ * only a transform and a single call to glDrawElements.
  * <p>
  * The unit sphere is approximated by recursively subdividing the triangular 
  * faces of an octahedron. The quality of the approximation increases with 
@@ -75,25 +76,43 @@ public class EllipsoidGlyph {
     return _xyz;
   }
 
+  /**
+   * Begins drawing of multiple ellipsoids. Until the method {@link #end()} 
+   * is called, the only OpenGL calls made between these two methods 
+   * should be calls to the draw methods of this glyph, or calls that 
+   * change OpenGL state not related to vertex arrays, such as the current 
+   * color or material.
+   */
+  public void begin() {
+    if (!_drawing) {
+      if (_vbs==null)
+        _vbs = makeVertexBuffers(_xyz);
+      _vbs.enable();
+      _drawing = true;
+    }
+  }
+
+  /**
+   * Ends drawing of multiple ellipsoids begun with {@link #begin()}.
+   */
+  public void end() {
+    if (_drawing) {
+      _vbs.disable();
+      _drawing = false;
+    }
+  }
+
   /**
    * Draws a unit sphere centered at the origin.
    */
   public void draw() {
-    if (_displayList==null) {
-      FloatBuffer xyz = Direct.newFloatBuffer(3*_nv);
-      xyz.put(_xyz); xyz.rewind();
-      _displayList = new GlDisplayList();
-      glEnableClientState(GL_VERTEX_ARRAY);
-      glEnableClientState(GL_NORMAL_ARRAY);
-      glNewList(_displayList.list(),GL_COMPILE);
-      glVertexPointer(3,GL_FLOAT,0,xyz);
-      glNormalPointer(GL_FLOAT,0,xyz);
-      glDrawArrays(GL_TRIANGLES,0,_nv);
-      glEndList();
-      glDisableClientState(GL_NORMAL_ARRAY);
-      glDisableClientState(GL_VERTEX_ARRAY);
+    if (_drawing) {
+      _vbs.draw(GL_TRIANGLES);
+    } else {
+      begin();
+      _vbs.draw(GL_TRIANGLES);
+      end();
     }
-    glCallList(_displayList.list());
   }
 
   /**
@@ -179,7 +198,17 @@ public class EllipsoidGlyph {
   private float[] _m; // transform matrix used when drawing
   private int _nv; // number of vertices for unit sphere
   private float[] _xyz; // vertices on the unit sphere
-  private GlDisplayList _displayList; // draws unit sphere when called
+  private VertexBuffers _vbs; // indexed vertices of the unit sphere
+  private boolean _drawing; // true, if between begin and end
+
+  private static VertexBuffers makeVertexBuffers(float[] xyz) {
+    int nt = xyz.length/9;
+    int[] index = new int[nt];
+    for (int it=0; it<nt; ++it)
+      index[it] = it;
+    int[] ijk = TriangleGroup.indexVertices(false,xyz);
+    return VertexBuffers.makeIndexed(3,index,ijk,xyz,xyz,null);
+  }
 
   private void makeTransformMatrix() {
     _m = new float[16];
@@ -17,6 +17,13 @@ package edu.mines.jtk.sgl;
 import java.awt.image.IndexColorModel;
 import java.nio.IntBuffer;
 import java.util.ArrayList;
+import java.util.Iterator;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.ThreadFactory;
+import javax.swing.SwingUtilities;
 
 import edu.mines.jtk.awt.ColorMap;
 import edu.mines.jtk.awt.ColorMapListener;
@@ -31,6 +38,15 @@ import static edu.mines.jtk.util.MathPlus.min;
  * An axis-aligned panel that draws a 2D image of a slice of a 3D array.
  * The corner points of the image panel's axis-aligned frame determines 
  * which slice of the 3D array is drawn.
+ * <p>
+ * By default, textures for an image panel are streamed. When a slice is
+ * first drawn, the panel quickly draws a coarse image computed from only
+ * a fraction of its samples, while worker threads prepare the image at
+ * full resolution, which is drawn when ready. When slices are dragged,
+ * work for slices passed over is cancelled, so that the image is refined
+ * only for the slice where dragging stops. Textures for slices recently 
+ * drawn are cached, so that those slices, when revisited, are drawn 
+ * without being loaded again.
  * @author Dave Hale, Colorado School of Mines
  * @version 2006.06.04
  */
@@ -177,6 +193,35 @@ public class ImagePanel extends AxisAlignedPanel {
     return _clips.getPercentileMax();
   }
 
+  /**
+   * Sets whether textures for this panel are streamed.
+   * If true, coarse images are drawn while images at full resolution are
+   * prepared by worker threads. Otherwise (the default), only images at
+   * full resolution, prepared while drawing, are drawn.
+   * <p>
+   * Streaming requires that the {@link Float3} for this panel be
+   * thread-safe, because its get methods are called concurrently by
+   * worker threads while the panel is drawing. Arrays wrapped by the
+   * constructors that take float[][][] may be streamed, provided that
+   * their values do not change while the panel is drawn.
+   * @param streaming true, for streaming; false, otherwise.
+   */
+  public void setTextureStreaming(boolean streaming) {
+    if (_streaming!=streaming) {
+      _streaming = streaming;
+      _texturesDirty = true;
+      dirtyDraw();
+    }
+  }
+
+  /**
+   * Determines whether textures for this panel are streamed.
+   * @return true, if streaming; false, otherwise.
+   */
+  public boolean isTextureStreaming() {
+    return _streaming;
+  }
+
   /**
    * Adds the specified color map listener.
    * @param cml the listener.
@@ -201,6 +246,23 @@ public class ImagePanel extends AxisAlignedPanel {
     drawTextures();
   }
 
+  ///////////////////////////////////////////////////////////////////////////
+  // package
+
+  /**
+   * Sets the cache of textures for slices recently drawn by this panel.
+   * Panels in a group share one cache, which must be used with only one
+   * OpenGL context. A panel not in a group has its own cache, sized to
+   * hold the textures for a few slices.
+   * @param cache the texture cache.
+   */
+  void setTextureCache(TextureCache cache) {
+    if (_cacheOwned)
+      _cache.clear();
+    _cache = cache;
+    _cacheOwned = false;
+  }
+
   ///////////////////////////////////////////////////////////////////////////
   // private
 
@@ -274,7 +336,186 @@ public class ImagePanel extends AxisAlignedPanel {
 
   // Used when creating/loading a texture.
   private IntBuffer _pixels; // array[_lt][_ls] of image pixels for one texture
-  private float[][] _floats; // array[_ls][_lt] of image floats for one texture
+  private Boolean _mipmap; // true, if mipmaps; null, until determined
+
+  // Texture streaming. Textures in the cache array _tn are either fine,
+  // with image pixels at full resolution, or coarse, with pixels computed
+  // from every PREVIEW_FACTOR'th sample. Worker threads prepare tiles of
+  // fine pixels, and put them in a queue of tiles to be loaded. Queued
+  // tiles are loaded if their version and slice are still current. The
+  // version is incremented whenever all textures become stale.
+  private boolean _streaming = false; // true, if streaming textures
+  private boolean[][] _fine; // array[_mt][_ms]; true, if texture is fine
+  private int _version; // incremented when textures become stale
+  private ArrayList<Future<?>> _jobs = new ArrayList<Future<?>>();
+  private ConcurrentLinkedQueue<Tile> _tiles = 
+    new ConcurrentLinkedQueue<Tile>();
+  private static final int PREVIEW_FACTOR = 4;
+
+  // Fine textures for slices no longer drawn; may be shared by panels.
+  // If owned by this panel, the cache holds tiles for CACHE_SLICES slices.
+  private TextureCache _cache = new TextureCache(0);
+  private boolean _cacheOwned = true; // true, if not shared by panels
+  private static final int CACHE_SLICES = 4;
+
+  // Worker threads shared by all image panels.
+  private static final ExecutorService _workers =
+    Executors.newFixedThreadPool(
+      max(1,Runtime.getRuntime().availableProcessors()-1),
+      new ThreadFactory() {
+        public Thread newThread(Runnable r) {
+          Thread t = new Thread(r,"ImagePanel");
+          t.setDaemon(true);
+          t.setPriority(Thread.NORM_PRIORITY-1);
+          return t;
+        }
+      });
+
+  // Key for a cached texture.
+  private static class TileKey {
+    TileKey(ImagePanel ip, Axis axis, int version, int kp, int js, int jt) {
+      _ip = ip;
+      _axis = axis;
+      _version = version;
+      _kp = kp;
+      _js = js;
+      _jt = jt;
+    }
+    public boolean equals(Object o) {
+      if (!(o instanceof TileKey))
+        return false;
+      TileKey k = (TileKey)o;
+      return _ip==k._ip && _axis==k._axis && _version==k._version &&
+             _kp==k._kp && _js==k._js && _jt==k._jt;
+    }
+    public int hashCode() {
+      int h = System.identityHashCode(_ip);
+      h = 31*h+_axis.hashCode();
+      h = 31*h+_version;
+      h = 31*h+_kp;
+      h = 31*h+_js;
+      h = 31*h+_jt;
+      return h;
+    }
+    private ImagePanel _ip;
+    private Axis _axis;
+    private int _version,_kp,_js,_jt;
+  }
+
+  // A tile of image pixels for one texture. Everything required to
+  // compute the pixels is copied when the tile is constructed, so that
+  // pixels may be computed in any thread.
+  private class Tile implements Runnable {
+    Tile(int js, int jt, int df) {
+      this.js = js;
+      this.jt = jt;
+      this.df = df;
+      axis = _axis;
+      version = _version;
+      kp = slice();
+      ks = js*(_ls-1);
+      kt = jt*(_lt-1);
+      ls = min(_ls,_ns-ks);
+      lt = min(_lt,_nt-kt);
+      lsp = _ls;
+      ltp = _lt;
+      clipMin = _clipMin;
+      clipMax = _clipMax;
+      icm = _colorMap.getColorModel();
+    }
+    public void run() {
+      pixels = makePixels();
+      _tiles.add(this);
+      SwingUtilities.invokeLater(new Runnable() {
+        public void run() {
+          dirtyDraw();
+        }
+      });
+    }
+
+    // Returns image pixels. If the decimation factor df exceeds one,
+    // reads only every df'th line of samples, and replicates each pixel
+    // for a block of df*df pixels. Pixels outside the portion of the 
+    // texture drawn are copied from the nearest edge, so that mipmaps
+    // are not polluted by junk.
+    int[] makePixels() {
+      float[][] f = new float[ls][lt];
+      if (df==1) {
+        if (axis==Axis.X) {
+          _f.get12(lt,ls,kt,ks,kp,f);
+        } else if (axis==Axis.Y) {
+          _f.get13(lt,ls,kt,kp,ks,f);
+        } else if (axis==Axis.Z) {
+          _f.get23(lt,ls,kp,kt,ks,f);
+        }
+      } else {
+        float[] g = new float[lt];
+        for (int is=0; is<ls; is+=df) {
+          int ms = min(is+df/2,ls-1);
+          if (axis==Axis.X) {
+            _f.get1(lt,kt,ks+ms,kp,g);
+          } else if (axis==Axis.Y) {
+            _f.get1(lt,kt,kp,ks+ms,g);
+          } else if (axis==Axis.Z) {
+            _f.get2(lt,kp,kt,ks+ms,g);
+          }
+          for (int it=0; it<lt; it+=df)
+            f[is][it] = g[min(it+df/2,lt-1)];
+        }
+      }
+      float fscale = 255.0f/(clipMax-clipMin);
+      float fshift = clipMin;
+      int[] p = new int[lsp*ltp];
+      for (int is=0; is<ls; is+=df) {
+        for (int it=0; it<lt; it+=df) {
+          float fi = (f[is][it]-fshift)*fscale;
+          if (fi<0.0f)
+            fi = 0.0f;
+          if (fi>255.0f)
+            fi = 255.0f;
+          int i = (int)(fi+0.5f);
+          int r = icm.getRed(i);
+          int g = icm.getGreen(i);
+          int b = icm.getBlue(i);
+          int a = icm.getAlpha(i);
+          int pi = (r&0xff)|((g&0xff)<<8)|((b&0xff)<<16)|((a&0xff)<<24);
+          for (int bt=it; bt<min(it+df,lt); ++bt) {
+            for (int bs=is; bs<min(is+df,ls); ++bs)
+              p[bs+bt*lsp] = pi;
+          }
+        }
+      }
+      for (int it=0; it<lt; ++it) {
+        for (int is=ls; is<lsp; ++is)
+          p[is+it*lsp] = p[ls-1+it*lsp];
+      }
+      for (int it=lt; it<ltp; ++it)
+        System.arraycopy(p,(lt-1)*lsp,p,it*lsp,lsp);
+      return p;
+    }
+
+    final int js,jt,df; // texture indices and decimation factor
+    final Axis axis; // axis of panel
+    final int version; // version of textures
+    final int kp; // index of slice
+    final int ks,kt; // indices of first samples in texture
+    final int ls,lt; // numbers of samples drawn in texture
+    final int lsp,ltp; // numbers of pixels in texture
+    final float clipMin,clipMax; // clips
+    final IndexColorModel icm; // color model
+    int[] pixels; // pixels computed by worker thread
+  }
+
+  // Returns the index of the slice drawn by this panel.
+  private int slice() {
+    if (_axis==Axis.X) {
+      return _kxmin;
+    } else if (_axis==Axis.Y) {
+      return _kymin;
+    } else {
+      return _kzmin;
+    }
+  }
 
   /**
    * Update the clip min/max for this panel, if necessary.
@@ -319,6 +560,9 @@ public class ImagePanel extends AxisAlignedPanel {
     if (_texturesDirty)
       updateTextures();
 
+    // Load any tiles of fine pixels prepared by worker threads.
+    loadTiles();
+
     // Prepare to draw textures.
     glShadeModel(GL_FLAT);
     glEnable(GL_TEXTURE_2D);
@@ -415,7 +659,9 @@ public class ImagePanel extends AxisAlignedPanel {
   private void updateSampling(
     Axis axis, Sampling sx, Sampling sy, Sampling sz) 
   {
+    cancelJobs();
     disposeTextures();
+    ++_version;
     int nx = sx.getCount();
     int ny = sy.getCount();
     int nz = sz.getCount();
@@ -456,6 +702,9 @@ public class ImagePanel extends AxisAlignedPanel {
     _ms = 1+(_ns-2)/(_ls-1);
     _mt = 1+(_nt-2)/(_lt-1);
     _tn = new GlTextureName[_mt][_ms];
+    _fine = new boolean[_mt][_ms];
+    if (_cacheOwned)
+      _cache.setCapacity(CACHE_SLICES*_ms*_mt);
     _kxmin = 0;  _kxmax = -1;
     _kymin = 0;  _kymax = -1;
     _kzmin = 0;  _kzmax = -1;
@@ -464,7 +713,6 @@ public class ImagePanel extends AxisAlignedPanel {
     _jsmin = 0;  _jsmax = -1;
     _jtmin = 0;  _jtmax = -1;
     _pixels = Direct.newIntBuffer(_ls*_lt);
-    _floats = new float[_ls][_lt];
   }
 
   private void updateBoundsAndTextures(
@@ -483,6 +731,7 @@ public class ImagePanel extends AxisAlignedPanel {
     int kxmax = _sx.indexOfNearest(_xmax);
     int kymax = _sy.indexOfNearest(_ymax);
     int kzmax = _sz.indexOfNearest(_zmax);
+    int kpold = slice();
     boolean stale;
     if (_axis==Axis.X) {
       stale = _kxmin!=kxmin;
@@ -516,15 +765,25 @@ public class ImagePanel extends AxisAlignedPanel {
     int jsmax = max(0,_ksmax-1)/(_ls-1);
     int jtmax = max(0,_ktmax-1)/(_lt-1);
 
+    // Work for a slice no longer drawn is pointless.
+    if (stale)
+      cancelJobs();
+
     // Stale textures are in the cache but no longer needed.
-    // Move stale textures from the cache to a stale list.
+    // Put fine stale textures in the cache of textures for slices
+    // recently drawn. Move other stale textures to a stale list.
     ArrayList<GlTextureName> staleList = new ArrayList<GlTextureName>();
     for (int jt=_jtmin; jt<=_jtmax; ++jt) {
       for (int js=_jsmin; js<=_jsmax; ++js) {
         if (stale || js<jsmin || jt<jtmin || jsmax<js || jtmax<jt) {
           if (_tn[jt][js]!=null) {
-            staleList.add(_tn[jt][js]);
+            if (_fine[jt][js] && !_texturesDirty) {
+              _cache.put(tileKey(kpold,js,jt),_tn[jt][js]);
+            } else {
+              staleList.add(_tn[jt][js]);
+            }
             _tn[jt][js] = null;
+            _fine[jt][js] = false;
           }
         }
       }
@@ -532,7 +791,21 @@ public class ImagePanel extends AxisAlignedPanel {
     int nstale = staleList.size();
 
     // Update texture cache. For each texture required but not cached,
-    // if possible, reuse a stale texture, else make a new texture.
+    // if possible, take a fine texture from the cache of textures for
+    // slices recently drawn. Otherwise, reuse a stale texture, if any, 
+    // or recycle a texture from that cache, or make a new texture.
+    int kp = slice();
+    for (int jt=jtmin; jt<=jtmax; ++jt) {
+      for (int js=jsmin; js<=jsmax; ++js) {
+        GlTextureName tn = _tn[jt][js];
+        if (tn==null && !_texturesDirty)
+          tn = _cache.take(tileKey(kp,js,jt));
+        if (tn!=null) {
+          _tn[jt][js] = tn;
+          _fine[jt][js] = true;
+        }
+      }
+    }
     for (int jt=jtmin; jt<=jtmax; ++jt) {
       for (int js=jsmin; js<=jsmax; ++js) {
         GlTextureName tn = _tn[jt][js];
@@ -540,7 +813,9 @@ public class ImagePanel extends AxisAlignedPanel {
           if (!staleList.isEmpty()) {
             tn = staleList.remove(--nstale);
           } else {
-            tn = makeTexture();
+            tn = _cache.recycle();
+            if (tn==null)
+              tn = makeTexture();
           }
           _tn[jt][js] = tn;
           loadTexture(js,jt);
@@ -566,6 +841,10 @@ public class ImagePanel extends AxisAlignedPanel {
 
   private void updateTextures() {
 
+    // All textures, including any being prepared, are now stale.
+    cancelJobs();
+    ++_version;
+
     // Reload only those textures already cached.
     for (int jt=_jtmin; jt<=_jtmax; ++jt) {
       for (int js=_jsmin; js<=_jsmax; ++js) {
@@ -592,55 +871,86 @@ public class ImagePanel extends AxisAlignedPanel {
   }
 
   private GlTextureName makeTexture() {
+    if (_mipmap==null)
+      _mipmap = isFunctionAvailable("glGenerateMipmap");
     glPixelStorei(GL_UNPACK_ALIGNMENT,1);
     GlTextureName tn = new GlTextureName();
     glBindTexture(GL_TEXTURE_2D,tn.name());
-    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_S,GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_T,GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
+    if (_mipmap) {
+      glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_EDGE);
+      glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_T,GL_CLAMP_TO_EDGE);
+      glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
+      glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,
+                      GL_LINEAR_MIPMAP_LINEAR);
+    } else {
+      glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_S,GL_REPEAT);
+      glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_T,GL_REPEAT);
+      glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
+      glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
+    }
     glTexImage2D(
       GL_TEXTURE_2D,0,GL_RGBA,_ls,_lt,0,GL_RGBA,GL_UNSIGNED_BYTE,_pixels);
+    if (_mipmap)
+      glGenerateMipmap(GL_TEXTURE_2D);
     glBindTexture(GL_TEXTURE_2D,0);
     return tn;
   }
 
+  // Loads a texture. If streaming, loads coarse pixels now and submits
+  // to worker threads the preparation of fine pixels to be loaded later.
   private void loadTexture(int js, int jt) {
-    int ks = js*(_ls-1);
-    int kt = jt*(_lt-1);
-    int ls = min(_ls,_ns-ks);
-    int lt = min(_lt,_nt-kt);
-    if (_axis==Axis.X) {
-      _f.get12(lt,ls,kt,ks,_kxmin,_floats);
-    } else if (_axis==Axis.Y) {
-      _f.get13(lt,ls,kt,_kymin,ks,_floats);
-    } else if (_axis==Axis.Z) {
-      _f.get23(lt,ls,_kzmin,kt,ks,_floats);
+    if (_streaming) {
+      loadPixels(_tn[jt][js],new Tile(js,jt,PREVIEW_FACTOR).makePixels());
+      _fine[jt][js] = false;
+      if (_jobs.size()>=2*_ms*_mt) {
+        for (Iterator<Future<?>> it=_jobs.iterator(); it.hasNext();) {
+          if (it.next().isDone())
+            it.remove();
+        }
+      }
+      _jobs.add(_workers.submit(new Tile(js,jt,1)));
+    } else {
+      loadPixels(_tn[jt][js],new Tile(js,jt,1).makePixels());
+      _fine[jt][js] = true;
     }
-    float fscale = 255.0f/(_clipMax-_clipMin);
-    float fshift = _clipMin;
-    IndexColorModel icm = _colorMap.getColorModel();
-    for (int is=0; is<ls; ++is) {
-      for (int it=0; it<lt; ++it) {
-        float fi = (_floats[is][it]-fshift)*fscale;
-        if (fi<0.0f)
-          fi = 0.0f;
-        if (fi>255.0f)
-          fi = 255.0f;
-        int i = (int)(fi+0.5f);
-        int r = icm.getRed(i);
-        int g = icm.getGreen(i);
-        int b = icm.getBlue(i);
-        int a = icm.getAlpha(i);
-        int p = (r&0xff)|((g&0xff)<<8)|((b&0xff)<<16)|((a&0xff)<<24);
-        _pixels.put(is+it*_ls,p);
+  }
+
+  // Loads any tiles of fine pixels that are still current.
+  private void loadTiles() {
+    for (Tile tile=_tiles.poll(); tile!=null; tile=_tiles.poll()) {
+      if (tile.version==_version && tile.axis==_axis && tile.kp==slice()) {
+        int js = tile.js;
+        int jt = tile.jt;
+        if (_tn[jt][js]!=null && !_fine[jt][js]) {
+          loadPixels(_tn[jt][js],tile.pixels);
+          _fine[jt][js] = true;
+        }
       }
     }
+  }
+
+  // Cancels any pending preparation of fine pixels.
+  private void cancelJobs() {
+    for (Future<?> job:_jobs)
+      job.cancel(false);
+    _jobs.clear();
+    _tiles.clear();
+  }
+
+  private void loadPixels(GlTextureName tn, int[] p) {
+    _pixels.rewind();
+    _pixels.put(p);
+    _pixels.rewind();
     glPixelStorei(GL_UNPACK_ALIGNMENT,1);
-    GlTextureName tn = _tn[jt][js];
     glBindTexture(GL_TEXTURE_2D,tn.name());
     glTexSubImage2D(
       GL_TEXTURE_2D,0,0,0,_ls,_lt,GL_RGBA,GL_UNSIGNED_BYTE,_pixels);
+    if (_mipmap)
+      glGenerateMipmap(GL_TEXTURE_2D);
     glBindTexture(GL_TEXTURE_2D,0);
   }
+
+  private TileKey tileKey(int kp, int js, int jt) {
+    return new TileKey(this,_axis,_version,kp,js,jt);
+  }
 }
@@ -236,6 +236,27 @@ public class ImagePanelGroup extends Group {
     _colorMap.removeListener(cml);
   }
 
+  /**
+   * Sets whether textures for image panels in this group are streamed.
+   * @param streaming true, for streaming; false, otherwise.
+   * @see ImagePanel#setTextureStreaming(boolean)
+   */
+  public void setTextureStreaming(boolean streaming) {
+    for (ImagePanel ip:_ipList)
+      ip.setTextureStreaming(streaming);
+  }
+
+  /**
+   * Sets the maximum number of textures cached for slices recently drawn.
+   * All image panels in this group share one cache of textures, so that
+   * slices revisited by any panel are drawn without loading them again.
+   * Each texture has 64*64 pixels. The default size is 1024 textures.
+   * @param size the maximum number of cached textures.
+   */
+  public void setTextureCacheSize(int size) {
+    _textureCache.setCapacity(size);
+  }
+
   /**
    * Sets indices of image slices displayed in this group.
    * @param k1 index in 1st dimension (Z axis).
@@ -281,6 +302,7 @@ public class ImagePanelGroup extends Group {
   private ArrayList<ImagePanel> _ipList;
   private Clips _clips;
   private ColorMap _colorMap = new ColorMap(0.0,1.0,ColorMap.GRAY);
+  private TextureCache _textureCache = new TextureCache(1024);
 
   private void addPanels(
     Sampling s1, Sampling s2, Sampling s3, Float3 f3, Axis[] axes) 
@@ -308,6 +330,7 @@ public class ImagePanelGroup extends Group {
       AxisAlignedQuad aaq = new AxisAlignedQuad(axes[jp],qmin,qmax);
       ImagePanel ip = new ImagePanel(s1,s2,s3,f3);
       ip.setColorModel(getColorModel());
+      ip.setTextureCache(_textureCache);
       aaq.getFrame().addChild(ip);
       this.addChild(aaq);
       _ipList.add(ip);
@@ -15,8 +15,11 @@ limitations under the License.
 package edu.mines.jtk.sgl;
 
 import java.nio.FloatBuffer;
+import java.util.Random;
 
 import static edu.mines.jtk.ogl.Gl.*;
+import static edu.mines.jtk.util.MathPlus.*;
+import edu.mines.jtk.util.Check;
 import edu.mines.jtk.util.Direct;
 
 /**
@@ -81,6 +84,19 @@ public class PointGroup extends Group {
     buildTree(xyz,rgb);
   }
 
+  /**
+   * Sets the tolerance used to select levels of detail, in pixels.
+   * Subsets of points that appear small in a view are drawn with fewer 
+   * points, such that about one point is drawn for each square with 
+   * sides of this number of pixels. The default tolerance is one pixel.
+   * @param tolerance the tolerance; zero, to always draw all points.
+   */
+  public void setDetailTolerance(float tolerance) {
+    Check.argument(tolerance>=0.0f,"tolerance>=0.0f");
+    _detailTolerance = tolerance;
+    dirtyDraw();
+  }
+
   ///////////////////////////////////////////////////////////////////////////
   // private
 
@@ -91,15 +107,18 @@ public class PointGroup extends Group {
   private static final int MIN_POINT_PER_NODE = 2048;
 
   private float _size; // size of cubes used to represent points
+  private float _detailTolerance = 1.0f; // in pixels; zero for no LOD
 
   /**
    * Recursively builds a binary tree with leaf point nodes.
+   * Interior nodes are groups with bounding spheres that enclose the
+   * boxes of points in their subtrees.
    */
   private void buildTree(float[] xyz, float[] rgb) {
     BoundingBoxTree bbt = new BoundingBoxTree(MIN_POINT_PER_NODE,xyz);
     buildTree(this,bbt.getRoot(),xyz,rgb);
   }
-  private void buildTree(
+  private BoundingBox buildTree(
     Group parent, BoundingBoxTree.Node bbtNode, 
     float[] xyz, float[] rgb) 
   {
@@ -111,12 +130,35 @@ public class PointGroup extends Group {
         pn = new PointNode(bbtNode,xyz,rgb);
       }
       parent.addChild(pn);
+      return pn._bb;
     } else {
-      Group group = new Group();
+      BoxGroup group = new BoxGroup();
       parent.addChild(group);
-      buildTree(group,bbtNode.getLeft(),xyz,rgb);
-      buildTree(group,bbtNode.getRight(),xyz,rgb);
+      BoundingBox bb = new BoundingBox();
+      bb.expandBy(buildTree(group,bbtNode.getLeft(),xyz,rgb));
+      bb.expandBy(buildTree(group,bbtNode.getRight(),xyz,rgb));
+      group.setBoundingBox(bb);
+      return bb;
+    }
+  }
+
+  /**
+   * Returns a copy of the specified point indices in random order, so 
+   * that points drawn for any prefix of those indices are spread evenly.
+   * The order is repeatable.
+   */
+  private static int[] shuffle(int[] index) {
+    int n = index.length;
+    int[] shuffled = new int[n];
+    System.arraycopy(index,0,shuffled,0,n);
+    Random random = new Random(n);
+    for (int i=n-1; i>0; --i) {
+      int j = random.nextInt(i+1);
+      int t = shuffled[i];
+      shuffled[i] = shuffled[j];
+      shuffled[j] = t;
     }
+    return shuffled;
   }
 
   /**
@@ -127,153 +169,159 @@ public class PointGroup extends Group {
     public PointNode(
       BoundingBoxTree.Node bbtNode, float[] xyz, float[] rgb) 
     {
-      BoundingBox bb = bbtNode.getBoundingBox();
-      _bs = new BoundingSphere(bb);
+      _bb = new BoundingBox(bbtNode.getBoundingBox());
+      _bs = new BoundingSphere(_bb);
       _np = bbtNode.getSize();
+      _nd = _np;
       int np = _np;
       int nv = np;
       int nc = np;
-      int[] index = bbtNode.getIndices();
-      _vb = Direct.newFloatBuffer(3*nv);
-      _cb = (rgb!=null)?Direct.newFloatBuffer(3*nc):null;
+      int[] index = shuffle(bbtNode.getIndices());
+      FloatBuffer vb = Direct.newFloatBuffer(3*nv);
+      FloatBuffer cb = (rgb!=null)?Direct.newFloatBuffer(3*nc):null;
       for (int ip=0,iv=0,ic=0; ip<np; ++ip) {
         int i = 3*index[ip];
-        _vb.put(iv++,xyz[i+X]);
-        _vb.put(iv++,xyz[i+Y]);
-        _vb.put(iv++,xyz[i+Z]);
-        if (_cb!=null) {
-          _cb.put(ic++,rgb[i+R]);
-          _cb.put(ic++,rgb[i+G]);
-          _cb.put(ic++,rgb[i+B]);
+        vb.put(iv++,xyz[i+X]);
+        vb.put(iv++,xyz[i+Y]);
+        vb.put(iv++,xyz[i+Z]);
+        if (cb!=null) {
+          cb.put(ic++,rgb[i+R]);
+          cb.put(ic++,rgb[i+G]);
+          cb.put(ic++,rgb[i+B]);
         }
       }
+      _vbs = new VertexBuffers(vb,null,cb,null);
     }
 
     public PointNode(
       BoundingBoxTree.Node bbtNode, float size, float[] xyz, float[] rgb) 
     {
+      float d = 0.5f*size;
       BoundingBox bb = bbtNode.getBoundingBox();
-      _bs = new BoundingSphere(bb);
+      Point3 pmin = bb.getMin();
+      Point3 pmax = bb.getMax();
+      _bb = new BoundingBox(pmin.x-d,pmin.y-d,pmin.z-d,
+                            pmax.x+d,pmax.y+d,pmax.z+d);
+      _bs = new BoundingSphere(_bb);
       _np = bbtNode.getSize();
+      _nd = _np;
       int np = _np;
       int nv = np;
       int nn = np;
       int nc = np;
-      int[] index = bbtNode.getIndices();
-      _vb = Direct.newFloatBuffer(3*4*6*nv);
-      _nb = Direct.newFloatBuffer(3*4*6*nn);
-      _cb = (rgb!=null)?Direct.newFloatBuffer(3*4*6*nc):null;
-      float d = 0.5f*size;
+      int[] index = shuffle(bbtNode.getIndices());
+      FloatBuffer vb = Direct.newFloatBuffer(3*4*6*nv);
+      FloatBuffer nb = Direct.newFloatBuffer(3*4*6*nn);
+      FloatBuffer cb = (rgb!=null)?Direct.newFloatBuffer(3*4*6*nc):null;
       for (int ip=0,iv=0,in=0,ic=0; ip<np; ++ip) {
         int i = 3*index[ip];
         float xi = xyz[i+X];
         float yi = xyz[i+Y];
         float zi = xyz[i+Z];
 
-        _vb.put(iv++,xi-d); _vb.put(iv++,yi-d); _vb.put(iv++,zi-d);
-        _vb.put(iv++,xi-d); _vb.put(iv++,yi-d); _vb.put(iv++,zi+d);
-        _vb.put(iv++,xi-d); _vb.put(iv++,yi+d); _vb.put(iv++,zi+d);
-        _vb.put(iv++,xi-d); _vb.put(iv++,yi+d); _vb.put(iv++,zi-d);
-
-        _vb.put(iv++,xi-d); _vb.put(iv++,yi-d); _vb.put(iv++,zi-d);
-        _vb.put(iv++,xi+d); _vb.put(iv++,yi-d); _vb.put(iv++,zi-d);
-        _vb.put(iv++,xi+d); _vb.put(iv++,yi-d); _vb.put(iv++,zi+d);
-        _vb.put(iv++,xi-d); _vb.put(iv++,yi-d); _vb.put(iv++,zi+d);
-
-        _vb.put(iv++,xi-d); _vb.put(iv++,yi-d); _vb.put(iv++,zi-d);
-        _vb.put(iv++,xi-d); _vb.put(iv++,yi+d); _vb.put(iv++,zi-d);
-        _vb.put(iv++,xi+d); _vb.put(iv++,yi+d); _vb.put(iv++,zi-d);
-        _vb.put(iv++,xi+d); _vb.put(iv++,yi-d); _vb.put(iv++,zi-d);
-
-        _vb.put(iv++,xi+d); _vb.put(iv++,yi-d); _vb.put(iv++,zi-d);
-        _vb.put(iv++,xi+d); _vb.put(iv++,yi+d); _vb.put(iv++,zi-d);
-        _vb.put(iv++,xi+d); _vb.put(iv++,yi+d); _vb.put(iv++,zi+d);
-        _vb.put(iv++,xi+d); _vb.put(iv++,yi-d); _vb.put(iv++,zi+d);
-
-        _vb.put(iv++,xi-d); _vb.put(iv++,yi+d); _vb.put(iv++,zi-d);
-        _vb.put(iv++,xi-d); _vb.put(iv++,yi+d); _vb.put(iv++,zi+d);
-        _vb.put(iv++,xi+d); _vb.put(iv++,yi+d); _vb.put(iv++,zi+d);
-        _vb.put(iv++,xi+d); _vb.put(iv++,yi+d); _vb.put(iv++,zi-d);
-
-        _vb.put(iv++,xi-d); _vb.put(iv++,yi-d); _vb.put(iv++,zi+d);
-        _vb.put(iv++,xi+d); _vb.put(iv++,yi-d); _vb.put(iv++,zi+d);
-        _vb.put(iv++,xi+d); _vb.put(iv++,yi+d); _vb.put(iv++,zi+d);
-        _vb.put(iv++,xi-d); _vb.put(iv++,yi+d); _vb.put(iv++,zi+d);
-
-        _nb.put(in++,-1.0f); _nb.put(in++, 0.0f); _nb.put(in++, 0.0f);
-        _nb.put(in++,-1.0f); _nb.put(in++, 0.0f); _nb.put(in++, 0.0f);
-        _nb.put(in++,-1.0f); _nb.put(in++, 0.0f); _nb.put(in++, 0.0f);
-        _nb.put(in++,-1.0f); _nb.put(in++, 0.0f); _nb.put(in++, 0.0f);
-
-        _nb.put(in++, 0.0f); _nb.put(in++,-1.0f); _nb.put(in++, 0.0f);
-        _nb.put(in++, 0.0f); _nb.put(in++,-1.0f); _nb.put(in++, 0.0f);
-        _nb.put(in++, 0.0f); _nb.put(in++,-1.0f); _nb.put(in++, 0.0f);
-        _nb.put(in++, 0.0f); _nb.put(in++,-1.0f); _nb.put(in++, 0.0f);
-
-        _nb.put(in++, 0.0f); _nb.put(in++, 0.0f); _nb.put(in++,-1.0f);
-        _nb.put(in++, 0.0f); _nb.put(in++, 0.0f); _nb.put(in++,-1.0f);
-        _nb.put(in++, 0.0f); _nb.put(in++, 0.0f); _nb.put(in++,-1.0f);
-        _nb.put(in++, 0.0f); _nb.put(in++, 0.0f); _nb.put(in++,-1.0f);
-
-        _nb.put(in++, 1.0f); _nb.put(in++, 0.0f); _nb.put(in++, 0.0f);
-        _nb.put(in++, 1.0f); _nb.put(in++, 0.0f); _nb.put(in++, 0.0f);
-        _nb.put(in++, 1.0f); _nb.put(in++, 0.0f); _nb.put(in++, 0.0f);
-        _nb.put(in++, 1.0f); _nb.put(in++, 0.0f); _nb.put(in++, 0.0f);
-
-        _nb.put(in++, 0.0f); _nb.put(in++, 1.0f); _nb.put(in++, 0.0f);
-        _nb.put(in++, 0.0f); _nb.put(in++, 1.0f); _nb.put(in++, 0.0f);
-        _nb.put(in++, 0.0f); _nb.put(in++, 1.0f); _nb.put(in++, 0.0f);
-        _nb.put(in++, 0.0f); _nb.put(in++, 1.0f); _nb.put(in++, 0.0f);
-
-        _nb.put(in++, 0.0f); _nb.put(in++, 0.0f); _nb.put(in++, 1.0f);
-        _nb.put(in++, 0.0f); _nb.put(in++, 0.0f); _nb.put(in++, 1.0f);
-        _nb.put(in++, 0.0f); _nb.put(in++, 0.0f); _nb.put(in++, 1.0f);
-        _nb.put(in++, 0.0f); _nb.put(in++, 0.0f); _nb.put(in++, 1.0f);
-
-        if (_cb!=null) {
+        vb.put(iv++,xi-d); vb.put(iv++,yi-d); vb.put(iv++,zi-d);
+        vb.put(iv++,xi-d); vb.put(iv++,yi-d); vb.put(iv++,zi+d);
+        vb.put(iv++,xi-d); vb.put(iv++,yi+d); vb.put(iv++,zi+d);
+        vb.put(iv++,xi-d); vb.put(iv++,yi+d); vb.put(iv++,zi-d);
+
+        vb.put(iv++,xi-d); vb.put(iv++,yi-d); vb.put(iv++,zi-d);
+        vb.put(iv++,xi+d); vb.put(iv++,yi-d); vb.put(iv++,zi-d);
+        vb.put(iv++,xi+d); vb.put(iv++,yi-d); vb.put(iv++,zi+d);
+        vb.put(iv++,xi-d); vb.put(iv++,yi-d); vb.put(iv++,zi+d);
+
+        vb.put(iv++,xi-d); vb.put(iv++,yi-d); vb.put(iv++,zi-d);
+        vb.put(iv++,xi-d); vb.put(iv++,yi+d); vb.put(iv++,zi-d);
+        vb.put(iv++,xi+d); vb.put(iv++,yi+d); vb.put(iv++,zi-d);
+        vb.put(iv++,xi+d); vb.put(iv++,yi-d); vb.put(iv++,zi-d);
+
+        vb.put(iv++,xi+d); vb.put(iv++,yi-d); vb.put(iv++,zi-d);
+        vb.put(iv++,xi+d); vb.put(iv++,yi+d); vb.put(iv++,zi-d);
+        vb.put(iv++,xi+d); vb.put(iv++,yi+d); vb.put(iv++,zi+d);
+        vb.put(iv++,xi+d); vb.put(iv++,yi-d); vb.put(iv++,zi+d);
+
+        vb.put(iv++,xi-d); vb.put(iv++,yi+d); vb.put(iv++,zi-d);
+        vb.put(iv++,xi-d); vb.put(iv++,yi+d); vb.put(iv++,zi+d);
+        vb.put(iv++,xi+d); vb.put(iv++,yi+d); vb.put(iv++,zi+d);
+        vb.put(iv++,xi+d); vb.put(iv++,yi+d); vb.put(iv++,zi-d);
+
+        vb.put(iv++,xi-d); vb.put(iv++,yi-d); vb.put(iv++,zi+d);
+        vb.put(iv++,xi+d); vb.put(iv++,yi-d); vb.put(iv++,zi+d);
+        vb.put(iv++,xi+d); vb.put(iv++,yi+d); vb.put(iv++,zi+d);
+        vb.put(iv++,xi-d); vb.put(iv++,yi+d); vb.put(iv++,zi+d);
+
+        nb.put(in++,-1.0f); nb.put(in++, 0.0f); nb.put(in++, 0.0f);
+        nb.put(in++,-1.0f); nb.put(in++, 0.0f); nb.put(in++, 0.0f);
+        nb.put(in++,-1.0f); nb.put(in++, 0.0f); nb.put(in++, 0.0f);
+        nb.put(in++,-1.0f); nb.put(in++, 0.0f); nb.put(in++, 0.0f);
+
+        nb.put(in++, 0.0f); nb.put(in++,-1.0f); nb.put(in++, 0.0f);
+        nb.put(in++, 0.0f); nb.put(in++,-1.0f); nb.put(in++, 0.0f);
+        nb.put(in++, 0.0f); nb.put(in++,-1.0f); nb.put(in++, 0.0f);
+        nb.put(in++, 0.0f); nb.put(in++,-1.0f); nb.put(in++, 0.0f);
+
+        nb.put(in++, 0.0f); nb.put(in++, 0.0f); nb.put(in++,-1.0f);
+        nb.put(in++, 0.0f); nb.put(in++, 0.0f); nb.put(in++,-1.0f);
+        nb.put(in++, 0.0f); nb.put(in++, 0.0f); nb.put(in++,-1.0f);
+        nb.put(in++, 0.0f); nb.put(in++, 0.0f); nb.put(in++,-1.0f);
+
+        nb.put(in++, 1.0f); nb.put(in++, 0.0f); nb.put(in++, 0.0f);
+        nb.put(in++, 1.0f); nb.put(in++, 0.0f); nb.put(in++, 0.0f);
+        nb.put(in++, 1.0f); nb.put(in++, 0.0f); nb.put(in++, 0.0f);
+        nb.put(in++, 1.0f); nb.put(in++, 0.0f); nb.put(in++, 0.0f);
+
+        nb.put(in++, 0.0f); nb.put(in++, 1.0f); nb.put(in++, 0.0f);
+        nb.put(in++, 0.0f); nb.put(in++, 1.0f); nb.put(in++, 0.0f);
+        nb.put(in++, 0.0f); nb.put(in++, 1.0f); nb.put(in++, 0.0f);
+        nb.put(in++, 0.0f); nb.put(in++, 1.0f); nb.put(in++, 0.0f);
+
+        nb.put(in++, 0.0f); nb.put(in++, 0.0f); nb.put(in++, 1.0f);
+        nb.put(in++, 0.0f); nb.put(in++, 0.0f); nb.put(in++, 1.0f);
+        nb.put(in++, 0.0f); nb.put(in++, 0.0f); nb.put(in++, 1.0f);
+        nb.put(in++, 0.0f); nb.put(in++, 0.0f); nb.put(in++, 1.0f);
+
+        if (cb!=null) {
           float ri = rgb[i+R];
           float gi = rgb[i+G];
           float bi = rgb[i+B];
           for (int j=0; j<24; ++j) {
-            _cb.put(ic++,ri);
-            _cb.put(ic++,gi);
-            _cb.put(ic++,bi);
+            cb.put(ic++,ri);
+            cb.put(ic++,gi);
+            cb.put(ic++,bi);
           }
         }
       }
+      _vbs = new VertexBuffers(vb,nb,cb,null);
     }
 
     protected BoundingSphere computeBoundingSphere(boolean finite) {
       return _bs;
     }
 
-    protected void draw(DrawContext dc) {
-      glEnableClientState(GL_VERTEX_ARRAY);
-      glVertexPointer(3,GL_FLOAT,0,_vb);
-      if (_nb!=null) {
-        glEnableClientState(GL_NORMAL_ARRAY);
-        glNormalPointer(GL_FLOAT,0,_nb);
-      }
-      if (_cb!=null) {
-        glEnableClientState(GL_COLOR_ARRAY);
-        glColorPointer(3,GL_FLOAT,0,_cb);
+    protected void cull(CullContext cc) {
+      _nd = _np;
+      float tolerance = PointGroup.this._detailTolerance;
+      if (tolerance>0.0f) {
+        double d = cc.getPixelDiameterOf(this)/tolerance;
+        if (d*d<_np)
+          _nd = max(1,(int)ceil(d*d));
       }
+      super.cull(cc);
+    }
+
+    protected void draw(DrawContext dc) {
+      _vbs.enable();
       if (_size>0.0f) {
-        glDrawArrays(GL_QUADS,0,4*6*_np);
+        _vbs.draw(GL_QUADS,4*6*_nd);
       } else {
-        glDrawArrays(GL_POINTS,0,_np);
+        _vbs.draw(GL_POINTS,_nd);
       }
-      if (_cb!=null)
-        glDisableClientState(GL_COLOR_ARRAY);
-      if (_nb!=null)
-        glDisableClientState(GL_NORMAL_ARRAY);
-      glDisableClientState(GL_VERTEX_ARRAY);
+      _vbs.disable();
     }
     
+    private BoundingBox _bb; // bounding box of points (or cubes)
     private BoundingSphere _bs; // pre-computed bounding sphere
     private int _np; // number of points
-    private FloatBuffer _vb; // vertex buffer
-    private FloatBuffer _nb; // normal buffer
-    private FloatBuffer _cb; // color buffer
+    private int _nd; // number of points drawn
+    private VertexBuffers _vbs; // vertices, normals and colors
   }
 }
@@ -19,7 +19,6 @@ import java.util.HashMap;
 
 import edu.mines.jtk.dsp.Sampling;
 import static edu.mines.jtk.ogl.Gl.*;
-import edu.mines.jtk.util.Direct;
 import java.awt.Color;
 
 /**
@@ -358,10 +357,8 @@ public class QuadGroup extends Group implements Selectable {
   // private
 
   // Constants for indexing packed arrays.
-  private static final int I = 0,  J = 1,  K = 2, L = 3;
   private static final int X = 0,  Y = 1,  Z = 2;
   private static final int U = 0,  V = 1,  W = 2;
-  private static final int R = 0,  G = 1,  B = 2;
 
   private static final int MIN_QUAD_PER_NODE = 1024;
 
@@ -398,61 +395,8 @@ public class QuadGroup extends Group implements Selectable {
       BoundingBox bb = bbtNode.getBoundingBox();
       _bs = new BoundingSphere(bb);
       _nq = bbtNode.getSize();
-      int nq = _nq;
-      int nv = 4*nq;
-      int nn = 4*nq;
-      int nc = 4*nq;
       int[] index = bbtNode.getIndices();
-      _vb = Direct.newFloatBuffer(3*nv);
-      _nb = (uvw!=null)?Direct.newFloatBuffer(3*nn):null;
-      _cb = (rgb!=null)?Direct.newFloatBuffer(3*nc):null;
-      for (int iq=0,iv=0,in=0,ic=0; iq<nq; ++iq) {
-        int jq = 4*index[iq];
-        int i = 3*ijkl[jq+I];
-        int j = 3*ijkl[jq+J];
-        int k = 3*ijkl[jq+K];
-        int l = 3*ijkl[jq+L];
-        _vb.put(iv++,xyz[i+X]);
-        _vb.put(iv++,xyz[i+Y]);
-        _vb.put(iv++,xyz[i+Z]);
-        _vb.put(iv++,xyz[j+X]);
-        _vb.put(iv++,xyz[j+Y]);
-        _vb.put(iv++,xyz[j+Z]);
-        _vb.put(iv++,xyz[k+X]);
-        _vb.put(iv++,xyz[k+Y]);
-        _vb.put(iv++,xyz[k+Z]);
-        _vb.put(iv++,xyz[l+X]);
-        _vb.put(iv++,xyz[l+Y]);
-        _vb.put(iv++,xyz[l+Z]);
-        if (_nb!=null) {
-          _nb.put(in++,uvw[i+U]);
-          _nb.put(in++,uvw[i+V]);
-          _nb.put(in++,uvw[i+W]);
-          _nb.put(in++,uvw[j+U]);
-          _nb.put(in++,uvw[j+V]);
-          _nb.put(in++,uvw[j+W]);
-          _nb.put(in++,uvw[k+U]);
-          _nb.put(in++,uvw[k+V]);
-          _nb.put(in++,uvw[k+W]);
-          _nb.put(in++,uvw[l+U]);
-          _nb.put(in++,uvw[l+V]);
-          _nb.put(in++,uvw[l+W]);
-        }
-        if (_cb!=null) {
-          _cb.put(ic++,rgb[i+R]);
-          _cb.put(ic++,rgb[i+G]);
-          _cb.put(ic++,rgb[i+B]);
-          _cb.put(ic++,rgb[j+R]);
-          _cb.put(ic++,rgb[j+G]);
-          _cb.put(ic++,rgb[j+B]);
-          _cb.put(ic++,rgb[k+R]);
-          _cb.put(ic++,rgb[k+G]);
-          _cb.put(ic++,rgb[k+B]);
-          _cb.put(ic++,rgb[l+R]);
-          _cb.put(ic++,rgb[l+G]);
-          _cb.put(ic++,rgb[l+B]);
-        }
-      }
+      _vbs = VertexBuffers.makeIndexed(4,index,ijkl,xyz,uvw,rgb);
     }
 
     protected BoundingSphere computeBoundingSphere(boolean finite) {
@@ -461,49 +405,42 @@ public class QuadGroup extends Group implements Selectable {
 
     protected void draw(DrawContext dc) {
       boolean selected = QuadGroup.this.isSelected();
-      glEnableClientState(GL_VERTEX_ARRAY);
-      glVertexPointer(3,GL_FLOAT,0,_vb);
-      if (_nb!=null) {
-        glEnableClientState(GL_NORMAL_ARRAY);
-        glNormalPointer(GL_FLOAT,0,_nb);
-      }
-      if (_cb!=null) {
-        glEnableClientState(GL_COLOR_ARRAY);
-        glColorPointer(3,GL_FLOAT,0,_cb);
-      }
+      _vbs.enable();
       if (selected) {
         glEnable(GL_POLYGON_OFFSET_FILL);
         glPolygonOffset(1.0f,1.0f);
       }
-      glDrawArrays(GL_QUADS,0,4*_nq);
-      if (_nb!=null)
-        glDisableClientState(GL_NORMAL_ARRAY);
-      if (_cb!=null)
-        glDisableClientState(GL_COLOR_ARRAY);
+      _vbs.draw(GL_QUADS);
+      _vbs.disableNormalsAndColors();
       if (selected) {
         glPolygonMode(GL_FRONT_AND_BACK,GL_LINE);
         glDisable(GL_LIGHTING);
         glColor3d(1.0,1.0,1.0);
-        glDrawArrays(GL_QUADS,0,4*_nq);
+        _vbs.draw(GL_QUADS);
       }
-      glDisableClientState(GL_VERTEX_ARRAY);
+      _vbs.disable();
     }
 
     public void pick(PickContext pc) {
       Segment ps = pc.getPickSegment();
-      for (int iq=0,j=0; iq<_nq; ++iq) {
-        double xi = _vb.get(j++);
-        double yi = _vb.get(j++);
-        double zi = _vb.get(j++);
-        double xj = _vb.get(j++);
-        double yj = _vb.get(j++);
-        double zj = _vb.get(j++);
-        double xk = _vb.get(j++);
-        double yk = _vb.get(j++);
-        double zk = _vb.get(j++);
-        double xl = _vb.get(j++);
-        double yl = _vb.get(j++);
-        double zl = _vb.get(j++);
+      FloatBuffer vb = _vbs.getVertexBuffer();
+      for (int iq=0,ie=0; iq<_nq; ++iq) {
+        int i = 3*_vbs.getElement(ie++);
+        int j = 3*_vbs.getElement(ie++);
+        int k = 3*_vbs.getElement(ie++);
+        int l = 3*_vbs.getElement(ie++);
+        double xi = vb.get(i+X);
+        double yi = vb.get(i+Y);
+        double zi = vb.get(i+Z);
+        double xj = vb.get(j+X);
+        double yj = vb.get(j+Y);
+        double zj = vb.get(j+Z);
+        double xk = vb.get(k+X);
+        double yk = vb.get(k+Y);
+        double zk = vb.get(k+Z);
+        double xl = vb.get(l+X);
+        double yl = vb.get(l+Y);
+        double zl = vb.get(l+Z);
         Point3 p = ps.intersectWithTriangle(xi,yi,zi,xj,yj,zj,xk,yk,zk);
         if (p==null)
           p = ps.intersectWithTriangle(xk,yk,zk,xl,yl,zl,xi,yi,zi);
@@ -514,9 +451,7 @@ public class QuadGroup extends Group implements Selectable {
     
     private BoundingSphere _bs; // pre-computed bounding sphere
     private int _nq; // number of quads
-    private FloatBuffer _vb; // vertex buffer
-    private FloatBuffer _nb; // normal buffer
-    private FloatBuffer _cb; // color buffer
+    private VertexBuffers _vbs; // indexed vertices, normals and colors
   }
 
   private static class Vertex {
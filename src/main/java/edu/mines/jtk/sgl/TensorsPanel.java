@@ -85,7 +85,12 @@ public class TensorsPanel extends AxisAlignedPanel {
     if (aaf==null)
       return;
     Axis axis = aaf.getAxis();
-    drawEllipsoids(axis);
+    _eg.begin();
+    try {
+      drawEllipsoids(axis);
+    } finally {
+      _eg.end();
+    }
   }
 
   /////////////////////////////////////////////////////////////////////////////
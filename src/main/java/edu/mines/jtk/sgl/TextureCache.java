@@ -0,0 +1,124 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.sgl;
+
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+
+import edu.mines.jtk.ogl.GlTextureName;
+import edu.mines.jtk.util.Check;
+
+/**
+ * A least-recently-used cache of OpenGL textures. For internal use only.
+ * Image panels put in this cache textures that they no longer draw, and
+ * take them back if later drawn again, without loading them again. When
+ * the cache is full, the least-recently-used texture is recycled or
+ * disposed.
+ * <p>
+ * Textures are valid only in the OpenGL context in which they were made.
+ * Therefore, methods of this class must be called only while that context
+ * is current, typically while drawing.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+class TextureCache {
+
+  /**
+   * Constructs a cache with specified capacity.
+   * @param capacity the maximum number of textures cached.
+   */
+  public TextureCache(int capacity) {
+    setCapacity(capacity);
+  }
+
+  /**
+   * Sets the maximum number of textures in this cache. If necessary,
+   * disposes least-recently-used textures to satisfy that maximum.
+   * @param capacity the maximum number of textures cached.
+   */
+  public void setCapacity(int capacity) {
+    Check.argument(capacity>=0,"capacity>=0");
+    _capacity = capacity;
+    trim(capacity);
+  }
+
+  /**
+   * Gets the maximum number of textures in this cache.
+   * @return the maximum number of textures cached.
+   */
+  public int getCapacity() {
+    return _capacity;
+  }
+
+  /**
+   * Takes from this cache the texture with specified key.
+   * The texture, if any, is removed from this cache.
+   * @param key the key.
+   * @return the texture; null, if none.
+   */
+  public GlTextureName take(Object key) {
+    return _map.remove(key);
+  }
+
+  /**
+   * Puts into this cache a texture with specified key.
+   * Any texture already cached with the same key is disposed.
+   * @param key the key.
+   * @param tn the texture.
+   */
+  public void put(Object key, GlTextureName tn) {
+    GlTextureName tnOld = _map.put(key,tn);
+    if (tnOld!=null && tnOld!=tn)
+      tnOld.dispose();
+    trim(_capacity);
+  }
+
+  /**
+   * Takes from this cache the least-recently-used texture, if full.
+   * A full cache thereby provides textures to be reused with new keys.
+   * @return the texture; null, if this cache is not full.
+   */
+  public GlTextureName recycle() {
+    if (_map.isEmpty() || _map.size()<_capacity)
+      return null;
+    Iterator<GlTextureName> it = _map.values().iterator();
+    GlTextureName tn = it.next();
+    it.remove();
+    return tn;
+  }
+
+  /**
+   * Disposes all textures in this cache.
+   */
+  public void clear() {
+    trim(0);
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // private
+
+  private int _capacity;
+  private LinkedHashMap<Object,GlTextureName> _map =
+    new LinkedHashMap<Object,GlTextureName>(16,0.75f,true);
+
+  private void trim(int capacity) {
+    Iterator<GlTextureName> it = _map.values().iterator();
+    while (_map.size()>capacity) {
+      GlTextureName tn = it.next();
+      it.remove();
+      tn.dispose();
+    }
+  }
+}
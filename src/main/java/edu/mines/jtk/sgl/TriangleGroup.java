@@ -18,8 +18,8 @@ import java.nio.FloatBuffer;
 import java.util.HashMap;
 
 import edu.mines.jtk.dsp.Sampling;
+import edu.mines.jtk.util.Check;
 import static edu.mines.jtk.ogl.Gl.*;
-import edu.mines.jtk.util.Direct;
 import java.awt.Color;
 
 /**
@@ -347,6 +347,20 @@ public class TriangleGroup extends Group implements Selectable {
     cs.setColor(color);
   }
 
+  /**
+   * Sets the tolerance used to select levels of detail, in pixels.
+   * Subsets of triangles that appear small in a view are drawn with
+   * fewer triangles, obtained by merging nearby vertices. Vertices are 
+   * displaced by no more than approximately this number of pixels.
+   * The default tolerance is one pixel.
+   * @param tolerance the tolerance; zero, to always draw all triangles.
+   */
+  public void setDetailTolerance(float tolerance) {
+    Check.argument(tolerance>=0.0f,"tolerance>=0.0f");
+    _detailTolerance = tolerance;
+    dirtyDraw();
+  }
+
   ///////////////////////////////////////////////////////////////////////////
   // protected
 
@@ -359,32 +373,41 @@ public class TriangleGroup extends Group implements Selectable {
   // private
 
   // Constants for indexing packed arrays.
-  private static final int I = 0,  J = 1,  K = 2;
   private static final int X = 0,  Y = 1,  Z = 2;
   private static final int U = 0,  V = 1,  W = 2;
-  private static final int R = 0,  G = 1,  B = 2;
 
   private static final int MIN_TRI_PER_NODE = 1024;
 
+  // Numbers of cells along each axis for levels of detail, coarsest first.
+  private static final int[] LOD_GRIDS = {2,4,8,16,32};
+
+  private float _detailTolerance = 1.0f; // in pixels; zero for no LOD
+
   /**
    * Recursively builds a binary tree with leaf triangle nodes.
+   * Interior nodes are groups with bounding spheres that enclose the
+   * boxes of vertices in their subtrees.
    */
   private void buildTree(int[] ijk, float[] xyz, float[] uvw, float[] rgb) {
     float[] c = computeCenters(ijk,xyz);
     BoundingBoxTree bbt = new BoundingBoxTree(MIN_TRI_PER_NODE,c);
     buildTree(this,bbt.getRoot(),ijk,xyz,uvw,rgb);
   }
-  private void buildTree(Group parent, BoundingBoxTree.Node bbtNode, 
+  private BoundingBox buildTree(Group parent, BoundingBoxTree.Node bbtNode, 
     int[] ijk, float[] xyz, float[] uvw, float[] rgb) 
   {
     if (bbtNode.isLeaf()) {
       TriangleNode tn = new TriangleNode(bbtNode,ijk,xyz,uvw,rgb);
       parent.addChild(tn);
+      return tn._bb;
     } else {
-      Group group = new Group();
+      BoxGroup group = new BoxGroup();
       parent.addChild(group);
-      buildTree(group,bbtNode.getLeft(),ijk,xyz,uvw,rgb);
-      buildTree(group,bbtNode.getRight(),ijk,xyz,uvw,rgb);
+      BoundingBox bb = new BoundingBox();
+      bb.expandBy(buildTree(group,bbtNode.getLeft(),ijk,xyz,uvw,rgb));
+      bb.expandBy(buildTree(group,bbtNode.getRight(),ijk,xyz,uvw,rgb));
+      group.setBoundingBox(bb);
+      return bb;
     }
   }
 
@@ -396,113 +419,99 @@ public class TriangleGroup extends Group implements Selectable {
     public TriangleNode(BoundingBoxTree.Node bbtNode, 
       int[] ijk, float[] xyz, float[] uvw, float[] rgb) 
     {
-      BoundingBox bb = bbtNode.getBoundingBox();
-      _bs = new BoundingSphere(bb);
       _nt = bbtNode.getSize();
-      int nt = _nt;
-      int nv = 3*nt;
-      int nn = 3*nt;
-      int nc = 3*nt;
       int[] index = bbtNode.getIndices();
-      _vb = Direct.newFloatBuffer(3*nv);
-      _nb = (uvw!=null)?Direct.newFloatBuffer(3*nn):null;
-      _cb = (rgb!=null)?Direct.newFloatBuffer(3*nc):null;
-      for (int it=0,iv=0,in=0,ic=0; it<nt; ++it) {
-        int jt = 3*index[it];
-        int i = 3*ijk[jt+I];
-        int j = 3*ijk[jt+J];
-        int k = 3*ijk[jt+K];
-        _vb.put(iv++,xyz[i+X]);
-        _vb.put(iv++,xyz[i+Y]);
-        _vb.put(iv++,xyz[i+Z]);
-        _vb.put(iv++,xyz[j+X]);
-        _vb.put(iv++,xyz[j+Y]);
-        _vb.put(iv++,xyz[j+Z]);
-        _vb.put(iv++,xyz[k+X]);
-        _vb.put(iv++,xyz[k+Y]);
-        _vb.put(iv++,xyz[k+Z]);
-        if (_nb!=null) {
-          _nb.put(in++,uvw[i+U]);
-          _nb.put(in++,uvw[i+V]);
-          _nb.put(in++,uvw[i+W]);
-          _nb.put(in++,uvw[j+U]);
-          _nb.put(in++,uvw[j+V]);
-          _nb.put(in++,uvw[j+W]);
-          _nb.put(in++,uvw[k+U]);
-          _nb.put(in++,uvw[k+V]);
-          _nb.put(in++,uvw[k+W]);
-        }
-        if (_cb!=null) {
-          _cb.put(ic++,rgb[i+R]);
-          _cb.put(ic++,rgb[i+G]);
-          _cb.put(ic++,rgb[i+B]);
-          _cb.put(ic++,rgb[j+R]);
-          _cb.put(ic++,rgb[j+G]);
-          _cb.put(ic++,rgb[j+B]);
-          _cb.put(ic++,rgb[k+R]);
-          _cb.put(ic++,rgb[k+G]);
-          _cb.put(ic++,rgb[k+B]);
-        }
-      }
+      _vbs = VertexBuffers.makeIndexed(3,index,ijk,xyz,uvw,rgb);
+      FloatBuffer vb = _vbs.getVertexBuffer();
+      _bb = new BoundingBox();
+      for (int i=0,n=vb.capacity(); i<n; i+=3)
+        _bb.expandBy(vb.get(i+X),vb.get(i+Y),vb.get(i+Z));
+      _bs = new BoundingSphere(_bb);
+      _lods = new VertexBuffers[LOD_GRIDS.length];
     }
 
     protected BoundingSphere computeBoundingSphere(boolean finite) {
       return _bs;
     }
 
+    protected void cull(CullContext cc) {
+      _lod = _vbs;
+      float tolerance = TriangleGroup.this._detailTolerance;
+      if (tolerance>0.0f) {
+        double d = cc.getPixelDiameterOf(this)/tolerance;
+        for (int ilod=0; ilod<LOD_GRIDS.length; ++ilod) {
+          if (d<=LOD_GRIDS[ilod]) {
+            _lod = getLevel(ilod);
+            break;
+          }
+        }
+      }
+      super.cull(cc);
+    }
+
     protected void draw(DrawContext dc) {
       boolean selected = TriangleGroup.this.isSelected();
-      glEnableClientState(GL_VERTEX_ARRAY);
-      glVertexPointer(3,GL_FLOAT,0,_vb);
-      if (_nb!=null) {
-        glEnableClientState(GL_NORMAL_ARRAY);
-        glNormalPointer(GL_FLOAT,0,_nb);
-      }
-      if (_cb!=null) {
-        glEnableClientState(GL_COLOR_ARRAY);
-        glColorPointer(3,GL_FLOAT,0,_cb);
-      }
+      VertexBuffers vbs = (_lod!=null)?_lod:_vbs;
+      vbs.enable();
       if (selected) {
         glEnable(GL_POLYGON_OFFSET_FILL);
         glPolygonOffset(1.0f,1.0f);
       }
-      glDrawArrays(GL_TRIANGLES,0,3*_nt);
-      if (_nb!=null)
-        glDisableClientState(GL_NORMAL_ARRAY);
-      if (_cb!=null)
-        glDisableClientState(GL_COLOR_ARRAY);
+      vbs.draw(GL_TRIANGLES);
+      vbs.disableNormalsAndColors();
       if (selected) {
         glPolygonMode(GL_FRONT_AND_BACK,GL_LINE);
         glDisable(GL_LIGHTING);
         glColor3d(1.0,1.0,1.0);
-        glDrawArrays(GL_TRIANGLES,0,3*_nt);
+        vbs.draw(GL_TRIANGLES);
       }
-      glDisableClientState(GL_VERTEX_ARRAY);
+      vbs.disable();
     }
 
     public void pick(PickContext pc) {
       Segment ps = pc.getPickSegment();
-      for (int it=0,jt=0; it<_nt; ++it) {
-        double xi = _vb.get(jt++);
-        double yi = _vb.get(jt++);
-        double zi = _vb.get(jt++);
-        double xj = _vb.get(jt++);
-        double yj = _vb.get(jt++);
-        double zj = _vb.get(jt++);
-        double xk = _vb.get(jt++);
-        double yk = _vb.get(jt++);
-        double zk = _vb.get(jt++);
+      FloatBuffer vb = _vbs.getVertexBuffer();
+      for (int it=0,ie=0; it<_nt; ++it) {
+        int i = 3*_vbs.getElement(ie++);
+        int j = 3*_vbs.getElement(ie++);
+        int k = 3*_vbs.getElement(ie++);
+        double xi = vb.get(i+X);
+        double yi = vb.get(i+Y);
+        double zi = vb.get(i+Z);
+        double xj = vb.get(j+X);
+        double yj = vb.get(j+Y);
+        double zj = vb.get(j+Z);
+        double xk = vb.get(k+X);
+        double yk = vb.get(k+Y);
+        double zk = vb.get(k+Z);
         Point3 p = ps.intersectWithTriangle(xi,yi,zi,xj,yj,zj,xk,yk,zk);
         if (p!=null)
           pc.addResult(p);
       }
     }
     
+    private BoundingBox _bb; // bounding box of vertices
     private BoundingSphere _bs; // pre-computed bounding sphere
     private int _nt; // number of triangles
-    private FloatBuffer _vb; // vertex buffer
-    private FloatBuffer _nb; // normal buffer
-    private FloatBuffer _cb; // color buffer
+    private VertexBuffers _vbs; // indexed vertices, normals and colors
+    private VertexBuffers[] _lods; // decimated levels of detail, if made
+    private VertexBuffers _lod; // level of detail to draw
+
+    /**
+     * Gets the specified level of detail, decimating if necessary. If
+     * decimation would not much reduce the number of triangles, then the
+     * returned level is simply all triangles.
+     */
+    private VertexBuffers getLevel(int ilod) {
+      if (_lods[ilod]==null) {
+        int ng = LOD_GRIDS[ilod];
+        VertexBuffers lod = _vbs.decimateTriangles(ng,_bb);
+        if (4*lod.countElements()>3*_vbs.countElements())
+          lod = _vbs;
+        _lods[ilod] = lod;
+      }
+      return _lods[ilod];
+    }
   }
 
   private static class Vertex {
@@ -0,0 +1,415 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.sgl;
+
+import java.nio.Buffer;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
+import java.nio.ShortBuffer;
+import java.util.Arrays;
+import javax.media.opengl.GLContext;
+
+import edu.mines.jtk.ogl.GlBufferName;
+import edu.mines.jtk.util.Direct;
+import static edu.mines.jtk.ogl.Gl.*;
+import static edu.mines.jtk.util.MathPlus.max;
+
+/**
+ * Vertex arrays of static geometry. For internal use only.
+ * Holds packed (x,y,z) vertex coordinates, with optional normal vectors,
+ * colors, and vertex indices, in direct buffers. When first drawn in an
+ * OpenGL context that supports buffer objects, these arrays are copied
+ * once to buffer objects, and are thereafter drawn from those buffer
+ * objects, without being copied again. Otherwise, they are drawn as
+ * client-side vertex arrays.
+ * <p>
+ * The direct buffers are retained, for picking and in case these arrays
+ * are later drawn in a different OpenGL context.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+class VertexBuffers {
+
+  /**
+   * Constructs vertex arrays for the specified buffers.
+   * @param vb buffer of packed (x,y,z) vertex coordinates.
+   * @param nb buffer of packed (u,v,w) normal vectors; null, if none.
+   * @param cb buffer of packed (r,g,b) colors; null, if none.
+   * @param ib buffer of vertex indices, either a {@link ShortBuffer}
+   *  of unsigned shorts or an {@link IntBuffer}; null, if none.
+   */
+  public VertexBuffers(
+    FloatBuffer vb, FloatBuffer nb, FloatBuffer cb, Buffer ib)
+  {
+    _vb = vb;
+    _nb = nb;
+    _cb = cb;
+    _ib = ib;
+    _ni = (ib!=null)?ib.capacity():vb.capacity()/3;
+  }
+
+  /**
+   * Constructs indexed vertex arrays for a subset of indexed primitives.
+   * Only those vertices referenced by the specified primitives are stored,
+   * and each such vertex is stored only once, however many primitives
+   * reference it. Vertex indices are stored as unsigned shorts if the
+   * number of stored vertices permits; otherwise, as ints.
+   * @param m the number of vertices per primitive; e.g., 3 for triangles.
+   * @param index array of indices of primitives in the subset.
+   * @param ijk array[m*np] of packed vertex indices for all np primitives.
+   * @param xyz array of packed vertex (x,y,z) coordinates.
+   * @param uvw array of packed vertex (u,v,w) normals; null, if none.
+   * @param rgb array of packed vertex (r,g,b) colors; null, if none.
+   * @return the vertex arrays.
+   */
+  public static VertexBuffers makeIndexed(
+    int m, int[] index, int[] ijk, float[] xyz, float[] uvw, float[] rgb)
+  {
+    // Sorted unique vertex indices referenced by the primitives.
+    int np = index.length;
+    int ni = m*np;
+    int[] iv = new int[ni];
+    for (int ip=0,ii=0; ip<np; ++ip) {
+      int jp = m*index[ip];
+      for (int j=0; j<m; ++j)
+        iv[ii++] = ijk[jp+j];
+    }
+    int[] jv = Arrays.copyOf(iv,ni);
+    Arrays.sort(jv);
+    int nv = 0;
+    for (int ii=0; ii<ni; ++ii) {
+      if (ii==0 || jv[ii]!=jv[ii-1])
+        jv[nv++] = jv[ii];
+    }
+
+    // Vertex, normal and color buffers for only those vertices.
+    FloatBuffer vb = Direct.newFloatBuffer(3*nv);
+    FloatBuffer nb = (uvw!=null)?Direct.newFloatBuffer(3*nv):null;
+    FloatBuffer cb = (rgb!=null)?Direct.newFloatBuffer(3*nv):null;
+    for (int kv=0,k=0; kv<nv; ++kv) {
+      int i = 3*jv[kv];
+      vb.put(k  ,xyz[i  ]);
+      vb.put(k+1,xyz[i+1]);
+      vb.put(k+2,xyz[i+2]);
+      if (nb!=null) {
+        nb.put(k  ,uvw[i  ]);
+        nb.put(k+1,uvw[i+1]);
+        nb.put(k+2,uvw[i+2]);
+      }
+      if (cb!=null) {
+        cb.put(k  ,rgb[i  ]);
+        cb.put(k+1,rgb[i+1]);
+        cb.put(k+2,rgb[i+2]);
+      }
+      k += 3;
+    }
+
+    // Local indices of vertices within those buffers.
+    Buffer ib;
+    if (nv<=MAX_SHORT_INDEX) {
+      ShortBuffer sb = Direct.newShortBuffer(ni);
+      for (int ii=0; ii<ni; ++ii)
+        sb.put(ii,(short)Arrays.binarySearch(jv,0,nv,iv[ii]));
+      ib = sb;
+    } else {
+      IntBuffer lb = Direct.newIntBuffer(ni);
+      for (int ii=0; ii<ni; ++ii)
+        lb.put(ii,Arrays.binarySearch(jv,0,nv,iv[ii]));
+      ib = lb;
+    }
+    return new VertexBuffers(vb,nb,cb,ib);
+  }
+
+  /**
+   * Returns decimated indexed vertex arrays for triangles in these arrays.
+   * Decimation is by vertex clustering. The specified bounding box is
+   * divided into ng x ng x ng cells, and all vertices within each cell
+   * are replaced by one vertex with averaged coordinates, normal vectors
+   * and colors. Triangles with fewer than three distinct vertices after
+   * clustering are discarded.
+   * <p>
+   * The distance that any vertex moves is at most the diagonal of a cell.
+   * @param ng number of cells along each axis of the bounding box.
+   * @param bb bounding box that contains all vertices.
+   * @return the decimated vertex arrays.
+   */
+  public VertexBuffers decimateTriangles(int ng, BoundingBox bb) {
+    Point3 pmin = bb.getMin();
+    Point3 pmax = bb.getMax();
+    double sx = ng/max(pmax.x-pmin.x,Double.MIN_NORMAL);
+    double sy = ng/max(pmax.y-pmin.y,Double.MIN_NORMAL);
+    double sz = ng/max(pmax.z-pmin.z,Double.MIN_NORMAL);
+
+    // Cluster index for each vertex; clusters are numbered in order of
+    // their first vertex.
+    int nv = _vb.capacity()/3;
+    int[] cell = new int[ng*ng*ng];
+    Arrays.fill(cell,-1);
+    int[] kc = new int[nv];
+    int nc = 0;
+    for (int kv=0,k=0; kv<nv; ++kv,k+=3) {
+      int ix = cellIndex(sx*(_vb.get(k  )-pmin.x),ng);
+      int iy = cellIndex(sy*(_vb.get(k+1)-pmin.y),ng);
+      int iz = cellIndex(sz*(_vb.get(k+2)-pmin.z),ng);
+      int ic = ix+ng*(iy+ng*iz);
+      if (cell[ic]<0)
+        cell[ic] = nc++;
+      kc[kv] = cell[ic];
+    }
+
+    // Averaged vertices and colors, and summed normals, for clusters.
+    float[] vc = new float[3*nc];
+    float[] nsum = (_nb!=null)?new float[3*nc]:null;
+    float[] csum = (_cb!=null)?new float[3*nc]:null;
+    int[] count = new int[nc];
+    for (int kv=0,k=0; kv<nv; ++kv,k+=3) {
+      int j = 3*kc[kv];
+      ++count[kc[kv]];
+      for (int m=0; m<3; ++m) {
+        vc[j+m] += _vb.get(k+m);
+        if (nsum!=null) nsum[j+m] += _nb.get(k+m);
+        if (csum!=null) csum[j+m] += _cb.get(k+m);
+      }
+    }
+    FloatBuffer vb = Direct.newFloatBuffer(3*nc);
+    FloatBuffer nb = (nsum!=null)?Direct.newFloatBuffer(nsum):null;
+    FloatBuffer cb = (csum!=null)?Direct.newFloatBuffer(3*nc):null;
+    for (int jc=0,j=0; jc<nc; ++jc,j+=3) {
+      float s = 1.0f/count[jc];
+      for (int m=0; m<3; ++m) {
+        vb.put(j+m,s*vc[j+m]);
+        if (cb!=null) cb.put(j+m,s*csum[j+m]);
+      }
+    }
+
+    // Triangles with three distinct clusters.
+    int nt = _ni/3;
+    int[] ijk = new int[3*nt];
+    int ni = 0;
+    for (int it=0,ie=0; it<nt; ++it,ie+=3) {
+      int i = kc[getElement(ie  )];
+      int j = kc[getElement(ie+1)];
+      int k = kc[getElement(ie+2)];
+      if (i!=j && j!=k && k!=i) {
+        ijk[ni++] = i;
+        ijk[ni++] = j;
+        ijk[ni++] = k;
+      }
+    }
+    Buffer ib;
+    if (nc<=MAX_SHORT_INDEX) {
+      ShortBuffer sb = Direct.newShortBuffer(ni);
+      for (int ii=0; ii<ni; ++ii)
+        sb.put(ii,(short)ijk[ii]);
+      ib = sb;
+    } else {
+      IntBuffer lb = Direct.newIntBuffer(ni);
+      for (int ii=0; ii<ni; ++ii)
+        lb.put(ii,ijk[ii]);
+      ib = lb;
+    }
+    return new VertexBuffers(vb,nb,cb,ib);
+  }
+
+  /**
+   * Gets the buffer of packed (x,y,z) vertex coordinates.
+   * @return the buffer; by reference, not by copy.
+   */
+  public FloatBuffer getVertexBuffer() {
+    return _vb;
+  }
+
+  /**
+   * Returns the number of vertices drawn. If indexed, this number is
+   * the number of indices; otherwise, it is the number of vertices.
+   * @return the number of vertices drawn.
+   */
+  public int countElements() {
+    return _ni;
+  }
+
+  /**
+   * Gets the index of the vertex drawn with specified element index.
+   * @param ie the element index, in [0,countElements()).
+   * @return the vertex index.
+   */
+  public int getElement(int ie) {
+    if (_ib instanceof ShortBuffer) {
+      return ((ShortBuffer)_ib).get(ie)&0xffff;
+    } else if (_ib instanceof IntBuffer) {
+      return ((IntBuffer)_ib).get(ie);
+    } else {
+      return ie;
+    }
+  }
+
+  /**
+   * Enables all arrays for drawing. Normal and color arrays are enabled
+   * only if this object has normals and colors, respectively. This method
+   * must be paired with a call to {@link #disable()} after drawing.
+   */
+  public void enable() {
+    boolean vbo = bind();
+    glEnableClientState(GL_VERTEX_ARRAY);
+    if (vbo) {
+      glBindBuffer(GL_ARRAY_BUFFER,_vbn.name());
+      glVertexPointer(3,GL_FLOAT,0,0L);
+    } else {
+      glVertexPointer(3,GL_FLOAT,0,_vb);
+    }
+    if (_nb!=null) {
+      glEnableClientState(GL_NORMAL_ARRAY);
+      if (vbo) {
+        glBindBuffer(GL_ARRAY_BUFFER,_nbn.name());
+        glNormalPointer(GL_FLOAT,0,0L);
+      } else {
+        glNormalPointer(GL_FLOAT,0,_nb);
+      }
+    }
+    if (_cb!=null) {
+      glEnableClientState(GL_COLOR_ARRAY);
+      if (vbo) {
+        glBindBuffer(GL_ARRAY_BUFFER,_cbn.name());
+        glColorPointer(3,GL_FLOAT,0,0L);
+      } else {
+        glColorPointer(3,GL_FLOAT,0,_cb);
+      }
+    }
+    if (vbo) {
+      glBindBuffer(GL_ARRAY_BUFFER,0);
+      if (_ibn!=null)
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,_ibn.name());
+    }
+    _vbo = vbo;
+  }
+
+  /**
+   * Disables normal and color arrays, but not the vertex array.
+   * Subsequent draws use the current normal and color.
+   */
+  public void disableNormalsAndColors() {
+    if (_nb!=null)
+      glDisableClientState(GL_NORMAL_ARRAY);
+    if (_cb!=null)
+      glDisableClientState(GL_COLOR_ARRAY);
+  }
+
+  /**
+   * Disables all arrays enabled by the method {@link #enable()}.
+   */
+  public void disable() {
+    disableNormalsAndColors();
+    glDisableClientState(GL_VERTEX_ARRAY);
+    if (_vbo && _ibn!=null)
+      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,0);
+  }
+
+  /**
+   * Draws primitives with the specified mode. Arrays must be enabled.
+   * @param mode the mode; e.g., GL_TRIANGLES.
+   */
+  public void draw(int mode) {
+    draw(mode,_ni);
+  }
+
+  /**
+   * Draws primitives for only the first specified number of elements.
+   * Arrays must be enabled.
+   * @param mode the mode; e.g., GL_TRIANGLES.
+   * @param ne the number of elements (vertices) drawn.
+   */
+  public void draw(int mode, int ne) {
+    if (_ib==null) {
+      glDrawArrays(mode,0,ne);
+    } else {
+      int type = (_ib instanceof ShortBuffer) ?
+        GL_UNSIGNED_SHORT :
+        GL_UNSIGNED_INT;
+      if (_vbo) {
+        glDrawElements(mode,ne,type,0L);
+      } else {
+        glDrawElements(mode,ne,type,_ib);
+      }
+    }
+  }
+
+  /**
+   * Disposes any buffer objects. The direct buffers are retained, and
+   * buffer objects will be made again if these arrays are drawn again.
+   */
+  public void dispose() {
+    if (_vbn!=null) _vbn.dispose();
+    if (_nbn!=null) _nbn.dispose();
+    if (_cbn!=null) _cbn.dispose();
+    if (_ibn!=null) _ibn.dispose();
+    _vbn = _nbn = _cbn = _ibn = null;
+    _context = null;
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // private
+
+  private static final int MAX_SHORT_INDEX = 65535;
+
+  private FloatBuffer _vb; // vertex buffer
+  private FloatBuffer _nb; // normal buffer
+  private FloatBuffer _cb; // color buffer
+  private Buffer _ib; // index buffer
+  private int _ni; // number of elements drawn
+  private GLContext _context; // context of buffer objects, if any
+  private GlBufferName _vbn,_nbn,_cbn,_ibn; // buffer objects
+  private boolean _vbo; // true, if drawing from buffer objects
+
+  /**
+   * Ensures that buffer objects, if supported, exist in the current
+   * context. Returns true, if buffer objects exist; false, otherwise.
+   */
+  private boolean bind() {
+    GLContext context = GLContext.getCurrent();
+    if (_context!=context) {
+      dispose();
+      _context = context;
+      if (isFunctionAvailable("glGenBuffers") &&
+          isFunctionAvailable("glBindBuffer") &&
+          isFunctionAvailable("glBufferData")) {
+        _vbn = makeBuffer(GL_ARRAY_BUFFER,_vb,4);
+        if (_nb!=null)
+          _nbn = makeBuffer(GL_ARRAY_BUFFER,_nb,4);
+        if (_cb!=null)
+          _cbn = makeBuffer(GL_ARRAY_BUFFER,_cb,4);
+        if (_ib!=null) {
+          int size = (_ib instanceof ShortBuffer)?2:4;
+          _ibn = makeBuffer(GL_ELEMENT_ARRAY_BUFFER,_ib,size);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER,0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,0);
+      }
+    }
+    return _vbn!=null;
+  }
+
+  private static int cellIndex(double x, int ng) {
+    int i = (int)x;
+    return (i<0)?0:(i>=ng)?ng-1:i;
+  }
+
+  private static GlBufferName makeBuffer(int target, Buffer b, int size) {
+    GlBufferName bn = new GlBufferName();
+    b.rewind();
+    glBindBuffer(target,bn.name());
+    glBufferData(target,(long)size*b.capacity(),b,GL_STATIC_DRAW);
+    return bn;
+  }
+}
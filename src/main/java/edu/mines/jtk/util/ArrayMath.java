@@ -109,10 +109,18 @@ import java.util.Random;
  * sum - returns the sum of array values
  * max - returns the maximum value in an array and (optionally) its indices
  * min - returns the minimum value in an array and (optionally) its indices
+ * lincomb - computes a linear combination of two arrays in one pass
+ * evaluate - evaluates an arbitrary element-wise expression in one pass
  * dump - prints an array to standard output
  * </pre>
  * Many more utility methods are included as well, for sorting, searching, 
  * etc.
+ * <p>
+ * For large 2-D and 3-D arrays, element-wise operations and the 
+ * reductions sum, max, and min process array elements in parallel. 
+ * Methods with output array arguments, and methods lincomb and evaluate 
+ * that compute expressions of more than one operation in one pass, 
+ * enable such computations without allocating temporary arrays.
  * @see java.lang.Math
  * @author Dave Hale and Chris Engelsma, Colorado School of Mines
  * @version 2009.06.23
@@ -10961,6 +10969,48 @@ public class ArrayMath {
   public static void div(double[][][] rx, double rb, double[][][] rz) {
     _div.apply(rx,rb,rz);
   }
+  // Arrays with fewer elements than this are processed serially.
+  private static final long PARALLEL_MIN = 1<<16;
+
+  // Performs a loop over the slowest dimension of an array with the
+  // specified number of elements, in parallel if that number is large.
+  private static void loop(long size, int n, Parallel.LoopInt body) {
+    if (size<PARALLEL_MIN || n<2) {
+      for (int i=0; i<n; ++i)
+        body.compute(i);
+    } else {
+      Parallel.loop(n,body);
+    }
+  }
+
+  // Returns a value computed in a reduction over the slowest dimension
+  // of an array with the specified number of elements, in parallel if
+  // that number is large.
+  private static <V> V reduce(long size, int n, Parallel.ReduceInt<V> body) {
+    if (size<PARALLEL_MIN || n<2) {
+      V v = body.compute(0);
+      for (int i=1; i<n; ++i)
+        v = body.combine(v,body.compute(i));
+      return v;
+    } else {
+      return Parallel.reduce(n,body);
+    }
+  }
+
+  // Numbers of elements in regular arrays.
+  private static long size(float[][] a) {
+    return (a.length==0)?0:(long)a.length*a[0].length;
+  }
+  private static long size(float[][][] a) {
+    return (a.length==0)?0:a.length*size(a[0]);
+  }
+  private static long size(double[][] a) {
+    return (a.length==0)?0:(long)a.length*a[0].length;
+  }
+  private static long size(double[][][] a) {
+    return (a.length==0)?0:a.length*size(a[0]);
+  }
+
   private static abstract class Binary {
     float[] apply(float[] rx, float[] ry) {
       int n1 = rx.length;
@@ -10980,80 +11030,112 @@ public class ArrayMath {
       apply(rx,rb,rz);
       return rz;
     }
-    float[][] apply(float[][] rx, float[][] ry) {
+    float[][] apply(final float[][] rx, final float[][] ry) {
       int n2 = rx.length;
-      float[][] rz = new float[n2][];
-      for (int i2=0; i2<n2; ++i2)
-        rz[i2] = apply(rx[i2],ry[i2]);
+      final float[][] rz = new float[n2][];
+      loop(size(rx),n2,new Parallel.LoopInt() {
+        public void compute(int i2) {
+          rz[i2] = apply(rx[i2],ry[i2]);
+        }
+      });
       return rz;
     }
-    float[][] apply(float ra, float[][] ry) {
+    float[][] apply(final float ra, final float[][] ry) {
       int n2 = ry.length;
-      float[][] rz = new float[n2][];
-      for (int i2=0; i2<n2; ++i2)
-        rz[i2] = apply(ra,ry[i2]);
+      final float[][] rz = new float[n2][];
+      loop(size(ry),n2,new Parallel.LoopInt() {
+        public void compute(int i2) {
+          rz[i2] = apply(ra,ry[i2]);
+        }
+      });
       return rz;
     }
-    float[][] apply(float[][] rx, float rb) {
+    float[][] apply(final float[][] rx, final float rb) {
       int n2 = rx.length;
-      float[][] rz = new float[n2][];
-      for (int i2=0; i2<n2; ++i2)
-        rz[i2] = apply(rx[i2],rb);
+      final float[][] rz = new float[n2][];
+      loop(size(rx),n2,new Parallel.LoopInt() {
+        public void compute(int i2) {
+          rz[i2] = apply(rx[i2],rb);
+        }
+      });
       return rz;
     }
-    float[][][] apply(float[][][] rx, float[][][] ry) {
+    float[][][] apply(final float[][][] rx, final float[][][] ry) {
       int n3 = rx.length;
-      float[][][] rz = new float[n3][][];
-      for (int i3=0; i3<n3; ++i3)
-        rz[i3] = apply(rx[i3],ry[i3]);
+      final float[][][] rz = new float[n3][][];
+      loop(size(rx),n3,new Parallel.LoopInt() {
+        public void compute(int i3) {
+          rz[i3] = apply(rx[i3],ry[i3]);
+        }
+      });
       return rz;
     }
-    float[][][] apply(float ra, float[][][] ry) {
+    float[][][] apply(final float ra, final float[][][] ry) {
       int n3 = ry.length;
-      float[][][] rz = new float[n3][][];
-      for (int i3=0; i3<n3; ++i3)
-        rz[i3] = apply(ra,ry[i3]);
+      final float[][][] rz = new float[n3][][];
+      loop(size(ry),n3,new Parallel.LoopInt() {
+        public void compute(int i3) {
+          rz[i3] = apply(ra,ry[i3]);
+        }
+      });
       return rz;
     }
-    float[][][] apply(float[][][] rx, float rb) {
+    float[][][] apply(final float[][][] rx, final float rb) {
       int n3 = rx.length;
-      float[][][] rz = new float[n3][][];
-      for (int i3=0; i3<n3; ++i3)
-        rz[i3] = apply(rx[i3],rb);
+      final float[][][] rz = new float[n3][][];
+      loop(size(rx),n3,new Parallel.LoopInt() {
+        public void compute(int i3) {
+          rz[i3] = apply(rx[i3],rb);
+        }
+      });
       return rz;
     }
     abstract void apply(float[] rx, float[] ry, float[] rz);
     abstract void apply(float   ra, float[] ry, float[] rz);
     abstract void apply(float[] rx, float   rb, float[] rz);
-    void apply(float[][] rx, float[][] ry, float[][] rz) {
-      int n2 = rx.length;
-      for (int i2=0; i2<n2; ++i2)
-        apply(rx[i2],ry[i2],rz[i2]);
-    }
-    void apply(float ra, float[][] ry, float[][] rz) {
-      int n2 = ry.length;
-      for (int i2=0; i2<n2; ++i2)
-        apply(ra,ry[i2],rz[i2]);
+    void apply(final float[][] rx, final float[][] ry, final float[][] rz) {
+      loop(size(rx),rx.length,new Parallel.LoopInt() {
+        public void compute(int i2) {
+          apply(rx[i2],ry[i2],rz[i2]);
+        }
+      });
     }
-    void apply(float[][] rx, float rb, float[][] rz) {
-      int n2 = rx.length;
-      for (int i2=0; i2<n2; ++i2)
-        apply(rx[i2],rb,rz[i2]);
+    void apply(final float ra, final float[][] ry, final float[][] rz) {
+      loop(size(ry),ry.length,new Parallel.LoopInt() {
+        public void compute(int i2) {
+          apply(ra,ry[i2],rz[i2]);
+        }
+      });
     }
-    void apply(float[][][] rx, float[][][] ry, float[][][] rz) {
-      int n3 = rx.length;
-      for (int i3=0; i3<n3; ++i3)
-        apply(rx[i3],ry[i3],rz[i3]);
+    void apply(final float[][] rx, final float rb, final float[][] rz) {
+      loop(size(rx),rx.length,new Parallel.LoopInt() {
+        public void compute(int i2) {
+          apply(rx[i2],rb,rz[i2]);
+        }
+      });
+    }
+    void apply(
+      final float[][][] rx, final float[][][] ry, final float[][][] rz)
+    {
+      loop(size(rx),rx.length,new Parallel.LoopInt() {
+        public void compute(int i3) {
+          apply(rx[i3],ry[i3],rz[i3]);
+        }
+      });
     }
-    void apply(float ra, float[][][] ry, float[][][] rz) {
-      int n3 = ry.length;
-      for (int i3=0; i3<n3; ++i3)
-        apply(ra,ry[i3],rz[i3]);
+    void apply(final float ra, final float[][][] ry, final float[][][] rz) {
+      loop(size(ry),ry.length,new Parallel.LoopInt() {
+        public void compute(int i3) {
+          apply(ra,ry[i3],rz[i3]);
+        }
+      });
     }
-    void apply(float[][][] rx, float rb, float[][][] rz) {
-      int n3 = rx.length;
-      for (int i3=0; i3<n3; ++i3)
-        apply(rx[i3],rb,rz[i3]);
+    void apply(final float[][][] rx, final float rb, final float[][][] rz) {
+      loop(size(rx),rx.length,new Parallel.LoopInt() {
+        public void compute(int i3) {
+          apply(rx[i3],rb,rz[i3]);
+        }
+      });
     }
     double[] apply(double[] rx, double[] ry) {
       int n1 = rx.length;
@@ -11073,80 +11155,112 @@ public class ArrayMath {
       apply(rx,rb,rz);
       return rz;
     }
-    double[][] apply(double[][] rx, double[][] ry) {
+    double[][] apply(final double[][] rx, final double[][] ry) {
       int n2 = rx.length;
-      double[][] rz = new double[n2][];
-      for (int i2=0; i2<n2; ++i2)
-        rz[i2] = apply(rx[i2],ry[i2]);
+      final double[][] rz = new double[n2][];
+      loop(size(rx),n2,new Parallel.LoopInt() {
+        public void compute(int i2) {
+          rz[i2] = apply(rx[i2],ry[i2]);
+        }
+      });
       return rz;
     }
-    double[][] apply(double ra, double[][] ry) {
+    double[][] apply(final double ra, final double[][] ry) {
       int n2 = ry.length;
-      double[][] rz = new double[n2][];
-      for (int i2=0; i2<n2; ++i2)
-        rz[i2] = apply(ra,ry[i2]);
+      final double[][] rz = new double[n2][];
+      loop(size(ry),n2,new Parallel.LoopInt() {
+        public void compute(int i2) {
+          rz[i2] = apply(ra,ry[i2]);
+        }
+      });
       return rz;
     }
-    double[][] apply(double[][] rx, double rb) {
+    double[][] apply(final double[][] rx, final double rb) {
       int n2 = rx.length;
-      double[][] rz = new double[n2][];
-      for (int i2=0; i2<n2; ++i2)
-        rz[i2] = apply(rx[i2],rb);
+      final double[][] rz = new double[n2][];
+      loop(size(rx),n2,new Parallel.LoopInt() {
+        public void compute(int i2) {
+          rz[i2] = apply(rx[i2],rb);
+        }
+      });
       return rz;
     }
-    double[][][] apply(double[][][] rx, double[][][] ry) {
+    double[][][] apply(final double[][][] rx, final double[][][] ry) {
       int n3 = rx.length;
-      double[][][] rz = new double[n3][][];
-      for (int i3=0; i3<n3; ++i3)
-        rz[i3] = apply(rx[i3],ry[i3]);
+      final double[][][] rz = new double[n3][][];
+      loop(size(rx),n3,new Parallel.LoopInt() {
+        public void compute(int i3) {
+          rz[i3] = apply(rx[i3],ry[i3]);
+        }
+      });
       return rz;
     }
-    double[][][] apply(double ra, double[][][] ry) {
+    double[][][] apply(final double ra, final double[][][] ry) {
       int n3 = ry.length;
-      double[][][] rz = new double[n3][][];
-      for (int i3=0; i3<n3; ++i3)
-        rz[i3] = apply(ra,ry[i3]);
+      final double[][][] rz = new double[n3][][];
+      loop(size(ry),n3,new Parallel.LoopInt() {
+        public void compute(int i3) {
+          rz[i3] = apply(ra,ry[i3]);
+        }
+      });
       return rz;
     }
-    double[][][] apply(double[][][] rx, double rb) {
+    double[][][] apply(final double[][][] rx, final double rb) {
       int n3 = rx.length;
-      double[][][] rz = new double[n3][][];
-      for (int i3=0; i3<n3; ++i3)
-        rz[i3] = apply(rx[i3],rb);
+      final double[][][] rz = new double[n3][][];
+      loop(size(rx),n3,new Parallel.LoopInt() {
+        public void compute(int i3) {
+          rz[i3] = apply(rx[i3],rb);
+        }
+      });
       return rz;
     }
     abstract void apply(double[] rx, double[] ry, double[] rz);
     abstract void apply(double   ra, double[] ry, double[] rz);
     abstract void apply(double[] rx, double   rb, double[] rz);
-    void apply(double[][] rx, double[][] ry, double[][] rz) {
-      int n2 = rx.length;
-      for (int i2=0; i2<n2; ++i2)
-        apply(rx[i2],ry[i2],rz[i2]);
-    }
-    void apply(double ra, double[][] ry, double[][] rz) {
-      int n2 = ry.length;
-      for (int i2=0; i2<n2; ++i2)
-        apply(ra,ry[i2],rz[i2]);
+    void apply(final double[][] rx, final double[][] ry, final double[][] rz) {
+      loop(size(rx),rx.length,new Parallel.LoopInt() {
+        public void compute(int i2) {
+          apply(rx[i2],ry[i2],rz[i2]);
+        }
+      });
     }
-    void apply(double[][] rx, double rb, double[][] rz) {
-      int n2 = rx.length;
-      for (int i2=0; i2<n2; ++i2)
-        apply(rx[i2],rb,rz[i2]);
+    void apply(final double ra, final double[][] ry, final double[][] rz) {
+      loop(size(ry),ry.length,new Parallel.LoopInt() {
+        public void compute(int i2) {
+          apply(ra,ry[i2],rz[i2]);
+        }
+      });
     }
-    void apply(double[][][] rx, double[][][] ry, double[][][] rz) {
-      int n3 = rx.length;
-      for (int i3=0; i3<n3; ++i3)
-        apply(rx[i3],ry[i3],rz[i3]);
+    void apply(final double[][] rx, final double rb, final double[][] rz) {
+      loop(size(rx),rx.length,new Parallel.LoopInt() {
+        public void compute(int i2) {
+          apply(rx[i2],rb,rz[i2]);
+        }
+      });
+    }
+    void apply(
+      final double[][][] rx, final double[][][] ry, final double[][][] rz)
+    {
+      loop(size(rx),rx.length,new Parallel.LoopInt() {
+        public void compute(int i3) {
+          apply(rx[i3],ry[i3],rz[i3]);
+        }
+      });
     }
-    void apply(double ra, double[][][] ry, double[][][] rz) {
-      int n3 = ry.length;
-      for (int i3=0; i3<n3; ++i3)
-        apply(ra,ry[i3],rz[i3]);
+    void apply(final double ra, final double[][][] ry, final double[][][] rz) {
+      loop(size(ry),ry.length,new Parallel.LoopInt() {
+        public void compute(int i3) {
+          apply(ra,ry[i3],rz[i3]);
+        }
+      });
     }
-    void apply(double[][][] rx, double rb, double[][][] rz) {
-      int n3 = rx.length;
-      for (int i3=0; i3<n3; ++i3)
-        apply(rx[i3],rb,rz[i3]);
+    void apply(final double[][][] rx, final double rb, final double[][][] rz) {
+      loop(size(rx),rx.length,new Parallel.LoopInt() {
+        public void compute(int i3) {
+          apply(rx[i3],rb,rz[i3]);
+        }
+      });
     }
   }
   private static Binary _add = new Binary() {
@@ -11612,30 +11726,40 @@ public class ArrayMath {
       apply(rx,ry);
       return ry;
     }
-    float[][] apply(float[][] rx) {
+    float[][] apply(final float[][] rx) {
       int n2 = rx.length;
-      float[][] ry = new float[n2][];
-      for (int i2=0; i2<n2; ++i2)
-        ry[i2] = apply(rx[i2]);
+      final float[][] ry = new float[n2][];
+      loop(size(rx),n2,new Parallel.LoopInt() {
+        public void compute(int i2) {
+          ry[i2] = apply(rx[i2]);
+        }
+      });
       return ry;
     }
-    float[][][] apply(float[][][] rx) {
+    float[][][] apply(final float[][][] rx) {
       int n3 = rx.length;
-      float[][][] ry = new float[n3][][];
-      for (int i3=0; i3<n3; ++i3)
-        ry[i3] = apply(rx[i3]);
+      final float[][][] ry = new float[n3][][];
+      loop(size(rx),n3,new Parallel.LoopInt() {
+        public void compute(int i3) {
+          ry[i3] = apply(rx[i3]);
+        }
+      });
       return ry;
     }
     abstract void apply(float[] rx, float[] ry);
-    void apply(float[][] rx, float[][] ry) {
-      int n2 = rx.length;
-      for (int i2=0; i2<n2; ++i2)
-        apply(rx[i2],ry[i2]);
+    void apply(final float[][] rx, final float[][] ry) {
+      loop(size(rx),rx.length,new Parallel.LoopInt() {
+        public void compute(int i2) {
+          apply(rx[i2],ry[i2]);
+        }
+      });
     }
-    void apply(float[][][] rx, float[][][] ry) {
-      int n3 = rx.length;
-      for (int i3=0; i3<n3; ++i3)
-        apply(rx[i3],ry[i3]);
+    void apply(final float[][][] rx, final float[][][] ry) {
+      loop(size(rx),rx.length,new Parallel.LoopInt() {
+        public void compute(int i3) {
+          apply(rx[i3],ry[i3]);
+        }
+      });
     }
     double[] apply(double[] rx) {
       int n1 = rx.length;
@@ -11643,30 +11767,40 @@ public class ArrayMath {
       apply(rx,ry);
       return ry;
     }
-    double[][] apply(double[][] rx) {
+    double[][] apply(final double[][] rx) {
       int n2 = rx.length;
-      double[][] ry = new double[n2][];
-      for (int i2=0; i2<n2; ++i2)
-        ry[i2] = apply(rx[i2]);
+      final double[][] ry = new double[n2][];
+      loop(size(rx),n2,new Parallel.LoopInt() {
+        public void compute(int i2) {
+          ry[i2] = apply(rx[i2]);
+        }
+      });
       return ry;
     }
-    double[][][] apply(double[][][] rx) {
+    double[][][] apply(final double[][][] rx) {
       int n3 = rx.length;
-      double[][][] ry = new double[n3][][];
-      for (int i3=0; i3<n3; ++i3)
-        ry[i3] = apply(rx[i3]);
+      final double[][][] ry = new double[n3][][];
+      loop(size(rx),n3,new Parallel.LoopInt() {
+        public void compute(int i3) {
+          ry[i3] = apply(rx[i3]);
+        }
+      });
       return ry;
     }
     abstract void apply(double[] rx, double[] ry);
-    void apply(double[][] rx, double[][] ry) {
-      int n2 = rx.length;
-      for (int i2=0; i2<n2; ++i2)
-        apply(rx[i2],ry[i2]);
+    void apply(final double[][] rx, final double[][] ry) {
+      loop(size(rx),rx.length,new Parallel.LoopInt() {
+        public void compute(int i2) {
+          apply(rx[i2],ry[i2]);
+        }
+      });
     }
-    void apply(double[][][] rx, double[][][] ry) {
-      int n3 = rx.length;
-      for (int i3=0; i3<n3; ++i3)
-        apply(rx[i3],ry[i3]);
+    void apply(final double[][][] rx, final double[][][] ry) {
+      loop(size(rx),rx.length,new Parallel.LoopInt() {
+        public void compute(int i3) {
+          apply(rx[i3],ry[i3]);
+        }
+      });
     }
   }
   private static Unary _abs = new Unary() {
@@ -11791,18 +11925,28 @@ public class ArrayMath {
     clip(rxmin,rxmax,rx,ry);
     return ry;
   }
-  public static float[][] clip(float rxmin, float rxmax, float[][] rx) {
+  public static float[][] clip(
+    final float rxmin, final float rxmax, final float[][] rx)
+  {
     int n2 = rx.length;
-    float[][] ry = new float[n2][];
-    for (int i2=0; i2<n2; ++i2)
-      ry[i2] = clip(rxmin,rxmax,rx[i2]);
+    final float[][] ry = new float[n2][];
+    loop(size(rx),n2,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        ry[i2] = clip(rxmin,rxmax,rx[i2]);
+      }
+    });
     return ry;
   }
-  public static float[][][] clip(float rxmin, float rxmax, float[][][] rx) {
+  public static float[][][] clip(
+    final float rxmin, final float rxmax, final float[][][] rx)
+  {
     int n3 = rx.length;
-    float[][][] ry = new float[n3][][];
-    for (int i3=0; i3<n3; ++i3)
-      ry[i3] = clip(rxmin,rxmax,rx[i3]);
+    final float[][][] ry = new float[n3][][];
+    loop(size(rx),n3,new Parallel.LoopInt() {
+      public void compute(int i3) {
+        ry[i3] = clip(rxmin,rxmax,rx[i3]);
+      }
+    });
     return ry;
   }
   public static void clip(
@@ -11815,18 +11959,24 @@ public class ArrayMath {
     }
   }
   public static void clip(
-    float rxmin, float rxmax, float[][] rx, float[][] ry) 
+    final float rxmin, final float rxmax,
+    final float[][] rx, final float[][] ry) 
   {
-    int n2 = rx.length;
-    for (int i2=0; i2<n2; ++i2)
-      clip(rxmin,rxmax,rx[i2],ry[i2]);
+    loop(size(rx),rx.length,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        clip(rxmin,rxmax,rx[i2],ry[i2]);
+      }
+    });
   }
   public static void clip(
-    float rxmin, float rxmax, float[][][] rx, float[][][] ry) 
+    final float rxmin, final float rxmax,
+    final float[][][] rx, final float[][][] ry) 
   {
-    int n3 = rx.length;
-    for (int i3=0; i3<n3; ++i3)
-      clip(rxmin,rxmax,rx[i3],ry[i3]);
+    loop(size(rx),rx.length,new Parallel.LoopInt() {
+      public void compute(int i3) {
+        clip(rxmin,rxmax,rx[i3],ry[i3]);
+      }
+    });
   }
   public static double[] clip(double rxmin, double rxmax, double[] rx) {
     int n1 = rx.length;
@@ -11834,18 +11984,28 @@ public class ArrayMath {
     clip(rxmin,rxmax,rx,ry);
     return ry;
   }
-  public static double[][] clip(double rxmin, double rxmax, double[][] rx) {
+  public static double[][] clip(
+    final double rxmin, final double rxmax, final double[][] rx)
+  {
     int n2 = rx.length;
-    double[][] ry = new double[n2][];
-    for (int i2=0; i2<n2; ++i2)
-      ry[i2] = clip(rxmin,rxmax,rx[i2]);
+    final double[][] ry = new double[n2][];
+    loop(size(rx),n2,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        ry[i2] = clip(rxmin,rxmax,rx[i2]);
+      }
+    });
     return ry;
   }
-  public static double[][][] clip(double rxmin, double rxmax, double[][][] rx) {
+  public static double[][][] clip(
+    final double rxmin, final double rxmax, final double[][][] rx)
+  {
     int n3 = rx.length;
-    double[][][] ry = new double[n3][][];
-    for (int i3=0; i3<n3; ++i3)
-      ry[i3] = clip(rxmin,rxmax,rx[i3]);
+    final double[][][] ry = new double[n3][][];
+    loop(size(rx),n3,new Parallel.LoopInt() {
+      public void compute(int i3) {
+        ry[i3] = clip(rxmin,rxmax,rx[i3]);
+      }
+    });
     return ry;
   }
   public static void clip(
@@ -11858,18 +12018,24 @@ public class ArrayMath {
     }
   }
   public static void clip(
-    double rxmin, double rxmax, double[][] rx, double[][] ry) 
+    final double rxmin, final double rxmax,
+    final double[][] rx, final double[][] ry) 
   {
-    int n2 = rx.length;
-    for (int i2=0; i2<n2; ++i2)
-      clip(rxmin,rxmax,rx[i2],ry[i2]);
+    loop(size(rx),rx.length,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        clip(rxmin,rxmax,rx[i2],ry[i2]);
+      }
+    });
   }
   public static void clip(
-    double rxmin, double rxmax, double[][][] rx, double[][][] ry) 
+    final double rxmin, final double rxmax,
+    final double[][][] rx, final double[][][] ry) 
   {
-    int n3 = rx.length;
-    for (int i3=0; i3<n3; ++i3)
-      clip(rxmin,rxmax,rx[i3],ry[i3]);
+    loop(size(rx),rx.length,new Parallel.LoopInt() {
+      public void compute(int i3) {
+        clip(rxmin,rxmax,rx[i3],ry[i3]);
+      }
+    });
   }
 
   ///////////////////////////////////////////////////////////////////////////
@@ -11881,18 +12047,24 @@ public class ArrayMath {
     pow(rx,ra,ry);
     return ry;
   }
-  public static float[][] pow(float[][] rx, float ra) {
+  public static float[][] pow(final float[][] rx, final float ra) {
     int n2 = rx.length;
-    float[][] ry = new float[n2][];
-    for (int i2=0; i2<n2; ++i2)
-      ry[i2] = pow(rx[i2],ra);
+    final float[][] ry = new float[n2][];
+    loop(size(rx),n2,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        ry[i2] = pow(rx[i2],ra);
+      }
+    });
     return ry;
   }
-  public static float[][][] pow(float[][][] rx, float ra) {
+  public static float[][][] pow(final float[][][] rx, final float ra) {
     int n3 = rx.length;
-    float[][][] ry = new float[n3][][];
-    for (int i3=0; i3<n3; ++i3)
-      ry[i3] = pow(rx[i3],ra);
+    final float[][][] ry = new float[n3][][];
+    loop(size(rx),n3,new Parallel.LoopInt() {
+      public void compute(int i3) {
+        ry[i3] = pow(rx[i3],ra);
+      }
+    });
     return ry;
   }
   public static void pow(float[] rx, float ra, float[] ry) {
@@ -11900,15 +12072,23 @@ public class ArrayMath {
     for (int i1=0; i1<n1; ++i1)
       ry[i1] = (float)Math.pow(rx[i1],ra);
   }
-  public static void pow(float[][] rx, float ra, float[][] ry) {
-    int n2 = rx.length;
-    for (int i2=0; i2<n2; ++i2)
-      pow(rx[i2],ra,ry[i2]);
+  public static void pow(
+    final float[][] rx, final float ra, final float[][] ry)
+  {
+    loop(size(rx),rx.length,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        pow(rx[i2],ra,ry[i2]);
+      }
+    });
   }
-  public static void pow(float[][][] rx, float ra, float[][][] ry) {
-    int n3 = rx.length;
-    for (int i3=0; i3<n3; ++i3)
-      pow(rx[i3],ra,ry[i3]);
+  public static void pow(
+    final float[][][] rx, final float ra, final float[][][] ry)
+  {
+    loop(size(rx),rx.length,new Parallel.LoopInt() {
+      public void compute(int i3) {
+        pow(rx[i3],ra,ry[i3]);
+      }
+    });
   }
   public static double[] pow(double[] rx, double ra) {
     int n1 = rx.length;
@@ -11916,18 +12096,24 @@ public class ArrayMath {
     pow(rx,ra,ry);
     return ry;
   }
-  public static double[][] pow(double[][] rx, double ra) {
+  public static double[][] pow(final double[][] rx, final double ra) {
     int n2 = rx.length;
-    double[][] ry = new double[n2][];
-    for (int i2=0; i2<n2; ++i2)
-      ry[i2] = pow(rx[i2],ra);
+    final double[][] ry = new double[n2][];
+    loop(size(rx),n2,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        ry[i2] = pow(rx[i2],ra);
+      }
+    });
     return ry;
   }
-  public static double[][][] pow(double[][][] rx, double ra) {
+  public static double[][][] pow(final double[][][] rx, final double ra) {
     int n3 = rx.length;
-    double[][][] ry = new double[n3][][];
-    for (int i3=0; i3<n3; ++i3)
-      ry[i3] = pow(rx[i3],ra);
+    final double[][][] ry = new double[n3][][];
+    loop(size(rx),n3,new Parallel.LoopInt() {
+      public void compute(int i3) {
+        ry[i3] = pow(rx[i3],ra);
+      }
+    });
     return ry;
   }
   public static void pow(double[] rx, double ra, double[] ry) {
@@ -11935,15 +12121,23 @@ public class ArrayMath {
     for (int i1=0; i1<n1; ++i1)
       ry[i1] = Math.pow(rx[i1],ra);
   }
-  public static void pow(double[][] rx, double ra, double[][] ry) {
-    int n2 = rx.length;
-    for (int i2=0; i2<n2; ++i2)
-      pow(rx[i2],ra,ry[i2]);
+  public static void pow(
+    final double[][] rx, final double ra, final double[][] ry)
+  {
+    loop(size(rx),rx.length,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        pow(rx[i2],ra,ry[i2]);
+      }
+    });
   }
-  public static void pow(double[][][] rx, double ra, double[][][] ry) {
-    int n3 = rx.length;
-    for (int i3=0; i3<n3; ++i3)
-      pow(rx[i3],ra,ry[i3]);
+  public static void pow(
+    final double[][][] rx, final double ra, final double[][][] ry)
+  {
+    loop(size(rx),rx.length,new Parallel.LoopInt() {
+      public void compute(int i3) {
+        pow(rx[i3],ra,ry[i3]);
+      }
+    });
   }
 
   ///////////////////////////////////////////////////////////////////////////
@@ -12040,19 +12234,25 @@ public class ArrayMath {
       sum += rx[i1];
     return sum;
   }
-  public static float sum(float[][] rx) {
+  public static float sum(final float[][] rx) {
     int n2 = rx.length;
-    float sum = 0.0f;
-    for (int i2=0; i2<n2; ++i2)
-      sum += sum(rx[i2]);
-    return sum;
+    final double[] s = new double[n2];
+    loop(size(rx),n2,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        s[i2] = dsum(rx[i2]);
+      }
+    });
+    return (float)sum(s);
   }
-  public static float sum(float[][][] rx) {
+  public static float sum(final float[][][] rx) {
     int n3 = rx.length;
-    float sum = 0.0f;
-    for (int i3=0; i3<n3; ++i3)
-      sum += sum(rx[i3]);
-    return sum;
+    final double[] s = new double[n3];
+    loop(size(rx),n3,new Parallel.LoopInt() {
+      public void compute(int i3) {
+        s[i3] = dsum(rx[i3]);
+      }
+    });
+    return (float)sum(s);
   }
   public static double sum(double[] rx) {
     int n1 = rx.length;
@@ -12061,18 +12261,49 @@ public class ArrayMath {
       sum += rx[i1];
     return sum;
   }
-  public static double sum(double[][] rx) {
+  public static double sum(final double[][] rx) {
+    int n2 = rx.length;
+    final double[] s = new double[n2];
+    loop(size(rx),n2,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        s[i2] = sum(rx[i2]);
+      }
+    });
+    return sum(s);
+  }
+  public static double sum(final double[][][] rx) {
+    int n3 = rx.length;
+    final double[] s = new double[n3];
+    loop(size(rx),n3,new Parallel.LoopInt() {
+      public void compute(int i3) {
+        s[i3] = dsum(rx[i3]);
+      }
+    });
+    return sum(s);
+  }
+
+  // Sums in double precision. Sums of rows in 2-D and 3-D arrays are
+  // stored in an array and then added in index order, so that results
+  // do not depend on whether rows are summed in parallel.
+  private static double dsum(float[] rx) {
+    int n1 = rx.length;
+    double sum = 0.0;
+    for (int i1=0; i1<n1; ++i1)
+      sum += rx[i1];
+    return sum;
+  }
+  private static double dsum(float[][] rx) {
     int n2 = rx.length;
     double sum = 0.0;
     for (int i2=0; i2<n2; ++i2)
-      sum += sum(rx[i2]);
+      sum += dsum(rx[i2]);
     return sum;
   }
-  public static double sum(double[][][] rx) {
-    int n3 = rx.length;
+  private static double dsum(double[][] rx) {
+    int n2 = rx.length;
     double sum = 0.0;
-    for (int i3=0; i3<n3; ++i3)
-      sum += sum(rx[i3]);
+    for (int i2=0; i2<n2; ++i2)
+      sum += sum(rx[i2]);
     return sum;
   }
 
@@ -12674,11 +12905,29 @@ public class ArrayMath {
   public static float max(float[] rx) {
     return max(rx,null);
   }
-  public static float max(float[][] rx) {
-    return max(rx,null);
-  }
-  public static float max(float[][][] rx) {
-    return max(rx,null);
+  public static float max(final float[][] rx) {
+    if (rx.length==0)
+      return -Float.MAX_VALUE;
+    return reduce(size(rx),rx.length,new Parallel.ReduceInt<Float>() {
+      public Float compute(int i2) {
+        return (rx[i2].length==0)?-Float.MAX_VALUE:max(rx[i2]);
+      }
+      public Float combine(Float va, Float vb) {
+        return max(va,vb);
+      }
+    });
+  }
+  public static float max(final float[][][] rx) {
+    if (rx.length==0)
+      return -Float.MAX_VALUE;
+    return reduce(size(rx),rx.length,new Parallel.ReduceInt<Float>() {
+      public Float compute(int i3) {
+        return max(rx[i3]);
+      }
+      public Float combine(Float va, Float vb) {
+        return max(va,vb);
+      }
+    });
   }
   public static float max(float[] rx, int[] index) {
     int i1max = 0;
@@ -12748,11 +12997,29 @@ public class ArrayMath {
   public static float min(float[] rx) {
     return min(rx,null);
   }
-  public static float min(float[][] rx) {
-    return min(rx,null);
-  }
-  public static float min(float[][][] rx) {
-    return min(rx,null);
+  public static float min(final float[][] rx) {
+    if (rx.length==0)
+      return Float.MAX_VALUE;
+    return reduce(size(rx),rx.length,new Parallel.ReduceInt<Float>() {
+      public Float compute(int i2) {
+        return (rx[i2].length==0)?Float.MAX_VALUE:min(rx[i2]);
+      }
+      public Float combine(Float va, Float vb) {
+        return min(va,vb);
+      }
+    });
+  }
+  public static float min(final float[][][] rx) {
+    if (rx.length==0)
+      return Float.MAX_VALUE;
+    return reduce(size(rx),rx.length,new Parallel.ReduceInt<Float>() {
+      public Float compute(int i3) {
+        return min(rx[i3]);
+      }
+      public Float combine(Float va, Float vb) {
+        return min(va,vb);
+      }
+    });
   }
   public static float min(float[] rx, int[] index) {
     int i1min = 0;
@@ -12822,11 +13089,29 @@ public class ArrayMath {
   public static double max(double[] rx) {
     return max(rx,null);
   }
-  public static double max(double[][] rx) {
-    return max(rx,null);
-  }
-  public static double max(double[][][] rx) {
-    return max(rx,null);
+  public static double max(final double[][] rx) {
+    if (rx.length==0)
+      return -Double.MAX_VALUE;
+    return reduce(size(rx),rx.length,new Parallel.ReduceInt<Double>() {
+      public Double compute(int i2) {
+        return (rx[i2].length==0)?-Double.MAX_VALUE:max(rx[i2]);
+      }
+      public Double combine(Double va, Double vb) {
+        return max(va,vb);
+      }
+    });
+  }
+  public static double max(final double[][][] rx) {
+    if (rx.length==0)
+      return -Double.MAX_VALUE;
+    return reduce(size(rx),rx.length,new Parallel.ReduceInt<Double>() {
+      public Double compute(int i3) {
+        return max(rx[i3]);
+      }
+      public Double combine(Double va, Double vb) {
+        return max(va,vb);
+      }
+    });
   }
   public static double max(double[] rx, int[] index) {
     int i1max = 0;
@@ -12896,11 +13181,29 @@ public class ArrayMath {
   public static double min(double[] rx) {
     return min(rx,null);
   }
-  public static double min(double[][] rx) {
-    return min(rx,null);
-  }
-  public static double min(double[][][] rx) {
-    return min(rx,null);
+  public static double min(final double[][] rx) {
+    if (rx.length==0)
+      return Double.MAX_VALUE;
+    return reduce(size(rx),rx.length,new Parallel.ReduceInt<Double>() {
+      public Double compute(int i2) {
+        return (rx[i2].length==0)?Double.MAX_VALUE:min(rx[i2]);
+      }
+      public Double combine(Double va, Double vb) {
+        return min(va,vb);
+      }
+    });
+  }
+  public static double min(final double[][][] rx) {
+    if (rx.length==0)
+      return Double.MAX_VALUE;
+    return reduce(size(rx),rx.length,new Parallel.ReduceInt<Double>() {
+      public Double compute(int i3) {
+        return min(rx[i3]);
+      }
+      public Double combine(Double va, Double vb) {
+        return min(va,vb);
+      }
+    });
   }
   public static double min(double[] rx, int[] index) {
     int i1min = 0;
@@ -12968,6 +13271,130 @@ public class ArrayMath {
     return min;
   }
 
+  ///////////////////////////////////////////////////////////////////////////
+  // lincomb, evaluate
+
+  /**
+   * An element-wise expression of up to three values. Implementations
+   * of this interface enable arbitrary arithmetic of arrays to be 
+   * evaluated in one pass over array elements, without allocating 
+   * temporary arrays for intermediate results.
+   */
+  public interface Expression {
+
+    /**
+     * Returns the value of this expression for specified values.
+     * @param x a value from the first array.
+     * @param y a value from the second array.
+     * @param z a value from the third array.
+     * @return the value of this expression.
+     */
+    public float evaluate(float x, float y, float z);
+  }
+
+  /**
+   * Computes the linear combination rz = ra*rx+rb*ry in one pass.
+   * The output array rz may be the same as the array rx or ry.
+   * @param ra the scale factor for rx.
+   * @param rx input array.
+   * @param rb the scale factor for ry.
+   * @param ry input array.
+   * @param rz output array.
+   */
+  public static void lincomb(
+    float ra, float[] rx, float rb, float[] ry, float[] rz)
+  {
+    int n1 = rx.length;
+    for (int i1=0; i1<n1; ++i1)
+      rz[i1] = ra*rx[i1]+rb*ry[i1];
+  }
+  public static void lincomb(
+    final float ra, final float[][] rx, 
+    final float rb, final float[][] ry, final float[][] rz)
+  {
+    loop(size(rx),rx.length,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        lincomb(ra,rx[i2],rb,ry[i2],rz[i2]);
+      }
+    });
+  }
+  public static void lincomb(
+    final float ra, final float[][][] rx, 
+    final float rb, final float[][][] ry, final float[][][] rz)
+  {
+    loop(size(rx),rx.length,new Parallel.LoopInt() {
+      public void compute(int i3) {
+        lincomb(ra,rx[i3],rb,ry[i3],rz[i3]);
+      }
+    });
+  }
+  public static void lincomb(
+    double ra, double[] rx, double rb, double[] ry, double[] rz)
+  {
+    int n1 = rx.length;
+    for (int i1=0; i1<n1; ++i1)
+      rz[i1] = ra*rx[i1]+rb*ry[i1];
+  }
+  public static void lincomb(
+    final double ra, final double[][] rx, 
+    final double rb, final double[][] ry, final double[][] rz)
+  {
+    loop(size(rx),rx.length,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        lincomb(ra,rx[i2],rb,ry[i2],rz[i2]);
+      }
+    });
+  }
+  public static void lincomb(
+    final double ra, final double[][][] rx, 
+    final double rb, final double[][][] ry, final double[][][] rz)
+  {
+    loop(size(rx),rx.length,new Parallel.LoopInt() {
+      public void compute(int i3) {
+        lincomb(ra,rx[i3],rb,ry[i3],rz[i3]);
+      }
+    });
+  }
+
+  /**
+   * Evaluates an element-wise expression in one pass, such that
+   * ru[i] = e.evaluate(rx[i],ry[i],rz[i]). Input arrays not used by the
+   * expression may be any arrays with the same dimensions, such as rx.
+   * The output array ru may be the same as any of the input arrays.
+   * @param e the expression.
+   * @param rx input array.
+   * @param ry input array.
+   * @param rz input array.
+   * @param ru output array.
+   */
+  public static void evaluate(
+    Expression e, float[] rx, float[] ry, float[] rz, float[] ru)
+  {
+    int n1 = rx.length;
+    for (int i1=0; i1<n1; ++i1)
+      ru[i1] = e.evaluate(rx[i1],ry[i1],rz[i1]);
+  }
+  public static void evaluate(
+    final Expression e, final float[][] rx, final float[][] ry, 
+    final float[][] rz, final float[][] ru)
+  {
+    loop(size(rx),rx.length,new Parallel.LoopInt() {
+      public void compute(int i2) {
+        evaluate(e,rx[i2],ry[i2],rz[i2],ru[i2]);
+      }
+    });
+  }
+  public static void evaluate(
+    final Expression e, final float[][][] rx, final float[][][] ry, 
+    final float[][][] rz, final float[][][] ru)
+  {
+    loop(size(rx),rx.length,new Parallel.LoopInt() {
+      public void compute(int i3) {
+        evaluate(e,rx[i3],ry[i3],rz[i3],ru[i3]);
+      }
+    });
+  }
+
   ///////////////////////////////////////////////////////////////////////////
   // cadd, csub, cmul, cdiv
 
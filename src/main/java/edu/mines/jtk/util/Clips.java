@@ -36,6 +36,12 @@ import static edu.mines.jtk.util.ArrayMath.*;
  * updated when percentiles are changed. If not using percentiles, because 
  * clipMin and clipMax are specified explicitly, then these arrays are 
  * ignored.
+ * <p>
+ * By default, clips computed from percentiles are exact, but computing
+ * them requires a partial sort of a copy of the array of values. For
+ * large arrays, clips may instead be estimated with a specified maximum
+ * error in percentiles, using a {@link QuantileSketch} computed in 
+ * parallel without copying the array.
  *
  * @author Dave Hale, Colorado School of Mines
  * @version 2007.01.10
@@ -236,6 +242,32 @@ public class Clips {
     }
   }
 
+  /**
+   * Sets the maximum error in percentiles used to compute clips. If
+   * zero, the default, clips are exact. Otherwise, clips are estimated,
+   * such that the rank of each clip value, as a percentage of the number
+   * of values, differs from the corresponding percentile by no more than 
+   * this error. Estimated clips for percentiles 0.0 and 100.0 are exact.
+   * @param percError the maximum error, in percent.
+   */
+  public void setPercentileError(double percError) {
+    Check.argument(0.0<=percError,"0<=percError");
+    Check.argument(percError<100.0,"percError<100");
+    if (_percError!=(float)percError) {
+      _percError = (float)percError;
+      if (_usePercentiles)
+        _clipsDirty = true;
+    }
+  }
+
+  /**
+   * Gets the maximum error in percentiles used to compute clips.
+   * @return the maximum error, in percent; zero, if clips are exact.
+   */
+  public float getPercentileError() {
+    return _percError;
+  }
+
   /**
    * Gets the minimum percentile.
    * @return the minimum percentile.
@@ -260,6 +292,7 @@ public class Clips {
   private float _clipMax; // values > clipMax will be clipped
   private float _percMin = 0.0f; // may be used to compute _clipMin
   private float _percMax = 100.0f; // may be used to compute _clipMax
+  private float _percError = 0.0f; // if non-zero, clips are estimated
   private boolean _usePercentiles = true; // true, if using percentiles
   private Object _f; // array used to compute clips from percentiles
 
@@ -299,6 +332,42 @@ public class Clips {
         }
       }
 
+      // Else if we may estimate percentiles, ...
+      else if (_percError>0.0f) {
+        QuantileSketch qs = null;
+        double error = 0.01*_percError;
+        if (_f instanceof float[]) {
+          float[] a = (float[])_f;
+          int k = QuantileSketch.getCapacity(error,a.length);
+          qs = QuantileSketch.compute(k,a);
+        } else if (_f instanceof float[][]) {
+          float[][] a = (float[][])_f;
+          int k = QuantileSketch.getCapacity(error,count(a));
+          qs = QuantileSketch.compute(k,a);
+        } else if (_f instanceof float[][][]) {
+          float[][][] a = (float[][][])_f;
+          int k = QuantileSketch.getCapacity(error,count(a));
+          qs = QuantileSketch.compute(k,a);
+        } else if (_f instanceof Float3) {
+          Float3 f3 = (Float3)_f;
+          int n1 = f3.getN1();
+          int n2 = f3.getN2();
+          int n3 = f3.getN3();
+          int k = QuantileSketch.getCapacity(error,(long)n1*n2*n3);
+          qs = new QuantileSketch(k);
+          float[][] a = new float[n2][n1];
+          for (int i3=0; i3<n3; ++i3) {
+            f3.get12(n1,n2,0,0,i3,a);
+            qs.update(a);
+          }
+        }
+        if (qs!=null && qs.getCount()>0) {
+          _clipMin = qs.estimate(0.01*_percMin);
+          _clipMax = qs.estimate(0.01*_percMax);
+          clipsComputed = true;
+        }
+      }
+
       // Else if we must compute percentiles, ...
       else {
         float[] a = null;
@@ -343,6 +412,18 @@ public class Clips {
       }
     }
   }
+  private static long count(float[][] a) {
+    long n = 0;
+    for (int i=0; i<a.length; ++i)
+      n += a[i].length;
+    return n;
+  }
+  private static long count(float[][][] a) {
+    long n = 0;
+    for (int i=0; i<a.length; ++i)
+      n += count(a[i]);
+    return n;
+  }
   private void makeClipsValid() {
     if (_clipMin>=_clipMax) {
       double clipAvg = 0.5*(_clipMin+_clipMax);
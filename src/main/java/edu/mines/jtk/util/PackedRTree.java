@@ -0,0 +1,670 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.util;
+
+import java.util.ArrayList;
+
+import static edu.mines.jtk.util.ArrayMath.quickIndexSort;
+
+/**
+ * An immutable packed R-tree of bounded objects, stored in flat arrays.
+ * <p>
+ * Like an {@link RTree}, a packed R-tree facilitates searches for objects
+ * near a specified point. However, a packed R-tree is constructed once,
+ * for a specified array of objects, and cannot be changed. Objects are
+ * packed into nodes by sort-tile-recursion (STR), as in the method
+ * {@link RTree#addPacked(Object[])}, and then each level of nodes is
+ * packed in the same way into the next level up. The bounds of all
+ * nodes and objects are stored in contiguous arrays of floats, so that
+ * searches need not dereference any node or object, except to compute
+ * the distance to an object that might be found.
+ * <p>
+ * Objects found are identified by their indices in the array of objects
+ * with which the tree was constructed. Methods for batches of points
+ * search for each point in parallel. These and other searches use
+ * per-thread workspaces, so that, apart from arrays returned, they
+ * perform no memory allocation for each point searched.
+ * <p>
+ * Reference: Leutenegger, S.T., Lopez, M.A., and Edgington, J., 1997,
+ * STR: a simple and efficient algorithm for R-tree packing: Proceedings
+ * of the 13th International Conference on Data Engineering, 497-506.
+ *
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+public class PackedRTree {
+
+  /**
+   * Constructs a packed R-tree for the specified boxed objects.
+   * @param ndim the number of dimensions.
+   * @param nmax the maximum number of boxes per node.
+   * @param objects array of objects, each of which implements
+   *  the interface {@link RTree.Boxed}.
+   */
+  public PackedRTree(int ndim, int nmax, Object[] objects) {
+    this(ndim,nmax,objects,new DefaultBoxer());
+  }
+
+  /**
+   * Constructs a packed R-tree for the specified objects.
+   * @param ndim the number of dimensions.
+   * @param nmax the maximum number of boxes per node.
+   * @param objects array of objects.
+   * @param boxer computes bounds and distances for the objects.
+   */
+  public PackedRTree(
+    int ndim, int nmax, Object[] objects, RTree.Boxer boxer)
+  {
+    Check.argument(ndim>0,"ndim>0");
+    Check.argument(nmax>=2,"nmax>=2");
+    _ndim = ndim;
+    _nmax = nmax;
+    _boxer = boxer;
+    _objects = objects.clone();
+    build();
+  }
+
+  /**
+   * Returns the number of objects in this tree.
+   * @return the number of objects.
+   */
+  public int size() {
+    return _objects.length;
+  }
+
+  /**
+   * Gets the object with specified index.
+   * @param index the index of the object.
+   * @return the object.
+   */
+  public Object getObject(int index) {
+    return _objects[index];
+  }
+
+  /**
+   * Gets the number of levels in this tree.
+   * @return the number of levels.
+   */
+  public int getLevels() {
+    return _nlevel;
+  }
+
+  /**
+   * Finds the object nearest to the specified point.
+   * @param point array of point coordinates.
+   * @return the index of the nearest object; -1, if this tree is empty.
+   */
+  public int findNearest(float[] point) {
+    Check.argument(point.length==_ndim,"point.length equals tree ndim");
+    Query q = query();
+    return (findNearest(1,point,q)>0)?q.bi[0]:-1;
+  }
+
+  /**
+   * Finds the k objects nearest to the specified point.
+   * @param k the number of nearest objects to find.
+   * @param point array of point coordinates.
+   * @return array of object indices, ordered by increasing distance
+   *  to the point.
+   */
+  public int[] findNearest(int k, float[] point) {
+    Check.argument(k>0,"k>0");
+    Check.argument(point.length==_ndim,"point.length equals tree ndim");
+    Query q = query();
+    int m = findNearest(k,point,q);
+    int[] index = new int[m];
+    System.arraycopy(q.bi,0,index,0,m);
+    return index;
+  }
+
+  /**
+   * Finds the k objects nearest to each of the specified points.
+   * Points are searched in parallel.
+   * @param k the number of nearest objects to find.
+   * @param points array[npoint][ndim] of point coordinates.
+   * @return array[npoint][] of object indices, each ordered by
+   *  increasing distance to the corresponding point.
+   */
+  public int[][] findNearest(int k, float[][] points) {
+    Check.argument(k>0,"k>0");
+    int npoint = points.length;
+    int m = Math.min(k,size());
+    int[][] index = new int[npoint][m];
+    findNearest(k,points,index,null);
+    return index;
+  }
+
+  /**
+   * Finds the k objects nearest to each of the specified points.
+   * Points are searched in parallel. Results are returned in the
+   * specified arrays. If fewer than k objects are found for a point,
+   * as when this tree contains fewer than k objects, then remaining
+   * indices are -1 and distances are {@link Float#MAX_VALUE}.
+   * @param k the number of nearest objects to find.
+   * @param points array[npoint][ndim] of point coordinates.
+   * @param index array[npoint][k] of object indices, each ordered
+   *  by increasing distance to the corresponding point.
+   * @param ds array[npoint][k] of distances squared; may be null.
+   */
+  public void findNearest(
+    final int k, final float[][] points,
+    final int[][] index, final float[][] ds)
+  {
+    Check.argument(k>0,"k>0");
+    checkPoints(points,"points");
+    int npoint = points.length;
+    int nchunk = (npoint+CHUNK-1)/CHUNK;
+    final int fnpoint = npoint;
+    Parallel.loop(nchunk,new Parallel.LoopInt() {
+    public void compute(int ichunk) {
+      Query q = query();
+      int jfirst = ichunk*CHUNK;
+      int jlast = Math.min(jfirst+CHUNK,fnpoint);
+      for (int j=jfirst; j<jlast; ++j) {
+        float[] point = points[j];
+        int[] ij = index[j];
+        int m = findNearest(k,point,q);
+        int l = Math.min(m,ij.length);
+        System.arraycopy(q.bi,0,ij,0,l);
+        for (int i=l; i<ij.length; ++i)
+          ij[i] = -1;
+        if (ds!=null) {
+          float[] dj = ds[j];
+          l = Math.min(m,dj.length);
+          System.arraycopy(q.bd,0,dj,0,l);
+          for (int i=l; i<dj.length; ++i)
+            dj[i] = Float.MAX_VALUE;
+        }
+      }
+    }});
+  }
+
+  /**
+   * Finds all objects in a specified sphere. An object is considered
+   * <em>in</em> the sphere if the distance from the sphere's center to
+   * the object (not its bounds) is less than or equal to the sphere's
+   * radius.
+   * @param center array of sphere center coordinates.
+   * @param radius the sphere radius.
+   * @return array of indices of objects found.
+   */
+  public int[] findInSphere(float[] center, float radius) {
+    Check.argument(center.length==_ndim,"center.length equals tree ndim");
+    Query q = query();
+    int m = findInSphere(center,radius,q);
+    int[] index = new int[m];
+    System.arraycopy(q.si,0,index,0,m);
+    return index;
+  }
+
+  /**
+   * Finds all objects in spheres with the specified centers and radius.
+   * Spheres are searched in parallel.
+   * @param centers array[ncenter][ndim] of sphere center coordinates.
+   * @param radius the sphere radius.
+   * @return array[ncenter][] of indices of objects found.
+   */
+  public int[][] findInSphere(final float[][] centers, final float radius) {
+    Check.argument(radius>=0.0f,"radius>=0");
+    checkPoints(centers,"centers");
+    final int ncenter = centers.length;
+    final int[][] index = new int[ncenter][];
+    int nchunk = (ncenter+CHUNK-1)/CHUNK;
+    Parallel.loop(nchunk,new Parallel.LoopInt() {
+    public void compute(int ichunk) {
+      Query q = query();
+      int jfirst = ichunk*CHUNK;
+      int jlast = Math.min(jfirst+CHUNK,ncenter);
+      for (int j=jfirst; j<jlast; ++j) {
+        int m = findInSphere(centers[j],radius,q);
+        index[j] = new int[m];
+        System.arraycopy(q.si,0,index[j],0,m);
+      }
+    }});
+    return index;
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // private
+
+  // Ensures that all points have the number of dimensions of this tree.
+  private void checkPoints(float[][] points, String name) {
+    for (float[] point:points)
+      Check.argument(point.length==_ndim,
+        name+"[i].length equals tree ndim");
+  }
+
+  // Number of points searched in each parallel task.
+  private static final int CHUNK = 64;
+
+  private int _ndim; // number of dimensions
+  private int _nmax; // maximum number of boxes per node
+  private RTree.Boxer _boxer; // computes bounds and distances of objects
+  private Object[] _objects; // objects, in the order specified
+  private int[] _index; // object indices, in packed order
+  private float[] _omin,_omax; // object bounds, in packed order
+  private int _nnode; // number of nodes
+  private int _nleaf; // number of leaf nodes, which are nodes 0, 1, ...
+  private int _nlevel; // number of levels
+  private int _root; // index of root node; -1 if tree is empty
+  private int[] _first; // index of first child of each node
+  private int[] _count; // number of children of each node
+  private float[] _bmin,_bmax; // node bounds
+  private Parallel.Unsafe<Query> _queries = new Parallel.Unsafe<Query>();
+
+  /**
+   * The default boxer simply assumes that all objects are boxed.
+   */
+  private static class DefaultBoxer implements RTree.Boxer {
+    public final void getBounds(Object object, float[] min, float[] max) {
+      ((RTree.Boxed)object).getBounds(min,max);
+    }
+    public final float getDistanceSquared(Object object, float[] point) {
+      return ((RTree.Boxed)object).getDistanceSquared(point);
+    }
+  }
+
+  /**
+   * Workspace for searches. The heap of nodes is ordered by increasing
+   * distance, and the heap of best objects by decreasing distance.
+   */
+  private static class Query {
+    int nn; // number of nodes in heap of nodes
+    int[] ni; // node indices
+    float[] nd; // node distances squared
+    int nb; // number of objects in heap of best objects
+    int[] bi; // best object indices
+    float[] bd; // best object distances squared
+    int ns; // number of objects found in sphere
+    int[] si; // indices of objects found in sphere
+    Query(int nnode) {
+      ni = new int[nnode];
+      nd = new float[nnode];
+      bi = new int[1];
+      bd = new float[1];
+      si = new int[64];
+    }
+    void pushNode(int i, float d) {
+      int j = nn++;
+      while (j>0) {
+        int p = (j-1)/2;
+        if (nd[p]<=d)
+          break;
+        ni[j] = ni[p];
+        nd[j] = nd[p];
+        j = p;
+      }
+      ni[j] = i;
+      nd[j] = d;
+    }
+    int popNode() {
+      int i = ni[0];
+      int m = --nn;
+      int il = ni[m];
+      float dl = nd[m];
+      int j = 0;
+      for (int c=1; c<m; c=2*j+1) {
+        if (c+1<m && nd[c+1]<nd[c])
+          ++c;
+        if (dl<=nd[c])
+          break;
+        ni[j] = ni[c];
+        nd[j] = nd[c];
+        j = c;
+      }
+      ni[j] = il;
+      nd[j] = dl;
+      return i;
+    }
+    void addBest(int i, float d, int k) {
+      int j;
+      if (nb<k) {
+        j = nb++;
+        while (j>0) {
+          int p = (j-1)/2;
+          if (bd[p]>=d)
+            break;
+          bi[j] = bi[p];
+          bd[j] = bd[p];
+          j = p;
+        }
+      } else {
+        j = siftDownBest(0,d,nb);
+      }
+      bi[j] = i;
+      bd[j] = d;
+    }
+    int siftDownBest(int j, float d, int m) {
+      for (int c=2*j+1; c<m; c=2*j+1) {
+        if (c+1<m && bd[c+1]>bd[c])
+          ++c;
+        if (d>=bd[c])
+          break;
+        bi[j] = bi[c];
+        bd[j] = bd[c];
+        j = c;
+      }
+      return j;
+    }
+    void sortBest() {
+      for (int m=nb-1; m>0; --m) {
+        int i = bi[m];
+        float d = bd[m];
+        bi[m] = bi[0];
+        bd[m] = bd[0];
+        int j = siftDownBest(0,d,m);
+        bi[j] = i;
+        bd[j] = d;
+      }
+    }
+    void addSphere(int i) {
+      if (ns==si.length) {
+        int[] t = new int[2*ns];
+        System.arraycopy(si,0,t,0,ns);
+        si = t;
+      }
+      si[ns++] = i;
+    }
+  }
+
+  private Query query() {
+    Query q = _queries.get();
+    if (q==null)
+      _queries.set(q=new Query(Math.max(1,_nnode)));
+    return q;
+  }
+
+  /**
+   * Finds the k nearest objects, leaving their indices and distances
+   * squared in the workspace, sorted by increasing distance.
+   * Returns the number of objects found.
+   */
+  private int findNearest(int k, float[] point, Query q) {
+    q.nn = 0;
+    q.nb = 0;
+    if (_root<0)
+      return 0;
+    if (q.bi.length<k) {
+      q.bi = new int[k];
+      q.bd = new float[k];
+    }
+    q.pushNode(_root,distanceSquared(_bmin,_bmax,_root,point));
+    while (q.nn>0) {
+      float cutoff = (q.nb==k)?q.bd[0]:Float.MAX_VALUE;
+      if (q.nd[0]>=cutoff)
+        break;
+      int node = q.popNode();
+      int jfirst = _first[node];
+      int jlast = jfirst+_count[node];
+      if (node<_nleaf) {
+        for (int j=jfirst; j<jlast; ++j) {
+          if (distanceSquared(_omin,_omax,j,point)<cutoff) {
+            int i = _index[j];
+            float d = _boxer.getDistanceSquared(_objects[i],point);
+            if (d<cutoff) {
+              q.addBest(i,d,k);
+              cutoff = (q.nb==k)?q.bd[0]:Float.MAX_VALUE;
+            }
+          }
+        }
+      } else {
+        for (int j=jfirst; j<jlast; ++j) {
+          float d = distanceSquared(_bmin,_bmax,j,point);
+          if (d<cutoff)
+            q.pushNode(j,d);
+        }
+      }
+    }
+    q.sortBest();
+    return q.nb;
+  }
+
+  /**
+   * Finds all objects in a sphere, leaving their indices in the
+   * workspace. Returns the number of objects found.
+   */
+  private int findInSphere(float[] center, float radius, Query q) {
+    q.ns = 0;
+    if (_root<0)
+      return 0;
+    float ss = radius*radius;
+    int[] stack = q.ni;
+    int nstack = 0;
+    stack[nstack++] = _root;
+    while (nstack>0) {
+      int node = stack[--nstack];
+      int jfirst = _first[node];
+      int jlast = jfirst+_count[node];
+      if (node<_nleaf) {
+        for (int j=jfirst; j<jlast; ++j) {
+          if (distanceSquared(_omin,_omax,j,center)<=ss) {
+            int i = _index[j];
+            if (_boxer.getDistanceSquared(_objects[i],center)<=ss)
+              q.addSphere(i);
+          }
+        }
+      } else {
+        for (int j=jfirst; j<jlast; ++j) {
+          if (distanceSquared(_bmin,_bmax,j,center)<=ss)
+            stack[nstack++] = j;
+        }
+      }
+    }
+    return q.ns;
+  }
+
+  /**
+   * Returns the distance squared from a point to the box with
+   * specified index in the specified arrays of bounds.
+   */
+  private float distanceSquared(
+    float[] bmin, float[] bmax, int ibox, float[] point)
+  {
+    float s = 0.0f;
+    for (int idim=0,i=ibox*_ndim; idim<_ndim; ++idim,++i) {
+      float p = point[idim];
+      float d = 0.0f;
+      if (p<bmin[i]) {
+        d = bmin[i]-p;
+      } else if (p>bmax[i]) {
+        d = p-bmax[i];
+      }
+      s += d*d;
+    }
+    return s;
+  }
+
+  /**
+   * Builds the tree, bottom up, one level at a time.
+   */
+  private void build() {
+    int ndim = _ndim;
+    int n = _objects.length;
+    _index = new int[n];
+    _omin = new float[ndim*n];
+    _omax = new float[ndim*n];
+    if (n==0) {
+      _root = -1;
+      _first = _count = new int[0];
+      _bmin = _bmax = new float[0];
+      return;
+    }
+
+    // Bounds of objects, in the order specified.
+    float[] amin = new float[ndim];
+    float[] amax = new float[ndim];
+    float[] emin = new float[ndim*n];
+    float[] emax = new float[ndim*n];
+    for (int i=0; i<n; ++i) {
+      _boxer.getBounds(_objects[i],amin,amax);
+      System.arraycopy(amin,0,emin,i*ndim,ndim);
+      System.arraycopy(amax,0,emax,i*ndim,ndim);
+    }
+
+    // Levels of nodes; each level has arrays of first child,
+    // count of children, min bounds and max bounds.
+    ArrayList<int[]> firsts = new ArrayList<int[]>();
+    ArrayList<int[]> counts = new ArrayList<int[]>();
+    ArrayList<float[]> mins = new ArrayList<float[]>();
+    ArrayList<float[]> maxs = new ArrayList<float[]>();
+
+    // Pack entries (first objects, then nodes) into nodes.
+    int ne = n;
+    int[] index = new int[ne];
+    int ngroup;
+    do {
+      for (int i=0; i<ne; ++i)
+        index[i] = i;
+      float[][] x = new float[ndim][ne];
+      for (int i=0; i<ne; ++i) {
+        for (int idim=0,j=i*ndim; idim<ndim; ++idim,++j)
+          x[idim][i] = 0.5f*(emin[j]+emax[j]);
+      }
+      int[] starts = new int[ne+1];
+      ngroup = pack(0,x,0,ne,index,starts,0);
+      starts[ngroup] = ne;
+
+      // Reorder entries as packed.
+      float[] pmin = new float[ndim*ne];
+      float[] pmax = new float[ndim*ne];
+      for (int i=0; i<ne; ++i) {
+        System.arraycopy(emin,index[i]*ndim,pmin,i*ndim,ndim);
+        System.arraycopy(emax,index[i]*ndim,pmax,i*ndim,ndim);
+      }
+      if (firsts.isEmpty()) {
+        System.arraycopy(index,0,_index,0,n);
+        _omin = pmin;
+        _omax = pmax;
+      } else {
+        int l = firsts.size()-1;
+        int[] f = firsts.get(l);
+        int[] c = counts.get(l);
+        int[] pf = new int[ne];
+        int[] pc = new int[ne];
+        for (int i=0; i<ne; ++i) {
+          pf[i] = f[index[i]];
+          pc[i] = c[index[i]];
+        }
+        firsts.set(l,pf);
+        counts.set(l,pc);
+        mins.set(l,pmin);
+        maxs.set(l,pmax);
+      }
+
+      // Nodes in this level, with bounds that contain their children.
+      int[] first = new int[ngroup];
+      int[] count = new int[ngroup];
+      float[] bmin = new float[ndim*ngroup];
+      float[] bmax = new float[ndim*ngroup];
+      for (int ig=0; ig<ngroup; ++ig) {
+        int jfirst = starts[ig];
+        int jlast = starts[ig+1];
+        first[ig] = jfirst;
+        count[ig] = jlast-jfirst;
+        for (int idim=0; idim<ndim; ++idim) {
+          float bmini =  Float.MAX_VALUE;
+          float bmaxi = -Float.MAX_VALUE;
+          for (int j=jfirst; j<jlast; ++j) {
+            bmini = Math.min(bmini,pmin[j*ndim+idim]);
+            bmaxi = Math.max(bmaxi,pmax[j*ndim+idim]);
+          }
+          bmin[ig*ndim+idim] = bmini;
+          bmax[ig*ndim+idim] = bmaxi;
+        }
+      }
+      firsts.add(first);
+      counts.add(count);
+      mins.add(bmin);
+      maxs.add(bmax);
+      ne = ngroup;
+      emin = bmin;
+      emax = bmax;
+    } while (ngroup>1);
+
+    // Concatenate levels, leaves first, so that the root is last.
+    _nlevel = firsts.size();
+    _nleaf = firsts.get(0).length;
+    _nnode = 0;
+    for (int l=0; l<_nlevel; ++l)
+      _nnode += firsts.get(l).length;
+    _first = new int[_nnode];
+    _count = new int[_nnode];
+    _bmin = new float[ndim*_nnode];
+    _bmax = new float[ndim*_nnode];
+    for (int l=0,offset=0,below=0; l<_nlevel; ++l) {
+      int[] f = firsts.get(l);
+      int m = f.length;
+      for (int i=0; i<m; ++i)
+        _first[offset+i] = f[i]+below;
+      System.arraycopy(counts.get(l),0,_count,offset,m);
+      System.arraycopy(mins.get(l),0,_bmin,offset*ndim,m*ndim);
+      System.arraycopy(maxs.get(l),0,_bmax,offset*ndim,m*ndim);
+      below = offset;
+      offset += m;
+    }
+    _root = _nnode-1;
+  }
+
+  /**
+   * Recursively sorts entries [p,q) by their center coordinates, one
+   * dimension at a time, and records the starts of groups of at most
+   * nmax entries. Returns the number of groups recorded.
+   */
+  private int pack(
+    int idim, float[][] x, int p, int q, int[] index,
+    int[] starts, int ngroup)
+  {
+    int kdim = _ndim-idim;
+
+    // If nothing to add, simply return.
+    if (p>=q)
+      return ngroup;
+
+    // If packed for all dimensions, record groups.
+    if (kdim==0) {
+      for (int i=p; i<q; i+=_nmax)
+        starts[ngroup++] = i;
+      return ngroup;
+    }
+
+    // Sort slab by center coordinates for current dimension.
+    int nsort = q-p;
+    int[] isort = new int[nsort];
+    float[] xsort = new float[nsort];
+    float[] xidim = x[idim];
+    for (int jsort=0; jsort<nsort; ++jsort) {
+      isort[jsort] = jsort;
+      xsort[jsort] = xidim[index[p+jsort]];
+    }
+    quickIndexSort(xsort,isort);
+    for (int jsort=0; jsort<nsort; ++jsort)
+      isort[jsort] = index[p+isort[jsort]];
+    System.arraycopy(isort,0,index,p,nsort);
+
+    // Number of groups required for the sorted slab, number of slabs
+    // in the next dimension, and number of entries per slab, which is
+    // a multiple of nmax so that groups are full.
+    int ng = (nsort+_nmax-1)/_nmax;
+    int nslab = (int)Math.ceil(Math.pow(ng,1.0/kdim));
+    int mslab = _nmax*((ng+nslab-1)/nslab);
+
+    // Recursively pack, one slab at a time.
+    for (int pslab=p; pslab<q; pslab+=mslab) {
+      int qslab = Math.min(pslab+mslab,q);
+      ngroup = pack(idim+1,x,pslab,qslab,index,starts,ngroup);
+    }
+    return ngroup;
+  }
+}
@@ -18,6 +18,8 @@ package edu.mines.jtk.util;
 
 import java.util.Collection;
 import java.util.concurrent.*;
+import static java.lang.Math.max;
+import static java.lang.Math.min;
 
 /**
  * Utilities for parallel computing in loops over independent tasks.
@@ -134,18 +136,38 @@ import java.util.concurrent.*;
  * the range is split into two parts for processing by new tasks. If 
  * specified, the chunk size is a lower bound; the number of indices 
  * processed serially will never be lower, but may be higher, than 
- * a specified chunk size. The default chunk size is one.
+ * a specified chunk size.
  * <p>
- * The default chunk size is often sufficient, because the test for 
- * an excess number of queued tasks prevents tasks from being split 
- * needlessly. This test is especially useful when parallel loops are 
- * nested, as when looping over elements of multi-dimensional arrays. 
+ * If no chunk size is specified, then a chunk size is chosen adaptively.
+ * The first index is processed on the current thread, and the time
+ * required is used to estimate the cost of each index. The chunk size is
+ * then made large enough that the cost of splitting and queueing tasks is
+ * negligible, but small enough that all threads have work to do. For
+ * loops with costly iterations, the adaptive chunk size is one.
+ * <p>
+ * Even with small chunks, the test for an excess number of queued
+ * tasks prevents tasks from being split needlessly. This test is
+ * especially useful when parallel loops are nested, as when looping
+ * over elements of multi-dimensional arrays.
  * <p>
  * For example, an implementation of the method {@code sqrParallel} for 
  * 3D arrays could simply call the 2D version listed above. Tasks will 
  * naturally tend to be split for outer loops, but not inner loops, 
  * thereby reducing overhead, time spent splitting and queueing tasks.
  * <p>
+ * Alternatively, the methods loop2 and loop3 perform loops over two or
+ * three indices, such as the indices (i2,i3) of all 1-D arrays in a 3-D
+ * array. These methods split the combined range of indices, so that
+ * work is balanced among threads even when the outermost dimension is
+ * small. Each task processes a contiguous range of index pairs (or
+ * triples), in the order of nested serial loops, so that threads tend
+ * to access disjoint and contiguous parts of arrays.
+ * <p>
+ * By default, tasks are performed by a pool with one thread for each
+ * available processor. A different pool, perhaps with fewer threads so
+ * that computations use only some processors on a shared node, may be
+ * specified with the method {@link #setPool(ForkJoinPool)}.
+ * <p>
  * Reference: A Java Fork/Join Framework, by Doug Lea, describes the
  * framework used to implement this class. This framework will be part 
  * of JDK 7.
@@ -164,6 +186,29 @@ public class Parallel {
     public void compute(int i);
   }
 
+  /** A loop body that computes something for two int indices. */
+  public interface LoopInt2 {
+
+    /**
+     * Computes for the specified loop indices.
+     * @param i1 loop index in the inner (fastest) loop.
+     * @param i2 loop index in the outer (slowest) loop.
+     */
+    public void compute(int i1, int i2);
+  }
+
+  /** A loop body that computes something for three int indices. */
+  public interface LoopInt3 {
+
+    /**
+     * Computes for the specified loop indices.
+     * @param i1 loop index in the inner (fastest) loop.
+     * @param i2 loop index in the middle loop.
+     * @param i3 loop index in the outer (slowest) loop.
+     */
+    public void compute(int i1, int i2, int i3);
+  }
+
   /** A loop body that computes and returns a value for an int index. */
   public interface ReduceInt<V> {
 
@@ -263,7 +308,7 @@ public class Parallel {
    * @param body the loop body.
    */
   public static void loop(int end, LoopInt body) {
-    loop(0,end,1,1,body);
+    loop(0,end,1,body);
   }
  
   /**
@@ -273,7 +318,7 @@ public class Parallel {
    * @param body the loop body.
    */
   public static void loop(int begin, int end, LoopInt body) {
-    loop(begin,end,1,1,body);
+    loop(begin,end,1,body);
   }
 
   /**
@@ -284,7 +329,16 @@ public class Parallel {
    * @param body the loop body.
    */
   public static void loop(int begin, int end, int step, LoopInt body) {
-    loop(begin,end,step,1,body);
+    checkArgs(begin,end,step,1);
+    if (_serial || end<=begin+step) {
+      loop(begin,end,step,1,body);
+    } else {
+      long time = System.nanoTime();
+      body.compute(begin);
+      time = System.nanoTime()-time;
+      begin += step;
+      loop(begin,end,step,chunk(time,begin,end,step),body);
+    }
   }
 
   /**
@@ -305,7 +359,7 @@ public class Parallel {
       }
     } else {
       LoopIntAction task = new LoopIntAction(begin,end,step,chunk,body);
-      if (LoopIntAction.inForkJoinPool()) {
+      if (inPool()) {
         task.invoke();
       } else {
         _pool.invoke(task);
@@ -313,6 +367,68 @@ public class Parallel {
     }
   }
 
+  /**
+   * Performs a loop over two indices, equivalent to
+   * <pre><code>
+   * for (int i2=0; i2&lt;end2; ++i2)
+   *   for (int i1=0; i1&lt;end1; ++i1)
+   *     body.compute(i1,i2);
+   * </code></pre>
+   * The product end1*end2 must not exceed the largest int value.
+   * If either end index is zero, this method does nothing.
+   * @param end1 the end index (not included) for the inner loop.
+   * @param end2 the end index (not included) for the outer loop.
+   * @param body the loop body.
+   */
+  public static void loop2(final int end1, int end2, final LoopInt2 body) {
+    Check.argument(0<=end1 && 0<=end2,"0<=end1 && 0<=end2");
+    Check.argument((long)end1*end2<=Integer.MAX_VALUE,
+      "end1*end2 does not exceed Integer.MAX_VALUE");
+    if (end1==0 || end2==0)
+      return;
+    loop(end1*end2,new LoopInt() {
+      public void compute(int i) {
+        int i2 = i/end1;
+        body.compute(i-i2*end1,i2);
+      }
+    });
+  }
+
+  /**
+   * Performs a loop over three indices, equivalent to
+   * <pre><code>
+   * for (int i3=0; i3&lt;end3; ++i3)
+   *   for (int i2=0; i2&lt;end2; ++i2)
+   *     for (int i1=0; i1&lt;end1; ++i1)
+   *       body.compute(i1,i2,i3);
+   * </code></pre>
+   * The product end1*end2*end3 must not exceed the largest int value.
+   * If any end index is zero, this method does nothing.
+   * @param end1 the end index (not included) for the inner loop.
+   * @param end2 the end index (not included) for the middle loop.
+   * @param end3 the end index (not included) for the outer loop.
+   * @param body the loop body.
+   */
+  public static void loop3(
+    final int end1, final int end2, int end3, final LoopInt3 body)
+  {
+    Check.argument(0<=end1 && 0<=end2 && 0<=end3,
+      "0<=end1 && 0<=end2 && 0<=end3");
+    Check.argument((long)end1*end2*end3<=Integer.MAX_VALUE,
+      "end1*end2*end3 does not exceed Integer.MAX_VALUE");
+    if (end1==0 || end2==0 || end3==0)
+      return;
+    final int end12 = end1*end2;
+    loop(end12*end3,new LoopInt() {
+      public void compute(int i) {
+        int i3 = i/end12;
+        int i12 = i-i3*end12;
+        int i2 = i12/end1;
+        body.compute(i12-i2*end1,i2,i3);
+      }
+    });
+  }
+
   /**
    * Performs a reduce <code>for (int i=0; i&lt;end; ++i)</code>.
    * @param end the end index (not included) for the loop.
@@ -320,7 +436,7 @@ public class Parallel {
    * @return the computed value.
    */
   public static <V> V reduce(int end, ReduceInt<V> body) {
-    return reduce(0,end,1,1,body);
+    return reduce(0,end,1,body);
   }
 
   /**
@@ -331,7 +447,7 @@ public class Parallel {
    * @return the computed value.
    */
   public static <V> V reduce(int begin, int end, ReduceInt<V> body) {
-    return reduce(begin,end,1,1,body);
+    return reduce(begin,end,1,body);
   }
 
   /**
@@ -345,7 +461,17 @@ public class Parallel {
   public static <V> V reduce(
     int begin, int end, int step, ReduceInt<V> body) 
   {
-    return reduce(begin,end,step,1,body);
+    checkArgs(begin,end,step,1);
+    if (_serial || end<=begin+step) {
+      return reduce(begin,end,step,1,body);
+    } else {
+      long time = System.nanoTime();
+      V v = body.compute(begin);
+      time = System.nanoTime()-time;
+      begin += step;
+      int chunk = chunk(time,begin,end,step);
+      return body.combine(v,reduce(begin,end,step,chunk,body));
+    }
   }
 
   /**
@@ -370,7 +496,7 @@ public class Parallel {
       return v;
     } else {
       ReduceIntTask<V> task = new ReduceIntTask<V>(begin,end,step,chunk,body);
-      if (ReduceIntTask.inForkJoinPool()) {
+      if (inPool()) {
         return task.invoke();
       } else {
         return _pool.invoke(task);
@@ -392,6 +518,28 @@ public class Parallel {
     _serial = !parallel;
   }
 
+  /**
+   * Sets the pool of threads used by all methods of this class.
+   * For example, to use no more than four threads, specify
+   * <pre><code>
+   * Parallel.setPool(new ForkJoinPool(4));
+   * </code></pre>
+   * Tasks already submitted to the previous pool are unaffected.
+   * @param pool the pool.
+   */
+  public static void setPool(ForkJoinPool pool) {
+    Check.argument(pool!=null,"pool is not null");
+    _pool = pool;
+  }
+
+  /**
+   * Gets the pool of threads used by all methods of this class.
+   * @return the pool.
+   */
+  public static ForkJoinPool getPool() {
+    return _pool;
+  }
+
   ///////////////////////////////////////////////////////////////////////////
   // private
 
@@ -409,8 +557,16 @@ public class Parallel {
   // determine whether or not to split a task into two subtasks.
   private static final int NSQT = 6;
 
+  // Target time in nanoseconds for computations performed serially
+  // by each task, when chunk sizes are chosen adaptively.
+  private static final long GRAIN = 50000L;
+
+  // Lower bound on the number of tasks per thread, for load balancing,
+  // when chunk sizes are chosen adaptively.
+  private static final int NTPT = 8;
+
   // The pool shared by all fork-join tasks created through this class.
-  private static ForkJoinPool _pool = new ForkJoinPool();
+  private static volatile ForkJoinPool _pool = new ForkJoinPool();
 
   // Serial flag; true for no parallel processing.
   private static boolean _serial = false;
@@ -424,6 +580,24 @@ public class Parallel {
     Check.argument(chunk>0,"chunk>0");
   }
 
+  /**
+   * Returns true if the current thread is a worker in the current pool.
+   */
+  private static boolean inPool() {
+    return ForkJoinTask.inForkJoinPool() && ForkJoinTask.getPool()==_pool;
+  }
+
+  /**
+   * Returns an adaptive chunk size for the remaining loop range
+   * [begin:end), given the time in nanoseconds for one index.
+   */
+  private static int chunk(long time, int begin, int end, int step) {
+    long count = ((long)end-begin+step-1)/step;
+    long cmax = max(1L,count/((long)NTPT*_pool.getParallelism()));
+    long chunk = GRAIN/max(1L,time);
+    return (int)max(1L,min(chunk,cmax));
+  }
+
   /**
    * Splits range [begin:end) into [begin:middle) and [middle:end). The
    * returned middle index equals begin plus an integer multiple of step.
@@ -0,0 +1,337 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.util;
+
+import java.lang.ref.WeakReference;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.Iterator;
+import java.util.Map;
+import java.util.TreeMap;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.logging.Logger;
+
+/**
+ * Lightweight instrumentation of named phases and counters.
+ * <p>
+ * Code instrumented with a profiler starts and stops named phases, and
+ * adds to named counters, for example, of iterations, bytes allocated,
+ * or bytes read. Phases are timed with a {@link Stopwatch} for each
+ * thread that executes them, so that time spent by different threads
+ * can be reported separately. Phases with the same name may be nested
+ * within one thread; only the outermost phase is timed.
+ * <p>
+ * Profiling is disabled by default. When disabled, all methods that
+ * start and stop phases or add to counters return after reading one
+ * volatile boolean flag and, for stops, one atomic count of phases not
+ * yet stopped. Names of phases and counters should therefore be
+ * constant strings, so that no strings are built unless enabled.
+ * A phase started while enabled is stopped even if profiling has been
+ * disabled in the meantime.
+ * For example, to find where time goes in a local smoothing filter:
+ * <pre><code>
+ * Profiler.setEnabled(true);
+ * lsf.apply(c,x,y);
+ * Profiler.log(Logger.getLogger("profile"));
+ * </code></pre>
+ * <p>
+ * Class names are used as prefixes for phases and counters in this
+ * toolkit; e.g., "LocalSmoothingFilter.solve".
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+public class Profiler {
+
+  /**
+   * Enables or disables profiling. Timings and counts already
+   * accumulated are retained; they may be cleared with {@link #reset()}.
+   * @param enabled true, to enable; false, to disable.
+   */
+  public static void setEnabled(boolean enabled) {
+    _enabled = enabled;
+  }
+
+  /**
+   * Determines whether profiling is enabled.
+   * @return true, if enabled; false, otherwise.
+   */
+  public static boolean isEnabled() {
+    return _enabled;
+  }
+
+  /**
+   * Starts the named phase in the current thread.
+   * @param phase the name of the phase.
+   */
+  public static void start(String phase) {
+    if (_enabled)
+      data().start(phase);
+  }
+
+  /**
+   * Stops the named phase in the current thread.
+   * Does nothing if that phase was not started.
+   * @param phase the name of the phase.
+   */
+  public static void stop(String phase) {
+    if (_enabled || _open.get()>0) {
+      Data d = _data.get();
+      if (d!=null)
+        d.stop(phase);
+    }
+  }
+
+  /**
+   * Adds a specified amount to the named counter.
+   * @param counter the name of the counter.
+   * @param n the amount to add.
+   */
+  public static void count(String counter, long n) {
+    if (_enabled)
+      data().count(counter,n);
+  }
+
+  /**
+   * Clears all timings and counts, for all threads. Also discards
+   * data for threads that are no longer alive.
+   */
+  public static void reset() {
+    synchronized (_all) {
+      for (Iterator<Data> i=_all.iterator(); i.hasNext();) {
+        Data d = i.next();
+        if (d.isAlive()) {
+          d.reset();
+        } else {
+          i.remove();
+          d.discard();
+        }
+      }
+    }
+  }
+
+  /**
+   * Gets times for all phases, summed over all threads.
+   * @return map from phase names to times, in seconds.
+   */
+  public static Map<String,Double> getTimes() {
+    TreeMap<String,Double> times = new TreeMap<String,Double>();
+    synchronized (_all) {
+      for (Data d:_all) {
+        synchronized (d) {
+          for (Map.Entry<String,Phase> e:d.phases.entrySet()) {
+            String name = e.getKey();
+            double time = e.getValue().sw.time();
+            Double total = times.get(name);
+            times.put(name,(total!=null)?total+time:time);
+          }
+        }
+      }
+    }
+    return times;
+  }
+
+  /**
+   * Gets times for all phases in each thread.
+   * @return map from thread names to maps from phase names to times, 
+   *  in seconds. Threads that have executed no phases are omitted.
+   */
+  public static Map<String,Map<String,Double>> getThreadTimes() {
+    TreeMap<String,Map<String,Double>> times =
+      new TreeMap<String,Map<String,Double>>();
+    synchronized (_all) {
+      for (Data d:_all) {
+        synchronized (d) {
+          if (d.phases.isEmpty())
+            continue;
+          Map<String,Double> t = times.get(d.thread);
+          if (t==null)
+            times.put(d.thread,t=new TreeMap<String,Double>());
+          for (Map.Entry<String,Phase> e:d.phases.entrySet()) {
+            String name = e.getKey();
+            double time = e.getValue().sw.time();
+            Double total = t.get(name);
+            t.put(name,(total!=null)?total+time:time);
+          }
+        }
+      }
+    }
+    return times;
+  }
+
+  /**
+   * Gets the numbers of times that phases were started, summed over 
+   * all threads. Nested starts of a phase are not counted.
+   * @return map from phase names to numbers of calls.
+   */
+  public static Map<String,Long> getCalls() {
+    TreeMap<String,Long> calls = new TreeMap<String,Long>();
+    synchronized (_all) {
+      for (Data d:_all) {
+        synchronized (d) {
+          for (Map.Entry<String,Phase> e:d.phases.entrySet())
+            add(calls,e.getKey(),e.getValue().calls);
+        }
+      }
+    }
+    return calls;
+  }
+
+  /**
+   * Gets values of all counters, summed over all threads.
+   * @return map from counter names to values.
+   */
+  public static Map<String,Long> getCounts() {
+    TreeMap<String,Long> counts = new TreeMap<String,Long>();
+    synchronized (_all) {
+      for (Data d:_all) {
+        synchronized (d) {
+          for (Map.Entry<String,long[]> e:d.counts.entrySet())
+            add(counts,e.getKey(),e.getValue()[0]);
+        }
+      }
+    }
+    return counts;
+  }
+
+  /**
+   * Returns a report of all timings and counts.
+   * Times for each phase are summed over all threads, and then listed
+   * for each thread.
+   * @return the report.
+   */
+  public static String getReport() {
+    StringBuilder sb = new StringBuilder();
+    Map<String,Double> times = getTimes();
+    Map<String,Long> calls = getCalls();
+    for (Map.Entry<String,Double> e:times.entrySet()) {
+      String name = e.getKey();
+      sb.append(String.format("%-40s %12.6f s %10d calls%n",
+        name,e.getValue(),calls.get(name)));
+    }
+    Map<String,Map<String,Double>> threadTimes = getThreadTimes();
+    for (Map.Entry<String,Map<String,Double>> t:threadTimes.entrySet()) {
+      sb.append(String.format("  thread %s%n",t.getKey()));
+      for (Map.Entry<String,Double> e:t.getValue().entrySet())
+        sb.append(String.format("  %-38s %12.6f s%n",e.getKey(),e.getValue()));
+    }
+    for (Map.Entry<String,Long> e:getCounts().entrySet())
+      sb.append(String.format("%-40s %12d%n",e.getKey(),e.getValue()));
+    return sb.toString();
+  }
+
+  /**
+   * Logs a report of all timings and counts with level INFO.
+   * @param logger the logger.
+   */
+  public static void log(Logger logger) {
+    logger.info("Profiler:\n"+getReport());
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // private
+
+  private static volatile boolean _enabled = false;
+
+  // Number of outermost phases started but not yet stopped, in all
+  // threads. While positive, phases are stopped even if disabled.
+  private static final AtomicInteger _open = new AtomicInteger();
+
+  // Data for all threads, including those no longer alive, until reset.
+  private static final ArrayList<Data> _all = new ArrayList<Data>();
+
+  // Data for each thread; null for threads that have not been profiled.
+  private static final ThreadLocal<Data> _data = new ThreadLocal<Data>();
+
+  private static Data data() {
+    Data d = _data.get();
+    if (d==null) {
+      d = new Data(Thread.currentThread());
+      synchronized (_all) {
+        _all.add(d);
+      }
+      _data.set(d);
+    }
+    return d;
+  }
+
+  private static void add(Map<String,Long> map, String name, long n) {
+    Long total = map.get(name);
+    map.put(name,(total!=null)?total+n:n);
+  }
+
+  // A timed phase, for one thread.
+  private static class Phase {
+    Stopwatch sw = new Stopwatch();
+    int depth; // number of nested starts not yet stopped
+    long calls; // number of outermost starts
+  }
+
+  // Phases and counters for one thread. Methods are synchronized but
+  // uncontended, except while timings and counts are being read.
+  private static class Data {
+    String thread; // name of the thread
+    WeakReference<Thread> owner; // does not keep the thread reachable
+    HashMap<String,Phase> phases = new HashMap<String,Phase>();
+    HashMap<String,long[]> counts = new HashMap<String,long[]>();
+    Data(Thread thread) {
+      this.thread = thread.getName();
+      this.owner = new WeakReference<Thread>(thread);
+    }
+    boolean isAlive() {
+      Thread t = owner.get();
+      return t!=null && t.isAlive();
+    }
+    synchronized void start(String name) {
+      Phase p = phases.get(name);
+      if (p==null)
+        phases.put(name,p=new Phase());
+      if (p.depth++==0) {
+        ++p.calls;
+        p.sw.start();
+        _open.incrementAndGet();
+      }
+    }
+    synchronized void stop(String name) {
+      Phase p = phases.get(name);
+      if (p!=null && p.depth>0 && --p.depth==0) {
+        p.sw.stop();
+        _open.decrementAndGet();
+      }
+    }
+    synchronized void discard() {
+      for (Phase p:phases.values()) {
+        if (p.depth>0) {
+          p.depth = 0;
+          _open.decrementAndGet();
+        }
+      }
+    }
+    synchronized void count(String name, long n) {
+      long[] c = counts.get(name);
+      if (c==null)
+        counts.put(name,c=new long[1]);
+      c[0] += n;
+    }
+    synchronized void reset() {
+      for (Phase p:phases.values()) {
+        p.sw.reset();
+        p.calls = 0;
+        if (p.depth>0)
+          p.sw.start();
+      }
+      counts.clear();
+    }
+  }
+}
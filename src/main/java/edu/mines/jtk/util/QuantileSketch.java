@@ -0,0 +1,384 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.util;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+
+import static edu.mines.jtk.util.ArrayMath.*;
+
+/**
+ * A mergeable sketch of the distribution of values, for estimating
+ * quantiles. Like a {@link Quantiler}, a sketch processes values
+ * sequentially in one pass. Unlike a quantiler, a sketch estimates
+ * any quantile, and sketches of different sets of values may be merged
+ * into one sketch of all of those values. Sketches may therefore be
+ * computed in parallel, for different parts of an array.
+ * <p>
+ * A sketch stores a hierarchy of buffers, each with a specified capacity
+ * k. Values in the buffer at level h each represent 2^h values. When a
+ * buffer becomes full, it is sorted, and every other value is moved to
+ * the buffer in the next level. Storage therefore grows only with the
+ * logarithm of the number of values n.
+ * <p>
+ * The error in each such compaction is bounded, and this sketch keeps
+ * the sum of those bounds. The rank of a value estimated for quantile
+ * q differs from q*(n-1) by no more than the rank error, which is at
+ * most (1+log2(n/k))/(k-1) times n. Minimum and maximum values (quantiles 
+ * 0 and 1) are exact.
+ * <p>
+ * This sketch is a deterministic variant of the algorithm published by
+ * Karnin, Z., Lang, K., and Liberty, E., 2016, Optimal quantile
+ * approximation in streams: IEEE 57th Annual Symposium on Foundations of
+ * Computer Science, p. 71-78.
+ *
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+public class QuantileSketch {
+
+  /**
+   * Constructs a sketch with specified capacity.
+   * @param k the capacity of each buffer in the sketch; k &gt;= 2.
+   */
+  public QuantileSketch(int k) {
+    Check.argument(k>=2,"k>=2");
+    _k = k;
+  }
+
+  /**
+   * Returns the capacity required to ensure a specified rank error.
+   * @param error upper bound on rank error, a fraction of count n.
+   * @param n upper bound on the number of values in the sketch.
+   * @return the capacity of each buffer in the sketch.
+   */
+  public static int getCapacity(double error, long n) {
+    Check.argument(error>0.0,"error>0.0");
+    int k = 2;
+    while (k<n && getError(k,n)>error && k<Integer.MAX_VALUE/2)
+      k += max(1,k/16);
+    return k;
+  }
+
+  /**
+   * Returns a sketch of values in the specified array.
+   * Values are processed in parallel.
+   * @param k the capacity of each buffer in the sketch.
+   * @param f array of values.
+   * @return the sketch.
+   */
+  public static QuantileSketch compute(final int k, final float[] f) {
+    final int n = f.length;
+    int nchunk = max(1,(n+CHUNK-1)/CHUNK);
+    return Parallel.reduce(nchunk,new Parallel.ReduceInt<QuantileSketch>() {
+      public QuantileSketch compute(int ichunk) {
+        QuantileSketch qs = new QuantileSketch(k);
+        int jlast = min(n,(ichunk+1)*CHUNK);
+        for (int j=ichunk*CHUNK; j<jlast; ++j)
+          qs.update(f[j]);
+        return qs;
+      }
+      public QuantileSketch combine(QuantileSketch qa, QuantileSketch qb) {
+        return merged(qa,qb);
+      }
+    });
+  }
+
+  /**
+   * Returns a sketch of values in the specified array.
+   * Values are processed in parallel.
+   * @param k the capacity of each buffer in the sketch.
+   * @param f array of values.
+   * @return the sketch.
+   */
+  public static QuantileSketch compute(final int k, final float[][] f) {
+    final int[] jr = chunkRows(f);
+    int nchunk = jr.length-1;
+    if (nchunk==0)
+      return new QuantileSketch(k);
+    return Parallel.reduce(nchunk,new Parallel.ReduceInt<QuantileSketch>() {
+      public QuantileSketch compute(int ichunk) {
+        QuantileSketch qs = new QuantileSketch(k);
+        for (int i2=jr[ichunk]; i2<jr[ichunk+1]; ++i2)
+          qs.update(f[i2]);
+        return qs;
+      }
+      public QuantileSketch combine(QuantileSketch qa, QuantileSketch qb) {
+        return merged(qa,qb);
+      }
+    });
+  }
+
+  /**
+   * Returns a sketch of values in the specified array.
+   * Values are processed in parallel.
+   * @param k the capacity of each buffer in the sketch.
+   * @param f array of values.
+   * @return the sketch.
+   */
+  public static QuantileSketch compute(int k, float[][][] f) {
+    int n3 = f.length;
+    int nrow = 0;
+    for (int i3=0; i3<n3; ++i3)
+      nrow += f[i3].length;
+    float[][] rows = new float[nrow][];
+    for (int i3=0,jrow=0; i3<n3; ++i3) {
+      int n2 = f[i3].length;
+      System.arraycopy(f[i3],0,rows,jrow,n2);
+      jrow += n2;
+    }
+    return compute(k,rows);
+  }
+
+  /**
+   * Gets the capacity of each buffer in this sketch.
+   * @return the capacity.
+   */
+  public int getCapacity() {
+    return _k;
+  }
+
+  /**
+   * Gets the number of values in this sketch.
+   * @return the number of values.
+   */
+  public long getCount() {
+    return _n;
+  }
+
+  /**
+   * Gets the minimum value in this sketch.
+   * @return the minimum value.
+   */
+  public float getMin() {
+    return _min;
+  }
+
+  /**
+   * Gets the maximum value in this sketch.
+   * @return the maximum value.
+   */
+  public float getMax() {
+    return _max;
+  }
+
+  /**
+   * Gets the upper bound on rank error for quantiles estimated from
+   * this sketch. This bound is a fraction of the number of values.
+   * @return the bound on rank error; zero, if estimates are exact.
+   */
+  public double getRankError() {
+    return (_n>0)?(double)_error/(double)_n:0.0;
+  }
+
+  /**
+   * Updates this sketch with the specified value.
+   * Values that are not-a-number (NaN) are ignored.
+   * @param f the value.
+   */
+  public void update(float f) {
+    if (f==f) {
+      if (_n==0) {
+        _min = _max = f;
+      } else if (f<_min) {
+        _min = f;
+      } else if (f>_max) {
+        _max = f;
+      }
+      ++_n;
+      add(0,f);
+    }
+  }
+
+  /**
+   * Updates this sketch with the specified values.
+   * @param f array of values.
+   */
+  public void update(float[] f) {
+    int n = f.length;
+    for (int i=0; i<n; ++i)
+      update(f[i]);
+  }
+
+  /**
+   * Updates this sketch with the specified values.
+   * @param f array of values.
+   */
+  public void update(float[][] f) {
+    int n = f.length;
+    for (int i=0; i<n; ++i)
+      update(f[i]);
+  }
+
+  /**
+   * Updates this sketch with the specified values.
+   * @param f array of values.
+   */
+  public void update(float[][][] f) {
+    int n = f.length;
+    for (int i=0; i<n; ++i)
+      update(f[i]);
+  }
+
+  /**
+   * Merges the specified sketch into this sketch. After merging, this
+   * sketch represents the values in both sketches. The other sketch is
+   * not changed.
+   * @param qs the other sketch.
+   */
+  public void merge(QuantileSketch qs) {
+    Check.argument(qs!=this,"other sketch is not this sketch");
+    if (qs._n==0)
+      return;
+    if (_n==0) {
+      _min = qs._min;
+      _max = qs._max;
+    } else {
+      _min = min(_min,qs._min);
+      _max = max(_max,qs._max);
+    }
+    _n += qs._n;
+    _error += qs._error;
+    for (int h=0; h<qs._nlevel; ++h) {
+      float[] b = qs._buffers.get(h);
+      for (int i=0; i<qs._sizes[h]; ++i)
+        add(h,b[i]);
+    }
+  }
+
+  /**
+   * Returns an estimate of the specified quantile. The estimated value
+   * is that with rank approximately q*(n-1), rounded to the nearest
+   * integer, among all n values sorted in increasing order.
+   * @param q the quantile fraction; 0 &lt;= q &lt;= 1 is required.
+   * @return the estimated value.
+   */
+  public float estimate(double q) {
+    Check.argument(0.0<=q,"0.0<=q");
+    Check.argument(q<=1.0,"q<=1.0");
+    Check.state(_n>0,"sketch is not empty");
+    if (q==0.0)
+      return _min;
+    if (q==1.0)
+      return _max;
+    int m = 0;
+    for (int h=0; h<_nlevel; ++h)
+      m += _sizes[h];
+    float[] v = new float[m];
+    int[] l = new int[m];
+    for (int h=0,j=0; h<_nlevel; ++h) {
+      float[] b = _buffers.get(h);
+      for (int i=0; i<_sizes[h]; ++i,++j) {
+        v[j] = b[i];
+        l[j] = h;
+      }
+    }
+    int[] k = rampint(0,1,m);
+    quickIndexSort(v,k);
+    long r = (long)rint(q*(_n-1));
+    long c = 0;
+    for (int j=0; j<m; ++j) {
+      c += 1L<<l[k[j]];
+      if (c>r)
+        return v[k[j]];
+    }
+    return _max;
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // private
+
+  private static final int CHUNK = 65536; // values per parallel task
+
+  private int _k; // capacity of each buffer
+  private long _n; // number of values
+  private float _min; // minimum value
+  private float _max; // maximum value
+  private long _error; // sum of bounds on errors of all compactions
+  private int _nlevel; // number of levels with buffers
+  private ArrayList<float[]> _buffers = new ArrayList<float[]>();
+  private int[] _sizes = new int[0]; // number of values in each buffer
+  private boolean[] _odds = new boolean[0]; // true, to keep odd values
+
+  // Bound on rank error, a fraction of n, for n values and capacity k.
+  private static double getError(int k, long n) {
+    if (n<k)
+      return 0.0;
+    double nlevel = 1.0+floor(log((double)n/(double)k)/log(2.0));
+    return nlevel/(k-1.0);
+  }
+
+  // Returns indices of the first rows in chunks of rows with about
+  // CHUNK values each, followed by the number of rows. Each parallel
+  // task then allocates one set of buffers for many rows.
+  private static int[] chunkRows(float[][] f) {
+    int n2 = f.length;
+    int[] jr = new int[n2+1];
+    int nchunk = 0;
+    long m = 0;
+    for (int i2=0; i2<n2; ++i2) {
+      if (i2==0 || m>=CHUNK) {
+        jr[nchunk++] = i2;
+        m = 0;
+      }
+      m += f[i2].length;
+    }
+    jr[nchunk] = n2;
+    return copy(nchunk+1,jr);
+  }
+
+  // Returns the merge of two sketches, reusing the larger.
+  private static QuantileSketch merged(QuantileSketch qa, QuantileSketch qb) {
+    if (qa._n<qb._n) {
+      qb.merge(qa);
+      return qb;
+    } else {
+      qa.merge(qb);
+      return qa;
+    }
+  }
+
+  // Adds a value to the buffer for level h, compacting it if full.
+  private void add(int h, float f) {
+    if (h==_nlevel) {
+      _buffers.add(new float[_k]);
+      _sizes = copy(h+1,_sizes);
+      _odds = Arrays.copyOf(_odds,h+1);
+      ++_nlevel;
+    }
+    _buffers.get(h)[_sizes[h]++] = f;
+    if (_sizes[h]==_k)
+      compact(h);
+  }
+
+  // Sorts the buffer for level h, and moves every other value of an
+  // even number of values to level h+1. The ranks of values in the
+  // sketch change by at most 2^h. Alternating between odd and even
+  // values tends to make errors in successive compactions cancel.
+  private void compact(int h) {
+    float[] b = _buffers.get(h);
+    int m = _sizes[h];
+    Arrays.sort(b,0,m);
+    int me = m&~1;
+    int ifirst = (_odds[h])?1:0;
+    _odds[h] = !_odds[h];
+    _error += 1L<<h;
+    for (int i=ifirst; i<me; i+=2)
+      add(h+1,b[i]);
+    if (m>me)
+      b[0] = b[m-1];
+    _sizes[h] = m-me;
+  }
+}
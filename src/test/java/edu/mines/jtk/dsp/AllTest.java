@@ -27,6 +27,7 @@ public class AllTest extends TestSuite {
   public static Test suite() {
     TestSuite suite = new TestSuite();
 
+    suite.addTestSuite(DynamicWarpingTest.class);
     suite.addTestSuite(EigenTest.class);
     suite.addTestSuite(EigenTensors2Test.class);
     suite.addTestSuite(EigenTensors3Test.class);
@@ -36,6 +37,7 @@ public class AllTest extends TestSuite {
     suite.addTestSuite(HilbertTransformFilterTest.class);
     suite.addTestSuite(HistogramTest.class);
     suite.addTestSuite(LocalCausalFilterTest.class);
+    suite.addTestSuite(LocalCorrelationFilterTest.class);
     suite.addTestSuite(LocalOrientFilterTest.class);
     suite.addTestSuite(Real1Test.class);
     suite.addTestSuite(Recursive2ndOrderFilterTest.class);
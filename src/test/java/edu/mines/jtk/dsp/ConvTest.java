@@ -157,6 +157,57 @@ public class ConvTest extends TestCase {
     }
   }
 
+  public void test1Long() {
+    int ntest = 20;
+    for (int itest=0; itest<ntest; ++itest) {
+      int lx = 50+_random.nextInt(300);
+      int ly = 50+_random.nextInt(3000);
+      int lz = 1+_random.nextInt(lx+ly+100);
+      int kx = -_random.nextInt(lx);
+      int ky = -_random.nextInt(ly);
+      int kz = -50+_random.nextInt(100)+kx+ky;
+      float[] x = sub(randfloat(lx),0.5f);
+      float[] y = sub(randfloat(ly),0.5f);
+      float[] zs = zerofloat(lz);
+      float[] zf = zerofloat(lz);
+
+      convSimple(lx,kx,x,ly,ky,y,lz,kz,zs);
+      Conv.conv(lx,kx,x,ly,ky,y,lz,kz,zf);
+      assertEquals(zs,zf,tolerance(x,y));
+
+      xcorSimple(lx,kx,x,ly,ky,y,lz,kz,zs);
+      Conv.xcor(lx,kx,x,ly,ky,y,lz,kz,zf);
+      assertEquals(zs,zf,tolerance(x,y));
+    }
+  }
+
+  public void test2Long() {
+    int ntest = 5;
+    for (int itest=0; itest<ntest; ++itest) {
+      int lx1 = 50+_random.nextInt(100);
+      int lx2 = 1+_random.nextInt(10);
+      int ly1 = 50+_random.nextInt(500);
+      int ly2 = 1+_random.nextInt(20);
+      int lz1 = 1+_random.nextInt(lx1+ly1);
+      int lz2 = 1+_random.nextInt(lx2+ly2);
+      int kx1 = -_random.nextInt(lx1), kx2 = -_random.nextInt(lx2);
+      int ky1 = -_random.nextInt(ly1), ky2 = -_random.nextInt(ly2);
+      int kz1 = kx1+ky1, kz2 = kx2+ky2;
+      float[][] x = sub(randfloat(lx1,lx2),0.5f);
+      float[][] y = sub(randfloat(ly1,ly2),0.5f);
+      float[][] zs = zerofloat(lz1,lz2);
+      float[][] zf = zerofloat(lz1,lz2);
+
+      convSimple(lx1,lx2,kx1,kx2,x,ly1,ly2,ky1,ky2,y,lz1,lz2,kz1,kz2,zs);
+      Conv.conv(lx1,lx2,kx1,kx2,x,ly1,ly2,ky1,ky2,y,lz1,lz2,kz1,kz2,zf);
+      assertEquals(zs,zf,tolerance(x,y));
+
+      xcorSimple(lx1,lx2,kx1,kx2,x,ly1,ly2,ky1,ky2,y,lz1,lz2,kz1,kz2,zs);
+      Conv.xcor(lx1,lx2,kx1,kx2,x,ly1,ly2,ky1,ky2,y,lz1,lz2,kz1,kz2,zf);
+      assertEquals(zs,zf,tolerance(x,y));
+    }
+  }
+
   private Random _random = new Random();
 
   private static void convSimple(
@@ -332,4 +383,27 @@ public class ConvTest extends TestCase {
       assertEquals(a[i],b[i]);
     }
   }
+
+  // Errors in sums computed with FFTs are proportional to products of
+  // the norms of the sequences convolved.
+  private static float tolerance(float[] x, float[] y) {
+    return TOLERANCE*sqrt(sum(mul(x,x))*sum(mul(y,y)));
+  }
+  private static float tolerance(float[][] x, float[][] y) {
+    return TOLERANCE*sqrt(sum(mul(x,x))*sum(mul(y,y)));
+  }
+  private static void assertEquals(float[] a, float[] b, float tolerance) {
+    int n = a.length;
+    for (int i=0; i<n; ++i) {
+      assertEquals(a[i],b[i],tolerance);
+    }
+  }
+  private static void assertEquals(
+    float[][] a, float[][] b, float tolerance) 
+  {
+    int n = a.length;
+    for (int i=0; i<n; ++i) {
+      assertEquals(a[i],b[i],tolerance);
+    }
+  }
 }
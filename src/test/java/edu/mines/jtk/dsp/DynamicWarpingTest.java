@@ -0,0 +1,86 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.dsp;
+
+import junit.framework.TestCase;
+import junit.framework.TestSuite;
+
+import java.util.Random;
+import static edu.mines.jtk.util.ArrayMath.*;
+
+/**
+ * Tests {@link edu.mines.jtk.dsp.DynamicWarping}.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+public class DynamicWarpingTest extends TestCase {
+  public static void main(String[] args) {
+    TestSuite suite = new TestSuite(DynamicWarpingTest.class);
+    junit.textui.TestRunner.run(suite);
+  }
+
+  public void testStreaming2() {
+    int n1 = 201;
+    int n2 = 13;
+    Random r = new Random(314159);
+    float[][] g = randfloat(r,n1,n2);
+    float[][] f = shift(3,g);
+    for (int esmooth=0; esmooth<2; ++esmooth) {
+      DynamicWarping dw = makeWarping(esmooth);
+      float[][] u = dw.findShifts(f,g);
+      for (int i2=0; i2<n2; ++i2)
+        assertTrue(equal(dw.findShifts(f[i2],g[i2]),u[i2]));
+    }
+  }
+
+  public void testStreaming3() {
+    int n1 = 101;
+    int n2 = 7;
+    int n3 = 8;
+    Random r = new Random(271828);
+    float[][][] g = randfloat(r,n1,n2,n3);
+    float[][][] f = new float[n3][][];
+    for (int i3=0; i3<n3; ++i3)
+      f[i3] = shift(-2,g[i3]);
+    for (int esmooth=0; esmooth<2; ++esmooth) {
+      DynamicWarping dw = makeWarping(esmooth);
+      float[][][] u = dw.findShifts(f,g);
+      for (int i3=0; i3<n3; ++i3)
+        for (int i2=0; i2<n2; ++i2)
+          assertTrue(equal(dw.findShifts(f[i3][i2],g[i3][i2]),u[i3][i2]));
+      assertEquals(-2.0f,u[n3/2][n2/2][n1/2],0.0f);
+    }
+  }
+
+  private static DynamicWarping makeWarping(int esmooth) {
+    DynamicWarping dw = new DynamicWarping(-5,5);
+    dw.setStrainMax(0.5);
+    dw.setErrorSmoothing(esmooth);
+    dw.setStreaming(true);
+    return dw;
+  }
+
+  // Returns f[i2][i1] = g[i2][i1+l], with zeros where i1+l is out of bounds.
+  private static float[][] shift(int l, float[][] g) {
+    int n1 = g[0].length;
+    int n2 = g.length;
+    float[][] f = new float[n2][n1];
+    for (int i2=0; i2<n2; ++i2) {
+      for (int i1=max(0,-l); i1<min(n1,n1-l); ++i1)
+        f[i2][i1] = g[i2][i1+l];
+    }
+    return f;
+  }
+}
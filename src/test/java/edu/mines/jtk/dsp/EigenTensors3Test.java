@@ -65,6 +65,63 @@ public class EigenTensors3Test extends TestCase {
     }
   }
 
+  public void testRows() {
+    testRows(true);
+    testRows(false);
+  }
+
+  private static void testRows(boolean compressed) {
+    int n1 = 19, n2 = 20, n3 = 21;
+    float[][][][] a = new float[6][n3][n2][n1];
+    for (int i3=0; i3<n3; ++i3) {
+      for (int i2=0; i2<n2; ++i2) {
+        for (int i1=0; i1<n1; ++i1) {
+          EigenTensors3 et = new EigenTensors3(1,1,1,false);
+          et.setEigenvalues(0,0,0,makeRandomEigenvalues());
+          float[] u = makeRandomEigenvector();
+          et.setEigenvectorU(0,0,0,u);
+          et.setEigenvectorW(0,0,0,makeOrthogonalVector(u));
+          float[] t = et.getTensor(0,0,0);
+          for (int j=0; j<6; ++j)
+            a[j][i3][i2][i1] = t[j];
+        }
+      }
+    }
+
+    // Rows set in parallel must equal tensors set one at a time.
+    EigenTensors3 et1 = new EigenTensors3(n1,n2,n3,compressed);
+    EigenTensors3 et2 = new EigenTensors3(n1,n2,n3,compressed);
+    et1.setTensors(a[0],a[1],a[2],a[3],a[4],a[5]);
+    float[] t = new float[6];
+    for (int i3=0; i3<n3; ++i3) {
+      for (int i2=0; i2<n2; ++i2) {
+        for (int i1=0; i1<n1; ++i1) {
+          for (int j=0; j<6; ++j)
+            t[j] = a[j][i3][i2][i1];
+          et2.setTensor(i1,i2,i3,t);
+        }
+      }
+    }
+
+    // Rows decoded at once must equal tensors decoded one at a time.
+    float[][] r = new float[6][n1];
+    float[] t1 = new float[6];
+    float[] t2 = new float[6];
+    for (int i3=0; i3<n3; ++i3) {
+      for (int i2=0; i2<n2; ++i2) {
+        et1.getTensors(i2,i3,r[0],r[1],r[2],r[3],r[4],r[5]);
+        for (int i1=0; i1<n1; ++i1) {
+          et1.getTensor(i1,i2,i3,t1);
+          et2.getTensor(i1,i2,i3,t2);
+          for (int j=0; j<6; ++j) {
+            assertEquals(t1[j],t2[j],0.0);
+            assertEquals(t1[j],r[j][i1],0.0);
+          }
+        }
+      }
+    }
+  }
+
   public void testIO() throws IOException,ClassNotFoundException {
 
     // Make random eigen-tensors.
@@ -119,6 +119,58 @@ public class FftComplexTest extends TestCase {
     }
   }
 
+  public void test2Split() {
+    int n1 = 100;
+    int[] ns = {2,7,16,48,105,1001};
+    for (int n:ns) {
+      int nfft = FftComplex.nfftSmall(n);
+      FftComplex fft = new FftComplex(nfft);
+      float[][] rx = randfloat(n1,nfft);
+      float[][] ix = randfloat(n1,nfft);
+      float[][] ry = zerofloat(n1,nfft);
+      float[][] iy = zerofloat(n1,nfft);
+      float[][] cx = cmplx(rx,ix);
+      fft.complexToComplex2(1,n1,rx,ix,ry,iy);
+      fft.complexToComplex2(1,n1,cx,cx);
+      assertEqual(cx,cmplx(ry,iy));
+      fft.complexToComplex2(-1,n1,ry,iy,ry,iy);
+      fft.complexToComplex2(-1,n1,cx,cx);
+      assertEqual(cx,cmplx(ry,iy));
+      float[][] cy = cmplx(ry,iy);
+      fft.scale(n1,nfft,cy);
+      assertEqual(cmplx(rx,ix),cy);
+    }
+  }
+
+  public void test2Chunks() {
+    int n1 = 150; // more than one chunk of transforms in 1st dimension
+    int[] ns = {2,16,105,1001};
+    for (int n:ns) {
+      int nfft = FftComplex.nfftSmall(n);
+      FftComplex fft = new FftComplex(nfft);
+      float[][] cr = mul(1.0f/nfft,crandfloat(n1,nfft)); // |transform|<1
+      float[][] cy = czerofloat(n1,nfft);
+      fft.complexToComplex2(1,n1,cr,cy);
+      float[] cx = new float[2*nfft];
+      float[][] ce = czerofloat(n1,nfft);
+      for (int i1=0; i1<n1; ++i1) {
+        for (int i2=0; i2<nfft; ++i2) {
+          cx[2*i2  ] = cr[i2][2*i1  ];
+          cx[2*i2+1] = cr[i2][2*i1+1];
+        }
+        fft.complexToComplex(1,cx,cx);
+        for (int i2=0; i2<nfft; ++i2) {
+          ce[i2][2*i1  ] = cx[2*i2  ];
+          ce[i2][2*i1+1] = cx[2*i2+1];
+        }
+      }
+      assertEqual(ce,cy);
+      fft.complexToComplex2(-1,n1,cy,cy);
+      fft.scale(n1,nfft,cy);
+      assertEqual(cr,cy);
+    }
+  }
+
   public void test3Random() {
     int n1 = 11;
     int n2 = 12;
@@ -183,6 +183,45 @@ public class FftRealTest extends TestCase {
     }
   }
 
+  public void test2Chunks() {
+    int n1 = 150; // more than one chunk of transforms in 1st dimension
+    int[] ns = {2,16,105,1001};
+    for (int n:ns) {
+      int nfft = FftReal.nfftSmall(n);
+      FftReal fft = new FftReal(nfft);
+      int nw = nfft/2+1;
+      float[][] rr = mul(1.0f/nfft,randfloat(n1,nfft)); // |transform|<1
+      float[][] cy = czerofloat(n1,nw);
+      fft.realToComplex2(1,n1,rr,cy);
+      float[] rx = new float[nfft];
+      float[] cx = new float[2*nw];
+      float[][] ce = czerofloat(n1,nw);
+      for (int i1=0; i1<n1; ++i1) {
+        for (int i2=0; i2<nfft; ++i2)
+          rx[i2] = rr[i2][i1];
+        fft.realToComplex(1,rx,cx);
+        for (int i2=0; i2<nw; ++i2) {
+          ce[i2][2*i1  ] = cx[2*i2  ];
+          ce[i2][2*i1+1] = cx[2*i2+1];
+        }
+      }
+      assertComplexEqual(n1,nw,ce,cy);
+      float[][] ry = zerofloat(n1,nfft);
+      fft.complexToReal2(-1,n1,cy,ry);
+      fft.scale(n1,nfft,ry);
+      assertRealEqual(n1,nfft,rr,ry);
+
+      // Same transforms, in place.
+      float[][] cz = czerofloat(n1,nfft);
+      copy(n1,nfft,rr,cz);
+      fft.realToComplex2(1,n1,cz,cz);
+      assertComplexEqual(n1,nw,ce,cz);
+      fft.complexToReal2(-1,n1,cz,cz);
+      fft.scale(n1,nfft,cz);
+      assertRealEqual(n1,nfft,rr,cz);
+    }
+  }
+
   private void assertRealEqual(int n1, float[] re, float[] ra) {
     float tolerance = (float)(n1)*FLT_EPSILON;
     for (int i1=0; i1<n1; ++i1)
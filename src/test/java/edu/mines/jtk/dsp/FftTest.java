@@ -16,6 +16,7 @@ package edu.mines.jtk.dsp;
 
 import junit.framework.*;
 
+import edu.mines.jtk.util.Parallel;
 import static edu.mines.jtk.util.ArrayMath.*;
 
 /**
@@ -103,6 +104,34 @@ public class FftTest extends TestCase {
     }
   }
 
+  public void testParallel() {
+    boolean[] complexs = {false,true};
+    for (boolean complex:complexs) {
+      float[][] f2 = randfloat(38,41);
+      float[][][] f3 = randfloat(20,23,29);
+      Fft fft2 = complex?new Fft(true,f2):new Fft(f2);
+      Fft fft3 = complex?new Fft(true,f3):new Fft(f3);
+      try {
+        Parallel.setParallel(false);
+        float[][] g2s = fft2.applyForward(f2);
+        float[][][] g3s = fft3.applyForward(f3);
+        float[][] h2s = fft2.applyInverse(g2s);
+        float[][][] h3s = fft3.applyInverse(g3s);
+        Parallel.setParallel(true);
+        float[][] g2p = fft2.applyForward(f2);
+        float[][][] g3p = fft3.applyForward(f3);
+        float[][] h2p = fft2.applyInverse(g2p);
+        float[][][] h3p = fft3.applyInverse(g3p);
+        assertTrue(equal(g2s,g2p));
+        assertTrue(equal(g3s,g3p));
+        assertTrue(equal(h2s,h2p));
+        assertTrue(equal(h3s,h3p));
+      } finally {
+        Parallel.setParallel(true);
+      }
+    }
+  }
+
   public void xxtest3() { // too long for routine testing
     for (boolean complex:_complex) {
       for (boolean overwrite:_overwrite) {
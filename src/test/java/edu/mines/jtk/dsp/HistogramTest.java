@@ -30,6 +30,14 @@ public class HistogramTest extends TestCase {
     junit.textui.TestRunner.run(suite);
   }
 
+  public void testEmpty() {
+    Histogram h = new Histogram(new float[0]);
+    assertEquals(1,h.getBinCount());
+    assertEquals(0,h.getLowCount());
+    assertEquals(0,h.getInCount());
+    assertEquals(0,h.getHighCount());
+  }
+
   public void testConstant() {
     int n = 1001;
     float vfill = 2.0f;
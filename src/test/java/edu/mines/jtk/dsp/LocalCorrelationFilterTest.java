@@ -0,0 +1,156 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.dsp;
+
+import junit.framework.TestCase;
+import junit.framework.TestSuite;
+
+import static edu.mines.jtk.util.ArrayMath.*;
+
+/**
+ * Tests {@link edu.mines.jtk.dsp.LocalCorrelationFilter}.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+public class LocalCorrelationFilterTest extends TestCase {
+  public static void main(String[] args) {
+    TestSuite suite = new TestSuite(LocalCorrelationFilterTest.class);
+    junit.textui.TestRunner.run(suite);
+  }
+
+  public void test1() {
+    int n1 = 51;
+    float[] f = randfloat(n1);
+    float[] g = randfloat(n1);
+    int[] lags = {-3,-1,0,2,4};
+    int nlag = lags.length;
+    for (LocalCorrelationFilter lcf:makeFilters()) {
+      lcf.setInputs(f,g);
+      float[][] c = new float[nlag][n1];
+      lcf.correlate(lags,c);
+      lcf.normalize(lags,c);
+      for (int ilag=0; ilag<nlag; ++ilag) {
+        float[] ci = new float[n1];
+        lcf.correlate(lags[ilag],ci);
+        lcf.normalize(lags[ilag],ci);
+        assertEqual(ci,c[ilag]);
+      }
+      float[][] cr = lcf.correlateLags1(-2,3);
+      for (int ilag=0; ilag<cr.length; ++ilag) {
+        float[] ci = new float[n1];
+        lcf.correlate(-2+ilag,ci);
+        lcf.normalize(-2+ilag,ci);
+        assertEqual(ci,cr[ilag]);
+      }
+    }
+  }
+
+  public void test2() {
+    int n1 = 23, n2 = 19;
+    float[][] f = randfloat(n1,n2);
+    float[][] g = randfloat(n1,n2);
+    int[] lag1 = {-2,0,1,0,3};
+    int[] lag2 = { 1,0,0,-2,2};
+    int nlag = lag1.length;
+    for (LocalCorrelationFilter lcf:makeFilters()) {
+      lcf.setInputs(f,g);
+      float[][][] c = new float[nlag][n2][n1];
+      lcf.correlate(lag1,lag2,c);
+      lcf.normalize(lag1,lag2,c);
+      for (int ilag=0; ilag<nlag; ++ilag) {
+        float[][] ci = new float[n2][n1];
+        lcf.correlate(lag1[ilag],lag2[ilag],ci);
+        lcf.normalize(lag1[ilag],lag2[ilag],ci);
+        assertEqual(ci,c[ilag]);
+      }
+      float[][][] cr = lcf.correlateLags1(-2,2,1);
+      for (int ilag=0; ilag<cr.length; ++ilag) {
+        float[][] ci = new float[n2][n1];
+        lcf.correlate(-2+ilag,1,ci);
+        lcf.normalize(-2+ilag,1,ci);
+        assertEqual(ci,cr[ilag]);
+      }
+    }
+  }
+
+  public void test3() {
+    int n1 = 13, n2 = 11, n3 = 9;
+    float[][][] f = randfloat(n1,n2,n3);
+    float[][][] g = randfloat(n1,n2,n3);
+    int[] lag1 = {-2,0,1,0,0};
+    int[] lag2 = { 1,0,0,-1,0};
+    int[] lag3 = { 0,0,1,0,-2};
+    int nlag = lag1.length;
+    for (LocalCorrelationFilter lcf:makeFilters()) {
+      lcf.setInputs(f,g);
+      float[][][][] c = new float[nlag][n3][n2][n1];
+      lcf.correlate(lag1,lag2,lag3,c);
+      lcf.normalize(lag1,lag2,lag3,c);
+      for (int ilag=0; ilag<nlag; ++ilag) {
+        float[][][] ci = new float[n3][n2][n1];
+        lcf.correlate(lag1[ilag],lag2[ilag],lag3[ilag],ci);
+        lcf.normalize(lag1[ilag],lag2[ilag],lag3[ilag],ci);
+        assertEqual(ci,c[ilag]);
+      }
+      float[][][][] cr = lcf.correlateLags1(-1,2,0,-1);
+      for (int ilag=0; ilag<cr.length; ++ilag) {
+        float[][][] ci = new float[n3][n2][n1];
+        lcf.correlate(-1+ilag,0,-1,ci);
+        lcf.normalize(-1+ilag,0,-1,ci);
+        assertEqual(ci,cr[ilag]);
+      }
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // private
+
+  private static LocalCorrelationFilter[] makeFilters() {
+    LocalCorrelationFilter.Type[] types = {
+      LocalCorrelationFilter.Type.SIMPLE,
+      LocalCorrelationFilter.Type.SYMMETRIC
+    };
+    LocalCorrelationFilter.Window[] windows = {
+      LocalCorrelationFilter.Window.GAUSSIAN,
+      LocalCorrelationFilter.Window.RECTANGLE
+    };
+    LocalCorrelationFilter[] lcfs = new LocalCorrelationFilter[4];
+    for (int itype=0,ilcf=0; itype<2; ++itype)
+      for (int iwindow=0; iwindow<2; ++iwindow,++ilcf)
+        lcfs[ilcf] = new LocalCorrelationFilter(
+          types[itype],windows[iwindow],4.0);
+    return lcfs;
+  }
+
+  // Batched lags must give exactly the same results as single lags.
+  private static void assertEqual(float[] x, float[] y) {
+    int n = x.length;
+    assertEquals(n,y.length);
+    for (int i=0; i<n; ++i)
+      assertEquals(x[i],y[i],0.0f);
+  }
+  private static void assertEqual(float[][] x, float[][] y) {
+    int n = x.length;
+    assertEquals(n,y.length);
+    for (int i=0; i<n; ++i)
+      assertEqual(x[i],y[i]);
+  }
+  private static void assertEqual(float[][][] x, float[][][] y) {
+    int n = x.length;
+    assertEquals(n,y.length);
+    for (int i=0; i<n; ++i)
+      assertEqual(x[i],y[i]);
+  }
+}
@@ -171,6 +171,36 @@ public class LocalOrientFilterTest extends TestCase {
     }
   }
 
+  public void test3Slabs() {
+    int n1 = 21, n2 = 22, n3 = 61;
+    float[][][] x = randfloat(n1,n2,n3);
+    LocalOrientFilter lof = new LocalOrientFilter(2.0,2.0,1.0);
+    EigenTensors3 et = lof.applyForTensors(x,false);
+    lof.setSlabSize(7);
+    EigenTensors3 es = lof.applyForTensors(x,false);
+    float[] a = new float[6];
+    float[] b = new float[6];
+    float amax = 0.0f;
+    for (int i3=0; i3<n3; ++i3) {
+      for (int i2=0; i2<n2; ++i2) {
+        for (int i1=0; i1<n1; ++i1) {
+          et.getTensor(i1,i2,i3,a);
+          amax = max(amax,max(abs(a[0]),abs(a[3]),abs(a[5])));
+        }
+      }
+    }
+    for (int i3=0; i3<n3; ++i3) {
+      for (int i2=0; i2<n2; ++i2) {
+        for (int i1=0; i1<n1; ++i1) {
+          et.getTensor(i1,i2,i3,a);
+          es.getTensor(i1,i2,i3,b);
+          for (int j=0; j<6; ++j)
+            assertEquals(a[j],b[j],1.0e-4*amax);
+        }
+      }
+    }
+  }
+
   private static void assertEqual(double e, float[][] a, double tol) {
     int n1 = a[0].length;
     int n2 = a.length;
@@ -18,6 +18,8 @@ import junit.framework.TestCase;
 import junit.framework.TestSuite;
 
 import java.util.Random;
+
+import edu.mines.jtk.util.Profiler;
 import static edu.mines.jtk.util.ArrayMath.*;
 
 /**
@@ -59,6 +61,85 @@ public class LocalSmoothingFilterTest extends TestCase {
     }
   }
 
+  public void testMultigrid2() {
+    int n1 = 41;
+    int n2 = 38;
+    LocalSmoothingFilter lsf = new LocalSmoothingFilter(1.0e-6,1000);
+    LocalSmoothingFilter lmg = new LocalSmoothingFilter(1.0e-6,1000);
+    lmg.setMultigrid(true);
+    float[][] s = randfloat(n1,n2);
+    float[][] x = sub(randfloat(n1,n2),0.5f);
+    float[][] y = sub(randfloat(n1,n2),0.5f);
+    float[][] dx = zerofloat(n1,n2);
+    float[][] dy = zerofloat(n1,n2);
+    float[][] ex = zerofloat(n1,n2);
+    Tensors2 d = new RandomTensors2(n1,n2);
+    float c = 100.0f;
+    lmg.apply(d,c,s,x,dx);
+    lmg.apply(d,c,s,y,dy);
+    lsf.apply(d,c,s,x,ex);
+    assertEquals(dot(x,dy),dot(y,dx),0.0001);
+    assertEquals(0.0f,max(abs(sub(dx,ex))),0.0001f);
+  }
+
+  public void testMultigrid3() {
+    int n1 = 17;
+    int n2 = 18;
+    int n3 = 19;
+    LocalSmoothingFilter lsf = new LocalSmoothingFilter(1.0e-6,1000);
+    LocalSmoothingFilter lmg = new LocalSmoothingFilter(1.0e-6,1000);
+    lmg.setMultigrid(true);
+    float[][][] x = sub(randfloat(n1,n2,n3),0.5f);
+    float[][][] dx = zerofloat(n1,n2,n3);
+    float[][][] ex = zerofloat(n1,n2,n3);
+    Tensors3 d = new IdentityTensors3();
+    float c = 100.0f;
+    lmg.apply(d,c,x,dx);
+    lsf.apply(d,c,x,ex);
+    assertEquals(0.0f,max(abs(sub(dx,ex))),0.0001f);
+  }
+
+  public void testIterations() {
+    int niter = 10000;
+    int[] ns = {33,129};
+    long[] kcg = new long[ns.length];
+    long[] kmg = new long[ns.length];
+    for (int i=0; i<ns.length; ++i) {
+      kcg[i] = countIterations(false,niter,ns[i]);
+      kmg[i] = countIterations(true,niter,ns[i]);
+      assertTrue(kcg[i]<niter);
+      assertTrue(kmg[i]<niter);
+      assertTrue(kmg[i]<kcg[i]);
+    }
+
+    // Iterations of conjugate gradients grow with the grid size; with
+    // the multigrid preconditioner they should grow much more slowly.
+    assertTrue(kcg[0]<kcg[1]);
+    assertTrue(kcg[1]*kmg[0]>kcg[0]*kmg[1]);
+  }
+
+  private static long countIterations(boolean mg, int niter, int n) {
+    LocalSmoothingFilter lsf = new LocalSmoothingFilter(1.0e-6,niter);
+    lsf.setMultigrid(mg);
+    float[][] x = sub(randfloat(new Random(n),n,n),0.5f);
+    float[][] y = zerofloat(n,n);
+    Tensors2 d = new IdentityTensors2();
+    float c = 10000.0f;
+    boolean enabled = Profiler.isEnabled();
+    Profiler.setEnabled(true);
+    Profiler.reset();
+    try {
+      lsf.apply(d,c,x,y);
+      Long count = Profiler.getCounts().get(
+        "LocalSmoothingFilter.iterations");
+      assertNotNull(count);
+      return count;
+    } finally {
+      Profiler.reset();
+      Profiler.setEnabled(enabled);
+    }
+  }
+
   private static float dot(float[][] x, float[][] y) {
     return sum(mul(x,y));
   }
@@ -97,6 +97,33 @@ public class RecursiveGaussianFilterTest extends TestCase {
     }
   }
 
+  public void testStrips() {
+    int n1 = 1001;
+    int n2 = 41;
+    RecursiveGaussianFilter.Method[] methods = {
+      RecursiveGaussianFilter.Method.DERICHE,
+      RecursiveGaussianFilter.Method.VAN_VLIET
+    };
+    for (RecursiveGaussianFilter.Method method:methods) {
+      RecursiveGaussianFilter rf = new RecursiveGaussianFilter(4.0,method);
+      float[][] x = randfloat(n1,n2);
+      float[][] y = zerofloat(n1,n2);
+      float[] xt = new float[n2];
+      float[] yt = new float[n2];
+      rf.applyX1(x,y);
+      for (int i1=0; i1<n1; ++i1) {
+        for (int i2=0; i2<n2; ++i2)
+          xt[i2] = x[i2][i1];
+        rf.apply1(xt,yt);
+        for (int i2=0; i2<n2; ++i2)
+          assertEquals(yt[i2],y[i2][i1],1.0e-5f);
+      }
+      float[][] z = copy(x);
+      rf.applyX1(z,z);
+      assertTrue(equal(y,z));
+    }
+  }
+
   private static float gaussian(float s, float x) {
     float xx = x*x;
     float ss = s*s;
@@ -107,6 +107,59 @@ public class SincInterpolatorTest extends TestCase {
     }
   }
 
+  public void testTraces() {
+    SincInterpolator si = new SincInterpolator();
+    Random random = new Random();
+    int nxu = 101;
+    double dxu = 1.1;
+    double fxu = 0.3;
+    int n2 = 5;
+    int n3 = 4;
+    float[][][] yu = new float[n3][n2][nxu];
+    for (int i3=0; i3<n3; ++i3)
+      for (int i2=0; i2<n2; ++i2)
+        for (int ixu=0; ixu<nxu; ++ixu)
+          yu[i3][i2][ixu] = random.nextFloat();
+    int nx = 130;
+    double dx = 0.9;
+    double fx = -5.0;
+    float[] x = new float[nx];
+    for (int ix=0; ix<nx; ++ix)
+      x[ix] = (float)(fx+ix*dx+random.nextFloat());
+    Sampling sxu = new Sampling(nxu,dxu,fxu);
+    Sampling sx = new Sampling(nx,dx,fx);
+    SincInterpolator.Extrapolation[] extraps = {
+      SincInterpolator.Extrapolation.ZERO,
+      SincInterpolator.Extrapolation.CONSTANT
+    };
+    for (SincInterpolator.Extrapolation extrap:extraps) {
+      si.setExtrapolation(extrap);
+      float[][][] yu3 = new float[n3][n2][nx];
+      float[][][] yx3 = new float[n3][n2][nx];
+      float[][][] ys3 = new float[n3][n2][nx];
+      float[][] yu2 = new float[n2][nx];
+      float[] yt = new float[nx];
+      si.interpolate(nxu,dxu,fxu,yu,nx,dx,fx,yu3);
+      si.interpolate(nxu,dxu,fxu,yu,nx,x,yx3);
+      si.interpolate(sxu,yu,sx,ys3);
+      si.interpolate(nxu,dxu,fxu,yu[1],nx,dx,fx,yu2);
+      for (int i3=0; i3<n3; ++i3) {
+        for (int i2=0; i2<n2; ++i2) {
+          si.interpolate(nxu,dxu,fxu,yu[i3][i2],nx,dx,fx,yt);
+          for (int ix=0; ix<nx; ++ix) {
+            assertEquals(yt[ix],yu3[i3][i2][ix],0.0);
+            assertEquals(yt[ix],ys3[i3][i2][ix],0.0);
+            if (i3==1)
+              assertEquals(yt[ix],yu2[i2][ix],0.0);
+          }
+          si.interpolate(nxu,dxu,fxu,yu[i3][i2],nx,x,yt);
+          for (int ix=0; ix<nx; ++ix)
+            assertEquals(yt[ix],yx3[i3][i2][ix],0.0);
+        }
+      }
+    }
+  }
+
   public void testErrorAndFrequency() {
     for (double emax:_emaxs) {
       for (double fmax:_fmaxs) {
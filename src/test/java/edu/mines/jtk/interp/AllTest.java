@@ -34,6 +34,7 @@ public class AllTest extends TestSuite {
     suite.addTestSuite(LasserreVolumeTest.class);
     suite.addTestSuite(SibsonInterpolator2Test.class);
     suite.addTestSuite(SibsonInterpolator3Test.class);
+    suite.addTestSuite(TimeMarker3Test.class);
     suite.addTestSuite(TricubicInterpolator3Test.class);
     suite.addTestSuite(TrilinearInterpolator3Test.class);
 
@@ -118,6 +118,32 @@ public class SibsonInterpolator2Test extends TestCase {
     }
   }
 
+  public void testPoints() {
+    TestFunction tf = TestFunction.makeSine();
+    float[][] fx = tf.sampleScattered2(NS,XMIN,XMAX,XMIN,XMAX);
+    float[] f = fx[0], x1 = fx[1], x2 = fx[2];
+    SibsonInterpolator2 si = new SibsonInterpolator2(f,x1,x2);
+    si.setNullValue(999.0f);
+    int np = 2000;
+    float[] y1 = randfloat(np), y2 = randfloat(np);
+    float[] g = si.interpolate(y1,y2);
+    SibsonInterpolator2.IndexWeight[][] iwa = si.getIndexWeights(y1,y2);
+    for (int ip=0; ip<np; ++ip) {
+      assertEquals(si.interpolate(y1[ip],y2[ip]),g[ip]);
+      SibsonInterpolator2.IndexWeight[] iw = 
+        si.getIndexWeights(y1[ip],y2[ip]);
+      assertEquals(iw==null,iwa[ip]==null);
+      if (iw!=null) {
+        float[] w = new float[NS];
+        for (SibsonInterpolator2.IndexWeight iwi:iw)
+          w[iwi.index] += iwi.weight;
+        for (SibsonInterpolator2.IndexWeight iwi:iwa[ip])
+          w[iwi.index] -= iwi.weight;
+        assertEquals(0.0f,max(abs(w)));
+      }
+    }
+  }
+
   private static final double TOLERANCE = 1.0e-5;
   private void assertEquals(float e, float a) {
     assertEquals(e,a,TOLERANCE);
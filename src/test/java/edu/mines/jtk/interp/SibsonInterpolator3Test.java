@@ -110,6 +110,32 @@ public class SibsonInterpolator3Test extends TestCase {
     }
   }
 
+  public void testPoints() {
+    TestFunction tf = TestFunction.makeSine();
+    float[][] fx = tf.sampleScattered3(NS,XMIN,XMAX,XMIN,XMAX,XMIN,XMAX);
+    float[] f = fx[0], x1 = fx[1], x2 = fx[2], x3 = fx[3];
+    SibsonInterpolator3 si = new SibsonInterpolator3(f,x1,x2,x3);
+    si.setNullValue(999.0f);
+    int np = 2000;
+    float[] y1 = randfloat(np), y2 = randfloat(np), y3 = randfloat(np);
+    float[] g = si.interpolate(y1,y2,y3);
+    SibsonInterpolator3.IndexWeight[][] iwa = si.getIndexWeights(y1,y2,y3);
+    for (int ip=0; ip<np; ++ip) {
+      assertEquals(si.interpolate(y1[ip],y2[ip],y3[ip]),g[ip]);
+      SibsonInterpolator3.IndexWeight[] iw = 
+        si.getIndexWeights(y1[ip],y2[ip],y3[ip]);
+      assertEquals(iw==null,iwa[ip]==null);
+      if (iw!=null) {
+        float[] w = new float[NS];
+        for (SibsonInterpolator3.IndexWeight iwi:iw)
+          w[iwi.index] += iwi.weight;
+        for (SibsonInterpolator3.IndexWeight iwi:iwa[ip])
+          w[iwi.index] -= iwi.weight;
+        assertEquals(0.0f,max(abs(w)));
+      }
+    }
+  }
+
   public static void benchMethods() {
     TestFunction tf = TestFunction.makeSine();
     //TestFunction tf = TestFunction.makeLinear();
@@ -0,0 +1,84 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.interp;
+
+import java.util.Random;
+
+import junit.framework.TestCase;
+import junit.framework.TestSuite;
+
+import edu.mines.jtk.dsp.Tensors3;
+import static edu.mines.jtk.util.ArrayMath.*;
+
+/**
+ * Tests {@link edu.mines.jtk.interp.TimeMarker3}.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+public class TimeMarker3Test extends TestCase {
+  public static void main(String[] args) {
+    TestSuite suite = new TestSuite(TimeMarker3Test.class);
+    junit.textui.TestRunner.run(suite);
+  }
+
+  public void testBlocked() {
+    // Dimensions not multiples of the block size, so that some blocks 
+    // are partial, and more than two blocks in each dimension.
+    int n1 = 37, n2 = 35, n3 = 33;
+    Tensors3 tensors = new Tensors3() {
+      public void getTensor(int i1, int i2, int i3, float[] a) {
+        a[0] = 1.0f;  a[1] = 0.2f;  a[2] = 0.1f;
+        a[3] = 0.8f;  a[4] = 0.0f;
+        a[5] = 0.6f;
+      }
+    };
+    float[][][] ts = fillfloat(1.0f,n1,n2,n3);
+    int[][][] ms = new int[n3][n2][n1];
+    Random r = new Random(314159);
+    int nk = 7;
+    for (int ik=1; ik<=nk; ++ik) {
+      int i1 = r.nextInt(n1);
+      int i2 = r.nextInt(n2);
+      int i3 = r.nextInt(n3);
+      ts[i3][i2][i1] = 0.0f;
+      ms[i3][i2][i1] = ik;
+    }
+    float[][][] tb = copy(ts);
+    int[][][] mb = copy(ms);
+
+    TimeMarker3 tm = new TimeMarker3(n1,n2,n3,tensors);
+    tm.setConcurrency(TimeMarker3.Concurrency.SERIAL);
+    tm.apply(ts,ms);
+    tm.setConcurrency(TimeMarker3.Concurrency.BLOCKED);
+    tm.apply(tb,mb);
+
+    // Times converge to within a small fraction, regardless of the order
+    // in which samples are processed. Marks may differ only for the few 
+    // samples that are nearly equidistant from two known samples.
+    int nm = 0;
+    for (int i3=0; i3<n3; ++i3) {
+      for (int i2=0; i2<n2; ++i2) {
+        for (int i1=0; i1<n1; ++i1) {
+          float tsi = ts[i3][i2][i1];
+          float tbi = tb[i3][i2][i1];
+          assertEquals(tsi,tbi,0.01f*max(1.0f,tsi));
+          if (mb[i3][i2][i1]!=ms[i3][i2][i1])
+            ++nm;
+        }
+      }
+    }
+    assertTrue(nm<=n1*n2*n3/100);
+  }
+}
@@ -28,6 +28,8 @@ public class AllTest extends TestSuite {
     TestSuite suite = new TestSuite();
 
     suite.addTestSuite(ArrayFileTest.class);
+    suite.addTestSuite(BrickedFloat3Test.class);
+    suite.addTestSuite(SlabPipelineTest.class);
 
     return suite;
   }
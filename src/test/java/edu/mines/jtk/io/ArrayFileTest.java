@@ -15,6 +15,8 @@ limitations under the License.
 package edu.mines.jtk.io;
 
 import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
 import java.io.IOException;
 import java.nio.ByteOrder;
 
@@ -42,6 +44,50 @@ public class ArrayFileTest extends TestCase {
     test(ByteOrder.LITTLE_ENDIAN);
   }
 
+  public void testArrays() throws IOException {
+    int n1 = 101, n2 = 102, n3 = 13; // rows shorter than i/o buffers
+    float[][][] a = randfloat(n1,n2,n3);
+    double[][][] c = randdouble(n1,n2,n3);
+    ByteOrder[] orders = {ByteOrder.BIG_ENDIAN,ByteOrder.LITTLE_ENDIAN};
+    boolean[] directs = {false,true};
+    File file = File.createTempFile("junk","dat");
+    try {
+      for (ByteOrder order:orders) {
+        for (boolean direct:directs) {
+          float[][][] b = zerofloat(n1,n2,n3);
+          double[][][] d = zerodouble(n1,n2,n3);
+          ArrayOutputStream aos = 
+            new ArrayOutputStream(new FileOutputStream(file),order,direct);
+          aos.writeInt(n1);
+          aos.writeFloats(a);
+          aos.writeDoubles(c[0]);
+          aos.writeDoubles(c);
+          aos.close();
+          ArrayInputStream ais = 
+            new ArrayInputStream(new FileInputStream(file),order,direct);
+          assertEquals(n1,ais.readInt());
+          ais.readFloats(b);
+          ais.readDoubles(d[0]);
+          assertTrue(equal(c[0],d[0]));
+          ais.readDoubles(d);
+          ais.close();
+          assertTrue(equal(a,b));
+          assertTrue(equal(c,d));
+        }
+        ArrayFile af = new ArrayFile(file,"rw",order,order);
+        float[][][] b = zerofloat(n1,n2,n3);
+        af.seek(0);
+        af.writeFloats(a);
+        af.seek(0);
+        af.readFloats(b);
+        assertTrue(equal(a,b));
+        af.close();
+      }
+    } finally {
+      file.delete();
+    }
+  }
+
   ///////////////////////////////////////////////////////////////////////////
   // private
 
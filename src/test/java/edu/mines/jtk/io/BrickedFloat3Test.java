@@ -0,0 +1,124 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.io;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.ByteOrder;
+import java.util.Random;
+
+import junit.framework.TestCase;
+import junit.framework.TestSuite;
+
+import static edu.mines.jtk.util.ArrayMath.*;
+
+/**
+ * Tests {@link edu.mines.jtk.io.BrickedFloat3}.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+public class BrickedFloat3Test extends TestCase {
+  public static void main(String[] args) {
+    TestSuite suite = new TestSuite(BrickedFloat3Test.class);
+    junit.textui.TestRunner.run(suite);
+  }
+
+  public void testBricked() throws IOException {
+    test(ByteOrder.BIG_ENDIAN,4,3,5,2);
+    test(ByteOrder.LITTLE_ENDIAN,4,3,5,2);
+    test(ByteOrder.BIG_ENDIAN,16,16,16,0);
+  }
+
+  public void testUnbricked() throws IOException {
+    int n1 = 10, n2 = 11, n3 = 12;
+    float[][][] a = randfloat(n1,n2,n3);
+    File file = File.createTempFile("junk","dat");
+    file.deleteOnExit();
+    ArrayFile af = new ArrayFile(file,"rw");
+    af.writeFloats(a);
+    af.close();
+    af = new ArrayFile(file,"r");
+    BrickedFloat3 bf3 = new BrickedFloat3(af,n1,n2,n3,n1,n2,1);
+    assertFalse(bf3.isWritable());
+    float[][][] b = new float[n3][n2][n1];
+    bf3.get123(n1,n2,n3,0,0,0,b);
+    assertEqual(a,b);
+    float[] b3 = new float[n3];
+    bf3.get3(n3,n1-1,n2-1,0,b3);
+    for (int i3=0; i3<n3; ++i3)
+      assertEquals(a[i3][n2-1][n1-1],b3[i3]);
+    af.close();
+    file.delete();
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // private
+
+  private static final int NTRIAL = 1000;
+
+  private static void test(
+    ByteOrder order, int m1, int m2, int m3, int nc)
+    throws IOException
+  {
+    int n1 = 10, n2 = 11, n3 = 12;
+    float[][][] a = randfloat(n1,n2,n3);
+    File file = File.createTempFile("junk","dat");
+    file.deleteOnExit();
+    ArrayFile af = new ArrayFile(file,"rw",order,order);
+    BrickedFloat3 bf3 = new BrickedFloat3(af,0L,n1,n2,n3,m1,m2,m3,nc);
+    assertTrue(bf3.isWritable());
+    bf3.set123(n1,n2,n3,0,0,0,a);
+    bf3.flush();
+    for (int i3=0; i3<n3; ++i3)
+      for (int i2=0; i2<n2; ++i2)
+        for (int i1=0; i1<n1; ++i1)
+          assertEquals(a[i3][i2][i1],bf3.get(i1,i2,i3));
+    Random r = new Random();
+    for (int itrial=0; itrial<NTRIAL; ++itrial) {
+      int k1 = 1+r.nextInt(n1-1);
+      int k2 = 1+r.nextInt(n2-1);
+      int k3 = 1+r.nextInt(n3-1);
+      int j1 = r.nextInt(n1-k1);
+      int j2 = r.nextInt(n2-k2);
+      int j3 = r.nextInt(n3-k3);
+      float[] s1 = new float[k1];
+      bf3.get1(k1,j1,j2,j3,s1);
+      for (int i1=0; i1<k1; ++i1)
+        assertEquals(a[j3][j2][j1+i1],s1[i1]);
+      float[][] s23 = new float[k3][k2];
+      bf3.get23(k2,k3,j1,j2,j3,s23);
+      for (int i3=0; i3<k3; ++i3)
+        for (int i2=0; i2<k2; ++i2)
+          assertEquals(a[j3+i3][j2+i2][j1],s23[i3][i2]);
+      float[][] s13 = randfloat(k1,k3);
+      bf3.set13(k1,k3,j1,j2,j3,s13);
+      for (int i3=0; i3<k3; ++i3)
+        for (int i1=0; i1<k1; ++i1)
+          a[j3+i3][j2][j1+i1] = s13[i3][i1];
+      float[] s = new float[k1*k2*k3];
+      bf3.get123(k1,k2,k3,j1,j2,j3,s);
+      for (int i3=0,is=0; i3<k3; ++i3)
+        for (int i2=0; i2<k2; ++i2)
+          for (int i1=0; i1<k1; ++i1,++is)
+            assertEquals(a[j3+i3][j2+i2][j1+i1],s[is]);
+    }
+    af.close();
+    file.delete();
+  }
+
+  private static void assertEqual(float[][][] a, float[][][] b) {
+    assertTrue(equal(a,b));
+  }
+}
@@ -0,0 +1,100 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.io;
+
+import junit.framework.TestCase;
+import junit.framework.TestSuite;
+
+import edu.mines.jtk.util.SimpleFloat3;
+import static edu.mines.jtk.util.ArrayMath.*;
+
+/**
+ * Tests {@link edu.mines.jtk.io.SlabPipeline}.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+public class SlabPipelineTest extends TestCase {
+  public static void main(String[] args) {
+    TestSuite suite = new TestSuite(SlabPipelineTest.class);
+    junit.textui.TestRunner.run(suite);
+  }
+
+  public void testCopy() {
+    int n1 = 5, n2 = 6, n3 = 17;
+    float[][][] x = randfloat(n1,n2,n3);
+    float[][][] y = zerofloat(n1,n2,n3);
+    SlabPipeline sp = new SlabPipeline(4,2);
+    sp.apply(new SimpleFloat3(x),new SimpleFloat3(y));
+    assertTrue(equal(x,y));
+  }
+
+  public void testHalo() {
+    int n1 = 5, n2 = 6, n3 = 17;
+    float[][][] x = randfloat(n1,n2,n3);
+    float[][][] z = zerofloat(n1,n2,n3);
+    smooth3(0,x,z);
+    smooth3(0,copy(z),z);
+    int[] m3s = {1,3,4,17,20};
+    for (int m3:m3s) {
+      float[][][] y = zerofloat(n1,n2,n3);
+      SlabPipeline sp = new SlabPipeline(m3,2);
+      SlabPipeline.Filter f = new SlabPipeline.Filter() {
+        public void apply(int j3, float[][][] x, float[][][] y) {
+          smooth3(j3,x,y);
+        }
+      };
+      sp.addFilter(f);
+      sp.addFilter(f);
+      sp.apply(new SimpleFloat3(x),new SimpleFloat3(y));
+      assertTrue(equal(z,y));
+    }
+  }
+
+  public void testException() {
+    int n1 = 5, n2 = 6, n3 = 17;
+    float[][][] x = randfloat(n1,n2,n3);
+    float[][][] y = zerofloat(n1,n2,n3);
+    SimpleFloat3 fy = new SimpleFloat3(y) {
+      public void set12(
+        int m1, int m2, int j1, int j2, int j3, float[][] s)
+      {
+        if (j3==9)
+          throw new IllegalStateException("cannot write slice 9");
+        super.set12(m1,m2,j1,j2,j3,s);
+      }
+    };
+    SlabPipeline sp = new SlabPipeline(4,2);
+    try {
+      sp.apply(new SimpleFloat3(x),fy);
+      fail("exception thrown by writer must be rethrown");
+    } catch (IllegalStateException e) {
+      assertEquals("cannot write slice 9",e.getMessage());
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // private
+
+  // Sum of three adjacent slices; zero beyond the slab ends. Exact
+  // results for two passes require a halo of two slices.
+  private static void smooth3(int j3, float[][][] x, float[][][] y) {
+    int n3 = x.length;
+    for (int i3=0; i3<n3; ++i3) {
+      copy(x[i3],y[i3]);
+      if (i3>0) add(x[i3-1],y[i3],y[i3]);
+      if (i3<n3-1) add(x[i3+1],y[i3],y[i3]);
+    }
+  }
+}
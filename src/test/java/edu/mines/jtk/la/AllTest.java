@@ -30,6 +30,7 @@ public class AllTest extends TestSuite {
     suite.addTestSuite(DMatrixTest.class);
     suite.addTestSuite(DMatrixEvdTest.class);
     suite.addTestSuite(DMatrixQrdTest.class);
+    suite.addTestSuite(DgemmTest.class);
 
     return suite;
   }
@@ -0,0 +1,125 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.la;
+
+import junit.framework.TestCase;
+import junit.framework.TestSuite;
+
+import static edu.mines.jtk.util.ArrayMath.*;
+
+/**
+ * Tests {@link edu.mines.jtk.la.Dgemm}.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+public class DgemmTest extends TestCase {
+  public static void main(String[] args) {
+    TestSuite suite = new TestSuite(DgemmTest.class);
+    junit.textui.TestRunner.run(suite);
+  }
+
+  public void testSmall() {
+    test(1,1,1);
+    test(3,2,5);
+    test(7,9,4);
+  }
+
+  public void testBlocks() {
+    // Dimensions that span more than one block and incomplete tiles.
+    test(131,263,5);
+    test(9,6,300);
+    test(130,261,259);
+  }
+
+  public void testOffsets() {
+    int m = 37, n = 41, k = 300;
+    double[][] a = randdouble(m+2,k+3);
+    double[][] b = randdouble(k+4,n+1);
+    double[][] c = randdouble(n+5,m+6);
+    double[][] d = copy(c);
+    double alpha = 0.5, beta = -2.0;
+    Dgemm.mul(true,true,m,n,k,alpha,a,2,3,b,4,1,beta,c,6,5);
+    for (int i=0; i<m; ++i) {
+      for (int j=0; j<n; ++j) {
+        double s = 0.0;
+        for (int p=0; p<k; ++p)
+          s += a[3+p][2+i]*b[1+j][4+p];
+        d[6+i][5+j] = alpha*s+beta*d[6+i][5+j];
+      }
+    }
+    assertEqual(d,c);
+  }
+
+  private static void test(int m, int n, int k) {
+    for (int it=0; it<4; ++it) {
+      boolean ta = (it&1)!=0;
+      boolean tb = (it&2)!=0;
+      double[][] a = (ta)?randdouble(m,k):randdouble(k,m);
+      double[][] b = (tb)?randdouble(k,n):randdouble(n,k);
+      double[][] c = randdouble(n,m);
+      double alpha = 1.5, beta = 0.25;
+
+      double[][] d = copy(c);
+      for (int i=0; i<m; ++i) {
+        for (int j=0; j<n; ++j) {
+          double s = 0.0;
+          for (int p=0; p<k; ++p)
+            s += ((ta)?a[p][i]:a[i][p])*((tb)?b[j][p]:b[p][j]);
+          d[i][j] = alpha*s+beta*d[i][j];
+        }
+      }
+
+      // Arrays of arrays.
+      double[][] e = copy(c);
+      Dgemm.mul(ta,tb,alpha,a,b,beta,e);
+      assertEqual(d,e);
+
+      // Column-major packed arrays, with leading dimensions.
+      int lda = ((ta)?k:m)+1;
+      int ldb = ((tb)?n:k)+2;
+      int ldc = m+3;
+      double[] ap = pack(a,lda);
+      double[] bp = pack(b,ldb);
+      double[] cp = pack(c,ldc);
+      Dgemm.mul(ta,tb,m,n,k,alpha,ap,lda,bp,ldb,beta,cp,ldc);
+      assertEqual(d,unpack(m,n,cp,ldc));
+    }
+  }
+
+  private static double[] pack(double[][] x, int ldx) {
+    int m = x.length;
+    int n = x[0].length;
+    double[] y = new double[ldx*n];
+    for (int j=0; j<n; ++j)
+      for (int i=0; i<m; ++i)
+        y[i+j*ldx] = x[i][j];
+    return y;
+  }
+
+  private static double[][] unpack(int m, int n, double[] y, int ldy) {
+    double[][] x = new double[m][n];
+    for (int j=0; j<n; ++j)
+      for (int i=0; i<m; ++i)
+        x[i][j] = y[i+j*ldy];
+    return x;
+  }
+
+  private static void assertEqual(double[][] a, double[][] b) {
+    for (int i=0; i<a.length; ++i) {
+      for (int j=0; j<a[i].length; ++j)
+        assertEquals(a[i][j],b[i][j],1.0e-10*(1.0+abs(a[i][j])));
+    }
+  }
+}
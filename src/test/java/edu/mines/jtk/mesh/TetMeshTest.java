@@ -351,6 +351,86 @@ public class TetMeshTest extends TestCase {
     //System.out.println("Nodes added/removed = "+nadd+"/"+nremove);
   }
 
+  public void testAddNodes() {
+    java.util.Random random = new java.util.Random();
+    int n = 1000;
+    float[] x = new float[n];
+    float[] y = new float[n];
+    float[] z = new float[n];
+    for (int i=0; i<n; ++i) {
+      x[i] = random.nextFloat();
+      y[i] = random.nextFloat();
+      z[i] = random.nextFloat();
+    }
+    x[n-1] = x[0];
+    y[n-1] = y[0];
+    z[n-1] = z[0];
+    TetMesh ta = new TetMesh();
+    for (int i=0; i<n-1; ++i)
+      ta.addNode(new TetMesh.Node(x[i],y[i],z[i]));
+    TetMesh tb = new TetMesh();
+    TetMesh.Node[] nodes = tb.addNodes(x,y,z);
+    tb.validate();
+    assertTrue((nodes[0]==null)!=(nodes[n-1]==null));
+    for (int i=1; i<n-1; ++i)
+      assertEquals(i,nodes[i].index);
+    assertEquals(ta.countNodes(),tb.countNodes());
+    assertEquals(ta.countTets(),tb.countTets());
+  }
+
+  public void testSnapshot() {
+    java.util.Random random = new java.util.Random();
+    int n = 500;
+    TetMesh tm = new TetMesh();
+    for (int i=0; i<n; ++i) {
+      TetMesh.Node node = new TetMesh.Node(
+        random.nextFloat(),random.nextFloat(),random.nextFloat());
+      node.index = i;
+      tm.addNode(node);
+    }
+    TetMeshSnapshot ts = tm.getSnapshot();
+    assertEquals(tm.getVersion(),ts.getVersion());
+    assertEquals(tm.countNodes(),ts.countNodes());
+    assertEquals(tm.countTets(),ts.countTets());
+    int ntet = ts.countTets();
+    int[] tetNodes = ts.getTetNodes();
+    int[] tetNabors = ts.getTetNabors();
+    for (int itet=0; itet<ntet; ++itet) {
+      for (int k=0; k<4; ++k) {
+        int jtet = tetNabors[4*itet+k];
+        if (jtet>=0) {
+          boolean mutual = false;
+          for (int l=0; l<4; ++l)
+            mutual |= tetNabors[4*jtet+l]==itet;
+          assertTrue(mutual);
+        }
+      }
+    }
+    int[] nodeIndices = ts.getNodeIndices();
+    int itet = 0;
+    for (int i=0; i<100; ++i) {
+      float x = random.nextFloat();
+      float y = random.nextFloat();
+      float z = random.nextFloat();
+      TetMesh.PointLocation pl = tm.locatePoint(x,y,z);
+      itet = ts.locateTet(x,y,z,itet);
+      assertEquals(pl.isInside(),itet>=0);
+      if (itet>=0) {
+        TetMesh.Tet tet = pl.tet();
+        int[] ia = {
+          tet.nodeA().index,tet.nodeB().index,
+          tet.nodeC().index,tet.nodeD().index
+        };
+        int[] ib = new int[4];
+        for (int k=0; k<4; ++k)
+          ib[k] = nodeIndices[tetNodes[4*itet+k]];
+        java.util.Arrays.sort(ia);
+        java.util.Arrays.sort(ib);
+        assertTrue(java.util.Arrays.equals(ia,ib));
+      }
+    }
+  }
+
   public void benchAddNode() {
     java.util.Random random = new java.util.Random();
     for (int itest=0; itest<16; ++itest) {
@@ -198,6 +198,30 @@ public class TriMeshTest extends TestCase {
     //System.out.println("Nodes added/removed = "+nadd+"/"+nremove);
   }
 
+  public void testAddNodes() {
+    java.util.Random random = new java.util.Random();
+    int n = 1000;
+    float[] x = new float[n];
+    float[] y = new float[n];
+    for (int i=0; i<n; ++i) {
+      x[i] = random.nextFloat();
+      y[i] = random.nextFloat();
+    }
+    x[n-1] = x[0];
+    y[n-1] = y[0];
+    TriMesh ta = new TriMesh();
+    for (int i=0; i<n-1; ++i)
+      ta.addNode(new TriMesh.Node(x[i],y[i]));
+    TriMesh tb = new TriMesh();
+    TriMesh.Node[] nodes = tb.addNodes(x,y);
+    tb.validate();
+    assertTrue((nodes[0]==null)!=(nodes[n-1]==null));
+    for (int i=1; i<n-1; ++i)
+      assertEquals(i,nodes[i].index);
+    assertEquals(ta.countNodes(),tb.countNodes());
+    assertEquals(ta.countTris(),tb.countTris());
+  }
+
   public void benchAddNode() {
     java.util.Random random = new java.util.Random();
     for (int itest=0; itest<3; ++itest) {
@@ -16,9 +16,11 @@ package edu.mines.jtk.mosaic;
 
 import java.awt.*;
 import java.awt.event.*;
+import java.util.HashMap;
 import javax.swing.*;
 
 import edu.mines.jtk.awt.ColorMap;
+import edu.mines.jtk.dsp.Sampling;
 
 /**
  * Tests {@link edu.mines.jtk.mosaic.ContoursView}
@@ -31,6 +33,7 @@ import edu.mines.jtk.awt.ColorMap;
 public class ContoursViewTest {
 
   public static void main(String[] args) {
+    testTiles();
     SwingUtilities.invokeLater(new Runnable() {
       public void run() {
         go();
@@ -38,6 +41,105 @@ public class ContoursViewTest {
     });
   }
 
+  // Traces contours in a grid of 3 by 2 tiles of 128 samples, and
+  // compares segments with those traced without tiles.
+  private static void testTiles() {
+    int n1 = 301;
+    int n2 = 257;
+    int nt = 6;
+    float[][] f = new float[n2][n1];
+    for (int i2=0; i2<n2; ++i2)
+      for (int i1=0; i1<n1; ++i1)
+        f[i2][i1] = (float)(Math.sin(0.031*i1+0.2)*Math.cos(0.023*i2-0.1));
+    Sampling s1 = new Sampling(n1);
+    Sampling s2 = new Sampling(n2);
+    ContoursView cv = new ContoursView(f);
+
+    // Contour values are not uniform, so that the contour sampling
+    // holds exactly these values.
+    float[] c = {-0.55f,-0.15f,0.25f,0.45f};
+    cv.setContours(c);
+    for (int ic=0; ic<c.length; ++ic)
+      checkTiles(cv,ic,c[ic],s1,s2,f);
+    checkCount(c.length*nt,cv.countContoursComputed());
+    checkValues(c,cv.getContours());
+
+    // New contour values; only those not cached are computed.
+    float[] d = {-0.55f,-0.35f,-0.15f,0.25f,0.45f,0.65f};
+    cv.setContours(d);
+    for (int id=0; id<d.length; ++id)
+      checkTiles(cv,id,d[id],s1,s2,f);
+    checkCount(d.length*nt,cv.countContoursComputed());
+    checkValues(d,cv.getContours());
+    cv.setContours(c);
+    checkTiles(cv,0,c[0],s1,s2,f);
+    checkCount(d.length*nt,cv.countContoursComputed());
+    checkValues(c,cv.getContours());
+  }
+  private static void checkTiles(
+    ContoursView cv, int ic, float fc,
+    Sampling s1, Sampling s2, float[][] f)
+  {
+    float[][][] xt = cv.getSegments(ic);
+    float[][][] xu = ContoursView.traceSegments(fc,s1,s2,f);
+
+    // Ends of segments on boundaries between tiles meet in pairs.
+    HashMap<String,Integer> ends = new HashMap<String,Integer>();
+    for (float[][] x:xt) {
+      int n = x[0].length;
+      for (int i=0; i<n; i+=Math.max(1,n-1)) {
+        float x1 = x[0][i];
+        float x2 = x[1][i];
+        if (x1==128.0f || x1==256.0f || x2==128.0f)
+          increment(ends,key(x1,x2));
+      }
+    }
+    if (ends.isEmpty())
+      throw new AssertionError("fc="+fc+": no segments cross tiles");
+    for (String k:ends.keySet()) {
+      if (ends.get(k)!=2)
+        throw new AssertionError("fc="+fc+": unmatched end at "+k);
+    }
+
+    // Segments in tiles and without tiles cross the same cells.
+    HashMap<String,Integer> et = edges(xt);
+    HashMap<String,Integer> eu = edges(xu);
+    if (!et.equals(eu))
+      throw new AssertionError("fc="+fc+": tiled segments differ");
+  }
+  private static HashMap<String,Integer> edges(float[][][] xs) {
+    HashMap<String,Integer> es = new HashMap<String,Integer>();
+    for (float[][] x:xs) {
+      for (int i=1; i<x[0].length; ++i) {
+        String ka = key(x[0][i-1],x[1][i-1]);
+        String kb = key(x[0][i],x[1][i]);
+        if (!ka.equals(kb))
+          increment(es,(ka.compareTo(kb)<0)?ka+" "+kb:kb+" "+ka);
+      }
+    }
+    return es;
+  }
+  private static String key(float x1, float x2) {
+    return Math.round(x1*1.0e4)+","+Math.round(x2*1.0e4);
+  }
+  private static void increment(HashMap<String,Integer> m, String k) {
+    Integer n = m.get(k);
+    m.put(k,(n==null)?1:n+1);
+  }
+  private static void checkCount(int expected, int count) {
+    if (count!=expected)
+      throw new AssertionError(
+        "contours computed="+count+" expected="+expected);
+  }
+  private static void checkValues(float[] expected, float[] c) {
+    if (c.length!=expected.length)
+      throw new AssertionError("number of contour values="+c.length);
+    for (int ic=0; ic<c.length; ++ic) {
+      if (c[ic]!=expected[ic])
+        throw new AssertionError("contour value="+c[ic]);
+    }
+  }
+
   public static void go() {
 
     float[][] array = new float[50][50];
@@ -14,6 +14,8 @@ limitations under the License.
 ****************************************************************************/
 package edu.mines.jtk.mosaic;
 
+import java.awt.image.BufferedImage;
+import java.awt.image.IndexColorModel;
 import static java.lang.Math.max;
 import javax.swing.*;
 
@@ -29,6 +31,7 @@ import static edu.mines.jtk.util.ArrayMath.*;
 public class PixelsViewTest {
 
   public static void main(String[] args) {
+    testTiles();
     SwingUtilities.invokeLater(new Runnable() {
       public void run() {
         test1();
@@ -37,6 +40,80 @@ public class PixelsViewTest {
     });
   }
 
+  // Paints to images larger than one tile, and compares pixels with
+  // those painted by new views and computed without tiles.
+  private static void testTiles() {
+    int n1 = 4;
+    int n2 = 3;
+    float[][] f = rampfloat(0.0f,1.0f,n1,n1,n2);
+    int wi = 400;
+    int hi = 300;
+
+    PlotPanel panel = makePanel(f,0.0f,11.0f,ColorMap.GRAY);
+    BufferedImage bi0 = paintToImage(panel,wi,hi);
+    checkGray(bi0,f,0.0f,11.0f);
+
+    // Change clips; tiles are reused, but their bytes recomputed.
+    PixelsView pv = (PixelsView)panel.getTile(0,0).getTiledView(0);
+    pv.setClips(0.0f,22.0f);
+    BufferedImage bi1 = paintToImage(panel,wi,hi);
+    checkGray(bi1,f,0.0f,22.0f);
+    checkSame(bi1,paintToImage(makePanel(f,0.0f,22.0f,ColorMap.GRAY),wi,hi));
+    pv.setClips(0.0f,11.0f);
+    checkSame(bi0,paintToImage(panel,wi,hi));
+
+    // Change color model; tiles are reused, but their images rebuilt.
+    pv.setColorModel(ColorMap.JET);
+    BufferedImage bi2 = paintToImage(panel,wi,hi);
+    checkSame(bi2,paintToImage(makePanel(f,0.0f,11.0f,ColorMap.JET),wi,hi));
+  }
+  private static PlotPanel makePanel(
+    float[][] f, float clipMin, float clipMax,
+    IndexColorModel icm)
+  {
+    PlotPanel panel = new PlotPanel(1,1,
+      PlotPanel.Orientation.X1RIGHT_X2UP,PlotPanel.AxesPlacement.NONE);
+    PixelsView pv = panel.addPixels(f);
+    pv.setInterpolation(PixelsView.Interpolation.NEAREST);
+    pv.setClips(clipMin,clipMax);
+    pv.setColorModel(icm);
+    return panel;
+  }
+  private static BufferedImage paintToImage(PlotPanel panel, int w, int h) {
+    BufferedImage bi = new BufferedImage(w,h,BufferedImage.TYPE_INT_RGB);
+    panel.getTile(0,0).paintToImage(bi);
+    return bi;
+  }
+  private static void checkGray(
+    BufferedImage bi, float[][] f, float clipMin, float clipMax)
+  {
+    int n1 = f[0].length;
+    int n2 = f.length;
+    int w = bi.getWidth();
+    int h = bi.getHeight();
+    for (int i2=0; i2<n2; ++i2) {
+      for (int i1=0; i1<n1; ++i1) {
+        int x = (int)((i1+0.5)*w/n1);
+        int y = (int)((n2-i2-0.5)*h/n2);
+        int b = (int)(255.0f*(f[i2][i1]-clipMin)/(clipMax-clipMin)+0.5f);
+        int g = (bi.getRGB(x,y)>>8)&0xff;
+        if (Math.abs(g-b)>1)
+          throw new AssertionError(
+            "pixel ("+x+","+y+"): gray="+g+" expected="+b);
+      }
+    }
+  }
+  private static void checkSame(BufferedImage bia, BufferedImage bib) {
+    int w = bia.getWidth();
+    int h = bia.getHeight();
+    for (int y=0; y<h; ++y) {
+      for (int x=0; x<w; ++x) {
+        if (bia.getRGB(x,y)!=bib.getRGB(x,y))
+          throw new AssertionError("pixel ("+x+","+y+") differs");
+      }
+    }
+  }
+
   private static void test1() {
     int n1 = 11;
     int n2 = 11;
@@ -23,6 +23,7 @@ import junit.framework.TestCase;
 import junit.framework.TestSuite;
 
 import edu.mines.jtk.util.Almost;
+import edu.mines.jtk.util.Parallel;
 
 /** Unit tests for edu.mines.jtk.opt.ArrayVect1f.
 */
@@ -82,6 +83,69 @@ public class ArrayVect1fTest extends TestCase {
     }
   }
 
+  /** Test parallel and fused operations on large vectors.
+   * @throws Exception any test failure */
+  public void testLarge() throws Exception {
+    int n = 300001; // large enough to be processed in parallel
+    float[] a = new float[n];
+    float[] b = new float[n];
+    float[] c = new float[n];
+    for (int i=0; i<n; ++i) {
+      a[i] = (float) Math.sin(0.01*i);
+      b[i] = (float) Math.cos(0.02*i);
+      c[i] = (float) (i%7) - 3.f;
+    }
+    ArrayVect1f va = new ArrayVect1f(a, 0, 1.);
+    ArrayVect1f vb = new ArrayVect1f(b, 0, 1.);
+    ArrayVect1f vc = new ArrayVect1f(c, 0, 1.);
+    double ab = 0.;
+    for (int i=0; i<n; ++i) {ab += (double) a[i]*b[i];}
+    assertEquals(ab, va.dot(vb), 1.e-9*n);
+
+    Vect vd = va.clone();
+    vd.add(0.5, -2., vb);
+    double dc = vd.dot(vc);
+    Vect ve = va.clone();
+    double ec = VectUtil.addAndDot(ve, 0.5, -2., vb, vc);
+    assertEquals(dc, ec, 1.e-9*n);
+    assert VectUtil.areSame(vd, ve);
+    for (int i=0; i<n; ++i) {
+      assertEquals(0.5f*a[i]-2.f*b[i], ((ArrayVect1f)ve).getData()[i], 0.f);
+    }
+  }
+
+  /** Test that dot products of large vectors are reproducible.
+   * @throws Exception any test failure */
+  public void testReproducible() throws Exception {
+    int n = 300001; // large enough to be processed in parallel
+    float[] a = new float[n];
+    float[] b = new float[n];
+    for (int i=0; i<n; ++i) {
+      a[i] = (float) Math.sin(0.01*i);
+      b[i] = (float) Math.cos(0.02*i);
+    }
+    ArrayVect1f va = new ArrayVect1f(a, 0, 1.);
+    ArrayVect1f vb = new ArrayVect1f(b, 0, 1.);
+    double ab = 0.;
+    double bb = 0.;
+    try {
+      for (int iter=0; iter<10; ++iter) {
+        Parallel.setParallel(iter%2==1);
+        ArrayVect1f vc = va.clone();
+        double abi = va.dot(vb);
+        double bbi = vc.addAndDot(0.5, -2., vb, vb);
+        if (iter==0) {
+          ab = abi;
+          bb = bbi;
+        }
+        assertEquals(ab, abi, 0.);
+        assertEquals(bb, bbi, 0.);
+      }
+    } finally {
+      Parallel.setParallel(true);
+    }
+  }
+
   // OPTIONAL OPTIONAL OPTIONAL OPTIONAL OPTIONAL OPTIONAL OPTIONAL
 
   /* Initialize objects used by all test methods */
@@ -20,6 +20,7 @@ import junit.framework.TestCase;
 import junit.framework.TestSuite;
 
 import edu.mines.jtk.util.Almost;
+import edu.mines.jtk.util.Parallel;
 
 /** Unit tests for edu.mines.jtk.opt.ArrayVect2f.
 */
@@ -70,6 +71,38 @@ public class ArrayVect2fTest extends TestCase {
     }
   }
 
+  /** Test that dot products of large vectors are reproducible. */
+  public void testReproducible() {
+    float[][] a = new float[301][1001]; // large enough for parallel
+    float[][] b = new float[301][1001];
+    for (int i=0; i<a.length; ++i) {
+      for (int j=0; j<a[i].length; ++j) {
+        a[i][j] = (float) Math.sin(0.01*i+0.03*j);
+        b[i][j] = (float) Math.cos(0.02*i-0.01*j);
+      }
+    }
+    ArrayVect2f va = new ArrayVect2f(a, 1.);
+    ArrayVect2f vb = new ArrayVect2f(b, 1.);
+    double ab = 0.;
+    double bb = 0.;
+    try {
+      for (int iter=0; iter<10; ++iter) {
+        Parallel.setParallel(iter%2==1);
+        ArrayVect2f vc = va.clone();
+        double abi = va.dot(vb);
+        double bbi = vc.addAndDot(0.5, -2., vb, vb);
+        if (iter==0) {
+          ab = abi;
+          bb = bbi;
+        }
+        assertEquals(ab, abi, 0.);
+        assertEquals(bb, bbi, 0.);
+      }
+    } finally {
+      Parallel.setParallel(true);
+    }
+  }
+
   // OPTIONAL OPTIONAL OPTIONAL OPTIONAL OPTIONAL OPTIONAL OPTIONAL
 
   /* Initialize objects used by all test methods */
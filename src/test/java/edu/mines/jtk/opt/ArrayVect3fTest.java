@@ -18,6 +18,7 @@ import junit.framework.TestCase;
 import junit.framework.TestSuite;
 
 import edu.mines.jtk.util.Almost;
+import edu.mines.jtk.util.Parallel;
 
 /** Unit tests for edu.mines.jtk.opt.ArrayVect3f.
 */
@@ -51,6 +52,40 @@ public class ArrayVect3fTest extends TestCase {
     assert Almost.FLOAT.equal(1./7., v.magnitude());
   }
 
+  /** Test that dot products of large vectors are reproducible. */
+  public void testReproducible() {
+    float[][][] a = new float[31][41][101]; // large enough for parallel
+    float[][][] b = new float[31][41][101];
+    for (int i=0; i<a.length; ++i) {
+      for (int j=0; j<a[i].length; ++j) {
+        for (int k=0; k<a[i][j].length; ++k) {
+          a[i][j][k] = (float) Math.sin(0.01*i+0.03*j-0.02*k);
+          b[i][j][k] = (float) Math.cos(0.02*i-0.01*j+0.04*k);
+        }
+      }
+    }
+    ArrayVect3f va = new ArrayVect3f(a, 1.);
+    ArrayVect3f vb = new ArrayVect3f(b, 1.);
+    double ab = 0.;
+    double bb = 0.;
+    try {
+      for (int iter=0; iter<10; ++iter) {
+        Parallel.setParallel(iter%2==1);
+        ArrayVect3f vc = va.clone();
+        double abi = va.dot(vb);
+        double bbi = vc.addAndDot(0.5, -2., vb, vb);
+        if (iter==0) {
+          ab = abi;
+          bb = bbi;
+        }
+        assertEquals(ab, abi, 0.);
+        assertEquals(bb, bbi, 0.);
+      }
+    } finally {
+      Parallel.setParallel(true);
+    }
+  }
+
   // OPTIONAL OPTIONAL OPTIONAL OPTIONAL OPTIONAL OPTIONAL OPTIONAL
 
   /* Initialize objects used by all test methods */
@@ -74,6 +74,38 @@ public class QuadraticSolverTest extends TestCase {
 
   }
 
+  /** Workspace vectors reused by many solves remain bounded in number.
+   */
+  public void testPool() {
+    Quadratic q = new Quadratic() {
+        public void multiplyHessian(Vect x) {
+          double[] data = ((ArrayVect1)x).getData();
+          double d0 = 2.*data[0] + 4.*data[1];
+          double d1 = 4.*data[0] + 11.*data[1];
+          data[0] = d0;
+          data[1] = d1;
+        }
+        public void inverseHessian(Vect x) {}
+        public Vect getB() { // a new vector for each linearization
+          return new TestVect(new double[] {2.,1.}, 1.);
+        }
+      };
+    VectPool pool = new VectPool(4);
+    for (int iter=0; iter<10; ++iter) {
+      QuadraticSolver qs = new QuadraticSolver(q, pool);
+      ArrayVect1 result = (ArrayVect1) qs.solve(2, null);
+      assert Almost.FLOAT.equal(-3., result.getData()[0]): "result="+result;
+      assert Almost.FLOAT.equal(1., result.getData()[1]): "result="+result;
+      pool.give(result);
+      assert pool.size() <= 4 : "pool size = "+pool.size();
+      assert TestVect.undisposed.size() <= 4 :
+        "undisposed vectors = "+TestVect.undisposed.size();
+    }
+    pool.dispose();
+    assert pool.size() == 0;
+    assert TestVect.undisposed.size() == 0 : TestVect.getTraces();
+  }
+
   private static class TestVect extends ArrayVect1 {
     private static final long serialVersionUID = 1L;
     /** Visible only for tests */
@@ -30,6 +30,7 @@ public class AllTest extends TestSuite {
     suite.addTestSuite(BoundingTest.class);
     suite.addTestSuite(BoundingBoxTreeTest.class);
     suite.addTestSuite(MatrixPointVectorTest.class);
+    suite.addTestSuite(VertexBuffersTest.class);
 
     return suite;
   }
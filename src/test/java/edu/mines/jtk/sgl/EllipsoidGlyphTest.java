@@ -152,6 +152,7 @@ public class EllipsoidGlyphTest {
     public void draw(DrawContext dc) {
       int ns = _cx.length;
       int nt = _cx[0].length;
+      _ellipsoid.begin();
       for (int is=0; is<ns; ++is) {
         for (int it=0; it<nt; ++it) {
           _ellipsoid.draw(
@@ -161,6 +162,7 @@ public class EllipsoidGlyphTest {
             _wx[is][it],_wy[is][it],_wz[is][it]);
         }
       }
+      _ellipsoid.end();
     }
     public BoundingSphere computeBoundingSphere(boolean finite) {
       return _bs;
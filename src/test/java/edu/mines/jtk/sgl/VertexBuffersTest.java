@@ -0,0 +1,118 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.sgl;
+
+import java.nio.FloatBuffer;
+
+import junit.framework.TestCase;
+import junit.framework.TestSuite;
+
+import static edu.mines.jtk.util.ArrayMath.*;
+
+/**
+ * Tests {@link edu.mines.jtk.sgl.VertexBuffers}.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+public class VertexBuffersTest extends TestCase {
+  public static void main(String[] args) {
+    TestSuite suite = new TestSuite(VertexBuffersTest.class);
+    junit.textui.TestRunner.run(suite);
+  }
+
+  public void testIndexed() {
+    // A grid of quads, each split into two triangles that share vertices.
+    int n1 = 11, n2 = 13;
+    int nv = n1*n2;
+    float[] xyz = randfloat(3*nv);
+    float[] uvw = randfloat(3*nv);
+    float[] rgb = randfloat(3*nv);
+    int nt = 2*(n1-1)*(n2-1);
+    int[] ijk = new int[3*nt];
+    for (int i2=0,k=0; i2<n2-1; ++i2) {
+      for (int i1=0; i1<n1-1; ++i1) {
+        int i00 = i1+i2*n1, i10 = i00+1, i01 = i00+n1, i11 = i01+1;
+        ijk[k++] = i00; ijk[k++] = i10; ijk[k++] = i11;
+        ijk[k++] = i00; ijk[k++] = i11; ijk[k++] = i01;
+      }
+    }
+
+    // A subset of every third triangle.
+    int np = (nt+2)/3;
+    int[] index = new int[np];
+    for (int ip=0; ip<np; ++ip)
+      index[ip] = 3*ip;
+    VertexBuffers vbs = VertexBuffers.makeIndexed(3,index,ijk,xyz,uvw,rgb);
+    FloatBuffer vb = vbs.getVertexBuffer();
+    assertEquals(3*np,vbs.countElements());
+    assertTrue(vb.capacity()<3*3*np);
+
+    // Every element refers to the vertex of the original primitive.
+    for (int ip=0,ie=0; ip<np; ++ip) {
+      for (int j=0; j<3; ++j,++ie) {
+        int iv = 3*ijk[3*index[ip]+j];
+        int kv = 3*vbs.getElement(ie);
+        for (int m=0; m<3; ++m)
+          assertEquals(xyz[iv+m],vb.get(kv+m),0.0f);
+      }
+    }
+  }
+
+  public void testDecimate() {
+    // A planar grid of n x n vertices and 2*(n-1)*(n-1) triangles.
+    int n = 17;
+    float[] xyz = new float[3*n*n];
+    for (int i2=0,k=0; i2<n; ++i2) {
+      for (int i1=0; i1<n; ++i1) {
+        xyz[k++] = i1;
+        xyz[k++] = i2;
+        xyz[k++] = 0.0f;
+      }
+    }
+    int nt = 2*(n-1)*(n-1);
+    int[] ijk = new int[3*nt];
+    for (int i2=0,k=0; i2<n-1; ++i2) {
+      for (int i1=0; i1<n-1; ++i1) {
+        int i00 = i1+i2*n, i10 = i00+1, i01 = i00+n, i11 = i01+1;
+        ijk[k++] = i00; ijk[k++] = i10; ijk[k++] = i11;
+        ijk[k++] = i00; ijk[k++] = i11; ijk[k++] = i01;
+      }
+    }
+    int[] index = new int[nt];
+    for (int it=0; it<nt; ++it)
+      index[it] = it;
+    VertexBuffers vbs = VertexBuffers.makeIndexed(3,index,ijk,xyz,xyz,null);
+    BoundingBox bb = new BoundingBox(xyz);
+
+    // With one vertex per cell, no triangles are lost.
+    VertexBuffers fine = vbs.decimateTriangles(2*n,bb);
+    assertEquals(3*nt,fine.countElements());
+
+    // With fewer cells, fewer triangles; vertices move less than a cell.
+    int ng = 4;
+    VertexBuffers coarse = vbs.decimateTriangles(ng,bb);
+    int ne = coarse.countElements();
+    assertTrue(0<ne && ne<3*nt/10);
+    FloatBuffer vb = coarse.getVertexBuffer();
+    float dcell = (float)(n-1)/ng;
+    for (int ie=0; ie<ne; ++ie) {
+      int k = 3*coarse.getElement(ie);
+      float x = vb.get(k), y = vb.get(k+1);
+      assertTrue(-dcell<x && x<n-1+dcell);
+      assertTrue(-dcell<y && y<n-1+dcell);
+      assertEquals(0.0f,vb.get(k+2),0.0f);
+    }
+  }
+}
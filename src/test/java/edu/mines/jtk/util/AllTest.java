@@ -39,6 +39,8 @@ public class AllTest extends TestSuite {
     suite.addTestSuite(MathPlusTest.class);
     suite.addTestSuite(ParameterTest.class);
     suite.addTestSuite(ParameterSetTest.class);
+    suite.addTestSuite(ProfilerTest.class);
+    suite.addTestSuite(QuantileSketchTest.class);
     suite.addTestSuite(QuantilerTest.class);
     suite.addTestSuite(SimpleFloat3Test.class);
     suite.addTestSuite(StopwatchTest.class);
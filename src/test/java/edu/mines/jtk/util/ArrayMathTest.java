@@ -249,6 +249,136 @@ public class ArrayMathTest extends TestCase {
     assertEquals(0,imin[2]);
   }
 
+  public void testParallel() {
+    // Large enough to be processed in parallel.
+    int n1 = 101;
+    int n2 = 102;
+    int n3 = 13;
+    float[][][] rx = randfloat(n1,n2,n3);
+    float[][][] ry = randfloat(n1,n2,n3);
+    float[][][] rz = zerofloat(n1,n2,n3);
+    float[][][] rs = add(rx,ry);
+    float[][][] rc = clip(0.25f,0.75f,rx);
+    float[][][] rq = sqrt(rx);
+    double sum = 0.0;
+    float max = rx[0][0][0];
+    float min = rx[0][0][0];
+    for (int i3=0; i3<n3; ++i3) {
+      for (int i2=0; i2<n2; ++i2) {
+        for (int i1=0; i1<n1; ++i1) {
+          float xi = rx[i3][i2][i1];
+          float yi = ry[i3][i2][i1];
+          assertTrue(rs[i3][i2][i1]==xi+yi);
+          assertTrue(rc[i3][i2][i1]==((xi<0.25f)?0.25f:(xi>0.75f)?0.75f:xi));
+          assertTrue(rq[i3][i2][i1]==(float)Math.sqrt(xi));
+          sum += xi;
+          max = max(max,xi);
+          min = min(min,xi);
+        }
+      }
+    }
+    assertEquals(sum,sum(rx),1.0e-4*sum);
+    assertTrue(max==max(rx));
+    assertTrue(min==min(rx));
+
+    // Ragged arrays with empty rows, with and without an empty first row.
+    for (int i0=0; i0<2; ++i0) {
+      float[][] fr = new float[n2*n3][];
+      double[][] dr = new double[n2*n3][];
+      for (int i2=0; i2<n2*n3; ++i2) {
+        int m1 = (i2%3==i0)?0:n1+i2%5;
+        fr[i2] = randfloat(m1);
+        dr[i2] = randdouble(m1);
+      }
+      float fmax = -Float.MAX_VALUE;
+      float fmin =  Float.MAX_VALUE;
+      double dmax = -Double.MAX_VALUE;
+      double dmin =  Double.MAX_VALUE;
+      for (int i2=0; i2<n2*n3; ++i2) {
+        for (int i1=0; i1<fr[i2].length; ++i1) {
+          fmax = max(fmax,fr[i2][i1]);
+          fmin = min(fmin,fr[i2][i1]);
+          dmax = max(dmax,dr[i2][i1]);
+          dmin = min(dmin,dr[i2][i1]);
+        }
+      }
+      assertTrue(fmax==max(fr));
+      assertTrue(fmin==min(fr));
+      assertTrue(dmax==max(dr));
+      assertTrue(dmin==min(dr));
+      float[][][] fr3 = {fr,new float[0][],fr};
+      double[][][] dr3 = {dr,new double[0][],dr};
+      assertTrue(fmax==max(fr3));
+      assertTrue(fmin==min(fr3));
+      assertTrue(dmax==max(dr3));
+      assertTrue(dmin==min(dr3));
+    }
+    assertTrue(-Float.MAX_VALUE==max(new float[0][]));
+    assertTrue( Float.MAX_VALUE==min(new float[0][]));
+    assertTrue(-Double.MAX_VALUE==max(new double[0][][]));
+    assertTrue( Double.MAX_VALUE==min(new double[0][][]));
+
+    // Fused expressions equal those computed with temporary arrays.
+    lincomb(2.0f,rx,-3.0f,ry,rz);
+    assertEqual(sub(mul(2.0f,rx),mul(3.0f,ry)),rz);
+    evaluate(new Expression() {
+      public float evaluate(float x, float y, float z) {
+        return x*y+z;
+      }
+    },rx,ry,rs,rz);
+    assertEqual(add(mul(rx,ry),rs),rz);
+  }
+
+  public void testSum() {
+    // Large enough to be processed in parallel.
+    int n1 = 101;
+    int n2 = 102;
+    int n3 = 13;
+    float[][][] fx = randfloat(n1,n2,n3);
+    double[][][] dx = randdouble(n1,n2,n3);
+    float[][] fx2 = new float[n2*n3][];
+    for (int i3=0,j2=0; i3<n3; ++i3)
+      for (int i2=0; i2<n2; ++i2,++j2)
+        fx2[j2] = fx[i3][i2];
+
+    // Reference sums of rows in double precision, added in index order.
+    // Rows of 3-D arrays are added for each slice, then slices are added.
+    double fs2 = 0.0;
+    double fs3 = 0.0;
+    double ds3 = 0.0;
+    for (int i3=0; i3<n3; ++i3) {
+      double fs = 0.0;
+      double ds = 0.0;
+      for (int i2=0; i2<n2; ++i2) {
+        double fr = 0.0;
+        double dr = 0.0;
+        for (int i1=0; i1<n1; ++i1) {
+          fr += fx[i3][i2][i1];
+          dr += dx[i3][i2][i1];
+        }
+        fs2 += fr;
+        fs += fr;
+        ds += dr;
+      }
+      fs3 += fs;
+      ds3 += ds;
+    }
+
+    // Same sums for repeated runs, in parallel and serially.
+    try {
+      for (int iter=0; iter<10; ++iter) {
+        Parallel.setParallel(iter%2==0);
+        assertTrue((float)fs2==sum(fx2));
+        assertTrue((float)fs3==sum(fx));
+        assertTrue(ds3==sum(dx));
+      }
+    } finally {
+      Parallel.setParallel(true);
+    }
+    assertTrue(0.0f==sum(new float[0][]));
+    assertTrue(0.0==sum(new double[0][][]));
+  }
+
   private void assertEqual(float[] rx, float[] ry) {
     assertTrue(equal(rx,ry));
   }
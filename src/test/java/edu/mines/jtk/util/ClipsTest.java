@@ -19,6 +19,7 @@ import junit.framework.TestSuite;
 
 import static edu.mines.jtk.util.ArrayMath.FLT_EPSILON;
 import static edu.mines.jtk.util.ArrayMath.rampfloat;
+import static edu.mines.jtk.util.ArrayMath.reshape;
 
 /**
  * Tests {@link edu.mines.jtk.util.Clips}.
@@ -49,4 +50,21 @@ public class ClipsTest extends TestCase {
       assertEquals(imax,cmax,tiny);
     }
   }
+
+  public void testPercentileError() {
+    int n1 = 1001, n2 = 1002;
+    float[][] f = reshape(n1,n2,rampfloat(0.0f,1.0f,n1*n2));
+    Clips clips = new Clips(f);
+    clips.setPercentileError(0.1);
+    double error = 0.001*(n1*n2-1);
+    for (int ip=0; ip<50; ip+=7) {
+      double pmin = ip;
+      double pmax = 100-ip;
+      clips.setPercentiles(pmin,pmax);
+      float cmin = clips.getClipMin();
+      float cmax = clips.getClipMax();
+      assertEquals(0.01*pmin*(n1*n2-1),cmin,error);
+      assertEquals(0.01*pmax*(n1*n2-1),cmax,error);
+    }
+  }
 }
@@ -15,6 +15,7 @@ limitations under the License.
 package edu.mines.jtk.util;
 
 import java.util.Random;
+import java.util.concurrent.ForkJoinPool;
 
 import junit.framework.TestCase;
 import junit.framework.TestSuite;
@@ -93,6 +94,97 @@ public class ParallelTest extends TestCase {
     });
   }
 
+  public void testAdaptive() {
+    Random r = new Random();
+    for (int ntest=0; ntest<100; ++ntest) {
+      int n = 1+r.nextInt(100000);
+      int begin = r.nextInt(n);
+      int step = 1+r.nextInt(6);
+      final float[] a = randfloat(n);
+      final float[] b = zerofloat(n);
+      loop(begin,n,step,new LoopInt() {
+        public void compute(int i) {
+          b[i] = a[i]*a[i];
+        }
+      });
+      float[] bs = zerofloat(n);
+      sqrS(begin,n,step,a,bs);
+      assertEquals(bs,b,0.0f);
+      int count = reduce(begin,n,step,new ReduceInt<Integer>() {
+        public Integer compute(int i) {
+          return 1;
+        }
+        public Integer combine(Integer c1, Integer c2) {
+          return c1+c2;
+        }
+      });
+      assertEquals((n-begin+step-1)/step,count);
+    }
+  }
+
+  public void testLoop2() {
+    final int n1 = 3, n2 = 1001;
+    final int[][] c = new int[n2][n1];
+    loop2(n1,n2,new LoopInt2() {
+      public void compute(int i1, int i2) {
+        ++c[i2][i1];
+      }
+    });
+    for (int i2=0; i2<n2; ++i2)
+      for (int i1=0; i1<n1; ++i1)
+        assertEquals(1,c[i2][i1]);
+    LoopInt2 fail = new LoopInt2() {
+      public void compute(int i1, int i2) {
+        fail("empty loop must not call its body");
+      }
+    };
+    loop2(0,n2,fail);
+    loop2(n1,0,fail);
+  }
+
+  public void testLoop3() {
+    final int n1 = 5, n2 = 7, n3 = 2;
+    final int[][][] c = new int[n3][n2][n1];
+    loop3(n1,n2,n3,new LoopInt3() {
+      public void compute(int i1, int i2, int i3) {
+        ++c[i3][i2][i1];
+      }
+    });
+    for (int i3=0; i3<n3; ++i3)
+      for (int i2=0; i2<n2; ++i2)
+        for (int i1=0; i1<n1; ++i1)
+          assertEquals(1,c[i3][i2][i1]);
+    LoopInt3 fail = new LoopInt3() {
+      public void compute(int i1, int i2, int i3) {
+        fail("empty loop must not call its body");
+      }
+    };
+    loop3(0,n2,n3,fail);
+    loop3(n1,0,n3,fail);
+    loop3(n1,n2,0,fail);
+  }
+
+  public void testPool() {
+    ForkJoinPool pool = getPool();
+    ForkJoinPool pool2 = new ForkJoinPool(2);
+    try {
+      setPool(pool2);
+      final float[] a = randfloat(10000);
+      final float[] b = zerofloat(10000);
+      loop(0,a.length,1,1,new LoopInt() {
+        public void compute(int i) {
+          b[i] = a[i]*a[i];
+        }
+      });
+      float[] bs = zerofloat(10000);
+      sqrS(0,a.length,1,a,bs);
+      assertEquals(bs,b,0.0f);
+    } finally {
+      setPool(pool);
+      pool2.shutdown();
+    }
+  }
+
   public void testUnsafe() {
     final Unsafe<Worker> nts = new Unsafe<Worker>();
     loop(20,new LoopInt() {
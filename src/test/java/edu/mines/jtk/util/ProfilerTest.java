@@ -0,0 +1,128 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.util;
+
+import java.util.Map;
+
+import junit.framework.TestCase;
+import junit.framework.TestSuite;
+
+/**
+ * Tests {@link edu.mines.jtk.util.Profiler}.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+public class ProfilerTest extends TestCase {
+  public static void main(String[] args) {
+    TestSuite suite = new TestSuite(ProfilerTest.class);
+    junit.textui.TestRunner.run(suite);
+  }
+
+  public void testDisabled() {
+    Profiler.setEnabled(false);
+    Profiler.reset();
+    Profiler.start("ProfilerTest.disabled");
+    Profiler.count("ProfilerTest.disabled",1);
+    Profiler.stop("ProfilerTest.disabled");
+    assertNull(Profiler.getTimes().get("ProfilerTest.disabled"));
+    assertNull(Profiler.getCounts().get("ProfilerTest.disabled"));
+  }
+
+  public void testPhasesAndCounts() {
+    Profiler.setEnabled(true);
+    Profiler.reset();
+    for (int i=0; i<3; ++i) {
+      Profiler.start("ProfilerTest.outer");
+      Profiler.start("ProfilerTest.outer"); // nested, not counted again
+      sleep(0.01);
+      Profiler.stop("ProfilerTest.outer");
+      Profiler.stop("ProfilerTest.outer");
+      Profiler.count("ProfilerTest.count",2);
+    }
+    Profiler.setEnabled(false);
+    double time = Profiler.getTimes().get("ProfilerTest.outer");
+    assertTrue(time>=0.03);
+    assertEquals(3L,(long)Profiler.getCalls().get("ProfilerTest.outer"));
+    assertEquals(6L,(long)Profiler.getCounts().get("ProfilerTest.count"));
+    String thread = Thread.currentThread().getName();
+    Map<String,Double> times = Profiler.getThreadTimes().get(thread);
+    assertEquals(time,times.get("ProfilerTest.outer"),0.0);
+    assertTrue(Profiler.getReport().contains("ProfilerTest.outer"));
+    Profiler.reset();
+    assertEquals(0.0,Profiler.getTimes().get("ProfilerTest.outer"),0.0);
+    assertNull(Profiler.getCounts().get("ProfilerTest.count"));
+  }
+
+  public void testThreads() {
+    Profiler.setEnabled(true);
+    Profiler.reset();
+    Parallel.loop(100,new Parallel.LoopInt() {
+      public void compute(int i) {
+        Profiler.start("ProfilerTest.parallel");
+        Profiler.count("ProfilerTest.parallel",i);
+        Profiler.stop("ProfilerTest.parallel");
+      }
+    });
+    Profiler.setEnabled(false);
+    assertEquals(100L,(long)Profiler.getCalls().get("ProfilerTest.parallel"));
+    assertEquals(4950L,(long)Profiler.getCounts().get("ProfilerTest.parallel"));
+    Profiler.reset();
+  }
+
+  public void testDisabledBeforeStop() {
+    Profiler.setEnabled(true);
+    Profiler.reset();
+    Profiler.start("ProfilerTest.toggle");
+    Profiler.setEnabled(false);
+    Profiler.stop("ProfilerTest.toggle"); // stopped, though disabled
+    Profiler.setEnabled(true);
+    Profiler.start("ProfilerTest.toggle");
+    Profiler.stop("ProfilerTest.toggle");
+    Profiler.setEnabled(false);
+    assertEquals(2L,(long)Profiler.getCalls().get("ProfilerTest.toggle"));
+    double time = Profiler.getTimes().get("ProfilerTest.toggle");
+    sleep(0.01);
+    assertEquals(time,Profiler.getTimes().get("ProfilerTest.toggle"),0.0);
+    Profiler.reset();
+  }
+
+  public void testDeadThreads() throws InterruptedException {
+    Profiler.setEnabled(true);
+    Profiler.reset();
+    Thread t = new Thread(new Runnable() {
+      public void run() {
+        Profiler.start("ProfilerTest.dead");
+        Profiler.stop("ProfilerTest.dead");
+        Profiler.start("ProfilerTest.dead"); // never stopped
+      }
+    },"ProfilerTest.dead");
+    t.start();
+    t.join();
+    Profiler.setEnabled(false);
+    assertNotNull(Profiler.getThreadTimes().get("ProfilerTest.dead"));
+    assertEquals(2L,(long)Profiler.getCalls().get("ProfilerTest.dead"));
+    Profiler.reset();
+    assertNull(Profiler.getThreadTimes().get("ProfilerTest.dead"));
+    assertNull(Profiler.getCalls().get("ProfilerTest.dead"));
+  }
+
+  private static void sleep(double time) {
+    try {
+      Thread.sleep((long)(time*1000.0));
+    } catch (InterruptedException e) {
+      throw new RuntimeException(e);
+    }
+  }
+}
@@ -0,0 +1,138 @@
+/****************************************************************************
+Copyright 2026, Colorado School of Mines and others.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+****************************************************************************/
+package edu.mines.jtk.util;
+
+import java.util.Arrays;
+import java.util.Random;
+
+import junit.framework.TestCase;
+import junit.framework.TestSuite;
+
+import static edu.mines.jtk.util.ArrayMath.*;
+
+/**
+ * Tests {@link edu.mines.jtk.util.QuantileSketch}.
+ * @author Dave Hale, Colorado School of Mines
+ * @version 2026.10.14
+ */
+public class QuantileSketchTest extends TestCase {
+  public static void main(String[] args) {
+    TestSuite suite = new TestSuite(QuantileSketchTest.class);
+    junit.textui.TestRunner.run(suite);
+  }
+
+  public void testExact() {
+    int n = 101;
+    float[] f = rampfloat(100.0f,-1.0f,n);
+    QuantileSketch qs = new QuantileSketch(2*n);
+    qs.update(f);
+    assertEquals(0.0,qs.getRankError());
+    for (int i=0; i<n; ++i)
+      assertEquals((float)i,qs.estimate(i/100.0));
+  }
+
+  public void testRankError() {
+    int n = 100000;
+    Random random = new Random(314159);
+    float[] f = new float[n];
+    for (int i=0; i<n; ++i)
+      f[i] = (float)random.nextGaussian();
+    float[] s = copy(f);
+    quickSort(s);
+    int k = 64;
+    QuantileSketch qs = new QuantileSketch(k);
+    qs.update(f);
+    checkSketch(qs,s);
+
+    // Merged sketches have the same bound on rank error.
+    QuantileSketch qa = new QuantileSketch(k);
+    QuantileSketch qb = new QuantileSketch(k);
+    qa.update(Arrays.copyOfRange(f,0,n/3));
+    qb.update(Arrays.copyOfRange(f,n/3,n));
+    qa.merge(qb);
+    checkSketch(qa,s);
+
+    // So do sketches computed in parallel.
+    checkSketch(QuantileSketch.compute(k,f),s);
+    checkSketch(QuantileSketch.compute(k,reshape(100,n/100,f)),s);
+  }
+
+  public void testRows() {
+    Random random = new Random(271828);
+    int n1 = 1000;
+    int n2 = 30;
+    int n3 = 7;
+    float[][][] f = new float[n3][n2][];
+    for (int i3=0; i3<n3; ++i3) {
+      for (int i2=0; i2<n2; ++i2) {
+        f[i3][i2] = new float[(i2%4==0)?0:n1];
+        for (int i1=0; i1<f[i3][i2].length; ++i1)
+          f[i3][i2][i1] = (float)random.nextGaussian();
+      }
+    }
+    float[] s3 = flatten(f);
+    float[] s2 = flatten(f[0]);
+    quickSort(s3);
+    quickSort(s2);
+    int k = 64;
+    checkSketch(QuantileSketch.compute(k,f),s3);
+    checkSketch(QuantileSketch.compute(k,f[0]),s2);
+  }
+
+  public void testEmpty() {
+    int k = 64;
+    assertEquals(0,QuantileSketch.compute(k,new float[0]).getCount());
+    assertEquals(0,QuantileSketch.compute(k,new float[0][]).getCount());
+    assertEquals(0,QuantileSketch.compute(k,new float[0][0]).getCount());
+    assertEquals(0,QuantileSketch.compute(k,new float[0][][]).getCount());
+    assertEquals(0,QuantileSketch.compute(k,new float[3][0][]).getCount());
+  }
+
+  public void testCapacity() {
+    long n = 1000000000L;
+    double error = 0.001;
+    int k = QuantileSketch.getCapacity(error,n);
+    double nlevel = 1.0+floor(log((double)n/k)/log(2.0));
+    assertTrue(nlevel/(k-1.0)<=error);
+  }
+
+  private static void checkSketch(QuantileSketch qs, float[] s) {
+    int n = s.length;
+    double error = qs.getRankError();
+    assertEquals(n,qs.getCount());
+    assertEquals(s[0],qs.getMin());
+    assertEquals(s[n-1],qs.getMax());
+    assertTrue(error>0.0);
+    assertTrue(error<=(1.0+log2(n/qs.getCapacity()))/(qs.getCapacity()-1));
+    for (int iq=0; iq<=100; ++iq) {
+      double q = iq/100.0;
+      float v = qs.estimate(q);
+
+      // Range [rlo,rhi] of ranks of the estimated value.
+      int rlo = 0;
+      while (s[rlo]<v)
+        ++rlo;
+      int rhi = rlo;
+      while (rhi<n-1 && s[rhi+1]==v)
+        ++rhi;
+      double r = rint(q*(n-1));
+      assertTrue(rlo-error*n<=r && r<=rhi+error*n);
+    }
+  }
+
+  private static double log2(double x) {
+    return log(x)/log(2.0);
+  }
+}
@@ -84,6 +84,69 @@ public class RTreeTest extends TestCase {
     }
   }
 
+  public void testPacked() {
+    int n = 2000;
+    RTree.Box[] boxs = new RTree.Box[n];
+    for (int i=0; i<n; ++i)
+      boxs[i] = randomBox(0.05f);
+    PackedRTree pt = new PackedRTree(3,8,boxs);
+    assertEquals(n,pt.size());
+    int k = 5;
+    int npoint = 300;
+    float[][] points = new float[npoint][];
+    for (int j=0; j<npoint; ++j)
+      points[j] = randomPoint();
+    int[][] index = pt.findNearest(k,points);
+    float radius = 0.1f;
+    int[][] inSphere = pt.findInSphere(points,radius);
+    for (int j=0; j<npoint; ++j) {
+      float[] point = points[j];
+      float[] ds = new float[n];
+      int ns = 0;
+      for (int i=0; i<n; ++i) {
+        ds[i] = boxs[i].getDistanceSquared(point);
+        if (ds[i]<=radius*radius)
+          ++ns;
+      }
+      Arrays.sort(ds);
+      assertEquals(k,index[j].length);
+      for (int l=0; l<k; ++l)
+        assertEquals(ds[l],boxs[index[j][l]].getDistanceSquared(point),0.0f);
+      assertEquals(ns,inSphere[j].length);
+      for (int i:inSphere[j])
+        assertTrue(boxs[i].getDistanceSquared(point)<=radius*radius);
+    }
+    int inear = pt.findNearest(points[0]);
+    assertEquals(boxs[index[0][0]].getDistanceSquared(points[0]),
+                 boxs[inear].getDistanceSquared(points[0]),0.0f);
+  }
+
+  public void testPackedArguments() {
+    int n = 100;
+    RTree.Box[] boxs = new RTree.Box[n];
+    for (int i=0; i<n; ++i)
+      boxs[i] = randomBox(0.05f);
+    PackedRTree pt = new PackedRTree(3,8,boxs);
+    float[][] points = {randomPoint(),randomPoint(),new float[2]};
+    int[][] index = new int[points.length][1];
+    try { pt.findNearest(1,points); fail(); }
+    catch (IllegalArgumentException e) {}
+    try { pt.findNearest(1,points,index,null); fail(); }
+    catch (IllegalArgumentException e) {}
+    try { pt.findInSphere(points,0.1f); fail(); }
+    catch (IllegalArgumentException e) {}
+    points[2] = randomPoint();
+    try { pt.findNearest(0,points); fail(); }
+    catch (IllegalArgumentException e) {}
+    try { pt.findNearest(0,points,index,null); fail(); }
+    catch (IllegalArgumentException e) {}
+    try { pt.findInSphere(points,-0.1f); fail(); }
+    catch (IllegalArgumentException e) {}
+    pt.findNearest(1,points,index,null);
+    assertEquals(pt.findInSphere(points[0],0.0f).length,
+                 pt.findInSphere(points,0.0f)[0].length);
+  }
+
   public void testIterator() {
     RTree rt = new RTree(3,4,12);
     int n = 100;